@@ -307,6 +307,165 @@ namespace ose::project
 					LOG_ERROR("Failed to parse rendering::projection settings");
 				}
 			}
+
+			// Parse the render path, either forward (default) or deferred
+			auto render_path_node = rendering_node->first_node("render_path");
+			auto render_path_attrib = render_path_node ? render_path_node->first_attribute("type") : nullptr;
+			if(render_path_attrib != nullptr)
+			{
+				std::string render_path { render_path_attrib->value() };
+				if(render_path == "deferred")
+					settings.rendering_settings_.render_path_ = ERenderPath::DEFERRED;
+				else if(render_path == "forward")
+					settings.rendering_settings_.render_path_ = ERenderPath::FORWARD;
+				else
+					LOG_ERROR("Render path must be forward or deferred");
+			}
+
+			// Process the texture streaming settings
+			auto texture_streaming_node = rendering_node->first_node("texture_streaming");
+			auto budget_attrib = texture_streaming_node ? texture_streaming_node->first_attribute("budget_mb") : nullptr;
+			if(budget_attrib != nullptr)
+			{
+				try
+				{
+					settings.rendering_settings_.texture_budget_mb_ = static_cast<uint32_t>(std::stoul(budget_attrib->value()));
+				}
+				catch(...)
+				{
+					LOG_ERROR("Failed to parse rendering::texture_streaming settings");
+				}
+			}
+
+			// Process the texture compression settings
+			auto texture_compression_node = rendering_node->first_node("texture_compression");
+			auto build_attrib = texture_compression_node ? texture_compression_node->first_attribute("build") : nullptr;
+			if(build_attrib != nullptr)
+				settings.rendering_settings_.build_texture_containers_ = std::string(build_attrib->value()) == "true";
+
+			// Process the upload queue settings
+			auto upload_queue_node = rendering_node->first_node("upload_queue");
+			auto upload_budget_attrib = upload_queue_node ? upload_queue_node->first_attribute("budget_ms") : nullptr;
+			if(upload_budget_attrib != nullptr)
+			{
+				try
+				{
+					settings.rendering_settings_.upload_budget_ms_ = std::stof(upload_budget_attrib->value());
+				}
+				catch(...)
+				{
+					LOG_ERROR("Failed to parse rendering::upload_queue settings");
+				}
+			}
+
+			// Process the static batching settings
+			auto static_batching_node = rendering_node->first_node("static_batching");
+			auto cell_size_attrib = static_batching_node ? static_batching_node->first_attribute("cell_size") : nullptr;
+			if(cell_size_attrib != nullptr)
+			{
+				try
+				{
+					settings.rendering_settings_.static_batch_cell_size_ = std::stof(cell_size_attrib->value());
+				}
+				catch(...)
+				{
+					LOG_ERROR("Failed to parse rendering::static_batching settings");
+				}
+			}
+
+			// Process the mesh level of detail settings
+			auto lod_node = rendering_node->first_node("lod");
+			auto screen_error_attrib = lod_node ? lod_node->first_attribute("screen_error") : nullptr;
+			if(screen_error_attrib != nullptr)
+			{
+				try
+				{
+					settings.rendering_settings_.lod_screen_error_ = std::stof(screen_error_attrib->value());
+				}
+				catch(...)
+				{
+					LOG_ERROR("Failed to parse rendering::lod settings");
+				}
+			}
+
+			// Process the dynamic resolution settings
+			auto dynamic_resolution_node = rendering_node->first_node("dynamic_resolution");
+			if(dynamic_resolution_node != nullptr)
+			{
+				auto enabled_attrib = dynamic_resolution_node->first_attribute("enabled");
+				auto target_ms_attrib = dynamic_resolution_node->first_attribute("target_ms");
+				auto min_scale_attrib = dynamic_resolution_node->first_attribute("min_scale");
+				auto filter_attrib = dynamic_resolution_node->first_attribute("filter");
+				settings.rendering_settings_.dynamic_resolution_ = enabled_attrib == nullptr || std::string(enabled_attrib->value()) == "true";
+				try
+				{
+					if(target_ms_attrib != nullptr)
+						settings.rendering_settings_.target_frame_time_ms_ = std::stof(target_ms_attrib->value());
+					if(min_scale_attrib != nullptr)
+						settings.rendering_settings_.min_render_scale_ = std::stof(min_scale_attrib->value());
+				}
+				catch(...)
+				{
+					LOG_ERROR("Failed to parse rendering::dynamic_resolution settings");
+				}
+				if(filter_attrib != nullptr)
+				{
+					std::string filter { filter_attrib->value() };
+					if(filter == "bilinear")
+						settings.rendering_settings_.upscale_filter_ = EUpscaleFilter::BILINEAR;
+					else if(filter == "sharpen")
+						settings.rendering_settings_.upscale_filter_ = EUpscaleFilter::SHARPEN;
+					else
+						LOG_ERROR("Upscale filter must be bilinear or sharpen");
+				}
+			}
+
+			auto profiler_node = rendering_node->first_node("profiler");
+			if(profiler_node != nullptr)
+			{
+				auto enabled_attrib = profiler_node->first_attribute("enabled");
+				auto overlay_attrib = profiler_node->first_attribute("overlay");
+				settings.rendering_settings_.profiler_ = enabled_attrib == nullptr || std::string(enabled_attrib->value()) == "true";
+				if(overlay_attrib != nullptr)
+					settings.rendering_settings_.profiler_overlay_ = std::string(overlay_attrib->value()) == "true";
+			}
+
+			// Effects are applied in the order they are listed, e.g. <post_processing><bloom threshold="0.8" intensity="0.6"/><vignette strength="0.4"/></post_processing>
+			auto post_processing_node = rendering_node->first_node("post_processing");
+			if(post_processing_node != nullptr)
+			{
+				for(auto effect_node = post_processing_node->first_node(); effect_node; effect_node = effect_node->next_sibling())
+				{
+					std::string type { effect_node->name() };
+					PostEffect effect;
+					if(type == "bloom")
+						effect.type_ = EPostEffect::BLOOM;
+					else if(type == "vignette")
+						effect.type_ = EPostEffect::VIGNETTE;
+					else
+					{
+						LOG_ERROR("Post effect must be bloom or vignette, found", type);
+						continue;
+					}
+					auto threshold_attrib = effect_node->first_attribute("threshold");
+					auto intensity_attrib = effect_node->first_attribute("intensity");
+					auto strength_attrib = effect_node->first_attribute("strength");
+					try
+					{
+						if(threshold_attrib != nullptr)
+							effect.threshold_ = std::stof(threshold_attrib->value());
+						if(intensity_attrib != nullptr)
+							effect.intensity_ = std::stof(intensity_attrib->value());
+						if(strength_attrib != nullptr)
+							effect.strength_ = std::stof(strength_attrib->value());
+					}
+					catch(...)
+					{
+						LOG_ERROR("Failed to parse rendering::post_processing settings");
+					}
+					settings.rendering_settings_.post_effects_.push_back(effect);
+				}
+			}
 		}
 
 		return settings;
@@ -471,6 +630,19 @@ namespace ose::project
 		// Create the new scene object
 		uptr<Scene> scene = ose::make_unique<Scene>(scene_name_attrib ? scene_name_attrib->value() : scene_name, control_settings);
 
+		// The scene can optionally override the project's render path
+		auto render_path_attrib = scene_node->first_attribute("render_path");
+		if(render_path_attrib != nullptr)
+		{
+			std::string render_path { render_path_attrib->value() };
+			if(render_path == "deferred")
+				scene->SetRenderPath(ERenderPath::DEFERRED);
+			else if(render_path == "forward")
+				scene->SetRenderPath(ERenderPath::FORWARD);
+			else
+				LOG_ERROR("Render path of scene", scene->GetName(), "must be forward or deferred");
+		}
+
 		// Map of aliases (lhs = alias, rhs = replacement), only applicable to current file
 		std::unordered_map<std::string, std::string> aliases;
 		ParseResources(resources_node, aliases, project);
@@ -669,6 +841,11 @@ namespace ose::project
 			return nullptr;
 		}
 
+		// Optionally has a static attribute, level geometry which never moves should be static s.t. it can be batched
+		auto static_attrib = entity_node->first_attribute("static");
+		if(static_attrib)
+			new_entity->SetStatic(std::string(static_attrib->value()) == "true");
+
 		// parse the transform component of the new entity
 		for(auto component_node = entity_node->first_node("transform"); component_node; component_node = component_node->next_sibling("transform"))
 		{
@@ -755,6 +932,18 @@ namespace ose::project
 				LOG_ERROR("Failed to parse num_cols/num_rows/num_tiles/spacing_x/spacing_y attribute(s) as integer");
 			}
 
+			// Optionally has a render_mode attribute, either chunked (default) or index_texture
+			auto render_mode_attrib = component_node->first_attribute("render_mode");
+			ETileRenderMode render_mode { ETileRenderMode::CHUNKED };
+			if(render_mode_attrib != nullptr)
+			{
+				std::string render_mode_text { render_mode_attrib->value() };
+				if(render_mode_text == "index_texture")
+					render_mode = ETileRenderMode::INDEX_TEXTURE;
+				else if(render_mode_text != "chunked")
+					LOG_ERROR("Unknown tile render mode", render_mode_text, "defaulting to chunked");
+			}
+
 			// If texture is an alias, find it's replacement text, else use the file text
 			std::string texture_text { (texture_attrib ? texture_attrib->value() : "") };
 			auto const texture_text_alias_pos { aliases.find(texture_text) };
@@ -779,7 +968,7 @@ namespace ose::project
 				material = project.GetResourceManager().GetMaterial("OSE-DefaultOpaqueSpriteMaterial");
 
 			if(tex != nullptr && tmap != nullptr) {
-				new_entity->AddComponent<TileRenderer>(name, tex, tmap, material, num_cols, num_rows, num_tiles, spacing_x, spacing_y);
+				new_entity->AddComponent<TileRenderer>(name, tex, tmap, material, num_cols, num_rows, num_tiles, spacing_x, spacing_y, render_mode);
 			} else {
 				if(tex == nullptr) {
 					LOG_ERROR("Texture", texture, "has not been loaded");
@@ -817,8 +1006,12 @@ namespace ose::project
 			if(!material)
 				material = project.GetResourceManager().GetMaterial("OSE-DefaultOpaqueMeshMaterial");
 
+			// Optionally has an occluder attribute, large meshes which hide others should be occluders
+			auto occluder_attrib = component_node->first_attribute("occluder");
+			bool occluder { occluder_attrib != nullptr && std::string(occluder_attrib->value()) == "true" };
+
 			if(mesh != nullptr) {
-				new_entity->AddComponent<MeshRenderer>(name, mesh, material);
+				new_entity->AddComponent<MeshRenderer>(name, mesh, material, occluder);
 			} else {
 				LOG_ERROR("Mesh", mesh_path, "has not been loaded");
 			}
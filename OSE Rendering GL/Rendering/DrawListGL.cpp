@@ -0,0 +1,83 @@
+#include "pch.h"
+#include "DrawListGL.h"
+
+namespace ose::rendering
+{
+	// Number of bits given to each field of the sort key, the fields sum to 64 bits
+	constexpr uint32_t KEY_PASS_BITS { 3 };
+	constexpr uint32_t KEY_BLEND_BITS { 1 };
+	constexpr uint32_t KEY_SHADER_BITS { 12 };
+	constexpr uint32_t KEY_MATERIAL_BITS { 12 };
+	constexpr uint32_t KEY_TEXTURE_BITS { 16 };
+	constexpr uint32_t KEY_DEPTH_BITS { 20 };
+
+	DrawListGL::DrawListGL() {}
+
+	DrawListGL::~DrawListGL() {}
+
+	// Build the sort key of a draw
+	// Opaque draws are ordered by state, then front to back to reduce overdraw
+	// Blended draws are ordered back to front for correct blending, then by state
+	// depth is the normalised [0, 1] distance from the camera
+	uint64_t DrawListGL::MakeKey(uint32_t pass, bool blend, uint32_t shader, uint32_t material, uint32_t texture, float depth)
+	{
+		auto field = [](uint32_t value, uint32_t bits) -> uint64_t {
+			return static_cast<uint64_t>(value) & ((uint64_t { 1 } << bits) - 1);
+		};
+
+		uint32_t const max_depth { (1u << KEY_DEPTH_BITS) - 1 };
+		uint32_t quantised_depth { static_cast<uint32_t>(std::clamp(depth, 0.0f, 1.0f) * max_depth) };
+
+		uint64_t key { field(pass, KEY_PASS_BITS) };
+		key = (key << KEY_BLEND_BITS) | field(blend ? 1 : 0, KEY_BLEND_BITS);
+		if(!blend)
+		{
+			key = (key << KEY_SHADER_BITS) | field(shader, KEY_SHADER_BITS);
+			key = (key << KEY_MATERIAL_BITS) | field(material, KEY_MATERIAL_BITS);
+			key = (key << KEY_TEXTURE_BITS) | field(texture, KEY_TEXTURE_BITS);
+			key = (key << KEY_DEPTH_BITS) | field(quantised_depth, KEY_DEPTH_BITS);
+		}
+		else
+		{
+			key = (key << KEY_DEPTH_BITS) | field(max_depth - quantised_depth, KEY_DEPTH_BITS);
+			key = (key << KEY_SHADER_BITS) | field(shader, KEY_SHADER_BITS);
+			key = (key << KEY_MATERIAL_BITS) | field(material, KEY_MATERIAL_BITS);
+			key = (key << KEY_TEXTURE_BITS) | field(texture, KEY_TEXTURE_BITS);
+		}
+		return key;
+	}
+
+	// Sort the draws by key using an LSD radix sort
+	void DrawListGL::Sort()
+	{
+		if(items_.size() < 2)
+			return;
+
+		scratch_.resize(items_.size());
+
+		// Sort one byte at a time from least to most significant, each pass is a stable counting sort
+		for(uint32_t shift = 0; shift < 64; shift += 8)
+		{
+			size_t counts[256] { 0 };
+			for(auto const & item : items_)
+				++counts[(item.key_ >> shift) & 0xFF];
+
+			// Skip the pass if every key has the same byte, the order would be unchanged
+			if(counts[(items_[0].key_ >> shift) & 0xFF] == items_.size())
+				continue;
+
+			size_t offset { 0 };
+			for(size_t & count : counts)
+			{
+				size_t c { count };
+				count = offset;
+				offset += c;
+			}
+
+			for(auto const & item : items_)
+				scratch_[counts[(item.key_ >> shift) & 0xFF]++] = item;
+
+			items_.swap(scratch_);
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+namespace ose::rendering
+{
+	// A single draw of a render group, referenced by index into the render pool
+	struct DrawItemGL
+	{
+		uint64_t key_;
+		uint32_t pass_;
+		uint32_t material_group_;
+		uint32_t render_group_;
+
+		// Range of instances of the render group to draw
+		uint32_t first_instance_;
+		uint32_t num_instances_;
+
+		// Level of detail the instances are drawn with, 0 for full detail
+		uint32_t lod_;
+	};
+
+	// Per-frame list of draws ordered by a 64-bit sort key
+	// The key orders draws by pass, then blending, then the state they require s.t. state changes are minimised
+	class DrawListGL
+	{
+	public:
+		DrawListGL();
+		~DrawListGL();
+		DrawListGL(DrawListGL const & other) = delete;
+		DrawListGL & operator=(DrawListGL const & other) = delete;
+		DrawListGL(DrawListGL && other) noexcept = default;
+		DrawListGL & operator=(DrawListGL && other) noexcept = default;
+
+		// Build the sort key of a draw
+		// Opaque draws are ordered by state, then front to back to reduce overdraw
+		// Blended draws are ordered back to front for correct blending, then by state
+		// depth is the normalised [0, 1] distance from the camera
+		static uint64_t MakeKey(uint32_t pass, bool blend, uint32_t shader, uint32_t material, uint32_t texture, float depth);
+
+		// Add a draw to the end of the list
+		void Push(uint64_t key, uint32_t pass, uint32_t material_group, uint32_t render_group, uint32_t first_instance, uint32_t num_instances,
+			uint32_t lod = 0)
+		{
+			items_.push_back({ key, pass, material_group, render_group, first_instance, num_instances, lod });
+		}
+
+		// Sort the draws by key using an LSD radix sort
+		void Sort();
+
+		// Remove all draws s.t. the list can be rebuilt for the next frame
+		void Clear() { items_.clear(); }
+
+		// Get the list of draws, sorted iff Sort has been called since the last Push
+		std::vector<DrawItemGL> const & GetItems() const { return items_; }
+
+	private:
+		std::vector<DrawItemGL> items_;
+
+		// Scratch buffer used by the radix sort, kept between frames to avoid reallocating
+		std::vector<DrawItemGL> scratch_;
+	};
+}
@@ -8,7 +8,10 @@ namespace ose::rendering
 	{
 		SPRITE_RENDERER,
 		TILE_RENDERER,
+		TILE_INDEX_RENDERER,
 		MESH_RENDERER,
-		DEFERRED_QUAD
+		DEFERRED_QUAD,
+		POINT_LIGHT,
+		DIR_LIGHT
 	};
 }
@@ -0,0 +1,38 @@
+#include "pch.h"
+#include "FrameFencesGL.h"
+
+namespace ose::rendering
+{
+	FrameFencesGL::~FrameFencesGL()
+	{
+		for(GLsync fence : fences_)
+			glDeleteSync(fence);
+	}
+
+	bool FrameFencesGL::PopOldest(bool wait)
+	{
+		if(fences_.empty())
+			return false;
+
+		GLsync fence { fences_.front() };
+		GLenum result { glClientWaitSync(fence, 0, 0) };
+		if(wait)
+		{
+			// Flush the fence on the first wait so it is guaranteed to signal, then wait for up to a second at a time
+			GLbitfield flags { GL_SYNC_FLUSH_COMMANDS_BIT };
+			while(result == GL_TIMEOUT_EXPIRED)
+			{
+				result = glClientWaitSync(fence, flags, 1000000000);
+				flags = 0;
+			}
+		}
+		if(result == GL_TIMEOUT_EXPIRED)
+			return false;
+		if(result == GL_WAIT_FAILED)
+			LOG_ERROR("Failed to wait for frame fence");
+
+		glDeleteSync(fence);
+		fences_.pop_front();
+		return true;
+	}
+}
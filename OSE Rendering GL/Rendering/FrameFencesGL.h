@@ -0,0 +1,26 @@
+#pragma once
+#include "OSE-Core/Rendering/FrameFences.h"
+#include <deque>
+
+namespace ose::rendering
+{
+	// GLsync fences waited for by a fenced ring allocator
+	// Requires GL 3.2 or ARB_sync
+	class FrameFencesGL final : public FrameFences
+	{
+	public:
+		FrameFencesGL() = default;
+		~FrameFencesGL();
+
+		FrameFencesGL(FrameFencesGL const &) = delete;
+		FrameFencesGL & operator=(FrameFencesGL const &) = delete;
+
+		void Insert() override { fences_.push_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)); }
+		bool PopOldest(bool wait) override;
+		size_t GetNumFences() const override { return fences_.size(); }
+
+	private:
+		// Fences oldest first
+		std::deque<GLsync> fences_;
+	};
+}
@@ -2,10 +2,12 @@
 
 namespace ose::rendering
 {
+	// G-buffer written by the geometry pass of the deferred render path
+	// Layout: position (rgb) + metallic (a), normal (rgb) + roughness (a), albedo (rgb) + ambient occlusion (a)
 	class FramebufferGL
 	{
 	public:
-		FramebufferGL(int fbwidth, int fbheight)
+		FramebufferGL(int fbwidth, int fbheight) : width_(fbwidth), height_(fbheight)
 		{
 			if(fbwidth <= 0 || fbheight <= 0)
 				throw std::invalid_argument("Framebuffer width/height out of bounds");
@@ -17,7 +19,7 @@ namespace ose::rendering
 			// Create a position buffer attachment
 			glGenTextures(1, &pos_buffer_);
 			glBindTexture(GL_TEXTURE_2D, pos_buffer_);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, fbwidth, fbheight, 0, GL_RGB, GL_FLOAT, NULL);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, fbwidth, fbheight, 0, GL_RGBA, GL_FLOAT, NULL);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, pos_buffer_, 0);
@@ -25,7 +27,7 @@ namespace ose::rendering
 			// Create a normal buffer attachment
 			glGenTextures(1, &norm_buffer_);
 			glBindTexture(GL_TEXTURE_2D, norm_buffer_);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, fbwidth, fbheight, 0, GL_RGB, GL_FLOAT, NULL);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, fbwidth, fbheight, 0, GL_RGBA, GL_FLOAT, NULL);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, norm_buffer_, 0);
@@ -33,7 +35,7 @@ namespace ose::rendering
 			// Create a colour + specular buffer attachment
 			glGenTextures(1, &col_buffer_);
 			glBindTexture(GL_TEXTURE_2D, col_buffer_);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, fbwidth, fbheight, 0, GL_RGB, GL_FLOAT, NULL);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, fbwidth, fbheight, 0, GL_RGBA, GL_FLOAT, NULL);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, GL_TEXTURE_2D, col_buffer_, 0);
@@ -57,6 +59,10 @@ namespace ose::rendering
 			glBindFramebuffer(GL_FRAMEBUFFER, 0);
 		}
 
+		// The framebuffer owns its OpenGL objects so cannot be copied
+		FramebufferGL(FramebufferGL const &) = delete;
+		FramebufferGL & operator=(FramebufferGL const &) = delete;
+
 		~FramebufferGL()
 		{
 			if(fbo_)
@@ -73,12 +79,14 @@ namespace ose::rendering
 
 		void Resize(int fbwidth, int fbheight)
 		{
+			width_ = fbwidth;
+			height_ = fbheight;
 			glBindTexture(GL_TEXTURE_2D, pos_buffer_);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, fbwidth, fbheight, 0, GL_RGB, GL_FLOAT, NULL);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, fbwidth, fbheight, 0, GL_RGBA, GL_FLOAT, NULL);
 			glBindTexture(GL_TEXTURE_2D, norm_buffer_);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, fbwidth, fbheight, 0, GL_RGB, GL_FLOAT, NULL);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, fbwidth, fbheight, 0, GL_RGBA, GL_FLOAT, NULL);
 			glBindTexture(GL_TEXTURE_2D, col_buffer_);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, fbwidth, fbheight, 0, GL_RGB, GL_FLOAT, NULL);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, fbwidth, fbheight, 0, GL_RGBA, GL_FLOAT, NULL);
 			glBindRenderbuffer(GL_RENDERBUFFER, depth_rbo_);
 			glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, fbwidth, fbheight);
 		}
@@ -89,11 +97,16 @@ namespace ose::rendering
 		GLuint GetColBuffer() const { return col_buffer_; }
 		GLuint GetDepthRbo() const { return depth_rbo_; }
 
+		int GetWidth() const { return width_; }
+		int GetHeight() const { return height_; }
+
 	private:
 		GLuint fbo_				{ 0 };
 		GLuint pos_buffer_		{ 0 };
 		GLuint norm_buffer_		{ 0 };
 		GLuint col_buffer_		{ 0 };
 		GLuint depth_rbo_		{ 0 };
+		int width_				{ 0 };
+		int height_				{ 0 };
 	};
 }
@@ -0,0 +1,67 @@
+#include "pch.h"
+#include "GpuTimerGL.h"
+
+namespace ose::rendering
+{
+	GpuTimerGL::~GpuTimerGL()
+	{
+		if(supported_)
+			glDeleteQueries(NUM_QUERIES * 2, &queries_[0][0]);
+	}
+
+	// Create the queries, must be called once OpenGL has been initialised
+	// Returns false if timer queries are not supported
+	bool GpuTimerGL::Init()
+	{
+		if(supported_)
+			return true;
+		supported_ = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+		if(supported_)
+			glGenQueries(NUM_QUERIES * 2, &queries_[0][0]);
+		return supported_;
+	}
+
+	// Start measuring the commands submitted from now on, only one measurement may be active at a time
+	void GpuTimerGL::Begin()
+	{
+		// When every query is still in flight the frame is not measured rather than waiting for the oldest
+		active_ = supported_ && num_pending_ < NUM_QUERIES;
+		if(active_)
+			glQueryCounter(queries_[next_][0], GL_TIMESTAMP);
+	}
+
+	// Stop measuring, the result can be read by Poll() once the GPU has executed the commands
+	void GpuTimerGL::End()
+	{
+		if(!active_)
+			return;
+		glQueryCounter(queries_[next_][1], GL_TIMESTAMP);
+		next_ = (next_ + 1) % NUM_QUERIES;
+		++num_pending_;
+		active_ = false;
+	}
+
+	// Get the most recent measurement (in milliseconds) which has become available since the last call, without waiting
+	// Returns false if no measurement has become available
+	bool GpuTimerGL::Poll(float & ms)
+	{
+		bool found { false };
+		while(num_pending_ > 0)
+		{
+			// Queries complete in order, so the oldest is checked first
+			// The end timestamp is written after the start, so once it is available both are
+			GLuint const * queries { queries_[(next_ + NUM_QUERIES - num_pending_) % NUM_QUERIES] };
+			GLint available { 0 };
+			glGetQueryObjectiv(queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+			if(!available)
+				break;
+			GLuint64 start { 0 }, end { 0 };
+			glGetQueryObjectui64v(queries[0], GL_QUERY_RESULT, &start);
+			glGetQueryObjectui64v(queries[1], GL_QUERY_RESULT, &end);
+			ms = static_cast<float>(end - start) / 1000000.0f;
+			--num_pending_;
+			found = true;
+		}
+		return found;
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+namespace ose::rendering
+{
+	// Measures the time the GPU spends executing the commands between Begin() and End() using a pair of timestamp queries
+	// Timestamps are used rather than a GL_TIME_ELAPSED query s.t. the profiler's elapsed time queries can be active inside the measurement
+	// Results arrive a few frames late, so a ring of queries is used and results are only read once available, s.t. the CPU never waits
+	// Timer queries require GL 3.3 or ARB_timer_query, when unavailable no results are ever returned
+	class GpuTimerGL
+	{
+	public:
+		// Number of measurements which can be in flight at once, Begin() skips a frame when all are in flight
+		static constexpr uint32_t NUM_QUERIES { 4 };
+
+		GpuTimerGL() = default;
+		~GpuTimerGL();
+
+		GpuTimerGL(GpuTimerGL const &) = delete;
+		GpuTimerGL & operator=(GpuTimerGL const &) = delete;
+
+		// Create the queries, must be called once OpenGL has been initialised
+		// Returns false if timer queries are not supported
+		bool Init();
+
+		// Returns true iff timer queries are supported
+		bool IsSupported() const { return supported_; }
+
+		// Start measuring the commands submitted from now on, only one measurement may be active at a time
+		void Begin();
+
+		// Stop measuring, the result can be read by Poll() once the GPU has executed the commands
+		void End();
+
+		// Get the most recent measurement (in milliseconds) which has become available since the last call, without waiting
+		// Returns false if no measurement has become available
+		bool Poll(float & ms);
+
+	private:
+		// Start and end timestamp query of each measurement
+		GLuint queries_[NUM_QUERIES][2] {};
+
+		// Index of the query the next measurement uses
+		uint32_t next_ { 0 };
+
+		// Number of measurements whose results haven't been read, the oldest is num_pending_ queries behind next_
+		uint32_t num_pending_ { 0 };
+
+		// True between Begin() and End() if a query was started
+		bool active_ { false };
+
+		bool supported_ { false };
+	};
+}
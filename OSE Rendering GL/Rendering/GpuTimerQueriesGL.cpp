@@ -0,0 +1,31 @@
+#include "pch.h"
+#include "GpuTimerQueriesGL.h"
+
+namespace ose::rendering
+{
+	GpuTimerQueriesGL::~GpuTimerQueriesGL()
+	{
+		if(!queries_.empty())
+			glDeleteQueries(static_cast<GLsizei>(queries_.size()), queries_.data());
+	}
+
+	uint32_t GpuTimerQueriesGL::CreateQuery()
+	{
+		GLuint query { 0 };
+		glGenQueries(1, &query);
+		queries_.push_back(query);
+		return query;
+	}
+
+	bool GpuTimerQueriesGL::TryGetResult(uint32_t query, uint64_t & ns)
+	{
+		GLint available { 0 };
+		glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+		if(!available)
+			return false;
+		GLuint64 result { 0 };
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+		ns = result;
+		return true;
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "OSE-Core/Rendering/GpuProfiler.h"
+
+namespace ose::rendering
+{
+	// GL_TIME_ELAPSED queries measured by the GPU profiler
+	// Requires GL 3.3 or ARB_timer_query
+	class GpuTimerQueriesGL final : public GpuTimerQueries
+	{
+	public:
+		GpuTimerQueriesGL() = default;
+		~GpuTimerQueriesGL();
+
+		GpuTimerQueriesGL(GpuTimerQueriesGL const &) = delete;
+		GpuTimerQueriesGL & operator=(GpuTimerQueriesGL const &) = delete;
+
+		// Returns true iff timer queries are supported, must be called once OpenGL has been initialised
+		static bool IsSupported() { return GLEW_VERSION_3_3 || GLEW_ARB_timer_query; }
+
+		uint32_t CreateQuery() override;
+		void BeginQuery(uint32_t query) override { glBeginQuery(GL_TIME_ELAPSED, query); }
+		void EndQuery(uint32_t query) override { glEndQuery(GL_TIME_ELAPSED); }
+		bool TryGetResult(uint32_t query, uint64_t & ns) override;
+
+	private:
+		std::vector<GLuint> queries_;
+	};
+}
@@ -0,0 +1,256 @@
+#include "pch.h"
+#include "LightClustersGL.h"
+#include <future>
+#include <thread>
+
+namespace ose::rendering
+{
+	LightClustersGL::~LightClustersGL()
+	{
+		glDeleteBuffers(1, &cluster_ubo_);
+		glDeleteTextures(1, &cluster_lights_texture_);
+		glDeleteBuffers(1, &cluster_lights_buffer_);
+		glDeleteTextures(1, &light_indices_texture_);
+		glDeleteBuffers(1, &light_indices_buffer_);
+		glDeleteTextures(1, &point_lights_texture_);
+		glDeleteBuffers(1, &point_lights_buffer_);
+	}
+
+	// Create the uniform buffer and buffer textures, must be called once OpenGL has been initialised
+	void LightClustersGL::Init()
+	{
+		glGenBuffers(1, &cluster_ubo_);
+		glBindBuffer(GL_UNIFORM_BUFFER, cluster_ubo_);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(shader::ClusterUniformBlockGL), nullptr, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		glBindBufferBase(GL_UNIFORM_BUFFER, shader::CLUSTER_UNIFORM_BLOCK_BINDING, cluster_ubo_);
+
+		CreateBufferTexture(cluster_lights_buffer_, cluster_lights_texture_, GL_RG32UI);
+		CreateBufferTexture(light_indices_buffer_, light_indices_texture_, GL_R16UI);
+		CreateBufferTexture(point_lights_buffer_, point_lights_texture_, GL_RGBA32F);
+
+		cluster_counts_.resize(NUM_CLUSTERS);
+		cluster_scratch_.resize(static_cast<size_t>(NUM_CLUSTERS) * MAX_LIGHTS_PER_CLUSTER);
+		cluster_lights_.resize(static_cast<size_t>(NUM_CLUSTERS) * 2);
+	}
+
+	// Set the projection the clusters are built for
+	// Perspective projections are sliced exponentially between znear and zfar, orthographic projections use a single slice
+	void LightClustersGL::SetProjection(glm::mat4 const & projection, bool perspective, float znear, float zfar, int fbwidth, int fbheight)
+	{
+		projection_ = projection;
+		perspective_ = perspective;
+		num_slices_ = perspective ? CLUSTERS_Z : 1;
+
+		// The log slicing requires a positive near plane
+		znear_ = std::max(znear, 0.01f);
+		zfar_ = std::max(zfar, znear_ * 2.0f);
+
+		float slice_scale { 0.0f };
+		float slice_bias { 0.0f };
+		if(perspective)
+		{
+			float log_depth_range { std::log(zfar_ / znear_) };
+			slice_scale = num_slices_ / log_depth_range;
+			slice_bias = -num_slices_ * std::log(znear_) / log_depth_range;
+		}
+		uniform_data_.cluster_scale_ = glm::vec4(static_cast<float>(CLUSTERS_X) / std::max(fbwidth, 1),
+			static_cast<float>(CLUSTERS_Y) / std::max(fbheight, 1), slice_scale, slice_bias);
+		uniform_data_.cluster_dims_ = glm::ivec4(CLUSTERS_X, CLUSTERS_Y, num_slices_, 0);
+	}
+
+	// Set the size (in pixels) of the viewport the clusters' screen tiles divide, e.g. when the scene is rendered at a lower resolution
+	void LightClustersGL::SetViewportSize(int width, int height)
+	{
+		uniform_data_.cluster_scale_.x = static_cast<float>(CLUSTERS_X) / std::max(width, 1);
+		uniform_data_.cluster_scale_.y = static_cast<float>(CLUSTERS_Y) / std::max(height, 1);
+	}
+
+	// Assign the point lights to clusters and upload the light lists and light data
+	void LightClustersGL::Update(glm::mat4 const & view, std::vector<PointLightData> const & point_lights)
+	{
+		size_t num_lights { std::min(point_lights.size(), MAX_POINT_LIGHTS) };
+
+		light_bounds_.resize(num_lights);
+		light_data_.resize(num_lights * 2);
+		for(size_t l = 0; l < num_lights; ++l)
+		{
+			light_bounds_[l] = GetLightBounds(view, point_lights[l]);
+			light_data_[l * 2 + 0] = glm::vec4(point_lights[l].position_, point_lights[l].radius_);
+			light_data_[l * 2 + 1] = glm::vec4(point_lights[l].color_, 0.0f);
+		}
+
+		// Each worker owns a contiguous range of depth slices
+		size_t num_workers { std::min<size_t>({ num_lights / MIN_LIGHTS_PER_WORKER,
+			std::max(std::thread::hardware_concurrency(), 1u), static_cast<size_t>(num_slices_) }) };
+		if(num_workers <= 1)
+		{
+			AssignSlices(0, num_slices_);
+		}
+		else
+		{
+			std::vector<std::future<void>> workers;
+			workers.reserve(num_workers - 1);
+			int32_t slices_per_worker { static_cast<int32_t>((num_slices_ + num_workers - 1) / num_workers) };
+			for(int32_t begin = slices_per_worker; begin < num_slices_; begin += slices_per_worker)
+				workers.push_back(std::async(std::launch::async, &LightClustersGL::AssignSlices, this, begin, std::min(begin + slices_per_worker, num_slices_)));
+			AssignSlices(0, std::min(slices_per_worker, num_slices_));
+			for(auto & worker : workers)
+				worker.get();
+		}
+
+		// Compact the per-cluster lists into a single list of light indices
+		int32_t num_clusters { CLUSTERS_X * CLUSTERS_Y * num_slices_ };
+		light_indices_.clear();
+		for(int32_t c = 0; c < num_clusters; ++c)
+		{
+			uint16_t const * first { cluster_scratch_.data() + static_cast<size_t>(c) * MAX_LIGHTS_PER_CLUSTER };
+			cluster_lights_[c * 2 + 0] = static_cast<uint32_t>(light_indices_.size());
+			cluster_lights_[c * 2 + 1] = cluster_counts_[c];
+			light_indices_.insert(light_indices_.end(), first, first + cluster_counts_[c]);
+		}
+
+		// Buffer textures may not be empty, so there is always at least one element uploaded
+		if(light_indices_.empty())
+			light_indices_.push_back(0);
+		if(light_data_.empty())
+			light_data_.resize(2, glm::vec4(0.0f));
+
+		UploadBuffer(cluster_lights_buffer_, cluster_lights_capacity_, cluster_lights_.data(), num_clusters * 2 * sizeof(uint32_t));
+		UploadBuffer(light_indices_buffer_, light_indices_capacity_, light_indices_.data(), light_indices_.size() * sizeof(uint16_t));
+		UploadBuffer(point_lights_buffer_, point_lights_capacity_, light_data_.data(), light_data_.size() * sizeof(glm::vec4));
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+		uniform_data_.view_matrix_ = view;
+		glBindBuffer(GL_UNIFORM_BUFFER, cluster_ubo_);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(uniform_data_), &uniform_data_);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	// Get the distance at which a point light of the given color is cut off
+	float LightClustersGL::GetPointLightRadius(glm::vec3 const & color)
+	{
+		// Attenuation is inverse square, so the intensity reaches the cutoff at sqrt(intensity / cutoff)
+		float intensity { std::max(color.r, std::max(color.g, color.b)) };
+		return std::sqrt(std::max(intensity, 0.0f) / POINT_LIGHT_CUTOFF);
+	}
+
+	// Calculate the range of clusters covered by a light
+	LightClustersGL::LightBounds LightClustersGL::GetLightBounds(glm::mat4 const & view, PointLightData const & light) const
+	{
+		LightBounds culled { 1, 0, 1, 0, 1, 0 };
+		glm::vec3 centre { view * glm::vec4(light.position_, 1.0f) };
+		float radius { light.radius_ };
+
+		// The camera looks down -z in view space
+		float depth { -centre.z };
+		LightBounds bounds;
+		if(perspective_)
+		{
+			if(depth + radius < znear_ || depth - radius > zfar_)
+				return culled;
+			bounds.z0_ = GetSlice(depth - radius);
+			bounds.z1_ = GetSlice(depth + radius);
+		}
+		else
+		{
+			bounds.z0_ = 0;
+			bounds.z1_ = 0;
+		}
+
+		// Project the corners of the light's view space bounding box to find the screen tiles it covers
+		// If the light crosses the near plane, the corners behind the camera cannot be projected so every tile is covered
+		glm::vec2 ndc_min { -1.0f };
+		glm::vec2 ndc_max { 1.0f };
+		if(!perspective_ || depth - radius > znear_)
+		{
+			ndc_min = glm::vec2(std::numeric_limits<float>::max());
+			ndc_max = glm::vec2(std::numeric_limits<float>::lowest());
+			for(int32_t corner = 0; corner < 8; ++corner)
+			{
+				glm::vec3 offset { corner & 1 ? radius : -radius, corner & 2 ? radius : -radius, corner & 4 ? radius : -radius };
+				glm::vec4 clip { projection_ * glm::vec4(centre + offset, 1.0f) };
+				glm::vec2 ndc { glm::vec2(clip) / clip.w };
+				ndc_min = glm::min(ndc_min, ndc);
+				ndc_max = glm::max(ndc_max, ndc);
+			}
+			if(ndc_max.x < -1.0f || ndc_max.y < -1.0f || ndc_min.x > 1.0f || ndc_min.y > 1.0f)
+				return culled;
+		}
+
+		auto to_tile = [](float ndc, int32_t num_tiles) -> int32_t {
+			int32_t tile { static_cast<int32_t>(std::floor((ndc * 0.5f + 0.5f) * num_tiles)) };
+			return std::clamp(tile, 0, num_tiles - 1);
+		};
+		bounds.x0_ = to_tile(ndc_min.x, CLUSTERS_X);
+		bounds.x1_ = to_tile(ndc_max.x, CLUSTERS_X);
+		bounds.y0_ = to_tile(ndc_min.y, CLUSTERS_Y);
+		bounds.y1_ = to_tile(ndc_max.y, CLUSTERS_Y);
+		return bounds;
+	}
+
+	// Get the depth slice containing a view space depth
+	int32_t LightClustersGL::GetSlice(float depth) const
+	{
+		if(!perspective_)
+			return 0;
+		float slice { std::log(std::max(depth, znear_)) * uniform_data_.cluster_scale_.z + uniform_data_.cluster_scale_.w };
+		return std::clamp(static_cast<int32_t>(slice), 0, num_slices_ - 1);
+	}
+
+	// Assign every light to the clusters of the depth slices [slice_begin, slice_end)
+	// Each slice is only written by one worker so no synchronisation is required
+	void LightClustersGL::AssignSlices(int32_t slice_begin, int32_t slice_end)
+	{
+		size_t const slice_size { static_cast<size_t>(CLUSTERS_X) * CLUSTERS_Y };
+		std::fill(cluster_counts_.begin() + slice_begin * slice_size, cluster_counts_.begin() + slice_end * slice_size, 0);
+
+		for(size_t l = 0; l < light_bounds_.size(); ++l)
+		{
+			LightBounds const & b { light_bounds_[l] };
+			if(b.x0_ > b.x1_)
+				continue;
+			int32_t z0 { std::max(b.z0_, slice_begin) };
+			int32_t z1 { std::min(b.z1_, slice_end - 1) };
+			for(int32_t z = z0; z <= z1; ++z)
+			{
+				for(int32_t y = b.y0_; y <= b.y1_; ++y)
+				{
+					for(int32_t x = b.x0_; x <= b.x1_; ++x)
+					{
+						size_t cluster { x + y * static_cast<size_t>(CLUSTERS_X) + z * slice_size };
+						uint16_t & count { cluster_counts_[cluster] };
+						if(count < MAX_LIGHTS_PER_CLUSTER)
+							cluster_scratch_[cluster * MAX_LIGHTS_PER_CLUSTER + count++] = static_cast<uint16_t>(l);
+					}
+				}
+			}
+		}
+	}
+
+	// Create a buffer and a buffer texture which reads from it
+	void LightClustersGL::CreateBufferTexture(GLuint & buffer, GLuint & texture, GLenum format)
+	{
+		glGenBuffers(1, &buffer);
+		glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+		glBufferData(GL_TEXTURE_BUFFER, 16, nullptr, GL_DYNAMIC_DRAW);
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_BUFFER, texture);
+		glTexBuffer(GL_TEXTURE_BUFFER, format, buffer);
+		glBindTexture(GL_TEXTURE_BUFFER, 0);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	}
+
+	// Upload data to a buffer, growing its storage if required
+	void LightClustersGL::UploadBuffer(GLuint buffer, size_t & capacity, void const * data, size_t size)
+	{
+		glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+		if(size > capacity)
+		{
+			// Grow geometrically s.t. adding lights rarely reallocates, the buffer texture keeps referencing the buffer
+			capacity = std::max(size, capacity * 2);
+			glBufferData(GL_TEXTURE_BUFFER, capacity, nullptr, GL_DYNAMIC_DRAW);
+		}
+		glBufferSubData(GL_TEXTURE_BUFFER, 0, size, data);
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "PointLightData.h"
+#include "Shader/UniformBlocksGL.h"
+
+namespace ose::rendering
+{
+	// Assigns point lights to a grid of clusters covering the view s.t. each fragment only shades the lights which reach its cluster
+	// The screen is split into CLUSTERS_X * CLUSTERS_Y tiles, each of which is split into depth slices (one slice for orthographic projections)
+	// The light lists are built on worker threads and uploaded to buffer textures read by the shaders
+	class LightClustersGL
+	{
+	public:
+		// Number of clusters along each axis of the grid
+		static constexpr int32_t CLUSTERS_X { 16 };
+		static constexpr int32_t CLUSTERS_Y { 9 };
+		static constexpr int32_t CLUSTERS_Z { 24 };
+		static constexpr int32_t NUM_CLUSTERS { CLUSTERS_X * CLUSTERS_Y * CLUSTERS_Z };
+
+		// Maximum number of lights assigned to one cluster, further lights are dropped from the cluster
+		static constexpr int32_t MAX_LIGHTS_PER_CLUSTER { 128 };
+
+		// Maximum number of point lights, light indices are stored as 16-bit integers
+		static constexpr size_t MAX_POINT_LIGHTS { 65535 };
+
+		// Fraction of a light's intensity below which its contribution is cut off
+		static constexpr float POINT_LIGHT_CUTOFF { 1.0f / 256.0f };
+
+		// Below this many lights the clusters are built on the calling thread since starting workers costs more than it saves
+		static constexpr size_t MIN_LIGHTS_PER_WORKER { 64 };
+
+		LightClustersGL() = default;
+		~LightClustersGL();
+
+		LightClustersGL(LightClustersGL const &) = delete;
+		LightClustersGL & operator=(LightClustersGL const &) = delete;
+
+		// Create the uniform buffer and buffer textures, must be called once OpenGL has been initialised
+		void Init();
+
+		// Set the projection the clusters are built for
+		// Perspective projections are sliced exponentially between znear and zfar, orthographic projections use a single slice
+		void SetProjection(glm::mat4 const & projection, bool perspective, float znear, float zfar, int fbwidth, int fbheight);
+
+		// Set the size (in pixels) of the viewport the clusters' screen tiles divide, e.g. when the scene is rendered at a lower resolution
+		void SetViewportSize(int width, int height);
+
+		// Assign the point lights to clusters and upload the light lists and light data
+		void Update(glm::mat4 const & view, std::vector<PointLightData> const & point_lights);
+
+		// Get the buffer textures read by the shaders
+		GLuint GetClusterLightsTexture() const { return cluster_lights_texture_; }
+		GLuint GetLightIndicesTexture() const { return light_indices_texture_; }
+		GLuint GetPointLightsTexture() const { return point_lights_texture_; }
+
+		// Get the distance at which a point light of the given color is cut off
+		static float GetPointLightRadius(glm::vec3 const & color);
+
+	private:
+		// Range of clusters covered by a light, the light is culled if x0_ > x1_
+		struct LightBounds
+		{
+			int32_t x0_, x1_;
+			int32_t y0_, y1_;
+			int32_t z0_, z1_;
+		};
+
+		// Calculate the range of clusters covered by a light
+		LightBounds GetLightBounds(glm::mat4 const & view, PointLightData const & light) const;
+
+		// Get the depth slice containing a view space depth
+		int32_t GetSlice(float depth) const;
+
+		// Assign every light to the clusters of the depth slices [slice_begin, slice_end)
+		// Each slice is only written by one worker so no synchronisation is required
+		void AssignSlices(int32_t slice_begin, int32_t slice_end);
+
+		// Create a buffer and a buffer texture which reads from it
+		static void CreateBufferTexture(GLuint & buffer, GLuint & texture, GLenum format);
+
+		// Upload data to a buffer, growing its storage if required
+		static void UploadBuffer(GLuint buffer, size_t & capacity, void const * data, size_t size);
+
+		// Projection the clusters are built for
+		glm::mat4 projection_ { 1.0f };
+		bool perspective_ { true };
+		float znear_ { 0.1f };
+		float zfar_ { 1000.0f };
+		int32_t num_slices_ { CLUSTERS_Z };
+
+		// Parameters of the ClusterData uniform block, the view matrix is set each update
+		shader::ClusterUniformBlockGL uniform_data_;
+
+		// Bounds of each light this update
+		std::vector<LightBounds> light_bounds_;
+
+		// Number of lights in each cluster and the fixed size list of lights of each cluster, filled by the workers
+		std::vector<uint16_t> cluster_counts_;
+		std::vector<uint16_t> cluster_scratch_;
+
+		// Compacted data uploaded to the buffer textures
+		// Each cluster is (offset into light indices, number of lights), each light is vec4(position, radius), vec4(color, 0)
+		std::vector<uint32_t> cluster_lights_;
+		std::vector<uint16_t> light_indices_;
+		std::vector<glm::vec4> light_data_;
+
+		GLuint cluster_ubo_ { 0 };
+
+		GLuint cluster_lights_buffer_ { 0 };
+		GLuint cluster_lights_texture_ { 0 };
+		size_t cluster_lights_capacity_ { 0 };
+
+		GLuint light_indices_buffer_ { 0 };
+		GLuint light_indices_texture_ { 0 };
+		size_t light_indices_capacity_ { 0 };
+
+		GLuint point_lights_buffer_ { 0 };
+		GLuint point_lights_texture_ { 0 };
+		size_t point_lights_capacity_ { 0 };
+	};
+}
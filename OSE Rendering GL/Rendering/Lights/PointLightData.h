@@ -6,5 +6,8 @@ namespace ose::rendering
 	{
 		glm::vec3 position_;
 		glm::vec3 color_;
+
+		// Distance at which the light's contribution is cut off, used to assign the light to clusters
+		float radius_;
 	};
 }
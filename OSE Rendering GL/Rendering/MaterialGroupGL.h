@@ -1,12 +1,28 @@
 #pragma once
 #include "RenderGroupGL.h"
+#include "Shader/UniformBlocksGL.h"
+#include "Shader/ShaderProgGLSL.h"
 
 namespace ose::rendering
 {
 	struct MaterialGroupGL
 	{
+		// The shader the group's materials use and the features they request, identifies the group
+		shader::ShaderProgGLSL const * shader_ { nullptr };
+		uint32_t shader_features_ { 0 };
+
+		// Variant of the shader which has been requested but was still building, nullptr once the group uses its variant
+		// Until then the group is drawn with the shader's default program
+		shader::ShaderVariantGL const * pending_variant_ { nullptr };
+
 		GLuint shader_prog_		{ 0 };
 
+		// Program drawing the group to the G-buffer in the deferred render path, 0 if the group is always drawn forward
+		GLuint gbuffer_shader_prog_ { 0 };
+
+		// Locations of the uniforms set by the rendering engine, copied from the shader program
+		shader::ShaderUniformsGL uniforms_;
+
 		bool enable_blend_ { false };
 		GLenum blend_fac_  { GL_SRC_ALPHA };
 		GLenum blend_func_ { GL_ONE_MINUS_SRC_ALPHA };
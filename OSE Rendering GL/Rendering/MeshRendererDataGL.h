@@ -0,0 +1,22 @@
+#pragma once
+
+namespace ose
+{
+	class Mesh;
+}
+
+namespace ose::rendering
+{
+	// Engine data given to a mesh renderer once it has been added to the render pool
+	struct MeshRendererDataGL
+	{
+		// ID of the mesh renderer within the render pool
+		uint32_t component_id_;
+
+		// The mesh whose shared GPU buffers the mesh renderer references
+		Mesh const * mesh_;
+
+		// True iff the mesh renderer was merged into a static batch rather than added as an instance
+		bool static_ { false };
+	};
+}
@@ -0,0 +1,125 @@
+#include "pch.h"
+#include "PostChainGL.h"
+
+namespace ose::rendering
+{
+	PostChainGL::~PostChainGL()
+	{
+		for(auto & program : programs_)
+		{
+			if(program)
+				program->DestroyShaderProg();
+		}
+	}
+
+	// Add the passes which apply effects to source (a transient target of the given size) to passes, the last pass draws to the window
+	// Each pass is a new pass of the allocator, every image it reads or writes is used by it
+	void PostChainGL::Plan(std::vector<PostEffect> const & effects, uint32_t source, glm::ivec2 const & size,
+		TransientTargetAllocator & allocator, std::vector<PostPassGL> & passes)
+	{
+		constexpr uint32_t NO_TARGET { TransientTargetAllocator::NO_TARGET };
+		RenderTargetDesc image_desc { size.x, size.y, ERenderTargetFormat::RGBA8, false };
+
+		// Add a pass reading source (and bloom) and writing to a new target of desc, or to the window if it is the last pass
+		auto add_pass = [&allocator, &passes](PostPassGL pass, RenderTargetDesc const & desc, bool to_window) {
+			allocator.BeginPass();
+			pass.dest_ = to_window ? NO_TARGET : allocator.Create(desc);
+			allocator.Use(pass.source_);
+			allocator.Use(pass.bloom_);
+			allocator.Use(pass.dest_);
+			passes.push_back(pass);
+			return pass.dest_;
+		};
+
+		uint32_t current { source };
+		for(size_t e = 0; e < effects.size(); ++e)
+		{
+			PostEffect const & effect { effects[e] };
+			bool last { e + 1 == effects.size() };
+			switch(effect.type_)
+			{
+			case EPostEffect::BLOOM:
+			{
+				// The bright image is blurred at half resolution, in a float format s.t. the faint tails of the blur don't band
+				// The horizontal blur's source is dead once it has been read, so the vertical blur reuses its memory
+				RenderTargetDesc half_desc { std::max(size.x / 2, 1), std::max(size.y / 2, 1), ERenderTargetFormat::RGBA16F, false };
+				glm::vec4 params { effect.threshold_, effect.intensity_, 0.0f, 0.0f };
+				uint32_t bright { add_pass({ shader::EPostPass::BLOOM_BRIGHT, current, NO_TARGET, NO_TARGET, { 0.0f, 0.0f }, params }, half_desc, false) };
+				uint32_t blur_h { add_pass({ shader::EPostPass::BLOOM_BLUR, bright, NO_TARGET, NO_TARGET, { 1.0f, 0.0f }, params }, half_desc, false) };
+				uint32_t blur_v { add_pass({ shader::EPostPass::BLOOM_BLUR, blur_h, NO_TARGET, NO_TARGET, { 0.0f, 1.0f }, params }, half_desc, false) };
+				current = add_pass({ shader::EPostPass::BLOOM_COMPOSITE, current, blur_v, NO_TARGET, { 0.0f, 0.0f }, params }, image_desc, last);
+				break;
+			}
+			case EPostEffect::VIGNETTE:
+			{
+				glm::vec4 params { 0.0f, 0.0f, effect.strength_, 0.0f };
+				current = add_pass({ shader::EPostPass::VIGNETTE, current, NO_TARGET, NO_TARGET, { 0.0f, 0.0f }, params }, image_desc, last);
+				break;
+			}
+			}
+		}
+	}
+
+	// Draw the planned passes, the last pass draws to window_rect (bottom left corner xy, size zw) of the window
+	// The transient targets must have been allocated and acquired from the pool
+	void PostChainGL::Draw(std::vector<PostPassGL> const & passes, glm::ivec4 const & window_rect, TransientTargetAllocator const & allocator,
+		RenderTargetPoolGL const & pool, StateCacheGL & state_cache, GLuint fullscreen_vao)
+	{
+		constexpr uint32_t NO_TARGET { TransientTargetAllocator::NO_TARGET };
+		state_cache.SetDepthTest(false, GL_LEQUAL);
+		state_cache.SetBlend(false, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		state_cache.BindVertexArray(fullscreen_vao);
+
+		for(auto const & pass : passes)
+		{
+			auto & program { programs_[static_cast<size_t>(pass.pass_)] };
+			if(!program)
+			{
+				program = ose::make_unique<shader::PostProcessShaderProgGLSL>(pass.pass_);
+				program->CreateShaderProg();
+				// The program sets its sampler uniforms whilst in use
+				state_cache.Invalidate();
+				state_cache.SetDepthTest(false, GL_LEQUAL);
+				state_cache.SetBlend(false, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+				state_cache.BindVertexArray(fullscreen_vao);
+			}
+
+			RenderTargetGL const & source { pool.Get(allocator.GetPhysical(pass.source_)) };
+			if(pass.dest_ == NO_TARGET)
+			{
+				state_cache.BindFramebuffer(0);
+				glViewport(window_rect.x, window_rect.y, window_rect.z, window_rect.w);
+			}
+			else
+			{
+				RenderTargetGL const & dest { pool.Get(allocator.GetPhysical(pass.dest_)) };
+				state_cache.BindFramebuffer(dest.GetFbo());
+				glViewport(0, 0, dest.GetWidth(), dest.GetHeight());
+			}
+
+			// If a program failed to build its pass is skipped, the chain still ends in the window s.t. the view isn't left blank
+			if(program->GetShaderProgId() == 0)
+			{
+				if(pass.dest_ == NO_TARGET)
+				{
+					glBindFramebuffer(GL_READ_FRAMEBUFFER, source.GetFbo());
+					glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+					glBlitFramebuffer(0, 0, source.GetWidth(), source.GetHeight(), window_rect.x, window_rect.y,
+						window_rect.x + window_rect.z, window_rect.y + window_rect.w, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+					glBindFramebuffer(GL_FRAMEBUFFER, 0);
+					state_cache.BindFramebuffer(0);
+				}
+				continue;
+			}
+
+			state_cache.UseProgram(program->GetShaderProgId());
+			state_cache.BindTexture(0, GL_TEXTURE_2D, source.GetColourTexture());
+			if(pass.bloom_ != NO_TARGET)
+				state_cache.BindTexture(1, GL_TEXTURE_2D, pool.Get(allocator.GetPhysical(pass.bloom_)).GetColourTexture());
+			glUniform2f(program->GetTexelSizeLocation(), 1.0f / source.GetWidth(), 1.0f / source.GetHeight());
+			glUniform2f(program->GetDirectionLocation(), pass.direction_.x, pass.direction_.y);
+			glUniform4fv(program->GetParamsLocation(), 1, glm::value_ptr(pass.params_));
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+		}
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "OSE-Core/Rendering/PostEffect.h"
+#include "OSE-Core/Rendering/TransientTargetAllocator.h"
+#include "Shader/Shaders/PostProcessShaderProgGLSL.h"
+#include "RenderTargetPoolGL.h"
+#include "StateCacheGL.h"
+
+namespace ose::rendering
+{
+	// A full screen pass of the post-processing chain, targets are handles of the frame's transient target allocator
+	struct PostPassGL
+	{
+		shader::EPostPass pass_ { shader::EPostPass::VIGNETTE };
+
+		// Image the pass reads, and the second image read by BLOOM_COMPOSITE
+		uint32_t source_ { TransientTargetAllocator::NO_TARGET };
+		uint32_t bloom_ { TransientTargetAllocator::NO_TARGET };
+
+		// Image the pass writes, NO_TARGET for the view's rect of the window
+		uint32_t dest_ { TransientTargetAllocator::NO_TARGET };
+
+		glm::vec2 direction_ { 0.0f, 0.0f };
+		glm::vec4 params_ { 0.0f };
+	};
+
+	// Plans and draws the post-processing chain applied to a camera's image
+	// The chain's intermediate images are transient targets, s.t. they share memory with every other transient target of the frame
+	class PostChainGL
+	{
+	public:
+		PostChainGL() = default;
+		~PostChainGL();
+
+		PostChainGL(PostChainGL const &) = delete;
+		PostChainGL & operator=(PostChainGL const &) = delete;
+
+		// Add the passes which apply effects to source (a transient target of the given size) to passes, the last pass draws to the window
+		// Each pass is a new pass of the allocator, every image it reads or writes is used by it
+		static void Plan(std::vector<PostEffect> const & effects, uint32_t source, glm::ivec2 const & size,
+			TransientTargetAllocator & allocator, std::vector<PostPassGL> & passes);
+
+		// Draw the planned passes, the last pass draws to window_rect (bottom left corner xy, size zw) of the window
+		// The transient targets must have been allocated and acquired from the pool
+		void Draw(std::vector<PostPassGL> const & passes, glm::ivec4 const & window_rect, TransientTargetAllocator const & allocator,
+			RenderTargetPoolGL const & pool, StateCacheGL & state_cache, GLuint fullscreen_vao);
+
+	private:
+		// Program of each pass type, created the first time the pass is drawn
+		std::array<uptr<shader::PostProcessShaderProgGLSL>, static_cast<size_t>(shader::EPostPass::NUM_PASSES)> programs_;
+	};
+}
@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "RenderCommandExecutorGL.h"
+#include "OSE-Core/Rendering/GpuProfiler.h"
+
+namespace ose::rendering
+{
+	// Execute every command of a list in order
+	void RenderCommandExecutorGL::Execute(RenderCommandList const & list)
+	{
+		std::vector<uint32_t> const & words { list.GetWords() };
+		for(size_t w = 0; w < words.size(); )
+		{
+			uint32_t type { words[w] };
+			ERenderCommand command { static_cast<ERenderCommand>(type) };
+			uint32_t const * args { words.data() + w + 1 };
+			w += 1 + RenderCommandList::GetNumArgs(command);
+
+			switch(command)
+			{
+			case ERenderCommand::BIND_FRAMEBUFFER:
+				state_cache_.BindFramebuffer(args[0]);
+				break;
+			case ERenderCommand::CLEAR:
+				glClear(args[0]);
+				break;
+			case ERenderCommand::SET_DEPTH_TEST:
+				state_cache_.SetDepthTest(args[0] != 0, args[1]);
+				break;
+			case ERenderCommand::SET_BLEND:
+				state_cache_.SetBlend(args[0] != 0, args[1], args[2]);
+				break;
+			case ERenderCommand::SET_PIPELINE:
+				state_cache_.UseProgram(args[0]);
+				break;
+			case ERenderCommand::BIND_VERTEX_ARRAY:
+				state_cache_.BindVertexArray(args[0]);
+				break;
+			case ERenderCommand::BIND_TEXTURE:
+				state_cache_.BindTexture(args[0], args[1], args[2]);
+				break;
+			case ERenderCommand::BIND_UNIFORM_BLOCK:
+				glBindBufferRange(GL_UNIFORM_BUFFER, args[0], args[1], args[2], args[3]);
+				break;
+			case ERenderCommand::SET_UNIFORM_MAT4:
+				glUniformMatrix4fv(static_cast<GLint>(args[0]), 1, GL_FALSE, reinterpret_cast<GLfloat const *>(args + 1));
+				break;
+			case ERenderCommand::DRAW:
+				if(args[3] == 1 && args[4] == 0)
+					glDrawArrays(args[0], args[1], args[2]);
+				else if(args[4] == 0)
+					glDrawArraysInstanced(args[0], args[1], args[2], args[3]);
+				else
+					glDrawArraysInstancedBaseInstance(args[0], args[1], args[2], args[3], args[4]);
+				break;
+			case ERenderCommand::DRAW_INDEXED:
+			{
+				GLvoid const * first_index { reinterpret_cast<GLvoid const *>(static_cast<uintptr_t>(args[4]) * sizeof(GLuint)) };
+				if(args[2] == 1 && args[3] == 0)
+					glDrawElements(args[0], args[1], GL_UNSIGNED_INT, first_index);
+				else if(args[3] == 0)
+					glDrawElementsInstanced(args[0], args[1], GL_UNSIGNED_INT, first_index, args[2]);
+				else
+					glDrawElementsInstancedBaseInstance(args[0], args[1], GL_UNSIGNED_INT, first_index, args[2], args[3]);
+				break;
+			}
+			case ERenderCommand::BLIT_DEPTH:
+				glBindFramebuffer(GL_READ_FRAMEBUFFER, args[0]);
+				glBindFramebuffer(GL_DRAW_FRAMEBUFFER, args[1]);
+				glBlitFramebuffer(0, 0, args[2], args[3], 0, 0, args[2], args[3], GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+				// Leave the destination bound to both targets, s.t. the state cache is correct whichever fbo it last bound
+				glBindFramebuffer(GL_FRAMEBUFFER, args[1]);
+				state_cache_.BindFramebuffer(args[1]);
+				break;
+			case ERenderCommand::BEGIN_TIMER:
+				if(profiler_)
+					profiler_->Begin(args[0]);
+				break;
+			case ERenderCommand::END_TIMER:
+				if(profiler_)
+					profiler_->End(args[0]);
+				break;
+			default:
+				LOG_ERROR("Unknown render command", type);
+				return;
+			}
+		}
+	}
+}
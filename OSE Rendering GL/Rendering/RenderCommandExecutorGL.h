@@ -0,0 +1,30 @@
+#pragma once
+#include "OSE-Core/Rendering/RenderCommandList.h"
+#include "StateCacheGL.h"
+
+namespace ose
+{
+	class GpuProfiler;
+}
+
+namespace ose::rendering
+{
+	// Replays render command lists on the OpenGL thread
+	// State changes go through the state cache, so redundant commands recorded by independent lists cost nothing
+	class RenderCommandExecutorGL
+	{
+	public:
+		RenderCommandExecutorGL(StateCacheGL & state_cache) : state_cache_(state_cache) {}
+
+		// Execute every command of a list in order
+		void Execute(RenderCommandList const & list);
+
+		// Set the profiler which measures the scopes of timer commands, nullptr ignores timer commands
+		void SetProfiler(GpuProfiler * profiler) { profiler_ = profiler; }
+
+	private:
+		StateCacheGL & state_cache_;
+
+		GpuProfiler * profiler_ { nullptr };
+	};
+}
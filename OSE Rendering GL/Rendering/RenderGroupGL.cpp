@@ -0,0 +1,120 @@
+#include "pch.h"
+#include "RenderGroupGL.h"
+#include "UploadQueueGL.h"
+
+namespace ose::rendering
+{
+	// Add an instance to the end of the render group
+	// local_bounds is the bounding box of the instance's geometry before it is transformed, used for culling
+	// Returns the index of the new instance
+	size_t RenderGroupGL::AddInstance(ITransform const & t, AABB const & local_bounds)
+	{
+		size_t i { transforms_.size() };
+		transforms_.push_back(&t);
+		local_bounds_.push_back(local_bounds);
+		world_bounds_.emplace_back();
+		instance_lods_.push_back(0);
+		instance_data_.resize(instance_data_.size() + instance_stride_, 0.0f);
+		UpdateInstance(i);
+		return i;
+	}
+
+	// Remove the instance at index i, all following instances are shifted down by one
+	void RenderGroupGL::RemoveInstance(size_t i)
+	{
+		transforms_.erase(transforms_.begin() + i);
+		local_bounds_.erase(local_bounds_.begin() + i);
+		world_bounds_.erase(world_bounds_.begin() + i);
+		instance_lods_.erase(instance_lods_.begin() + i);
+		auto first { instance_data_.begin() + i * instance_stride_ };
+		instance_data_.erase(first, first + instance_stride_);
+		MarkDirty(i, transforms_.size());
+	}
+
+	// Recalculate the transform dependant data of the instance at index i
+	void RenderGroupGL::UpdateInstance(size_t i)
+	{
+		ITransform const & t { *transforms_[i] };
+		float * data { GetInstanceData(i) };
+
+		glm::mat4 world { t.GetTransformMatrix() };
+
+		// Keep the bounds in world space s.t. culling doesn't need to transform them every frame
+		world_bounds_[i] = local_bounds_[i].Transformed(world);
+
+		if(type_ == ERenderObjectType::MESH_RENDERER)
+		{
+			// The normal matrix is calculated once per transform change rather than per vertex
+			glm::mat3 normal { glm::transpose(glm::inverse(glm::mat3(world))) };
+			std::memcpy(data, glm::value_ptr(world), sizeof(world));
+			std::memcpy(data + 16, glm::value_ptr(normal), sizeof(normal));
+		}
+		else
+		{
+			// Sprites and tiles only require the transform in the 2D plane (z is kept for layering)
+			glm::vec3 const & translation { t.GetTranslation() };
+			glm::vec3 const & scale { t.GetScale() };
+			data[0] = translation.x;
+			data[1] = translation.y;
+			data[2] = translation.z;
+			data[3] = glm::roll(t.GetOrientation());
+			data[4] = scale.x;
+			data[5] = scale.y;
+		}
+
+		MarkDirty(i, i + 1);
+	}
+
+	// Set the transform independent data of a sprite/tile instance
+	void RenderGroupGL::SetSpriteInstanceData(size_t i, glm::vec2 const & size, glm::vec4 const & uv_rect, float layer)
+	{
+		float * data { GetInstanceData(i) };
+		data[6] = size.x;
+		data[7] = size.y;
+		data[8] = uv_rect.x;
+		data[9] = uv_rect.y;
+		data[10] = uv_rect.z;
+		data[11] = uv_rect.w;
+		data[12] = layer;
+		MarkDirty(i, i + 1);
+	}
+
+	// Set the tileset parameters of an index texture tile renderer instance
+	void RenderGroupGL::SetTileIndexInstanceData(size_t i, glm::vec2 const & tileset_size, glm::vec2 const & spacing)
+	{
+		float * data { GetInstanceData(i) };
+		data[13] = tileset_size.x;
+		data[14] = tileset_size.y;
+		data[15] = spacing.x;
+		data[16] = spacing.y;
+		MarkDirty(i, i + 1);
+	}
+
+	// Extend the dirty range to include the instances [begin, end)
+	void RenderGroupGL::MarkDirty(size_t begin, size_t end)
+	{
+		if(begin >= end)
+			return;
+		if(dirty_begin_ == dirty_end_)
+		{
+			dirty_begin_ = begin;
+			dirty_end_ = end;
+		}
+		else
+		{
+			dirty_begin_ = std::min(dirty_begin_, begin);
+			dirty_end_ = std::max(dirty_end_, end);
+		}
+	}
+
+	// Returns true iff the upload queue has finished uploading the group's vertex data and textures
+	// Groups are not drawn until they have been uploaded
+	bool RenderGroupGL::IsUploaded() const
+	{
+		if(!UploadQueueGL::HasPending())
+			return true;
+		if(!UploadQueueGL::IsBufferReady(vbo_) || !UploadQueueGL::IsBufferReady(ibo_))
+			return false;
+		return std::all_of(textures_.begin(), textures_.end(), [](GLuint texture) { return UploadQueueGL::IsTextureReady(texture); });
+	}
+}
@@ -2,22 +2,37 @@
 #include "OSE-Core/Types.h"
 #include "TextureGL.h"
 #include "ERenderObjectType.h"
-
-namespace ose
-{
-	class ITransform;
-}
+#include "OSE-Core/Math/ITransform.h"
+#include "OSE-Core/Math/AABB.h"
 
 namespace ose::rendering
 {
 	struct RenderGroupGL
 	{
+		// Number of floats per sprite/tile instance
+		// Layout: vec4(position xyz, rotation), vec4(scale xy, size xy), vec4(uv offset xy, uv scale xy), float texture layer
+		static constexpr GLsizei SPRITE_INSTANCE_STRIDE { 13 };
+
+		// Number of floats per index texture tile renderer instance
+		// Layout: sprite instance layout, vec4(tileset cols, tileset rows, spacing xy)
+		static constexpr GLsizei TILE_INDEX_INSTANCE_STRIDE { 17 };
+
+		// Number of floats per mesh instance
+		// Layout: mat4 world transform, mat3 normal matrix
+		static constexpr GLsizei MESH_INSTANCE_STRIDE { 25 };
+
 		ERenderObjectType type_;
 
 		GLuint vbo_ { 0 };
 		GLuint ibo_ { 0 };
 		GLuint vao_ { 0 };
 
+		// Buffer of per-instance vertex attributes, 0 if the render group is drawn one instance at a time
+		GLuint instance_vbo_ { 0 };
+
+		// Number of instances the instance buffer has storage allocated for
+		size_t instance_capacity_ { 0 };
+
 		GLenum render_primitive_ { GL_TRIANGLES };
 		GLint first_ { 0 };
 		GLint count_ { 0 };
@@ -29,19 +44,90 @@ namespace ose::rendering
 		std::vector<GLuint> textures_;
 		GLuint texture_stride_ { 0 };
 
-		// TODO - Experiment with handling transforms differently
-		// TODO - Replace with pointer to glm::mat4 s.t. changes made to entity transform immediately have effect on render object
-		// TODO - Also consider using observer pattern to notify render object of transform changes
-		//std::vector<glm::mat4> transforms_;
+		// The target the textures are bound to, sprites and tiles are rendered from texture arrays
+		GLenum texture_target_ { GL_TEXTURE_2D };
+
+		// Global transform of each instance, used to identify the instance when its entity's transform changes
 		std::vector<ITransform const *> transforms_;
 
+		// Bounds of each instance in local space and in world space, world bounds are updated with the instance data
+		std::vector<AABB> local_bounds_;
+		std::vector<AABB> world_bounds_;
+
+		// Per-instance data, instance_stride_ floats per instance
+		// Transform dependant values are only recalculated when the entity's transform changes
+		std::vector<float> instance_data_;
+		GLsizei instance_stride_ { 0 };
+
+		// Index of the chunk of the tilemap rendered by the group, only used by tile renderers
+		uint32_t chunk_ { 0 };
+
+		// Range of a level of detail within the index buffer
+		struct LodGL
+		{
+			GLint first_index_;
+			GLint count_;
+
+			// Error of the level relative to the radius of the mesh, 0 for the full detail mesh
+			float error_;
+		};
+
+		// Levels of detail of the group's mesh, finest first, empty if the mesh is only drawn at full detail
+		std::vector<LodGL> lods_;
+
+		// Level of detail each instance is drawn with, kept between frames s.t. the level only changes past a margin
+		std::vector<uint8_t> instance_lods_;
+
+		// Range of instances [dirty_begin_, dirty_end_) whose instance data has changed since it was last uploaded
+		size_t dirty_begin_ { 0 };
+		size_t dirty_end_ { 0 };
+
 		RenderGroupGL(std::initializer_list<uint32_t> component_ids, ERenderObjectType type, GLuint vbo,
 				GLuint vao, GLenum render_primitive, GLint first,
 				GLint count, std::initializer_list<GLuint> textures//, std::initializer_list<ose::math::ITransform const &> transforms
 		)
 			: component_ids_(component_ids),
 			type_(type), vbo_(vbo), vao_(vao), render_primitive_(render_primitive),
-			first_(first), count_(count), textures_(textures) //, transforms_(transforms)
+			first_(first), count_(count), textures_(textures), //, transforms_(transforms)
+			instance_stride_(type == ERenderObjectType::MESH_RENDERER ? MESH_INSTANCE_STRIDE :
+				type == ERenderObjectType::TILE_INDEX_RENDERER ? TILE_INDEX_INSTANCE_STRIDE : SPRITE_INSTANCE_STRIDE)
 		{}
+
+		// Get the number of instances in the render group
+		size_t GetNumInstances() const { return transforms_.size(); }
+
+		// Get a pointer to the data of the instance at index i
+		float * GetInstanceData(size_t i) { return instance_data_.data() + i * instance_stride_; }
+		float const * GetInstanceData(size_t i) const { return instance_data_.data() + i * instance_stride_; }
+
+		// Add an instance to the end of the render group
+		// local_bounds is the bounding box of the instance's geometry before it is transformed, used for culling
+		// Returns the index of the new instance
+		size_t AddInstance(ITransform const & t, AABB const & local_bounds);
+
+		// Remove the instance at index i, all following instances are shifted down by one
+		void RemoveInstance(size_t i);
+
+		// Recalculate the transform dependant data of the instance at index i
+		void UpdateInstance(size_t i);
+
+		// Set the transform independent data of a sprite/tile instance
+		void SetSpriteInstanceData(size_t i, glm::vec2 const & size, glm::vec4 const & uv_rect, float layer);
+
+		// Set the tileset parameters of an index texture tile renderer instance
+		void SetTileIndexInstanceData(size_t i, glm::vec2 const & tileset_size, glm::vec2 const & spacing);
+
+		// Extend the dirty range to include the instances [begin, end)
+		void MarkDirty(size_t begin, size_t end);
+
+		// Returns true iff the instance data has changed since it was last uploaded
+		bool IsDirty() const { return dirty_begin_ != dirty_end_; }
+
+		// Mark the instance data as uploaded
+		void ClearDirty() { dirty_begin_ = dirty_end_ = 0; }
+
+		// Returns true iff the upload queue has finished uploading the group's vertex data and textures
+		// Groups are not drawn until they have been uploaded
+		bool IsUploaded() const;
 	};
 }
@@ -10,6 +10,13 @@
 #include "OSE-Core/Entity/Component/DirLight.h"
 
 #include "OSE-Core/Resources/Tilemap/Tilemap.h"
+#include "OSE-Core/Math/TransformChangeList.h"
+#include "SpriteRendererDataGL.h"
+#include "MeshRendererDataGL.h"
+#include "OSE-Core/Math/Frustum.h"
+#include "Lights/LightClustersGL.h"
+#include "UploadQueueGL.h"
+#include "OSE-Core/EngineDependencies/glm/gtc/packing.hpp"
 
 // TODO - Remove
 #include "OSE-Core/Math/ITransform.h"
@@ -17,6 +24,7 @@
 #include "Shader/Shaders/BRDFShaderProgGLSL.h"
 #include "Shader/Shaders/Default2DShaderProgGLSL.h"
 #include "Shader/Shaders/Default3DShaderProgGLSL.h"
+#include "Shader/Shaders/TileIndexShaderProgGLSL.h"
 
 namespace ose::rendering
 {
@@ -35,16 +43,42 @@ namespace ose::rendering
 
 				for(auto const & render_group : material_group.render_groups_)
 				{
-					glDeleteBuffers(1, &render_group.vbo_);
+					// Mesh buffers are shared between render groups so are deleted separately, as is the sprite quad
+					if(render_group.type_ != ERenderObjectType::MESH_RENDERER && render_group.type_ != ERenderObjectType::TILE_INDEX_RENDERER)
+						glDeleteBuffers(1, &render_group.vbo_);
+					glDeleteBuffers(1, &render_group.instance_vbo_);
 					glDeleteVertexArrays(1, &render_group.vao_);
 				}
 			}
 		}
+
+		glDeleteBuffers(1, &sprite_quad_vbo_);
+
+		for(auto const & [mesh, mesh_buffer] : mesh_buffers_)
+		{
+			glDeleteBuffers(1, &mesh_buffer.vbo_);
+			glDeleteBuffers(1, &mesh_buffer.ibo_);
+		}
+
+		for(auto const & cell : static_cells_)
+		{
+			glDeleteBuffers(1, &cell.vbo_);
+			glDeleteBuffers(1, &cell.ibo_);
+		}
+
+		for(auto & [texture, texture_array] : texture_arrays_)
+			texture_array->DestroyTextureAtlas();
+
+		for(auto const & [object_id, tile_renderer] : tile_renderers_)
+			glDeleteTextures(1, &tile_renderer.index_texture_);
 	}
 
 	// Initialise the render pool
 	void RenderPoolGL::Init(int fbwidth, int fbheight)
 	{
+		fb_width_ = fbwidth;
+		fb_height_ = fbheight;
+
 		/*framebuffers_.emplace_back(fbwidth, fbheight);
 		auto & fb = framebuffers_.back();
 
@@ -116,6 +150,19 @@ namespace ose::rendering
 		render_passes_[0].enable_depth_test_ = true;
 		render_passes_[0].depth_func_ = GL_LEQUAL;
 
+		// Create the unit quad shared by all sprite render groups
+		// Data consists of 2-float position and 2-float tex coords interleaved, ordered as a triangle strip
+		float quad_data[] = {
+			0, 0, 0, 1,
+			1, 0, 1, 1,
+			0, 1, 0, 0,
+			1, 1, 1, 0
+		};
+		glGenBuffers(1, &sprite_quad_vbo_);
+		glBindBuffer(GL_ARRAY_BUFFER, sprite_quad_vbo_);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(quad_data), quad_data, GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
 		// TODO - Remove
 		//{
 		//	// Create the default 2d shader prog
@@ -173,11 +220,21 @@ namespace ose::rendering
 	// Set the size of the framebuffer (required if render pool contains deferred shading render pass)
 	void RenderPoolGL::SetFramebufferSize(int width, int height)
 	{
+		fb_width_ = width;
+		fb_height_ = height;
+
 		// Update the deferred shading framebuffer objects
-		for(auto & fb : framebuffers_)
-		{
-			fb.Resize(width, height);
-		}
+		if(gbuffer_ && width > 0 && height > 0)
+			gbuffer_->Resize(width, height);
+	}
+
+	// Get the G-buffer of the deferred render path, the G-buffer is created the first time it is requested
+	// Returns nullptr if the framebuffer size is not yet known
+	FramebufferGL const * RenderPoolGL::GetGBuffer()
+	{
+		if(!gbuffer_ && fb_width_ > 0 && fb_height_ > 0)
+			gbuffer_ = ose::make_unique<FramebufferGL>(fb_width_, fb_height_);
+		return gbuffer_.get();
 	}
 
 	// Add a sprite renderer component to the render pool
@@ -194,73 +251,75 @@ namespace ose::rendering
 		if(!material_group)
 			return;
 
-		// Try to find a render object group to add the sprite renderer to
-		bool found_render_group { false };
+		// Sprites are rendered from texture arrays s.t. all sprites with textures in the same atlas can share a render group
+		TextureAtlasRegion region;
+		GLuint tex_id { GetSpriteTextureArray(sr->GetTexture(), region) };
+		if(tex_id == 0)
+		{
+			LOG_ERROR("Failed to add sprite renderer, could not create a texture array for the texture");
+			return;
+		}
+
+		// Try to find a render group which renders sprites from the same texture array
+		RenderGroupGL * render_group { nullptr };
 		for(auto & r : material_group->render_groups_)
 		{
-			if(r.type_ == ERenderObjectType::SPRITE_RENDERER)
+			if(r.type_ == ERenderObjectType::SPRITE_RENDERER && r.textures_[0] == tex_id)
 			{
-				// Add the sprite renderer to the existing render object
-				found_render_group = true;
-				r.textures_.push_back(static_cast<TextureGL const *>(sr->GetTexture())->GetGlTexId());
-				//r.transforms_.push_back(t.GetTransformMatrix());
-				r.transforms_.push_back(&t);
-				uint32_t object_id { NextComponentId() };
-				r.component_ids_.push_back(object_id);
-				sr->SetEngineData(object_id);
+				render_group = &r;
 				break;
 			}
 		}
 
-		// If the sprite renderer group could not be found, make one
-		if(!found_render_group)
+		// If no sprite render group exists for the texture, make one
+		if(!render_group)
 		{
-			// Create a VBO for the render object
-			GLuint vbo;
-			glGenBuffers(1, &vbo);
-			// Data consists of 2-float position and 2-float tex coords interleaved
-			float data[] = {
-				0, 0, 0, 1,
-				1, 0, 1, 1,
-				1, 1, 1, 0,
-				0, 1, 0, 0
-			};
-			glBindBuffer(GL_ARRAY_BUFFER, vbo);
-			glBufferData(GL_ARRAY_BUFFER, sizeof(data), data, GL_STATIC_DRAW);
-
-			// Create a VAO for the render object
+			// Create a VAO for the render group, the quad vertex data is shared by all sprite render groups
 			GLuint vao;
 			glGenVertexArrays(1, &vao);
 			glBindVertexArray(vao);
-			glBindBuffer(GL_ARRAY_BUFFER, vbo);
+			glBindBuffer(GL_ARRAY_BUFFER, sprite_quad_vbo_);
 			// TODO - Vertex attrib locations are to be controlled by the built shader program
 			glEnableVertexAttribArray(0);
 			glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
 			glEnableVertexAttribArray(1);
 			glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (GLvoid*)(2 * sizeof(float)));
+
+			// Create the per-instance buffer, storage is allocated once instances are uploaded
+			GLuint instance_vbo;
+			glGenBuffers(1, &instance_vbo);
+			SetSpriteInstanceAttribs(instance_vbo);
+
 			// Unbind the vao
 			glBindVertexArray(0);
 			glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-			// Add a new render object
-			GLenum primitive { GL_QUADS };
+			// Add a new render group, every sprite in the group is drawn by a single instanced draw call
+			GLenum primitive { GL_TRIANGLE_STRIP };
 			GLint first { 0 };
 			GLint count { 4 };
-			uint32_t object_id { NextComponentId() };
 			material_group->render_groups_.emplace_back(
-				std::initializer_list<uint32_t>{ object_id },
+				std::initializer_list<uint32_t>{},
 				ERenderObjectType::SPRITE_RENDERER,
-				vbo, vao,
+				0, vao,
 				primitive, first, count,
-				std::initializer_list<GLuint>{ static_cast<TextureGL const *>(sr->GetTexture())->GetGlTexId() }
-				//std::initializer_list<glm::mat4>{ t.GetTransformMatrix() }
-				//std::initializer_list<ITransform const &>{ t }
+				std::initializer_list<GLuint>{ tex_id }
 			);
-			// TODO - Remove
-			material_group->render_groups_.back().transforms_.emplace_back(&t);
-			material_group->render_groups_.back().texture_stride_ = 1;
-			sr->SetEngineData(object_id);
+			render_group = &material_group->render_groups_.back();
+			render_group->instance_vbo_ = instance_vbo;
+			render_group->texture_stride_ = 1;
+			render_group->texture_target_ = GL_TEXTURE_2D_ARRAY;
 		}
+
+		// Add the sprite renderer as a new instance of the render group
+		uint32_t object_id { NextComponentId() };
+		render_group->component_ids_.push_back(object_id);
+		glm::vec2 size { sr->GetTexture()->GetWidth(), sr->GetTexture()->GetHeight() };
+		size_t instance { render_group->AddInstance(t, AABB{ glm::vec3(0.0f), glm::vec3(size, 0.0f) }) };
+		render_group->SetSpriteInstanceData(instance, size, region.uv_rect_, static_cast<float>(region.layer_));
+		sr->SetEngineData(SpriteRendererDataGL{ object_id, region });
+
+		instance_index_dirty_ = true;
 	}
 
 	// Add a tile renderer component to the render pool
@@ -277,122 +336,62 @@ namespace ose::rendering
 		if(!material_group)
 			return;
 
-		// Get a reference to the tilemap
-		auto & tilemap = *tr->GetTilemap();
-
-		// Calculate tile dimensions s.t. when multiplied by the texture dimensions in the shader, the tiles will be the correct size
-		float tile_width  { 1.0f / tr->GetNumCols() };
-		float tile_height { 1.0f / tr->GetNumRows() };
+		// Tiles are rendered from a texture array by the same shader as sprites
+		TextureAtlasRegion region;
+		GLuint tex_id { GetSpriteTextureArray(tr->GetTexture(), region) };
+		if(tex_id == 0)
+		{
+			LOG_ERROR("Failed to add tile renderer, could not create a texture array for the texture");
+			return;
+		}
 
-		// Get the width and height of the tilemap
-		int32_t tilemap_width  { tilemap.GetWidth() };
-		int32_t tilemap_height { tilemap.GetHeight() };
+		if(tr->GetRenderMode() == ETileRenderMode::INDEX_TEXTURE)
+		{
+			AddTileIndexRenderer(t, tr, tex_id, region);
+			return;
+		}
 
-		// Get the x and y spacing between tiles
-		float spacing_x { tile_width * tr->GetSpacingX() };
-		float spacing_y { tile_height * tr->GetSpacingY() };
+		// Split the tilemap into chunks, each chunk is a render group s.t. it can be culled and streamed individually
+		// Chunk buffers are only built once the chunk comes close to the camera (see UpdateTileChunks)
+		auto const & tilemap = *tr->GetTilemap();
+		int32_t num_chunks_x { (tilemap.GetWidth() + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE };
+		int32_t num_chunks_y { (tilemap.GetHeight() + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE };
+		uint32_t object_id { NextComponentId() };
 
-		// Calculate the dimensions of half a pixel in texture co-ordinate space
-		float half_pixel_width  = { (1.0f / tr->GetTexture()->GetWidth()) / 2};
-		float half_pixel_height = { (1.0f / tr->GetTexture()->GetHeight()) / 2};
+		// The tile grid's vertices are scaled by the texture size in the shader
+		glm::vec2 size { tr->GetTexture()->GetWidth(), tr->GetTexture()->GetHeight() };
 
-		// Create a VBO for the render object
-		GLuint vbo;
-		glGenBuffers(1, &vbo);
-		// Data consists of 2-float position and 2-float tex coords interleaved, each tile is composed of 2 tris (6 vertices)
-		std::vector<float> data(static_cast<size_t>(6) * 4 * tilemap_width * tilemap_height);
-		glBindBuffer(GL_ARRAY_BUFFER, vbo);
-		for(size_t j = 0; j < tilemap_height; j++)
+		for(int32_t cy = 0; cy < num_chunks_y; ++cy)
 		{
-			for(size_t i = 0; i < tilemap_width; i++)
+			for(int32_t cx = 0; cx < num_chunks_x; ++cx)
 			{
-				// Get the value of the tile at (x, y) - Stored upside down so use y = j - height - 1 instead of y = j
-				int32_t value { tilemap(i, tilemap_height-j-1) };
-				if(value >= 0 && value < tr->GetNumTiles())
-				{
-					// Calculate the position of the tile in the texture atlas
-					int32_t atlas_x { value % tr->GetNumCols() };
-					int32_t atlas_y { value / tr->GetNumCols() };
-					// Calculate the position co-ordinates for the tile
-					float x0 = i * spacing_x;
-					float x1 = i * spacing_x + tile_width;
-					float y0 = j * spacing_y;
-					float y1 = j * spacing_y + tile_height;
-					// Calculate the texture co-ordinates for the tile
-					float u0 = (float)atlas_x / tr->GetNumCols() + half_pixel_width;
-					float u1 = (float)(atlas_x + 1) / tr->GetNumCols() - half_pixel_width;
-					float v0 = (float)atlas_y / tr->GetNumRows() + half_pixel_height;
-					float v1 = (float)(atlas_y + 1) / tr->GetNumRows() - half_pixel_height;
-					// Set the vertex's position and texture co-ordinates
-					size_t tile_offset { static_cast<size_t>(6*4*(i + (tilemap_height - j - 1)*tilemap_width)) };
-					// Top Left
-					data[tile_offset + 0*4 + 0] = x0;
-					data[tile_offset + 0*4 + 1] = y1;
-					data[tile_offset + 0*4 + 2] = u0;
-					data[tile_offset + 0*4 + 3] = v0;
-					// Bottom Right
-					data[tile_offset + 1*4 + 0] = x1;
-					data[tile_offset + 1*4 + 1] = y0;
-					data[tile_offset + 1*4 + 2] = u1;
-					data[tile_offset + 1*4 + 3] = v1;
-					// Top Right
-					data[tile_offset + 2*4 + 0] = x1;
-					data[tile_offset + 2*4 + 1] = y1;
-					data[tile_offset + 2*4 + 2] = u1;
-					data[tile_offset + 2*4 + 3] = v0;
-					// Bottom Right
-					data[tile_offset + 3*4 + 0] = x1;
-					data[tile_offset + 3*4 + 1] = y0;
-					data[tile_offset + 3*4 + 2] = u1;
-					data[tile_offset + 3*4 + 3] = v1;
-					// Top Left
-					data[tile_offset + 4*4 + 0] = x0;
-					data[tile_offset + 4*4 + 1] = y1;
-					data[tile_offset + 4*4 + 2] = u0;
-					data[tile_offset + 4*4 + 3] = v0;
-					// Bottom Left
-					data[tile_offset + 5*4 + 0] = x0;
-					data[tile_offset + 5*4 + 1] = y0;
-					data[tile_offset + 5*4 + 2] = u0;
-					data[tile_offset + 5*4 + 3] = v1;
-				}
+				material_group->render_groups_.emplace_back(
+					std::initializer_list<uint32_t>{ object_id },
+					ERenderObjectType::TILE_RENDERER,
+					0, 0,
+					GL_TRIANGLES, 0, 0,
+					std::initializer_list<GLuint>{ tex_id }
+				);
+				RenderGroupGL & render_group { material_group->render_groups_.back() };
+				render_group.texture_stride_ = 1;
+				render_group.texture_target_ = GL_TEXTURE_2D_ARRAY;
+				render_group.chunk_ = static_cast<uint32_t>(cx + cy * num_chunks_x);
+
+				// Each chunk is a single instance with the tile renderer's transform
+				size_t instance { render_group.AddInstance(t, GetTileChunkBounds(*tr, cx, cy)) };
+				render_group.SetSpriteInstanceData(instance, size, region.uv_rect_, static_cast<float>(region.layer_));
 			}
 		}
-		glBufferData(GL_ARRAY_BUFFER, data.size()*sizeof(float), data.data(), GL_STATIC_DRAW);
 
-		// Create a VAO for the render object
-		GLuint vao;
-		glGenVertexArrays(1, &vao);
-		glBindVertexArray(vao);
-		glBindBuffer(GL_ARRAY_BUFFER, vbo);
-		// TODO - Vertex attrib locations are to be controlled by the built shader program
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (GLvoid*)(2 * sizeof(float)));
-		// Unbind the vao
-		glBindVertexArray(0);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		TileRendererGL & tile_renderer { tile_renderers_[object_id] };
+		tile_renderer.tile_renderer_ = tr;
+		tile_renderer.tilemap_revision_ = tilemap.GetRevision();
+		tile_renderer.chunk_built_.assign(static_cast<size_t>(num_chunks_x) * num_chunks_y, 0);
+		tile_renderer.chunk_stale_.assign(static_cast<size_t>(num_chunks_x) * num_chunks_y, 0);
+		tile_renderer.num_chunks_x_ = num_chunks_x;
 
-		// Unlike SpriteRenderer, TileRenderer cannot share a render group since the tile grid is encoded into the buffer data
-		// Add a new render object
-		GLenum primitive { GL_TRIANGLES };
-		GLint first { 0 };
-		GLint count { 6 * tilemap_width * tilemap_height };
-		uint32_t object_id { NextComponentId() };
-		material_group->render_groups_.emplace_back(
-			std::initializer_list<uint32_t>{ object_id },
-			ERenderObjectType::TILE_RENDERER,
-			vbo, vao,
-			primitive, first, count,
-			std::initializer_list<GLuint>{ static_cast<TextureGL const *>(tr->GetTexture())->GetGlTexId() }
-			//std::initializer_list<glm::mat4>{ t.GetTransformMatrix() }
-			//std::initializer_list<ITransform const &>{ t }
-		);
-		// TODO - Remove
-		material_group->render_groups_.back().transforms_.emplace_back(&t);
-		material_group->render_groups_.back().texture_stride_ = 1;
 		tr->SetEngineData(object_id);
+		instance_index_dirty_ = true;
 	}
 
 	// Add a mesh renderer component to the render pool
@@ -408,167 +407,178 @@ namespace ose::rendering
 
 		// Get the mesh object to be rendered
 		Mesh const * mesh { mr->GetMesh() };
-		
-		// Create a VBO for the render object
-		GLuint vbo;
-		glGenBuffers(1, &vbo);
-		// Data consists of the vertex data is given in the mesh object
-		// TODO - Include tangent, bitangent and any other required data
-		std::vector<float> data(mesh->GetPositionData().size() + mesh->GetNormalData().size() + mesh->GetTexCoordData().size() + mesh->GetTangentData().size());
-		glBindBuffer(GL_ARRAY_BUFFER, vbo);
-		for(size_t p = 0, n = 0, t = 0, tan = 0; p < mesh->GetPositionData().size() && n < mesh->GetNormalData().size()
-			&& t < mesh->GetTexCoordData().size() && tan < mesh->GetTangentData().size(); p += 3, n += 3, t += 2, tan += 3)
-		{
-			data[p + n + t + tan + 0] = mesh->GetPositionData()[p + 0];
-			data[p + n + t + tan + 1] = mesh->GetPositionData()[p + 1];
-			data[p + n + t + tan + 2] = mesh->GetPositionData()[p + 2];
-
-			data[p + n + t + tan + 3] = mesh->GetNormalData()[n + 0];
-			data[p + n + t + tan + 4] = mesh->GetNormalData()[n + 1];
-			data[p + n + t + tan + 5] = mesh->GetNormalData()[n + 2];
-
-			data[p + n + t + tan + 6] = mesh->GetTexCoordData()[t + 0];
-			data[p + n + t + tan + 7] = mesh->GetTexCoordData()[t + 1];
 
-			data[p + n + t + tan + 8] = mesh->GetTangentData()[tan + 0];
-			data[p + n + t + tan + 9] = mesh->GetTangentData()[tan + 1];
-			data[p + n + t + tan + 10] = mesh->GetTangentData()[tan + 2];
+		// Get the textures of the material, every instance of a render group shares the same textures
+		// TODO - Material determines shader group and can contain multiple textures
+		std::vector<GLuint> textures;
+		for(auto texture : mr->GetMaterial()->GetTextures())
+		{
+			if(texture)
+				textures.push_back(static_cast<TextureGL const *>(texture)->GetGlTexId());
 		}
-		glBufferData(GL_ARRAY_BUFFER, data.size()*sizeof(float), data.data(), GL_STATIC_DRAW);
 
-		// Create an IBO for the render object
-		GLuint ibo;
-		glGenBuffers(1, &ibo);
-		// Data consists of indices to vertices, where 3 consecutive indices make up a triangle
-		std::vector<unsigned int> ibo_data;
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-		for(MeshSection section : mesh->GetSections())
+		// Mesh renderers sharing a mesh share the mesh's GPU buffers
+		MeshBufferGL const & mesh_buffer { AcquireMeshBuffer(mesh) };
+
+		// Try to find a render group which renders the same mesh with the same textures
+		RenderGroupGL * render_group { nullptr };
+		for(auto & rg : material_group->render_groups_)
 		{
-			for(unsigned int face_index : section.GetFaceIndices())
+			if(rg.type_ == ERenderObjectType::MESH_RENDERER && rg.vbo_ == mesh_buffer.vbo_ && rg.textures_ == textures)
 			{
-				ibo_data.push_back(face_index);
+				render_group = &rg;
+				break;
 			}
 		}
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, ibo_data.size() * sizeof(unsigned int), ibo_data.data(), GL_STATIC_DRAW);
-
-		// Create a VAO for the render object
-		GLuint vao;
-		glGenVertexArrays(1, &vao);
-		glBindVertexArray(vao);
-		glBindBuffer(GL_ARRAY_BUFFER, vbo);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-		// TODO - Vertex attrib locations are to be controlled by the built shader program
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), 0);
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (GLvoid*)(3 * sizeof(float)));
-		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (GLvoid*)(6 * sizeof(float)));
-		glEnableVertexAttribArray(3);
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (GLvoid*)(8 * sizeof(float)));
-		// Unbind the vao
-		glBindVertexArray(0);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-		// Add a new render object
-		GLenum primitive { GL_TRIANGLES };
-		GLint first { 0 };
-		GLint count { static_cast<GLint>(ibo_data.size()) };
-		uint32_t object_id { NextComponentId() };
-		material_group->render_groups_.emplace_back(
-			std::initializer_list<uint32_t>{ object_id },
-			ERenderObjectType::MESH_RENDERER,
-			vbo, vao,
-			primitive, first, count,
-			std::initializer_list<GLuint>{  }
-		//std::initializer_list<glm::mat4>{ t.GetTransformMatrix() }
-		//std::initializer_list<ITransform const &>{ t }
-		);
 
-		// If the mesh renderer contains a material, add the first texture
-		// TODO - Material determines shader group and can contain multiple textures
-		GLuint texture_stride { 0 };
-		if(mr->GetMaterial())
+		// If no such render group exists, create a new one
+		if(!render_group)
 		{
+			// Create a VAO for the render group
+			// The VAO references the shared mesh buffers and the render group's own instance buffer
+			GLuint vao;
+			glGenVertexArrays(1, &vao);
+			glBindVertexArray(vao);
+			SetMeshVertexAttribs(mesh_buffer.vbo_, mesh_buffer.ibo_, mesh_buffer.compact_);
+			GLuint instance_vbo;
+			glGenBuffers(1, &instance_vbo);
+			SetMeshInstanceAttribs(instance_vbo);
+			// Unbind the vao
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+			// Add a new render group
+			GLenum primitive { GL_TRIANGLES };
+			GLint first { 0 };
+			material_group->render_groups_.emplace_back(
+				std::initializer_list<uint32_t>{  },
+				ERenderObjectType::MESH_RENDERER,
+				mesh_buffer.vbo_, vao,
+				primitive, first, mesh_buffer.count_,
+				std::initializer_list<GLuint>{  }
+			);
+			render_group = &material_group->render_groups_.back();
+			render_group->ibo_ = mesh_buffer.ibo_;
+			render_group->lods_ = mesh_buffer.lods_;
+			render_group->instance_vbo_ = instance_vbo;
+			render_group->textures_ = std::move(textures);
+			render_group->texture_stride_ = static_cast<GLuint>(render_group->textures_.size());
+
+			// The render group's textures are streamed whilst the group exists
 			for(auto texture : mr->GetMaterial()->GetTextures())
 			{
 				if(texture)
-				{
-					material_group->render_groups_.back().textures_.emplace_back(static_cast<TextureGL const *>(texture)->GetGlTexId());
-					++texture_stride;
-				}
+					texture_streamer_.AddTexture(static_cast<TextureGL const *>(texture));
 			}
 		}
 
+		// Add the mesh renderer as an instance of the render group
+		uint32_t object_id { NextComponentId() };
+		render_group->component_ids_.push_back(object_id);
+		render_group->AddInstance(t, mesh_buffer.bounds_);
+		mr->SetEngineData(MeshRendererDataGL{ object_id, mesh });
+		instance_index_dirty_ = true;
+
+		// Occluders are also rasterized by the occlusion culler, which reads the mesh's CPU copy of its geometry
+		if(mr->IsOccluder())
+		{
+			OccluderGL occluder { object_id, &t, mesh, mesh_buffer.bounds_ };
+			for(MeshSection const & section : mesh->GetSections())
+				occluder.indices_.insert(occluder.indices_.end(), section.GetFaceIndices().begin(), section.GetFaceIndices().end());
+			occluders_.push_back(std::move(occluder));
+		}
+	}
+
+	// Add a mesh renderer component of a static entity to the render pool
+	// Static mesh renderers sharing a material are merged into batches before the next frame is drawn
+	void RenderPoolGL::AddStaticMeshRenderer(ITransform const & t, MeshRenderer * mr)
+	{
+		if(mr->GetMesh() == nullptr || mr->GetMaterial() == nullptr)
+			return;
+
+		// The mesh is pre-transformed with the entity's transform when its cell is built
+		Mesh const * mesh { mr->GetMesh() };
+		glm::mat4 world { t.GetTransformMatrix() };
+		AABB local_bounds { AABB::FromPositions(mesh->GetPositionData()) };
+		uint32_t object_id { NextComponentId() };
+		pending_static_meshes_.push_back({ object_id, mesh, mr->GetMaterial(), world, local_bounds.Transformed(world) });
+		static_batches_dirty_ = true;
+		mr->SetEngineData(MeshRendererDataGL{ object_id, mesh, true });
 
-		// Each mesh has its own render group
-		// TODO - Mesh renderers sharing a mesh will use the same render group
-		// TODO - Should use glDrawElementsInstanced for rendering the shared meshes
-		material_group->render_groups_.back().ibo_ = ibo;
-		material_group->render_groups_.back().transforms_.emplace_back(&t);
-		material_group->render_groups_.back().texture_stride_ = texture_stride;
-		mr->SetEngineData(object_id);
+		// Static occluders are rasterized from the mesh's own geometry, the same as other occluders
+		if(mr->IsOccluder())
+		{
+			OccluderGL occluder { object_id, &t, mesh, local_bounds };
+			for(MeshSection const & section : mesh->GetSections())
+				occluder.indices_.insert(occluder.indices_.end(), section.GetFaceIndices().begin(), section.GetFaceIndices().end());
+			occluders_.push_back(std::move(occluder));
+		}
 	}
 
 	// Add a point light component to the render pool
 	void RenderPoolGL::AddPointLight(ITransform const & t, PointLight * pl)
 	{
-		// TODO - Update the position of the light data when the point light's entity moves
-
 		PointLightData data;
 		data.position_ = glm::vec3(t.GetTranslation());
 		data.color_ = glm::vec3(pl->GetColor());
+		data.radius_ = LightClustersGL::GetPointLightRadius(data.color_);
+		uint32_t object_id { NextComponentId() };
 		point_lights_.push_back(data);
+		point_light_transforms_.push_back(&t);
+		point_light_ids_.push_back(object_id);
+		pl->SetEngineData(object_id);
+		instance_index_dirty_ = true;
 	}
 
 	// Add a direction light component to the render pool
 	void RenderPoolGL::AddDirLight(ITransform const & t, DirLight * dl)
 	{
-		// TODO - Update the position of the light data when the point light's entity rotates
-
 		DirLightData data;
 		data.direction_ = glm::vec3(t.GetForward());
 		data.color_ = glm::vec3(dl->GetColor());
+		uint32_t object_id { NextComponentId() };
 		dir_lights_.push_back(data);
+		dir_light_transforms_.push_back(&t);
+		dir_light_ids_.push_back(object_id);
+		dl->SetEngineData(object_id);
+		instance_index_dirty_ = true;
 	}
 
 	// Remove a sprite renderer component from the render pool
 	void RenderPoolGL::RemoveSpriteRenderer(SpriteRenderer * sr)
 	{
-		// Try to find the render object the sprite renderer belongs to
-		bool found { false };
+		// Find the sprite renderer data within the render object
+		uint32_t object_id { std::any_cast<SpriteRendererDataGL>(sr->GetEngineData()).component_id_ };
+
+		// Try to find the render group the sprite renderer belongs to
 		for(auto & p : render_passes_) {
 			for(auto & s : p.material_groups_) {
 				for(auto it = s.render_groups_.begin(); it != s.render_groups_.end(); ++it) {
 					if(it->type_ == ERenderObjectType::SPRITE_RENDERER)
 					{
-						// Find the sprite renderer data within the render object
-						uint32_t object_id { std::any_cast<uint32_t>(sr->GetEngineData()) };
-						for(int i = 0; i < it->component_ids_.size(); i++)
+						for(size_t i = 0; i < it->component_ids_.size(); i++)
 						{
 							if(it->component_ids_[i] == object_id)
 							{
-								// Remove the component
+								// Remove the instance, the instance buffer is re-uploaded from the removed instance onwards
 								it->component_ids_.erase(it->component_ids_.begin() + i);
-								it->transforms_.erase(it->transforms_.begin() + i);
-								it->textures_.erase(it->textures_.begin() + i);
-								found = true;
-								break;
+								it->RemoveInstance(i);
+								instance_index_dirty_ = true;
+
+								// If there are no sprite renderers left in the render group, erase the render group
+								// NOTE - The quad vbo is shared by all sprite render groups so is not deleted here
+								if(it->component_ids_.size() == 0)
+								{
+									for(GLuint texture : it->textures_)
+										texture_streamer_.RemoveTexture(texture);
+									glDeleteBuffers(1, &it->instance_vbo_);
+									glDeleteVertexArrays(1, &it->vao_);
+									s.render_groups_.erase(it);
+								}
+								return;
 							}
 						}
-						// If there are no sprite renderers left in the render object, erase the render object
-						if(it->component_ids_.size() == 0)
-						{
-							glDeleteBuffers(1, &it->vbo_);
-							glDeleteVertexArrays(1, &it->vao_);
-							s.render_groups_.erase(it);
-						}
-						// If the sprite renderer was found then exit the method early
-						if(found)
-						{
-							return;
-						}
 					}
 				}
 			}
@@ -578,50 +588,94 @@ namespace ose::rendering
 	// Remove a tile renderer component from the render pool
 	void RenderPoolGL::RemoveTileRenderer(TileRenderer * tr)
 	{
-		// Try to find the render object the tile renderer belongs to
+		// Find the tile renderer data within the render object
+		uint32_t object_id { std::any_cast<uint32_t>(tr->GetEngineData()) };
+
+		// Remove every chunk of the tile renderer
 		for(auto & p : render_passes_) {
 			for(auto & s : p.material_groups_) {
-				for(auto it = s.render_groups_.begin(); it != s.render_groups_.end(); ++it) {
-					if(it->type_ == ERenderObjectType::TILE_RENDERER)
+				for(size_t r = s.render_groups_.size(); r-- > 0; ) {
+					RenderGroupGL & render_group { s.render_groups_[r] };
+					if(render_group.type_ == ERenderObjectType::TILE_RENDERER && render_group.component_ids_[0] == object_id)
 					{
-						// Find the tile renderer data within the render object
-						uint32_t object_id { std::any_cast<uint32_t>(tr->GetEngineData()) };
-						
-						// Can remove the entire render object since each tile renderer has its own render object
-						if(it->component_ids_[0] == object_id)
-						{
-							glDeleteBuffers(1, &it->vbo_);
-							glDeleteVertexArrays(1, &it->vao_);
-							s.render_groups_.erase(it);
-							return;
-						}
+						EvictTileChunk(render_group);
+						s.render_groups_.erase(s.render_groups_.begin() + r);
+					}
+					else if(render_group.type_ == ERenderObjectType::TILE_INDEX_RENDERER && render_group.component_ids_[0] == object_id)
+					{
+						// The vertex buffer is the shared sprite quad
+						glDeleteBuffers(1, &render_group.instance_vbo_);
+						glDeleteVertexArrays(1, &render_group.vao_);
+						s.render_groups_.erase(s.render_groups_.begin() + r);
 					}
 				}
 			}
 		}
+
+		auto iter { tile_renderers_.find(object_id) };
+		if(iter != tile_renderers_.end())
+		{
+			glDeleteTextures(1, &iter->second.index_texture_);
+			tile_renderers_.erase(iter);
+		}
+		instance_index_dirty_ = true;
 	}
 
 	// Remove a mesh renderer component from the render pool
 	void RenderPoolGL::RemoveMeshRenderer(MeshRenderer * mr)
 	{
-		// Try to find the render object the mesh renderer belongs to
+		// Find the mesh renderer data within the render group
+		MeshRendererDataGL data { std::any_cast<MeshRendererDataGL>(mr->GetEngineData()) };
+
+		occluders_.erase(std::remove_if(occluders_.begin(), occluders_.end(),
+			[&data](OccluderGL const & occluder) { return occluder.component_id_ == data.component_id_; }), occluders_.end());
+
+		// Static mesh renderers are removed from their cell, which is rebuilt before the next frame is drawn
+		if(data.static_)
+		{
+			auto is_removed { [&data](StaticMeshGL const & static_mesh) { return static_mesh.component_id_ == data.component_id_; } };
+			pending_static_meshes_.erase(std::remove_if(pending_static_meshes_.begin(), pending_static_meshes_.end(), is_removed),
+				pending_static_meshes_.end());
+			for(auto & cell : static_cells_)
+			{
+				auto iter { std::find_if(cell.meshes_.begin(), cell.meshes_.end(), is_removed) };
+				if(iter != cell.meshes_.end())
+				{
+					cell.meshes_.erase(iter);
+					cell.dirty_ = true;
+					static_batches_dirty_ = true;
+					break;
+				}
+			}
+			return;
+		}
+
+		// Try to find the render group the mesh renderer belongs to
 		for(auto & p : render_passes_) {
 			for(auto & s : p.material_groups_) {
 				for(auto it = s.render_groups_.begin(); it != s.render_groups_.end(); ++it) {
 					if(it->type_ == ERenderObjectType::MESH_RENDERER)
 					{
-						// Find the mesh renderer data within the render object
-						uint32_t object_id { std::any_cast<uint32_t>(mr->GetEngineData()) };
-
-						// Can remove the entire render object since each mesh renderer has its own render object
-						// TODO - Change this once instancing is implemented
-						if(it->component_ids_[0] == object_id)
+						for(size_t i = 0; i < it->component_ids_.size(); i++)
 						{
-							glDeleteBuffers(1, &it->vbo_);
-							glDeleteBuffers(1, &it->ibo_);
-							glDeleteVertexArrays(1, &it->vao_);
-							s.render_groups_.erase(it);
-							return;
+							if(it->component_ids_[i] == data.component_id_)
+							{
+								// Remove the instance, the instance buffer is re-uploaded from the removed instance onwards
+								it->component_ids_.erase(it->component_ids_.begin() + i);
+								it->RemoveInstance(i);
+								instance_index_dirty_ = true;
+
+								// If there are no mesh renderers left in the render group, erase the render group
+								// NOTE - The mesh buffers are shared so are only deleted once no render group references them
+								if(it->component_ids_.size() == 0)
+								{
+									glDeleteBuffers(1, &it->instance_vbo_);
+									glDeleteVertexArrays(1, &it->vao_);
+									s.render_groups_.erase(it);
+								}
+								ReleaseMeshBuffer(data.mesh_);
+								return;
+							}
 						}
 					}
 				}
@@ -632,65 +686,1082 @@ namespace ose::rendering
 	// Remove a point light component from the render pool
 	void RenderPoolGL::RemovePointLight(PointLight * pl)
 	{
-		// TODO
+		uint32_t object_id { std::any_cast<uint32_t>(pl->GetEngineData()) };
+		auto iter { std::find(point_light_ids_.begin(), point_light_ids_.end(), object_id) };
+		if(iter == point_light_ids_.end())
+			return;
+
+		// Light order doesn't matter, so the last light is swapped into the removed light's place
+		size_t l { static_cast<size_t>(iter - point_light_ids_.begin()) };
+		point_lights_[l] = point_lights_.back();
+		point_light_transforms_[l] = point_light_transforms_.back();
+		point_light_ids_[l] = point_light_ids_.back();
+		point_lights_.pop_back();
+		point_light_transforms_.pop_back();
+		point_light_ids_.pop_back();
+		instance_index_dirty_ = true;
 	}
 
 	// Remove a direction light component from the render pool
 	void RenderPoolGL::RemoveDirLight(DirLight * dl)
 	{
-		// TODO
+		uint32_t object_id { std::any_cast<uint32_t>(dl->GetEngineData()) };
+		auto iter { std::find(dir_light_ids_.begin(), dir_light_ids_.end(), object_id) };
+		if(iter == dir_light_ids_.end())
+			return;
+
+		// Light order doesn't matter, so the last light is swapped into the removed light's place
+		size_t l { static_cast<size_t>(iter - dir_light_ids_.begin()) };
+		dir_lights_[l] = dir_lights_.back();
+		dir_light_transforms_[l] = dir_light_transforms_.back();
+		dir_light_ids_[l] = dir_light_ids_.back();
+		dir_lights_.pop_back();
+		dir_light_transforms_.pop_back();
+		dir_light_ids_.pop_back();
+		instance_index_dirty_ = true;
 	}
 
-	// Get a material group to render the given material in
-	// If no suitable material group exists, a new group is created
-	MaterialGroupGL * RenderPoolGL::GetMaterialGroup(RenderPassGL & render_pass, Material const * material)
+	// Build the tile chunks which are near the view frustum and evict those which are far outside of it
+	// Chunks affected by tilemap edits since the last update are rebuilt, index textures are patched texel by texel
+	void RenderPoolGL::UpdateTileChunks(Frustum const & frustum)
 	{
-		// Returns true if a material group's blending setup matches an EBlendMode object
-		auto is_blending_correct = [](EBlendMode mode, MaterialGroupGL const & group) -> bool {
-			if(mode == EBlendMode::OPAQUE && group.enable_blend_ == false)
-				return true;
-			if(mode == EBlendMode::ONE_MINUS_SRC_ALPHA && group.enable_blend_ == true && group.blend_func_ == GL_ONE_MINUS_SRC_ALPHA)
-				return true;
-			return false;
-		};
+		if(tile_renderers_.empty())
+			return;
 
-		// Try to find a material group to add the tile renderer to
-		MaterialGroupGL * material_group { nullptr };
-		shader::ShaderProgGLSL const * shader_prog = dynamic_cast<shader::ShaderProgGLSL const *>(material->GetShaderProg());
-		if(shader_prog)
+		// Mark the chunks containing edited tiles as stale
+		std::vector<TileEdit> edits;
+		for(auto & [object_id, tile_renderer] : tile_renderers_)
 		{
-			for(auto & s : render_pass.material_groups_)
+			Tilemap const & tilemap { *tile_renderer.tile_renderer_->GetTilemap() };
+			if(tilemap.GetRevision() == tile_renderer.tilemap_revision_)
+				continue;
+
+			edits.clear();
+			bool has_edit_log { tilemap.GetEditsSince(tile_renderer.tilemap_revision_, edits) };
+			if(tile_renderer.index_texture_ != 0)
+			{
+				// Once most of the tilemap has changed, a single upload is cheaper than one per tile
+				if(has_edit_log && edits.size() * 4 < static_cast<size_t>(tilemap.GetWidth()) * tilemap.GetHeight())
+					UploadTileIndexEdits(tile_renderer, edits);
+				else
+					UploadTileIndexTexture(tile_renderer);
+			}
+			else if(has_edit_log)
+			{
+				for(TileEdit const & edit : edits)
+				{
+					// Tile rows are stored upside down, so convert the row to the chunk's row
+					int32_t j { tilemap.GetHeight() - edit.row_ - 1 };
+					size_t chunk { static_cast<size_t>(edit.col_ / TILE_CHUNK_SIZE + (j / TILE_CHUNK_SIZE) * tile_renderer.num_chunks_x_) };
+					if(chunk < tile_renderer.chunk_stale_.size())
+						tile_renderer.chunk_stale_[chunk] = 1;
+				}
+			}
+			else
 			{
-				if(shader_prog->GetShaderProgId() == s.shader_prog_ && is_blending_correct(material->GetBlendMode(), s))
-					material_group = &s;
+				std::fill(tile_renderer.chunk_stale_.begin(), tile_renderer.chunk_stale_.end(), 1);
 			}
+			tile_renderer.tilemap_revision_ = tilemap.GetRevision();
 		}
-		else
+
+		for(auto & render_pass : render_passes_)
 		{
-			LOG_ERROR("Failed to find a suitable shader group, material shader is not of type ShaderProgGLSL");
-			return nullptr;
+			for(auto & material_group : render_pass.material_groups_)
+			{
+				for(auto & render_group : material_group.render_groups_)
+				{
+					if(render_group.type_ != ERenderObjectType::TILE_RENDERER)
+						continue;
+
+					auto iter { tile_renderers_.find(render_group.component_ids_[0]) };
+					if(iter == tile_renderers_.end())
+						continue;
+					TileRendererGL & tile_renderer { iter->second };
+					uint32_t chunk { render_group.chunk_ };
+
+					// Chunks are built within one chunk of the frustum and evicted once more than three chunks away
+					// The gap between the two distances prevents chunks on the boundary from being rebuilt every frame
+					AABB const & bounds { render_group.world_bounds_[0] };
+					glm::vec3 extents { bounds.GetExtents() * 2.0f };
+					if(tile_renderer.chunk_built_[chunk])
+					{
+						AABB evict_bounds { bounds.min_ - extents * 3.0f, bounds.max_ + extents * 3.0f };
+						if(!frustum.Intersects(evict_bounds))
+						{
+							EvictTileChunk(render_group);
+							tile_renderer.chunk_built_[chunk] = 0;
+						}
+						else if(tile_renderer.chunk_stale_[chunk])
+						{
+							BuildTileChunk(render_group, *tile_renderer.tile_renderer_);
+						}
+					}
+					else
+					{
+						AABB build_bounds { bounds.min_ - extents, bounds.max_ + extents };
+						if(frustum.Intersects(build_bounds))
+						{
+							BuildTileChunk(render_group, *tile_renderer.tile_renderer_);
+							tile_renderer.chunk_built_[chunk] = 1;
+						}
+					}
+					tile_renderer.chunk_stale_[chunk] = 0;
+				}
+			}
 		}
+	}
 
-		// If no usable shader group exists, create a new one
-		if(!material_group)
-		{
-			MaterialGroupGL mg;
-			mg.enable_blend_ = material->GetBlendMode() == EBlendMode::OPAQUE ? false : true;
-			mg.blend_fac_ = GL_SRC_ALPHA;
-			mg.blend_func_ = GL_ONE_MINUS_SRC_ALPHA;
-			mg.shader_prog_ = shader_prog->GetShaderProgId();
+	// Merge the static mesh renderers added since the last update into the batches of their grid cells
+	// Cells whose mesh renderers have been added or removed are rebuilt, each cell is a single draw per material
+	void RenderPoolGL::UpdateStaticBatches(float cell_size)
+	{
+		if(!static_batches_dirty_)
+			return;
+		static_batches_dirty_ = false;
 
-			// Rendering of opaque objects should be done before rendering of alpha enabled objects
-			// Therefore, if attempting to add an opaque shader group, ensure it is inserted before any alpha shader groups
-			if(material->GetBlendMode() == EBlendMode::OPAQUE)
+		// Assign each pending mesh renderer to the cell containing the centre of its bounds
+		// Mesh renderers are never split between cells, so cells' bounds overlap by up to the size of their largest mesh
+		cell_size = std::max(cell_size, 0.001f);
+		for(StaticMeshGL & static_mesh : pending_static_meshes_)
+		{
+			glm::ivec3 cell_pos { glm::floor(static_mesh.world_bounds_.GetCenter() / cell_size) };
+			auto iter { std::find_if(static_cells_.begin(), static_cells_.end(), [&static_mesh, &cell_pos](StaticCellGL const & cell) {
+				return cell.material_ == static_mesh.material_ && cell.cell_ == cell_pos;
+			}) };
+			if(iter == static_cells_.end())
 			{
-				material_group = &*render_pass.material_groups_.insert(render_pass.material_groups_.begin(), mg);
+				static_cells_.push_back({ static_mesh.material_, cell_pos, {}, NextComponentId() });
+				iter = static_cells_.end() - 1;
 			}
+			iter->meshes_.push_back(static_mesh);
+			iter->dirty_ = true;
+		}
+		pending_static_meshes_.clear();
+
+		// Rebuild the dirty cells, erasing those which no longer contain any mesh renderers
+		for(size_t c = static_cells_.size(); c-- > 0; )
+		{
+			StaticCellGL & cell { static_cells_[c] };
+			if(!cell.dirty_)
+				continue;
+			DestroyStaticCell(cell);
+			if(cell.meshes_.empty())
+				static_cells_.erase(static_cells_.begin() + c);
 			else
-			{
-				render_pass.material_groups_.push_back(mg);
-				material_group = &render_pass.material_groups_.back();
-			}
+				BuildStaticCell(cell);
+		}
+	}
+
+	// Merge the meshes of a static batch cell into a single world space vertex and index buffer, and add the cell's render group
+	void RenderPoolGL::BuildStaticCell(StaticCellGL & cell)
+	{
+		cell.dirty_ = false;
+
+		MaterialGroupGL * material_group = GetMaterialGroup(render_passes_[0], cell.material_);
+		if(!material_group)
+			return;
+
+		std::vector<GLuint> textures;
+		for(auto texture : cell.material_->GetTextures())
+		{
+			if(texture)
+				textures.push_back(static_cast<TextureGL const *>(texture)->GetGlTexId());
+		}
+
+		// Indices of each mesh are offset by the number of vertices of the meshes before it
+		size_t num_vertices { 0 };
+		size_t num_indices { 0 };
+		AABB bounds { cell.meshes_[0].world_bounds_ };
+		for(StaticMeshGL const & static_mesh : cell.meshes_)
+		{
+			num_vertices += static_mesh.mesh_->GetPositionData().size() / 3;
+			for(MeshSection const & section : static_mesh.mesh_->GetSections())
+				num_indices += section.GetFaceIndices().size();
+			bounds = bounds.Merged(static_mesh.world_bounds_);
+		}
+
+		// The merged buffers use the same interleaved layout as the buffers of a single mesh
+		// The uploads capture the cell's meshes by value since the cell may be rebuilt before they are filled
+		size_t vbo_size { num_vertices * 11 * sizeof(float) };
+		glGenBuffers(1, &cell.vbo_);
+		glBindBuffer(GL_ARRAY_BUFFER, cell.vbo_);
+		glBufferData(GL_ARRAY_BUFFER, vbo_size, nullptr, GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		UploadQueueGL::QueueBuffer(cell.vbo_, vbo_size, [meshes = cell.meshes_, vbo_size](uint8_t * dst) {
+			float * data { reinterpret_cast<float *>(dst) };
+			// Vertices missing any attribute are left zeroed
+			std::memset(dst, 0, vbo_size);
+			for(StaticMeshGL const & static_mesh : meshes)
+			{
+				Mesh const & mesh { *static_mesh.mesh_ };
+				glm::mat3 normal_matrix { glm::transpose(glm::inverse(glm::mat3(static_mesh.world_))) };
+				glm::mat3 tangent_matrix { static_mesh.world_ };
+				size_t n { mesh.GetPositionData().size() / 3 };
+				bool has_attribs { mesh.GetNormalData().size() >= n * 3 && mesh.GetTexCoordData().size() >= n * 2 && mesh.GetTangentData().size() >= n * 3 };
+				for(size_t v = 0; v < n; ++v, data += 11)
+				{
+					glm::vec3 position { static_mesh.world_ * glm::vec4(glm::make_vec3(&mesh.GetPositionData()[v * 3]), 1.0f) };
+					std::memcpy(data, glm::value_ptr(position), sizeof(position));
+					if(!has_attribs)
+						continue;
+
+					// Normals and tangents of degenerate vertices are left as they are rather than normalised
+					glm::vec3 normal { normal_matrix * glm::make_vec3(&mesh.GetNormalData()[v * 3]) };
+					glm::vec3 tangent { tangent_matrix * glm::make_vec3(&mesh.GetTangentData()[v * 3]) };
+					if(glm::dot(normal, normal) > 0.0f)
+						normal = glm::normalize(normal);
+					if(glm::dot(tangent, tangent) > 0.0f)
+						tangent = glm::normalize(tangent);
+					std::memcpy(data + 3, glm::value_ptr(normal), sizeof(normal));
+					data[6] = mesh.GetTexCoordData()[v * 2 + 0];
+					data[7] = mesh.GetTexCoordData()[v * 2 + 1];
+					std::memcpy(data + 8, glm::value_ptr(tangent), sizeof(tangent));
+				}
+			}
+		});
+
+		size_t ibo_size { num_indices * sizeof(unsigned int) };
+		glGenBuffers(1, &cell.ibo_);
+		// NOTE - The element array binding is VAO state, so no VAO may be bound while the IBO is allocated
+		glBindVertexArray(0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, cell.ibo_);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, ibo_size, nullptr, GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		UploadQueueGL::QueueBuffer(cell.ibo_, ibo_size, [meshes = cell.meshes_](uint8_t * dst) {
+			unsigned int * indices { reinterpret_cast<unsigned int *>(dst) };
+			unsigned int base { 0 };
+			for(StaticMeshGL const & static_mesh : meshes)
+			{
+				for(MeshSection const & section : static_mesh.mesh_->GetSections())
+					indices = std::transform(section.GetFaceIndices().begin(), section.GetFaceIndices().end(), indices,
+						[base](unsigned int index) { return index + base; });
+				base += static_cast<unsigned int>(static_mesh.mesh_->GetPositionData().size() / 3);
+			}
+		});
+
+		// The cell is drawn as a single instance with an identity transform
+		GLuint vao;
+		glGenVertexArrays(1, &vao);
+		glBindVertexArray(vao);
+		SetMeshVertexAttribs(cell.vbo_, cell.ibo_, false);
+		GLuint instance_vbo;
+		glGenBuffers(1, &instance_vbo);
+		SetMeshInstanceAttribs(instance_vbo);
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+		material_group->render_groups_.emplace_back(
+			std::initializer_list<uint32_t>{ cell.component_id_ },
+			ERenderObjectType::MESH_RENDERER,
+			cell.vbo_, vao,
+			GL_TRIANGLES, 0, static_cast<GLint>(num_indices),
+			std::initializer_list<GLuint>{  }
+		);
+		RenderGroupGL & render_group { material_group->render_groups_.back() };
+		render_group.ibo_ = cell.ibo_;
+		render_group.instance_vbo_ = instance_vbo;
+		render_group.textures_ = std::move(textures);
+		render_group.texture_stride_ = static_cast<GLuint>(render_group.textures_.size());
+		render_group.AddInstance(static_batch_transform_, bounds);
+		for(auto texture : cell.material_->GetTextures())
+		{
+			if(texture)
+				texture_streamer_.AddTexture(static_cast<TextureGL const *>(texture));
+		}
+		instance_index_dirty_ = true;
+	}
+
+	// Remove the render group of a static batch cell and delete the cell's buffers
+	void RenderPoolGL::DestroyStaticCell(StaticCellGL & cell)
+	{
+		if(cell.vbo_ == 0)
+			return;
+
+		for(auto & p : render_passes_) {
+			for(auto & s : p.material_groups_) {
+				for(auto it = s.render_groups_.begin(); it != s.render_groups_.end(); ++it) {
+					if(it->type_ == ERenderObjectType::MESH_RENDERER && it->vbo_ == cell.vbo_)
+					{
+						for(GLuint texture : it->textures_)
+							texture_streamer_.RemoveTexture(texture);
+						glDeleteBuffers(1, &it->instance_vbo_);
+						glDeleteVertexArrays(1, &it->vao_);
+						s.render_groups_.erase(it);
+						break;
+					}
+				}
+			}
+		}
+
+		UploadQueueGL::CancelBuffer(cell.vbo_);
+		UploadQueueGL::CancelBuffer(cell.ibo_);
+		glDeleteBuffers(1, &cell.vbo_);
+		glDeleteBuffers(1, &cell.ibo_);
+		cell.vbo_ = 0;
+		cell.ibo_ = 0;
+		instance_index_dirty_ = true;
+	}
+
+	// Switch each material group whose shader variant has finished building from the default program to the variant
+	void RenderPoolGL::UpdateShaderVariants()
+	{
+		for(auto & render_pass : render_passes_)
+		{
+			for(auto & material_group : render_pass.material_groups_)
+			{
+				shader::ShaderVariantGL const * variant { material_group.pending_variant_ };
+				if(!variant || !variant->ready_.load(std::memory_order_acquire))
+					continue;
+
+				// If the variant failed to build the group keeps drawing with the default program
+				if(variant->prog_)
+				{
+					material_group.shader_prog_ = variant->prog_;
+					material_group.gbuffer_shader_prog_ = variant->gbuffer_prog_;
+					material_group.uniforms_ = variant->uniforms_;
+				}
+				material_group.pending_variant_ = nullptr;
+			}
+		}
+	}
+
+	// Choose the level of detail of each mesh instance from the size of its bounds on screen
+	// Levels are chosen s.t. their error covers no more than screen_error pixels, with a margin before moving to a coarser level
+	void RenderPoolGL::UpdateMeshLods(glm::mat4 const & view_proj, float pixels_per_unit, float screen_error)
+	{
+		// A coarser level is only used once the instance is this much smaller than the size the level is allowed at
+		// Without the margin, instances at the boundary between two levels would switch between them every frame
+		constexpr float LOD_HYSTERESIS { 0.15f };
+
+		for(auto & render_pass : render_passes_)
+		{
+			for(auto & material_group : render_pass.material_groups_)
+			{
+				for(auto & render_group : material_group.render_groups_)
+				{
+					if(render_group.lods_.size() < 2)
+						continue;
+
+					// A level's error on screen is its relative error multiplied by the instance's projected radius
+					// so each level is allowed up to a projected diameter of 2 * screen_error / error
+					auto max_screen_size { [&render_group, screen_error](size_t lod) {
+						float error { render_group.lods_[lod].error_ };
+						return error > 0.0f ? 2.0f * screen_error / error : std::numeric_limits<float>::max();
+					} };
+
+					for(size_t i = 0; i < render_group.GetNumInstances(); ++i)
+					{
+						AABB const & bounds { render_group.world_bounds_[i] };
+						float diameter { 2.0f * glm::length(bounds.GetExtents()) };
+						float w { (view_proj * glm::vec4(bounds.GetCenter(), 1.0f)).w };
+						float screen_size { diameter * pixels_per_unit / std::max(w, 0.0001f) };
+
+						// Move to a finer level as soon as the current level's error would be visible
+						size_t lod { render_group.instance_lods_[i] };
+						while(lod > 0 && screen_size > max_screen_size(lod))
+							--lod;
+						while(lod + 1 < render_group.lods_.size() && screen_size < max_screen_size(lod + 1) * (1.0f - LOD_HYSTERESIS))
+							++lod;
+						render_group.instance_lods_[i] = static_cast<uint8_t>(lod);
+					}
+				}
+			}
+		}
+	}
+
+	// Upload the changed range of each render group's instance data to its instance buffer
+	void RenderPoolGL::UpdateInstanceBuffers()
+	{
+		for(auto & render_pass : render_passes_)
+		{
+			for(auto & material_group : render_pass.material_groups_)
+			{
+				for(auto & render_group : material_group.render_groups_)
+				{
+					if(render_group.instance_vbo_ == 0 || !render_group.IsDirty())
+						continue;
+
+					size_t num_instances { render_group.GetNumInstances() };
+					size_t stride_bytes { render_group.instance_stride_ * sizeof(float) };
+					glBindBuffer(GL_ARRAY_BUFFER, render_group.instance_vbo_);
+
+					if(num_instances > render_group.instance_capacity_)
+					{
+						// Grow the buffer geometrically s.t. adding instances rarely reallocates, then upload every instance
+						render_group.instance_capacity_ = std::max(num_instances, render_group.instance_capacity_ * 2);
+						glBufferData(GL_ARRAY_BUFFER, render_group.instance_capacity_ * stride_bytes, nullptr, GL_DYNAMIC_DRAW);
+						glBufferSubData(GL_ARRAY_BUFFER, 0, num_instances * stride_bytes, render_group.instance_data_.data());
+					}
+					else
+					{
+						// Only upload the instances which have changed
+						size_t end { std::min(render_group.dirty_end_, num_instances) };
+						if(render_group.dirty_begin_ < end)
+						{
+							glBufferSubData(GL_ARRAY_BUFFER, render_group.dirty_begin_ * stride_bytes,
+								(end - render_group.dirty_begin_) * stride_bytes, render_group.GetInstanceData(render_group.dirty_begin_));
+						}
+					}
+
+					render_group.ClearDirty();
+				}
+			}
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	// Update the render objects of all entities whose global transform changed this frame
+	void RenderPoolGL::ApplyTransformChanges(TransformChangeList const & changes)
+	{
+		if(changes.IsEmpty())
+			return;
+
+		if(instance_index_dirty_)
+			RebuildInstanceIndex();
+
+		// Only the instances of entities which have moved are recalculated, and only their range of instance data is marked dirty
+		for(auto const & change : changes.GetChanges())
+		{
+			auto iter { instance_index_.find(change.transform_) };
+			if(iter == instance_index_.end())
+				continue;
+
+			for(InstanceLocation const & loc : iter->second)
+			{
+				switch(loc.type_)
+				{
+				case ERenderObjectType::POINT_LIGHT:
+					point_lights_[loc.instance_].position_ = glm::vec3(change.transform_->GetTranslation());
+					break;
+				case ERenderObjectType::DIR_LIGHT:
+					dir_lights_[loc.instance_].direction_ = glm::vec3(change.transform_->GetForward());
+					break;
+				default:
+					render_passes_[loc.pass_].material_groups_[loc.material_group_].render_groups_[loc.render_group_].UpdateInstance(loc.instance_);
+					break;
+				}
+			}
+		}
+	}
+
+	// Set the per-instance vertex attributes of a sprite/tile render group on the currently bound VAO
+	// stride is the number of floats per instance, larger for instance layouts which extend the sprite layout
+	void RenderPoolGL::SetSpriteInstanceAttribs(GLuint instance_vbo, GLsizei stride_floats)
+	{
+		GLsizei stride { static_cast<GLsizei>(stride_floats * sizeof(float)) };
+		glBindBuffer(GL_ARRAY_BUFFER, instance_vbo);
+		// Position and rotation
+		glEnableVertexAttribArray(2);
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, 0);
+		glVertexAttribDivisor(2, 1);
+		// Scale and size
+		glEnableVertexAttribArray(3);
+		glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(4 * sizeof(float)));
+		glVertexAttribDivisor(3, 1);
+		// UV rect
+		glEnableVertexAttribArray(4);
+		glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(8 * sizeof(float)));
+		glVertexAttribDivisor(4, 1);
+		// Texture layer
+		glEnableVertexAttribArray(5);
+		glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(12 * sizeof(float)));
+		glVertexAttribDivisor(5, 1);
+	}
+
+	// Set the per-instance vertex attributes of an index texture tile render group on the currently bound VAO
+	void RenderPoolGL::SetTileIndexInstanceAttribs(GLuint instance_vbo)
+	{
+		SetSpriteInstanceAttribs(instance_vbo, RenderGroupGL::TILE_INDEX_INSTANCE_STRIDE);
+		// Tileset columns, rows and spacing
+		GLsizei stride { RenderGroupGL::TILE_INDEX_INSTANCE_STRIDE * sizeof(float) };
+		glEnableVertexAttribArray(6);
+		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(13 * sizeof(float)));
+		glVertexAttribDivisor(6, 1);
+	}
+
+	// Get the local space bounds of a tile chunk
+	AABB RenderPoolGL::GetTileChunkBounds(TileRenderer const & tr, int32_t chunk_x, int32_t chunk_y)
+	{
+		// Tile dimensions are fractions of the texture s.t. the shader can scale them by the texture size
+		float tile_width  { 1.0f / tr.GetNumCols() };
+		float tile_height { 1.0f / tr.GetNumRows() };
+		float spacing_x { tile_width * tr.GetSpacingX() };
+		float spacing_y { tile_height * tr.GetSpacingY() };
+
+		int32_t i0 { chunk_x * TILE_CHUNK_SIZE };
+		int32_t j0 { chunk_y * TILE_CHUNK_SIZE };
+		int32_t i1 { std::min(i0 + TILE_CHUNK_SIZE, tr.GetTilemap()->GetWidth()) - 1 };
+		int32_t j1 { std::min(j0 + TILE_CHUNK_SIZE, tr.GetTilemap()->GetHeight()) - 1 };
+
+		glm::vec2 size { tr.GetTexture()->GetWidth(), tr.GetTexture()->GetHeight() };
+		glm::vec2 min { i0 * spacing_x, j0 * spacing_y };
+		glm::vec2 max { i1 * spacing_x + tile_width, j1 * spacing_y + tile_height };
+		return { glm::vec3(min * size, 0.0f), glm::vec3(max * size, 0.0f) };
+	}
+
+	// Build (or rebuild) the vertex data of a tile chunk from its tilemap
+	void RenderPoolGL::BuildTileChunk(RenderGroupGL & render_group, TileRenderer const & tr)
+	{
+		auto const & tilemap = *tr.GetTilemap();
+
+		// Calculate tile dimensions s.t. when multiplied by the texture dimensions in the shader, the tiles will be the correct size
+		float tile_width  { 1.0f / tr.GetNumCols() };
+		float tile_height { 1.0f / tr.GetNumRows() };
+
+		// Get the width and height of the tilemap
+		int32_t tilemap_width  { tilemap.GetWidth() };
+		int32_t tilemap_height { tilemap.GetHeight() };
+
+		// Get the x and y spacing between tiles
+		float spacing_x { tile_width * tr.GetSpacingX() };
+		float spacing_y { tile_height * tr.GetSpacingY() };
+
+		// Calculate the dimensions of half a pixel in texture co-ordinate space
+		float half_pixel_width  = { (1.0f / tr.GetTexture()->GetWidth()) / 2};
+		float half_pixel_height = { (1.0f / tr.GetTexture()->GetHeight()) / 2};
+
+		// Get the range of tiles covered by the chunk
+		int32_t num_chunks_x { (tilemap_width + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE };
+		int32_t i0 { static_cast<int32_t>(render_group.chunk_ % num_chunks_x) * TILE_CHUNK_SIZE };
+		int32_t j0 { static_cast<int32_t>(render_group.chunk_ / num_chunks_x) * TILE_CHUNK_SIZE };
+		int32_t i1 { std::min(i0 + TILE_CHUNK_SIZE, tilemap_width) };
+		int32_t j1 { std::min(j0 + TILE_CHUNK_SIZE, tilemap_height) };
+
+		// Data consists of 2-float position and 2-float tex coords interleaved, each tile is composed of 2 tris (6 vertices)
+		// Empty tiles are skipped s.t. sparse chunks have small buffers
+		std::vector<float> data;
+		data.reserve(static_cast<size_t>(6) * 4 * TILE_CHUNK_SIZE * TILE_CHUNK_SIZE);
+		for(int32_t j = j0; j < j1; j++)
+		{
+			for(int32_t i = i0; i < i1; i++)
+			{
+				// Get the value of the tile at (x, y) - Stored upside down so use y = j - height - 1 instead of y = j
+				int32_t value { tilemap(i, tilemap_height-j-1) };
+				if(value >= 0 && value < tr.GetNumTiles())
+				{
+					// Calculate the position of the tile in the texture atlas
+					int32_t atlas_x { value % tr.GetNumCols() };
+					int32_t atlas_y { value / tr.GetNumCols() };
+					// Calculate the position co-ordinates for the tile
+					float x0 = i * spacing_x;
+					float x1 = i * spacing_x + tile_width;
+					float y0 = j * spacing_y;
+					float y1 = j * spacing_y + tile_height;
+					// Calculate the texture co-ordinates for the tile
+					float u0 = (float)atlas_x / tr.GetNumCols() + half_pixel_width;
+					float u1 = (float)(atlas_x + 1) / tr.GetNumCols() - half_pixel_width;
+					float v0 = (float)atlas_y / tr.GetNumRows() + half_pixel_height;
+					float v1 = (float)(atlas_y + 1) / tr.GetNumRows() - half_pixel_height;
+					// Set the vertices' positions and texture co-ordinates
+					float tile[] = {
+						x0, y1, u0, v0,		// Top Left
+						x1, y0, u1, v1,		// Bottom Right
+						x1, y1, u1, v0,		// Top Right
+						x1, y0, u1, v1,		// Bottom Right
+						x0, y1, u0, v0,		// Top Left
+						x0, y0, u0, v1		// Bottom Left
+					};
+					data.insert(data.end(), std::begin(tile), std::end(tile));
+				}
+			}
+		}
+
+		// Create the chunk's buffers the first time it is built
+		if(render_group.vao_ == 0)
+		{
+			glGenBuffers(1, &render_group.vbo_);
+			glGenBuffers(1, &render_group.instance_vbo_);
+			glGenVertexArrays(1, &render_group.vao_);
+			glBindVertexArray(render_group.vao_);
+			glBindBuffer(GL_ARRAY_BUFFER, render_group.vbo_);
+			// TODO - Vertex attrib locations are to be controlled by the built shader program
+			glEnableVertexAttribArray(0);
+			glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
+			glEnableVertexAttribArray(1);
+			glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (GLvoid*)(2 * sizeof(float)));
+			// The chunk is drawn as a single instance using the same per-instance attributes as sprites
+			SetSpriteInstanceAttribs(render_group.instance_vbo_);
+			// Unbind the vao
+			glBindVertexArray(0);
+
+			// The instance data must be uploaded to the new instance buffer
+			render_group.instance_capacity_ = 0;
+			render_group.MarkDirty(0, render_group.GetNumInstances());
+		}
+
+		// Re-upload only this chunk's vertices
+		// Chunks being built for the first time are uploaded by the upload queue, edits to a drawn chunk are uploaded immediately
+		// s.t. they are never drawn a frame late
+		size_t size { data.size() * sizeof(float) };
+		bool queued { render_group.count_ == 0 };
+		UploadQueueGL::CancelBuffer(render_group.vbo_);
+		glBindBuffer(GL_ARRAY_BUFFER, render_group.vbo_);
+		glBufferData(GL_ARRAY_BUFFER, size, queued ? nullptr : data.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		render_group.count_ = static_cast<GLint>(data.size() / 4);
+		if(queued)
+		{
+			auto vertices { std::make_shared<std::vector<float>>(std::move(data)) };
+			UploadQueueGL::QueueBuffer(render_group.vbo_, size, [vertices, size](uint8_t * dst) { std::memcpy(dst, vertices->data(), size); });
+		}
+	}
+
+	// Free the buffers of a tile chunk, the chunk is not drawn until it is built again
+	void RenderPoolGL::EvictTileChunk(RenderGroupGL & render_group)
+	{
+		UploadQueueGL::CancelBuffer(render_group.vbo_);
+		glDeleteBuffers(1, &render_group.vbo_);
+		glDeleteBuffers(1, &render_group.instance_vbo_);
+		glDeleteVertexArrays(1, &render_group.vao_);
+		render_group.vbo_ = 0;
+		render_group.instance_vbo_ = 0;
+		render_group.vao_ = 0;
+		render_group.count_ = 0;
+	}
+
+	// Add a tile renderer which is drawn as a single quad whose tiles are looked up in an index texture
+	void RenderPoolGL::AddTileIndexRenderer(ITransform const & t, TileRenderer * tr, GLuint tex_id, TextureAtlasRegion const & region)
+	{
+		auto const & tilemap = *tr->GetTilemap();
+		if(tilemap.GetWidth() <= 0 || tilemap.GetHeight() <= 0)
+		{
+			LOG_ERROR("Failed to add tile renderer, tilemap is empty");
+			return;
+		}
+
+		// The material's shader is replaced by the tile index shader, only the material's blend mode is used
+		if(!tile_index_shader_prog_)
+		{
+			tile_index_shader_prog_ = ose::make_unique<shader::TileIndexShaderProgGLSL>();
+			tile_index_shader_prog_->CreateShaderProg();
+		}
+		if(tile_index_shader_prog_->GetShaderProgId() == 0)
+		{
+			LOG_ERROR("Failed to add tile renderer, the tile index shader could not be built");
+			return;
+		}
+
+		MaterialGroupGL * material_group { GetMaterialGroup(render_passes_[0], tile_index_shader_prog_.get(), tr->GetMaterial()->GetBlendMode()) };
+		if(!material_group)
+			return;
+
+		uint32_t object_id { NextComponentId() };
+		TileRendererGL & tile_renderer { tile_renderers_[object_id] };
+		tile_renderer.tile_renderer_ = tr;
+		UploadTileIndexTexture(tile_renderer);
+
+		// Create a VAO for the render group, the quad vertex data is shared with the sprite render groups
+		GLuint vao;
+		glGenVertexArrays(1, &vao);
+		glBindVertexArray(vao);
+		glBindBuffer(GL_ARRAY_BUFFER, sprite_quad_vbo_);
+		// TODO - Vertex attrib locations are to be controlled by the built shader program
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (GLvoid*)(2 * sizeof(float)));
+
+		GLuint instance_vbo;
+		glGenBuffers(1, &instance_vbo);
+		SetTileIndexInstanceAttribs(instance_vbo);
+
+		// Unbind the vao
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		// The tileset and the index texture are both texture arrays s.t. the render group has a single texture target
+		material_group->render_groups_.emplace_back(
+			std::initializer_list<uint32_t>{ object_id },
+			ERenderObjectType::TILE_INDEX_RENDERER,
+			sprite_quad_vbo_, vao,
+			GL_TRIANGLE_STRIP, 0, 4,
+			std::initializer_list<GLuint>{ tex_id, tile_renderer.index_texture_ }
+		);
+		RenderGroupGL & render_group { material_group->render_groups_.back() };
+		render_group.instance_vbo_ = instance_vbo;
+		render_group.texture_stride_ = 2;
+		render_group.texture_target_ = GL_TEXTURE_2D_ARRAY;
+
+		// The quad covers the whole tile grid, scaled by the texture size in the shader as with chunked tile renderers
+		float tile_width  { 1.0f / tr->GetNumCols() };
+		float tile_height { 1.0f / tr->GetNumRows() };
+		glm::vec2 grid_size { (tilemap.GetWidth() - 1) * tile_width * tr->GetSpacingX() + tile_width,
+			(tilemap.GetHeight() - 1) * tile_height * tr->GetSpacingY() + tile_height };
+		glm::vec2 size { grid_size * glm::vec2(tr->GetTexture()->GetWidth(), tr->GetTexture()->GetHeight()) };
+
+		size_t instance { render_group.AddInstance(t, AABB{ glm::vec3(0.0f), glm::vec3(size, 0.0f) }) };
+		render_group.SetSpriteInstanceData(instance, size, region.uv_rect_, static_cast<float>(region.layer_));
+		render_group.SetTileIndexInstanceData(instance, glm::vec2(tr->GetNumCols(), tr->GetNumRows()),
+			glm::vec2(tr->GetSpacingX(), tr->GetSpacingY()));
+
+		tr->SetEngineData(object_id);
+		instance_index_dirty_ = true;
+	}
+
+	// Upload every tile value of a tile renderer to its index texture, creating the texture if required
+	void RenderPoolGL::UploadTileIndexTexture(TileRendererGL & tile_renderer)
+	{
+		TileRenderer const & tr { *tile_renderer.tile_renderer_ };
+		auto const & tilemap = *tr.GetTilemap();
+		int32_t width  { tilemap.GetWidth() };
+		int32_t height { tilemap.GetHeight() };
+		tile_renderer.tilemap_revision_ = tilemap.GetRevision();
+		if(width <= 0 || height <= 0)
+			return;
+
+		// Values which are not in the tileset are uploaded as -1 s.t. the shader doesn't have to know the number of tiles
+		std::vector<int32_t> indices(static_cast<size_t>(width) * height);
+		for(int32_t row = 0; row < height; ++row)
+		{
+			for(int32_t col = 0; col < width; ++col)
+			{
+				int32_t value { tilemap(col, row) };
+				indices[col + static_cast<size_t>(row) * width] = value >= 0 && value < tr.GetNumTiles() ? value : -1;
+			}
+		}
+
+		// The indices are a single layer texture array s.t. they share a texture target with the tileset
+		if(tile_renderer.index_texture_ == 0)
+			glGenTextures(1, &tile_renderer.index_texture_);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, tile_renderer.index_texture_);
+		if(width != tile_renderer.index_width_ || height != tile_renderer.index_height_)
+		{
+			// Integer textures can only be sampled with nearest filtering
+			glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R32I, width, height, 1, 0, GL_RED_INTEGER, GL_INT, indices.data());
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+			tile_renderer.index_width_ = width;
+			tile_renderer.index_height_ = height;
+		}
+		else
+		{
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, width, height, 1, GL_RED_INTEGER, GL_INT, indices.data());
+		}
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	}
+
+	// Upload only the edited tile values of a tile renderer to its index texture
+	void RenderPoolGL::UploadTileIndexEdits(TileRendererGL const & tile_renderer, std::vector<TileEdit> const & edits)
+	{
+		TileRenderer const & tr { *tile_renderer.tile_renderer_ };
+		auto const & tilemap = *tr.GetTilemap();
+
+		// Each edit is a single texel upload
+		glBindTexture(GL_TEXTURE_2D_ARRAY, tile_renderer.index_texture_);
+		for(TileEdit const & edit : edits)
+		{
+			if(edit.col_ >= tile_renderer.index_width_ || edit.row_ >= tile_renderer.index_height_)
+				continue;
+			int32_t value { tilemap(edit.col_, edit.row_) };
+			value = value >= 0 && value < tr.GetNumTiles() ? value : -1;
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, edit.col_, edit.row_, 0, 1, 1, 1, GL_RED_INTEGER, GL_INT, &value);
+		}
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	}
+
+	// Set the per-instance vertex attributes of a mesh render group on the currently bound VAO
+	void RenderPoolGL::SetMeshInstanceAttribs(GLuint instance_vbo)
+	{
+		GLsizei stride { RenderGroupGL::MESH_INSTANCE_STRIDE * sizeof(float) };
+		glBindBuffer(GL_ARRAY_BUFFER, instance_vbo);
+		// World transform, one attribute per column
+		for(GLuint c = 0; c < 4; ++c)
+		{
+			glEnableVertexAttribArray(4 + c);
+			glVertexAttribPointer(4 + c, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(4 * c * sizeof(float)));
+			glVertexAttribDivisor(4 + c, 1);
+		}
+		// Normal matrix, one attribute per column
+		for(GLuint c = 0; c < 3; ++c)
+		{
+			glEnableVertexAttribArray(8 + c);
+			glVertexAttribPointer(8 + c, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid*)((16 + 3 * c) * sizeof(float)));
+			glVertexAttribDivisor(8 + c, 1);
+		}
+	}
+
+	// Set the vertex attributes of a mesh vertex buffer (and its index buffer) on the currently bound VAO
+	// Full vertices are 11 floats, compact vertices are a float position, 10:10:10:2 normal, half float uv and 10:10:10:2 tangent
+	void RenderPoolGL::SetMeshVertexAttribs(GLuint vbo, GLuint ibo, bool compact)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+		// TODO - Vertex attrib locations are to be controlled by the built shader program
+		if(compact)
+		{
+			// The packed attributes are unpacked by the vertex fetch, so shaders read them as ordinary floats
+			glEnableVertexAttribArray(0);
+			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, COMPACT_VERTEX_SIZE, 0);
+			glEnableVertexAttribArray(1);
+			glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, COMPACT_VERTEX_SIZE, (GLvoid*)(12));
+			glEnableVertexAttribArray(2);
+			glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, COMPACT_VERTEX_SIZE, (GLvoid*)(16));
+			glEnableVertexAttribArray(3);
+			glVertexAttribPointer(3, 4, GL_INT_2_10_10_10_REV, GL_TRUE, COMPACT_VERTEX_SIZE, (GLvoid*)(20));
+			return;
+		}
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), 0);
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (GLvoid*)(3 * sizeof(float)));
+		glEnableVertexAttribArray(2);
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (GLvoid*)(6 * sizeof(float)));
+		glEnableVertexAttribArray(3);
+		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 11 * sizeof(float), (GLvoid*)(8 * sizeof(float)));
+	}
+
+	// Get the GPU buffers of a mesh, creating them if the mesh is not yet referenced by any mesh renderer
+	// Each call adds a reference which must be released with ReleaseMeshBuffer
+	RenderPoolGL::MeshBufferGL const & RenderPoolGL::AcquireMeshBuffer(Mesh const * mesh)
+	{
+		MeshBufferGL & mesh_buffer { mesh_buffers_[mesh] };
+		++mesh_buffer.ref_count_;
+		if(mesh_buffer.vbo_ != 0)
+			return mesh_buffer;
+
+		// Create a VBO for the mesh
+		// The storage is allocated now but the vertex data is interleaved and uploaded by the upload queue
+		// The mesh is not drawn until both buffers have been uploaded, the uploads are cancelled if the buffers are released first
+		glGenBuffers(1, &mesh_buffer.vbo_);
+		mesh_buffer.compact_ = mesh->GetMetaData().compact_vertices_;
+		// Data consists of the vertex data is given in the mesh object
+		// TODO - Include tangent, bitangent and any other required data
+		size_t vbo_size { (mesh->GetPositionData().size() + mesh->GetNormalData().size() + mesh->GetTexCoordData().size() + mesh->GetTangentData().size()) * sizeof(float) };
+		if(mesh_buffer.compact_)
+			vbo_size = mesh->GetPositionData().size() / 3 * COMPACT_VERTEX_SIZE;
+		glBindBuffer(GL_ARRAY_BUFFER, mesh_buffer.vbo_);
+		glBufferData(GL_ARRAY_BUFFER, vbo_size, nullptr, GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		if(mesh_buffer.compact_)
+		{
+			UploadQueueGL::QueueBuffer(mesh_buffer.vbo_, vbo_size, [mesh, vbo_size](uint8_t * dst) {
+				// Vertices missing any attribute are left zeroed
+				std::memset(dst, 0, vbo_size);
+				auto const & positions { mesh->GetPositionData() };
+				auto const & normals { mesh->GetNormalData() };
+				auto const & tex_coords { mesh->GetTexCoordData() };
+				auto const & tangents { mesh->GetTangentData() };
+				for(size_t v = 0; v * 3 < positions.size() && v * 3 < normals.size() && v * 2 < tex_coords.size() && v * 3 < tangents.size(); ++v)
+				{
+					uint8_t * vertex { dst + v * COMPACT_VERTEX_SIZE };
+					uint32_t normal { glm::packSnorm3x10_1x2(glm::vec4 { normals[v * 3 + 0], normals[v * 3 + 1], normals[v * 3 + 2], 0.0f }) };
+					uint32_t tex_coord { glm::packHalf2x16(glm::vec2 { tex_coords[v * 2 + 0], tex_coords[v * 2 + 1] }) };
+					uint32_t tangent { glm::packSnorm3x10_1x2(glm::vec4 { tangents[v * 3 + 0], tangents[v * 3 + 1], tangents[v * 3 + 2], 0.0f }) };
+					std::memcpy(vertex + 0, &positions[v * 3], 3 * sizeof(float));
+					std::memcpy(vertex + 12, &normal, sizeof(normal));
+					std::memcpy(vertex + 16, &tex_coord, sizeof(tex_coord));
+					std::memcpy(vertex + 20, &tangent, sizeof(tangent));
+				}
+			});
+		}
+		else
+		{
+			UploadQueueGL::QueueBuffer(mesh_buffer.vbo_, vbo_size, [mesh, vbo_size](uint8_t * dst) {
+				float * data { reinterpret_cast<float *>(dst) };
+				// Vertices missing any attribute are left zeroed
+				std::memset(dst, 0, vbo_size);
+				for(size_t p = 0, n = 0, t = 0, tan = 0; p < mesh->GetPositionData().size() && n < mesh->GetNormalData().size()
+					&& t < mesh->GetTexCoordData().size() && tan < mesh->GetTangentData().size(); p += 3, n += 3, t += 2, tan += 3)
+				{
+					data[p + n + t + tan + 0] = mesh->GetPositionData()[p + 0];
+					data[p + n + t + tan + 1] = mesh->GetPositionData()[p + 1];
+					data[p + n + t + tan + 2] = mesh->GetPositionData()[p + 2];
+
+					data[p + n + t + tan + 3] = mesh->GetNormalData()[n + 0];
+					data[p + n + t + tan + 4] = mesh->GetNormalData()[n + 1];
+					data[p + n + t + tan + 5] = mesh->GetNormalData()[n + 2];
+
+					data[p + n + t + tan + 6] = mesh->GetTexCoordData()[t + 0];
+					data[p + n + t + tan + 7] = mesh->GetTexCoordData()[t + 1];
+
+					data[p + n + t + tan + 8] = mesh->GetTangentData()[tan + 0];
+					data[p + n + t + tan + 9] = mesh->GetTangentData()[tan + 1];
+					data[p + n + t + tan + 10] = mesh->GetTangentData()[tan + 2];
+				}
+			});
+		}
+
+		// Create an IBO for the mesh
+		glGenBuffers(1, &mesh_buffer.ibo_);
+		// Data consists of indices to vertices, where 3 consecutive indices make up a triangle
+		size_t num_indices { 0 };
+		for(MeshSection const & section : mesh->GetSections())
+			num_indices += section.GetFaceIndices().size();
+
+		// The levels of detail follow the full detail mesh s.t. every level is drawn from the same buffers
+		if(!mesh->GetLods().empty())
+		{
+			mesh_buffer.lods_.push_back({ 0, static_cast<GLint>(num_indices), 0.0f });
+			GLint first_index { static_cast<GLint>(num_indices) };
+			for(MeshLod const & lod : mesh->GetLods())
+			{
+				mesh_buffer.lods_.push_back({ first_index, static_cast<GLint>(lod.indices_.size()), lod.error_ });
+				first_index += static_cast<GLint>(lod.indices_.size());
+			}
+		}
+		size_t total_indices { mesh_buffer.lods_.empty() ? num_indices : static_cast<size_t>(mesh_buffer.lods_.back().first_index_ + mesh_buffer.lods_.back().count_) };
+		size_t ibo_size { total_indices * sizeof(unsigned int) };
+		// NOTE - The element array binding is VAO state, so no VAO may be bound while the IBO is allocated
+		glBindVertexArray(0);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh_buffer.ibo_);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, ibo_size, nullptr, GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		UploadQueueGL::QueueBuffer(mesh_buffer.ibo_, ibo_size, [mesh](uint8_t * dst) {
+			unsigned int * indices { reinterpret_cast<unsigned int *>(dst) };
+			for(MeshSection const & section : mesh->GetSections())
+				indices = std::copy(section.GetFaceIndices().begin(), section.GetFaceIndices().end(), indices);
+			for(MeshLod const & lod : mesh->GetLods())
+				indices = std::copy(lod.indices_.begin(), lod.indices_.end(), indices);
+		});
+		mesh_buffer.count_ = static_cast<GLint>(num_indices);
+		mesh_buffer.bounds_ = AABB::FromPositions(mesh->GetPositionData());
+
+		return mesh_buffer;
+	}
+
+	// Release a reference to the GPU buffers of a mesh, the buffers are deleted once no mesh renderers reference them
+	void RenderPoolGL::ReleaseMeshBuffer(Mesh const * mesh)
+	{
+		auto iter { mesh_buffers_.find(mesh) };
+		if(iter == mesh_buffers_.end())
+			return;
+		if(--iter->second.ref_count_ > 0)
+			return;
+		UploadQueueGL::CancelBuffer(iter->second.vbo_);
+		UploadQueueGL::CancelBuffer(iter->second.ibo_);
+		glDeleteBuffers(1, &iter->second.vbo_);
+		glDeleteBuffers(1, &iter->second.ibo_);
+		mesh_buffers_.erase(iter);
+	}
+
+	// Get the texture array a sprite/tile texture is rendered from, along with the texture's region within the array
+	// Textures which are not part of an atlas (too large for an atlas layer, or loaded after the scene was activated)
+	// are given their own single layer texture array
+	// Returns 0 if no texture array could be created
+	GLuint RenderPoolGL::GetSpriteTextureArray(Texture const * texture, TextureAtlasRegion & region)
+	{
+		// Use the atlas the texture was packed into by the resource manager
+		TextureAtlasGL const * atlas { dynamic_cast<TextureAtlasGL const *>(texture->GetAtlas()) };
+		if(atlas)
+		{
+			region = texture->GetAtlasRegion();
+			return atlas->GetGlTexId();
+		}
+
+		// Otherwise, find or create a texture array containing only the texture
+		auto iter { texture_arrays_.find(texture) };
+		if(iter == texture_arrays_.end())
+		{
+			uptr<TextureAtlasGL> texture_array { ose::make_unique<TextureAtlasGL>(texture->GetWidth(), texture->GetHeight(), 0) };
+			if(!texture_array->AddTexture(texture))
+				return 0;
+			texture_array->Pack();
+			texture_array->CreateTextureAtlas();
+			iter = texture_arrays_.emplace(texture, std::move(texture_array)).first;
+		}
+
+		region = *iter->second->GetRegion(texture);
+		return iter->second->GetGlTexId();
+	}
+
+	// Rebuild the map from entity transforms to the render objects which use them
+	void RenderPoolGL::RebuildInstanceIndex()
+	{
+		instance_index_.clear();
+
+		for(uint32_t p = 0; p < render_passes_.size(); ++p)
+		{
+			auto const & render_pass { render_passes_[p] };
+			for(uint32_t m = 0; m < render_pass.material_groups_.size(); ++m)
+			{
+				auto const & material_group { render_pass.material_groups_[m] };
+				for(uint32_t r = 0; r < material_group.render_groups_.size(); ++r)
+				{
+					auto const & render_group { material_group.render_groups_[r] };
+					for(uint32_t i = 0; i < render_group.transforms_.size(); ++i)
+						instance_index_[render_group.transforms_[i]].push_back({ render_group.type_, p, m, r, i });
+				}
+			}
+		}
+
+		for(uint32_t l = 0; l < point_light_transforms_.size(); ++l)
+			instance_index_[point_light_transforms_[l]].push_back({ ERenderObjectType::POINT_LIGHT, 0, 0, 0, l });
+
+		for(uint32_t l = 0; l < dir_light_transforms_.size(); ++l)
+			instance_index_[dir_light_transforms_[l]].push_back({ ERenderObjectType::DIR_LIGHT, 0, 0, 0, l });
+
+		instance_index_dirty_ = false;
+	}
+
+	// Get a material group to render the given material in
+	// If no suitable material group exists, a new group is created
+	MaterialGroupGL * RenderPoolGL::GetMaterialGroup(RenderPassGL & render_pass, Material const * material)
+	{
+		shader::ShaderProgGLSL const * shader_prog = dynamic_cast<shader::ShaderProgGLSL const *>(material->GetShaderProg());
+		if(!shader_prog)
+		{
+			LOG_ERROR("Failed to find a suitable shader group, material shader is not of type ShaderProgGLSL");
+			return nullptr;
+		}
+
+		return GetMaterialGroup(render_pass, shader_prog, material->GetBlendMode(), material->GetShaderFeatures());
+	}
+
+	// Get a material group to render with the given shader program, blend mode and shader features
+	// If no suitable material group exists, a new group is created
+	MaterialGroupGL * RenderPoolGL::GetMaterialGroup(RenderPassGL & render_pass, shader::ShaderProgGLSL const * shader_prog, EBlendMode blend_mode, uint32_t shader_features)
+	{
+		// Returns true if a material group's blending setup matches an EBlendMode object
+		auto is_blending_correct = [](EBlendMode mode, MaterialGroupGL const & group) -> bool {
+			if(mode == EBlendMode::OPAQUE && group.enable_blend_ == false)
+				return true;
+			if(mode == EBlendMode::ONE_MINUS_SRC_ALPHA && group.enable_blend_ == true && group.blend_func_ == GL_ONE_MINUS_SRC_ALPHA)
+				return true;
+			return false;
+		};
+
+		// Try to find a material group to add the render object to
+		MaterialGroupGL * material_group { nullptr };
+		for(auto & s : render_pass.material_groups_)
+		{
+			if(shader_prog == s.shader_ && shader_features == s.shader_features_ && is_blending_correct(blend_mode, s))
+				material_group = &s;
+		}
+
+		// If no usable shader group exists, create a new one
+		if(!material_group)
+		{
+			MaterialGroupGL mg;
+			mg.enable_blend_ = blend_mode == EBlendMode::OPAQUE ? false : true;
+			mg.blend_fac_ = GL_SRC_ALPHA;
+			mg.blend_func_ = GL_ONE_MINUS_SRC_ALPHA;
+			mg.shader_prog_ = shader_prog->GetShaderProgId();
+			mg.gbuffer_shader_prog_ = shader_prog->GetGBufferShaderProgId();
+			mg.uniforms_ = shader_prog->GetUniforms();
+			mg.shader_ = shader_prog;
+			mg.shader_features_ = shader_features;
+
+			// The group is drawn with the default program until its variant has been built, see UpdateShaderVariants
+			// The shader compiler's thread writes the variant's programs before setting ready_, so they are only read once it is set
+			mg.pending_variant_ = shader_prog->GetVariant(shader_features);
+			if(mg.pending_variant_ && mg.pending_variant_->ready_.load(std::memory_order_acquire))
+			{
+				if(mg.pending_variant_->prog_)
+				{
+					mg.shader_prog_ = mg.pending_variant_->prog_;
+					mg.gbuffer_shader_prog_ = mg.pending_variant_->gbuffer_prog_;
+					mg.uniforms_ = mg.pending_variant_->uniforms_;
+				}
+				mg.pending_variant_ = nullptr;
+			}
+
+			// Draw order is determined by the rendering engine's draw list (opaque before blended), so groups are simply appended
+			render_pass.material_groups_.push_back(mg);
+			material_group = &render_pass.material_groups_.back();
 		}
 
 		return material_group;
@@ -6,10 +6,19 @@
 #include "OSE-Core/Math/Transform.h"
 #include "Lights/PointLightData.h"
 #include "Lights/DirLightData.h"
+#include "TextureAtlasGL.h"
+#include "TextureStreamerGL.h"
+#include "OSE-Core/Rendering/EBlendMode.h"
+#include "OSE-Core/Shader/EShaderFeature.h"
 
 namespace ose
 {
 	class Material;
+	class Mesh;
+	class Texture;
+	class Frustum;
+	struct TextureAtlasRegion;
+	struct TileEdit;
 }
 
 namespace ose::shader
@@ -17,6 +26,8 @@ namespace ose::shader
 	class BRDFShaderProgGLSL;
 	class Default2DShaderProgGLSL;
 	class Default3DShaderProgGLSL;
+	class TileIndexShaderProgGLSL;
+	class ShaderProgGLSL;
 }
 
 namespace ose::rendering
@@ -42,6 +53,10 @@ namespace ose::rendering
 		// Add a mesh renderer component to the render pool
 		void AddMeshRenderer(ose::ITransform const & t, MeshRenderer * mr) override;
 
+		// Add a mesh renderer component of a static entity to the render pool
+		// Static mesh renderers sharing a material are merged into batches before the next frame is drawn
+		void AddStaticMeshRenderer(ITransform const & t, MeshRenderer * mr) override;
+
 		// Add a point light component to the render pool
 		void AddPointLight(ITransform const & t, PointLight * pl) override;
 
@@ -63,6 +78,39 @@ namespace ose::rendering
 		// Remove a direction light component from the render pool
 		void RemoveDirLight(DirLight * dl) override;
 
+		// Update the render objects of all entities whose global transform changed this frame
+		void ApplyTransformChanges(TransformChangeList const & changes) override;
+
+		// Build the tile chunks which are near the view frustum and evict those which are far outside of it
+		// Chunks affected by tilemap edits since the last update are rebuilt, index textures are patched texel by texel
+		void UpdateTileChunks(Frustum const & frustum);
+
+		// Merge the static mesh renderers added since the last update into the batches of their grid cells
+		// Cells whose mesh renderers have been added or removed are rebuilt, each cell is a single draw per material
+		void UpdateStaticBatches(float cell_size);
+
+		// Choose the level of detail of each mesh instance from the size of its bounds on screen
+		// Levels are chosen s.t. their error covers no more than screen_error pixels, with a margin before moving to a coarser level
+		void UpdateMeshLods(glm::mat4 const & view_proj, float pixels_per_unit, float screen_error);
+
+		// Upload the changed range of each render group's instance data to its instance buffer
+		// Must be called on the render thread before the render passes are drawn
+		void UpdateInstanceBuffers();
+
+		// Switch each material group whose shader variant has finished building from the default program to the variant
+		// Must be called on the render thread before the draw list is built
+		void UpdateShaderVariants();
+
+		// Width and height (in tiles) of the chunks tile renderers are split into
+		static constexpr int32_t TILE_CHUNK_SIZE { 32 };
+
+		// Size (in bytes) of a vertex of a mesh imported with compact vertices
+		static constexpr GLsizei COMPACT_VERTEX_SIZE { 24 };
+
+		// Get the G-buffer of the deferred render path, the G-buffer is created the first time it is requested
+		// Returns nullptr if the framebuffer size is not yet known
+		FramebufferGL const * GetGBuffer();
+
 		// Get the list of render passes s.t. they can be rendered by the rendering engine
 		std::vector<RenderPassGL> const & GetRenderPasses() const { return render_passes_; }
 
@@ -72,12 +120,166 @@ namespace ose::rendering
 		// Get the list of direction lights s.t. they can be rendered by the rendering engine
 		std::vector<DirLightData> const & GetDirLights() const { return dir_lights_; }
 
+		// Get the streamer of the textures used by mesh renderers
+		TextureStreamerGL & GetTextureStreamer() { return texture_streamer_; }
+
+		// A mesh renderer whose mesh is rasterized into the occlusion buffer each frame
+		struct OccluderGL
+		{
+			uint32_t component_id_;
+			ITransform const * transform_;
+			Mesh const * mesh_;
+
+			// Bounds of the mesh, used to skip occluders outside the view frustum
+			AABB local_bounds_;
+
+			// Indices of every section of the mesh, s.t. the mesh is rasterized in one call
+			std::vector<unsigned int> indices_;
+		};
+
+		// Get the list of occluders s.t. the rendering engine can rasterize them
+		std::vector<OccluderGL> const & GetOccluders() const { return occluders_; }
+
 	private:
+		// GPU buffers of a mesh, shared by every render group which renders the mesh
+		struct MeshBufferGL
+		{
+			GLuint vbo_ { 0 };
+			GLuint ibo_ { 0 };
+			GLint count_ { 0 };
+
+			// True iff the VBO holds compact (24 byte) vertices, see SetMeshVertexAttribs
+			bool compact_ { false };
+
+			// Bounds of the mesh's vertex positions
+			AABB bounds_;
+
+			// Ranges of the mesh's levels of detail within the IBO, which holds every level after the full detail mesh
+			std::vector<RenderGroupGL::LodGL> lods_;
+
+			// Number of mesh renderers using the buffers
+			uint32_t ref_count_ { 0 };
+		};
+
+		// A static mesh renderer, pre-transformed into world space when its cell is built
+		struct StaticMeshGL
+		{
+			uint32_t component_id_;
+			Mesh const * mesh_;
+			Material const * material_;
+
+			// Global transform and world space bounds of the mesh renderer when it was added
+			glm::mat4 world_;
+			AABB world_bounds_;
+		};
+
+		// Cell of the static batching grid, holding the static mesh renderers of one material whose bounds are centred in the cell
+		// The cell's meshes are merged into one buffer s.t. the cell is drawn and culled as a single instance
+		struct StaticCellGL
+		{
+			Material const * material_;
+			glm::ivec3 cell_;
+			std::vector<StaticMeshGL> meshes_;
+
+			// Component id of the cell's render group
+			uint32_t component_id_;
+
+			// Merged buffers of the cell, 0 if the cell has not been built
+			GLuint vbo_ { 0 };
+			GLuint ibo_ { 0 };
+
+			// True iff meshes have been added or removed since the cell was built
+			bool dirty_ { true };
+		};
+
 		// Get a material group to render the given material in
 		// If no suitable material group exists, a new group is created
 		MaterialGroupGL * GetMaterialGroup(RenderPassGL & render_pass, Material const * material);
 
+		// Get a material group to render with the given shader program, blend mode and shader features
+		// If no suitable material group exists, a new group is created
+		MaterialGroupGL * GetMaterialGroup(RenderPassGL & render_pass, shader::ShaderProgGLSL const * shader_prog, EBlendMode blend_mode,
+			uint32_t shader_features = SHADER_FEATURE_DEFAULT);
+
+		// Rebuild the map from entity transforms to the render objects which use them
+		void RebuildInstanceIndex();
+
+		// Set the per-instance vertex attributes of a sprite/tile render group on the currently bound VAO
+		// stride is the number of floats per instance, larger for instance layouts which extend the sprite layout
+		static void SetSpriteInstanceAttribs(GLuint instance_vbo, GLsizei stride = RenderGroupGL::SPRITE_INSTANCE_STRIDE);
+
+		// Set the per-instance vertex attributes of an index texture tile render group on the currently bound VAO
+		static void SetTileIndexInstanceAttribs(GLuint instance_vbo);
+
+		// Set the per-instance vertex attributes of a mesh render group on the currently bound VAO
+		static void SetMeshInstanceAttribs(GLuint instance_vbo);
+
+		// Get the GPU buffers of a mesh, creating them if the mesh is not yet referenced by any mesh renderer
+		// Each call adds a reference which must be released with ReleaseMeshBuffer
+		MeshBufferGL const & AcquireMeshBuffer(Mesh const * mesh);
+
+		// Release a reference to the GPU buffers of a mesh, the buffers are deleted once no mesh renderers reference them
+		void ReleaseMeshBuffer(Mesh const * mesh);
+
+		// Set the vertex attributes of a mesh vertex buffer (and its index buffer) on the currently bound VAO
+		// Full vertices are 11 floats, compact vertices are a float position, 10:10:10:2 normal, half float uv and 10:10:10:2 tangent
+		static void SetMeshVertexAttribs(GLuint vbo, GLuint ibo, bool compact);
+
+		// Merge the meshes of a static batch cell into a single world space vertex and index buffer, and add the cell's render group
+		void BuildStaticCell(StaticCellGL & cell);
+
+		// Remove the render group of a static batch cell and delete the cell's buffers
+		void DestroyStaticCell(StaticCellGL & cell);
+
+		// Get the local space bounds of a tile chunk
+		static AABB GetTileChunkBounds(TileRenderer const & tr, int32_t chunk_x, int32_t chunk_y);
+
+		// Build (or rebuild) the vertex data of a tile chunk from its tilemap
+		static void BuildTileChunk(RenderGroupGL & render_group, TileRenderer const & tr);
+
+		// Free the buffers of a tile chunk, the chunk is not drawn until it is built again
+		static void EvictTileChunk(RenderGroupGL & render_group);
+
+		// Add a tile renderer which is drawn as a single quad whose tiles are looked up in an index texture
+		void AddTileIndexRenderer(ITransform const & t, TileRenderer * tr, GLuint tex_id, TextureAtlasRegion const & region);
+
+		// Get the texture array a sprite/tile texture is rendered from, along with the texture's region within the array
+		// Textures which are not part of an atlas (too large for an atlas layer, or loaded after the scene was activated)
+		// are given their own single layer texture array
+		// Returns 0 if no texture array could be created
+		GLuint GetSpriteTextureArray(Texture const * texture, TextureAtlasRegion & region);
+
 	private:
+		// Streaming state of a tile renderer, whose chunks are render groups sharing the tile renderer's component id
+		struct TileRendererGL
+		{
+			TileRenderer const * tile_renderer_ { nullptr };
+
+			// Revision of the tilemap when its edits were last applied
+			uint32_t tilemap_revision_ { 0 };
+
+			// Whether each chunk has buffers, and whether each chunk has edits which have not been uploaded
+			std::vector<uint8_t> chunk_built_;
+			std::vector<uint8_t> chunk_stale_;
+
+			int32_t num_chunks_x_ { 0 };
+
+			// Integer texture of tile values, only used by tile renderers in ETileRenderMode::INDEX_TEXTURE mode
+			GLuint index_texture_ { 0 };
+			int32_t index_width_ { 0 };
+			int32_t index_height_ { 0 };
+		};
+
+		// Location of a single instance (or light) within the render pool
+		struct InstanceLocation
+		{
+			ERenderObjectType type_;
+			uint32_t pass_;
+			uint32_t material_group_;
+			uint32_t render_group_;
+			uint32_t instance_;
+		};
+
 		// List of all render passes the render pool is to perform on each rendering engine update
 		std::vector<RenderPassGL> render_passes_;
 
@@ -87,16 +289,73 @@ namespace ose::rendering
 		// List of all dynamic direction lights
 		std::vector<DirLightData> dir_lights_;
 
+		// Global transforms of the entities owning each point light and direction light
+		std::vector<ITransform const *> point_light_transforms_;
+		std::vector<ITransform const *> dir_light_transforms_;
+
+		// Mesh renderers which were added as occluders
+		std::vector<OccluderGL> occluders_;
+
+		// Component ids of each point light and direction light, used to find a light when it is removed
+		std::vector<uint32_t> point_light_ids_;
+		std::vector<uint32_t> dir_light_ids_;
+
+		// Map from entity global transform to every instance using it
+		// Rebuilt lazily since adding or removing render objects can move existing instances
+		std::unordered_map<ITransform const *, std::vector<InstanceLocation>> instance_index_;
+		bool instance_index_dirty_ { true };
+
+		// Unit quad vertex buffer shared by all sprite render groups
+		GLuint sprite_quad_vbo_ { 0 };
+
+		// Map from tile renderer component id to the tile renderer's streaming state
+		std::unordered_map<uint32_t, TileRendererGL> tile_renderers_;
+
+		// Map from mesh to the GPU buffers created for it
+		std::unordered_map<Mesh const *, MeshBufferGL> mesh_buffers_;
+
+		// Single layer texture arrays created for sprite/tile textures which are not part of an atlas
+		std::unordered_map<Texture const *, uptr<TextureAtlasGL>> texture_arrays_;
+
+		// Streams the mip levels of the textures used by mesh render groups
+		// Sprite and tile textures are packed into texture arrays which are always fully resident
+		TextureStreamerGL texture_streamer_;
+
+		// Upload every tile value of a tile renderer to its index texture, creating the texture if required
+		static void UploadTileIndexTexture(TileRendererGL & tile_renderer);
+
+		// Upload only the edited tile values of a tile renderer to its index texture
+		static void UploadTileIndexEdits(TileRendererGL const & tile_renderer, std::vector<TileEdit> const & edits);
+
 		// Dummy transform used by deferred shaders
 		Transform deferred_shader_transform_;
 
+		// Static mesh renderers which have not yet been assigned to a cell
+		std::vector<StaticMeshGL> pending_static_meshes_;
+
+		// Cells of the static batching grid, only cells containing static mesh renderers exist
+		std::vector<StaticCellGL> static_cells_;
+
+		// True iff any cell is dirty or any static mesh renderer is pending
+		bool static_batches_dirty_ { false };
+
+		// Identity transform of the static batch render groups, whose vertices are already in world space
+		Transform static_batch_transform_;
+
 		// Default shader programs
 		uptr<shader::BRDFShaderProgGLSL> brdf_shader_prog_;
 		uptr<shader::Default2DShaderProgGLSL> default_2d_shader_prog_;
 		uptr<shader::Default3DShaderProgGLSL> default_3d_shader_prog_;
 
-		// List of all active framebuffer objects used for deferred rendering
-		std::vector<FramebufferGL> framebuffers_;
+		// Shader program of index texture tile renderers, created when the first one is added
+		uptr<shader::TileIndexShaderProgGLSL> tile_index_shader_prog_;
+
+		// G-buffer of the deferred render path, only created once the deferred render path is used
+		uptr<FramebufferGL> gbuffer_;
+
+		// Size of the window framebuffer, which the G-buffer matches
+		int fb_width_ { 0 };
+		int fb_height_ { 0 };
 
 		// Returns the next available object id
 		static uint32_t NextComponentId()
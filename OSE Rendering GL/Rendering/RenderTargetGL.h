@@ -0,0 +1,110 @@
+#pragma once
+#include "OSE-Core/Rendering/ERenderTargetFormat.h"
+
+namespace ose::rendering
+{
+	// Offscreen colour and depth target the scene is rendered to before being drawn to the window
+	// The colour texture is filtered linearly s.t. it can be sampled at a different resolution
+	// Layout: colour (rgba8 or rgba16f) texture, optional depth (24 bit) + stencil (8 bit) renderbuffer matching the G-buffer,
+	// s.t. depth can be blitted between them
+	class RenderTargetGL
+	{
+	public:
+		RenderTargetGL(int width, int height, ERenderTargetFormat format = ERenderTargetFormat::RGBA8, bool depth = true)
+			: width_(width), height_(height), format_(format)
+		{
+			if(width <= 0 || height <= 0)
+				throw std::invalid_argument("Render target width/height out of bounds");
+
+			// Create the fbo
+			glGenFramebuffers(1, &fbo_);
+			glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+
+			// Create the colour attachment
+			glGenTextures(1, &colour_texture_);
+			glBindTexture(GL_TEXTURE_2D, colour_texture_);
+			AllocateColour();
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colour_texture_, 0);
+
+			// Create the rbo for storing rendering depth info
+			if(depth)
+			{
+				glGenRenderbuffers(1, &depth_rbo_);
+				glBindRenderbuffer(GL_RENDERBUFFER, depth_rbo_);
+				glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+				glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depth_rbo_);
+				glBindRenderbuffer(GL_RENDERBUFFER, 0);
+			}
+
+			// Check the framebuffer was created successfully
+			if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+				LOG_ERROR("Render target framebuffer creation - FAILURE -", glGetError());
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		}
+
+		// The render target owns its OpenGL objects so cannot be copied
+		RenderTargetGL(RenderTargetGL const &) = delete;
+		RenderTargetGL & operator=(RenderTargetGL const &) = delete;
+
+		~RenderTargetGL()
+		{
+			if(fbo_)
+				glDeleteFramebuffers(1, &fbo_);
+			if(colour_texture_)
+				glDeleteTextures(1, &colour_texture_);
+			if(depth_rbo_)
+				glDeleteRenderbuffers(1, &depth_rbo_);
+		}
+
+		void Resize(int width, int height)
+		{
+			width_ = width;
+			height_ = height;
+			glBindTexture(GL_TEXTURE_2D, colour_texture_);
+			AllocateColour();
+			if(depth_rbo_)
+			{
+				glBindRenderbuffer(GL_RENDERBUFFER, depth_rbo_);
+				glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+				glBindRenderbuffer(GL_RENDERBUFFER, 0);
+			}
+		}
+
+		GLuint GetFbo() const { return fbo_; }
+		GLuint GetColourTexture() const { return colour_texture_; }
+		GLuint GetDepthRbo() const { return depth_rbo_; }
+
+		int GetWidth() const { return width_; }
+		int GetHeight() const { return height_; }
+		ERenderTargetFormat GetFormat() const { return format_; }
+		bool HasDepth() const { return depth_rbo_ != 0; }
+
+		// Get the number of bytes of GPU memory used by the target's attachments
+		size_t GetMemorySize() const
+		{
+			size_t colour_bytes { format_ == ERenderTargetFormat::RGBA16F ? 8u : 4u };
+			return static_cast<size_t>(width_) * height_ * (colour_bytes + (depth_rbo_ ? 4 : 0));
+		}
+
+	private:
+		// Allocate the storage of the bound colour texture at the target's size and format
+		void AllocateColour()
+		{
+			if(format_ == ERenderTargetFormat::RGBA16F)
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width_, height_, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+			else
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width_, height_, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		}
+
+		GLuint fbo_				{ 0 };
+		GLuint colour_texture_	{ 0 };
+		GLuint depth_rbo_		{ 0 };
+		int width_				{ 0 };
+		int height_				{ 0 };
+		ERenderTargetFormat format_ { ERenderTargetFormat::RGBA8 };
+	};
+}
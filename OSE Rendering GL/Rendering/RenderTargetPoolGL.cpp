@@ -0,0 +1,41 @@
+#include "pch.h"
+#include "RenderTargetPoolGL.h"
+
+namespace ose::rendering
+{
+	// Get a target for each of the frame's physical targets, must be called once a frame
+	void RenderTargetPoolGL::Acquire(std::vector<RenderTargetDesc> const & descs)
+	{
+		++frame_;
+		acquired_.assign(descs.size(), nullptr);
+		for(size_t i = 0; i < descs.size(); ++i)
+		{
+			auto iter { std::find_if(entries_.begin(), entries_.end(), [this, &descs, i](Entry const & entry) {
+				return entry.last_used_ != frame_ && entry.desc_ == descs[i];
+			}) };
+			if(iter == entries_.end())
+			{
+				RenderTargetDesc const & desc { descs[i] };
+				DEBUG_LOG("Creating transient render target", desc.width_, "x", desc.height_);
+				entries_.push_back({ desc, ose::make_unique<RenderTargetGL>(desc.width_, desc.height_, desc.format_, desc.depth_), 0 });
+				iter = entries_.end() - 1;
+			}
+			iter->last_used_ = frame_;
+			acquired_[i] = iter->target_.get();
+		}
+
+		// Targets are destroyed once unused for a while, e.g. after the window is resized or an effect is removed
+		entries_.erase(std::remove_if(entries_.begin(), entries_.end(), [this](Entry const & entry) {
+			return frame_ - entry.last_used_ > UNUSED_FRAMES;
+		}), entries_.end());
+	}
+
+	// Get the number of bytes of GPU memory used by the targets kept by the pool
+	size_t RenderTargetPoolGL::GetMemorySize() const
+	{
+		size_t size { 0 };
+		for(auto const & entry : entries_)
+			size += entry.target_->GetMemorySize();
+		return size;
+	}
+}
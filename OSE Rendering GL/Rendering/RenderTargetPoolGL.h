@@ -0,0 +1,50 @@
+#pragma once
+#include "OSE-Core/Rendering/TransientTargetAllocator.h"
+#include "RenderTargetGL.h"
+
+namespace ose::rendering
+{
+	// Render targets which only live for part of a frame, e.g. camera layers and the intermediate images of the post-processing chain
+	// Each frame the allocator's physical targets are matched with targets of the same description kept from earlier frames,
+	// s.t. targets are only created when the peak number of live targets grows, targets unused for UNUSED_FRAMES frames are destroyed
+	class RenderTargetPoolGL
+	{
+	public:
+		// Number of frames a target is kept without being used, s.t. a target which is only needed now and then isn't recreated each time
+		static constexpr uint64_t UNUSED_FRAMES { 60 };
+
+		RenderTargetPoolGL() = default;
+
+		RenderTargetPoolGL(RenderTargetPoolGL const &) = delete;
+		RenderTargetPoolGL & operator=(RenderTargetPoolGL const &) = delete;
+
+		// Get a target for each of the frame's physical targets, must be called once a frame
+		void Acquire(std::vector<RenderTargetDesc> const & descs);
+
+		// Get the target acquired for a physical target
+		RenderTargetGL & Get(uint32_t physical) const { return *acquired_[physical]; }
+
+		// Get the number of targets kept by the pool
+		size_t GetNumTargets() const { return entries_.size(); }
+
+		// Get the number of bytes of GPU memory used by the targets kept by the pool
+		size_t GetMemorySize() const;
+
+	private:
+		struct Entry
+		{
+			RenderTargetDesc desc_;
+			uptr<RenderTargetGL> target_;
+
+			// Number of the last frame the target was acquired
+			uint64_t last_used_ { 0 };
+		};
+
+		std::vector<Entry> entries_;
+
+		// Target of each physical target of the current frame
+		std::vector<RenderTargetGL *> acquired_;
+
+		uint64_t frame_ { 0 };
+	};
+}
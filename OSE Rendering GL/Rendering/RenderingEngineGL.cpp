@@ -1,6 +1,12 @@
 #include "pch.h"
 #include "RenderingEngineGL.h"
 #include "OSE-Core/Game/Camera/Camera.h"
+#include "OSE-Core/Math/Frustum.h"
+#include "OSE-Core/Resources/Mesh/Mesh.h"
+#include "Shader/ShaderCompilerGL.h"
+#include "UploadQueueGL.h"
+#include <thread>
+#include <future>
 
 namespace ose::rendering
 {
@@ -10,10 +16,30 @@ namespace ose::rendering
 		// TODO - Only load GLEW if used OpenGL functions are not available
 		InitGlew();
 
-		// Initialise the render pool only once OpenGL has been intialised
+		// Instance ranges can only be culled individually if draws can start part way through the instance buffer
+		base_instance_supported_ = GLEW_VERSION_4_2 || GLEW_ARB_base_instance;
+
+		// Initialise the render pool and light clusters only once OpenGL has been intialised
 		render_pool_.Init(fbwidth, fbheight);
+		light_clusters_.Init();
 		UpdateProjectionMatrix();
 
+		// Start the workers which stage texture and buffer uploads, using up to a quarter of the cores
+		UploadQueueGL::Start(std::clamp(std::thread::hardware_concurrency() / 4, 1u, 4u));
+
+		// Create the stream buffer the uniform blocks shared by every shader program are written to
+		GLint uniform_alignment { 0 };
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniform_alignment);
+		if(uniform_alignment > 0)
+			uniform_alignment_ = static_cast<size_t>(uniform_alignment);
+		uniform_stream_.Init(GL_UNIFORM_BUFFER, UNIFORM_STREAM_FRAME_CAPACITY);
+
+		// Full screen passes draw a single triangle generated from gl_VertexID, which still requires a vertex array to be bound
+		glGenVertexArrays(1, &fullscreen_vao_);
+
+		// Dynamic resolution falls back to the interval between frames if the GPU time can't be measured
+		gpu_timer_.Init();
+
 		// Set the default OpenGL settings
 		glCullFace(GL_BACK);
 		glEnable(GL_CULL_FACE);
@@ -24,7 +50,28 @@ namespace ose::rendering
 		glDepthFunc(GL_LEQUAL);
 	}
 
-	RenderingEngineGL::~RenderingEngineGL() {}
+	RenderingEngineGL::~RenderingEngineGL()
+	{
+		shader::ShaderCompilerGL::Stop();
+		UploadQueueGL::Stop();
+		if(fullscreen_vao_)
+			glDeleteVertexArrays(1, &fullscreen_vao_);
+		if(deferred_lighting_prog_)
+			deferred_lighting_prog_->DestroyShaderProg();
+		if(upscale_prog_)
+			upscale_prog_->DestroyShaderProg();
+		if(overlay_prog_)
+			overlay_prog_->DestroyShaderProg();
+	}
+
+	// Give the rendering engine a context which shares GPU objects with its own, s.t. shader variants can be built on a worker thread
+	void RenderingEngineGL::SetWorkerContext(std::function<void()> make_current, std::function<void()> release)
+	{
+		if(make_current)
+			shader::ShaderCompilerGL::Start(std::move(make_current), std::move(release));
+		else
+			shader::ShaderCompilerGL::Stop();
+	}
 
 	void RenderingEngineGL::UpdateOrthographicProjectionMatrix(int fbwidth, int fbheight)
 	{
@@ -34,6 +81,9 @@ namespace ose::rendering
 		///projection_matrix_ = glm::ortho(-(float)fbwidth/2 * aspect_ratio, (float)fbwidth/2 * aspect_ratio, -(float)fbheight/2 * aspect_ratio, (float)fbheight/2 * aspect_ratio);
 		projection_matrix_ = glm::ortho(0.0f, (float)fbwidth, 0.0f, (float)fbheight);
 		glViewport(0, 0, fbwidth, fbheight);
+		// 2D lights are clustered into screen tiles only
+		light_clusters_.SetProjection(projection_matrix_, false, 0.0f, 0.0f, fbwidth, fbheight);
+		projection_size_ = { fbwidth, fbheight };
 	}
 
 	void RenderingEngineGL::UpdatePerspectiveProjectionMatrix(float hfov_deg, int fbwidth, int fbheight, float znear, float zfar)
@@ -47,96 +97,815 @@ namespace ose::rendering
 		// TODO - test aspect ratio is correct for a variety of resolutions
 		projection_matrix_ = glm::perspective(vfov, aspect_ratio, znear, zfar);
 		glViewport(0, 0, fbwidth, fbheight);	// still required with shaders as far as I'm aware
+		light_clusters_.SetProjection(projection_matrix_, true, znear, zfar, fbwidth, fbheight);
+		projection_size_ = { fbwidth, fbheight };
 	}
 
 	// Render one frame to the screen
-	void RenderingEngineGL::Render(Camera const & active_camera)
+	// The active camera fills the window, then each camera layer is rendered to a texture and drawn to its viewport in order
+	void RenderingEngineGL::Render(Camera const & active_camera, std::vector<Camera const *> const & camera_layers)
 	{
-		for(auto const & render_pass : render_pool_.GetRenderPasses())
+		// Copy the uploads filled by the upload queue's workers, within the frame's upload budget
+		UploadQueueGL::Update(GetUploadBudget());
+
+		// Stream the texture levels requested by the last frame, texture bindings are reset by invalidating the state cache
+		TextureStreamerGL & texture_streamer { render_pool_.GetTextureStreamer() };
+		texture_streamer.SetBudget(GetTextureBudget());
+		texture_streamer.Update();
+
+		// Merge the static geometry added since the last frame into batches
+		render_pool_.UpdateStaticBatches(GetStaticBatchCellSize());
+
+		// Choose the resolution the active camera is rendered at
+		UpdateRenderScale();
+
+		// State may have been changed outside of rendering, e.g. by render pool updates
+		state_cache_.Invalidate();
+		cull_stats_ = {};
+
+		// Plan every view's targets before any is rendered, then get the physical targets the plan needs from the pool
+		PlanViews(active_camera, camera_layers);
+		transient_allocator_.Allocate();
+		target_pool_.Acquire(transient_allocator_.GetPhysicalDescs());
+
+		// Stream in the tile chunks near the active camera, must be done before instance data is uploaded
+		ViewGL const & active_view { views_.front() };
+		if(active_view.projection_size_ != projection_size_)
+			UpdateProjectionMatrix(active_view.projection_size_.x, active_view.projection_size_.y);
+		render_pool_.UpdateTileChunks(Frustum { projection_matrix_ * active_camera.GetGlobalTransform().GetInverseTransformMatrix() });
+
+		// Upload any instance data which has changed since the last frame
+		render_pool_.UpdateInstanceBuffers();
+
+		// Use any shader variants which have finished building on the shader compiler's thread
+		render_pool_.UpdateShaderVariants();
+
+		// Each view uploads its camera and lights to a new range of the stream buffer
+		uniform_stream_.BeginFrame();
+
+		// The light cluster textures use units which are never used by materials, so are bound once per frame
+		state_cache_.BindTexture(shader::CLUSTER_LIGHTS_TEXTURE_UNIT, GL_TEXTURE_BUFFER, light_clusters_.GetClusterLightsTexture());
+		state_cache_.BindTexture(shader::LIGHT_INDICES_TEXTURE_UNIT, GL_TEXTURE_BUFFER, light_clusters_.GetLightIndicesTexture());
+		state_cache_.BindTexture(shader::POINT_LIGHTS_TEXTURE_UNIT, GL_TEXTURE_BUFFER, light_clusters_.GetPointLightsTexture());
+
+		// Dynamic resolution keeps the GPU time of the whole frame, every view included, below the target
+		BeginProfiling();
+		if(active_view.upscale_)
+			gpu_timer_.Begin();
+		for(size_t v = 0; v < views_.size(); ++v)
+			RenderView(views_[v], v);
+		if(active_view.upscale_)
+			gpu_timer_.End();
+
+		if(GetFrameProfile() && IsProfilerOverlayEnabled())
+			DrawProfilerOverlay();
+		state_cache_.BindVertexArray(0);
+
+		// Fence the frame's uniform data s.t. its range is not overwritten until the GPU is done with it
+		uniform_stream_.EndFrame();
+	}
+
+	// Plan this frame's views and the transient targets they use, before anything is drawn
+	// Planning the whole frame first lets targets whose lifetimes don't overlap share memory, even between views
+	void RenderingEngineGL::PlanViews(Camera const & active_camera, std::vector<Camera const *> const & camera_layers)
+	{
+		transient_allocator_.Reset();
+		views_.clear();
+
+		int fbwidth { GetFramebufferWidth() };
+		int fbheight { GetFramebufferHeight() };
+		glm::ivec2 window_size { fbwidth, fbheight };
+		std::vector<PostEffect> const & effects { GetPostEffects() };
+
+		// The active camera fills the window, with dynamic resolution it is rendered to the scene target and scaled up
+		ViewGL & active_view { views_.emplace_back() };
+		active_view.camera_ = &active_camera;
+		active_view.projection_size_ = window_size;
+		active_view.render_size_ = render_size_;
+		active_view.window_rect_ = { 0, 0, fbwidth, fbheight };
+		active_view.upscale_ = scene_fbo_ != 0;
+		if(fbwidth <= 0 || fbheight <= 0)
+			return;
+
+		// Effects read the scene as a whole texture, so with dynamic resolution the scene is scaled up before it is post-processed
+		if(!effects.empty() && active_camera.IsPostProcessingEnabled())
+		{
+			transient_allocator_.BeginPass();
+			uint32_t image;
+			if(active_view.upscale_)
+				image = active_view.upscale_target_ = transient_allocator_.Create({ fbwidth, fbheight, ERenderTargetFormat::RGBA8, false });
+			else
+				image = active_view.scene_target_ = transient_allocator_.Create({ fbwidth, fbheight, ERenderTargetFormat::RGBA8, true });
+			transient_allocator_.Use(image);
+			PostChainGL::Plan(effects, image, window_size, transient_allocator_, active_view.post_passes_);
+		}
+
+		// Camera layers are rendered to a target the size of their viewport, which is then post-processed or copied to the window
+		for(Camera const * camera : camera_layers)
 		{
-			// Bind the fbo and clear the required buffers
-			glBindFramebuffer(GL_FRAMEBUFFER, render_pass.fbo_);
-			if(render_pass.clear_)
-				glClear(render_pass.clear_mode_);
+			glm::vec4 const & viewport { camera->GetViewport() };
+			glm::ivec4 rect { glm::round(viewport * glm::vec4(fbwidth, fbheight, fbwidth, fbheight)) };
+			if(rect.z <= 0 || rect.w <= 0)
+				continue;
+
+			ViewGL & layer_view { views_.emplace_back() };
+			layer_view.camera_ = camera;
+			layer_view.projection_size_ = { rect.z, rect.w };
+			layer_view.render_size_ = { rect.z, rect.w };
+			layer_view.window_rect_ = rect;
 
-			// Set the depth settings
-			if(render_pass.enable_depth_test_)
+			transient_allocator_.BeginPass();
+			layer_view.scene_target_ = transient_allocator_.Create({ rect.z, rect.w, ERenderTargetFormat::RGBA8, true });
+			transient_allocator_.Use(layer_view.scene_target_);
+			if(!effects.empty() && camera->IsPostProcessingEnabled())
 			{
-				glEnable(GL_DEPTH_TEST);
-				glDepthFunc(render_pass.depth_func_);
+				PostChainGL::Plan(effects, layer_view.scene_target_, layer_view.render_size_, transient_allocator_, layer_view.post_passes_);
 			}
 			else
 			{
-				glDisable(GL_DEPTH_TEST);
+				transient_allocator_.BeginPass();
+				transient_allocator_.Use(layer_view.scene_target_);
 			}
+		}
+	}
 
-			for(auto const & shader_group : render_pass.material_groups_)
+	// Render the scene from a view's camera to its target, then post-process it or copy it to its rect of the window
+	void RenderingEngineGL::RenderView(ViewGL const & view, size_t index)
+	{
+		constexpr uint32_t NO_TARGET { TransientTargetAllocator::NO_TARGET };
+
+		// Passes of the default framebuffer are redirected to the view's target, the scene covers its bottom left render_size_ pixels
+		render_size_ = view.render_size_;
+		if(view.scene_target_ != NO_TARGET)
+			scene_fbo_ = target_pool_.Get(transient_allocator_.GetPhysical(view.scene_target_)).GetFbo();
+		else
+			scene_fbo_ = view.upscale_ ? scene_target_->GetFbo() : 0;
+
+		// The light clusters' screen tiles divide the rendered area
+		if(view.projection_size_ != projection_size_)
+			UpdateProjectionMatrix(view.projection_size_.x, view.projection_size_.y);
+		light_clusters_.SetViewportSize(render_size_.x, render_size_.y);
+
+		glm::mat4 view_matrix { view.camera_->GetGlobalTransform().GetInverseTransformMatrix() };
+		glm::mat4 view_proj { projection_matrix_ * view_matrix };
+		Frustum frustum { view_proj };
+
+		// Rasterize the occluders on a worker whilst the camera and lights are uploaded
+		// The occlusion buffer is always reset s.t. meshes aren't culled by the last view's occluders
+		std::future<void> occluders;
+		if(render_pool_.GetOccluders().empty())
+			occlusion_buffer_.Begin(view_proj);
+		else
+			occluders = std::async(std::launch::async, &RenderingEngineGL::RasterizeOccluders, this, view_proj, std::cref(frustum));
+
+		// Upload the camera and lights once for every shader program
+		UpdateUniformBuffers(*view.camera_, view_matrix, view_proj);
+
+		// Choose the level of detail of each mesh instance, using the same projected size as texture streaming
+		// Levels are chosen again for each view, s.t. a small layer such as a minimap draws coarse levels
+		float pixels_per_unit { projection_matrix_[1][1] * 0.5f * static_cast<float>(render_size_.y) };
+		render_pool_.UpdateMeshLods(view_proj, pixels_per_unit, GetLodScreenError());
+
+		// Order the draws of every pass s.t. draws requiring the same state are adjacent
+		if(occluders.valid())
+			occluders.get();
+		BuildDrawList(view_proj, frustum);
+
+		// In the deferred render path opaque meshes are lit once per pixel before the forward passes run
+		// The forward passes then draw everything else on top, depth tested against the deferred geometry
+		FramebufferGL const * gbuffer { GetRenderPath() == ERenderPath::DEFERRED ? PrepareDeferred() : nullptr };
+
+		// Add the profiler scopes of the view's passes before recording, s.t. the recorded lists can begin and end them
+		AddViewScopes(view, index, gbuffer != nullptr);
+
+		// Record the view's commands, split between workers when there are enough draws
+		RecordCommands(gbuffer);
+
+		// Only the submission of the recorded commands has to happen on the OpenGL thread
+		glViewport(0, 0, render_size_.x, render_size_.y);
+		for(auto const & list : command_lists_)
+			executor_.Execute(list);
+
+		// With dynamic resolution the scene was drawn to the bottom left of the scene target, so is scaled up first
+		if(view.upscale_)
+		{
+			GLuint upscale_fbo { view.upscale_target_ == NO_TARGET ? 0 : target_pool_.Get(transient_allocator_.GetPhysical(view.upscale_target_)).GetFbo() };
+			if(profiler_)
+				profiler_->Begin(upscale_scope_);
+			Upscale(upscale_fbo);
+			if(profiler_)
+				profiler_->End(upscale_scope_);
+		}
+
+		if(profiler_)
+			profiler_->Begin(post_scope_);
+		if(!view.post_passes_.empty())
+		{
+			post_chain_.Draw(view.post_passes_, view.window_rect_, transient_allocator_, target_pool_, state_cache_, fullscreen_vao_);
+		}
+		else if(view.scene_target_ != NO_TARGET)
+		{
+			// A layer without effects is copied to its rect of the window as it is
+			glm::ivec4 const & rect { view.window_rect_ };
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, scene_fbo_);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+			glBlitFramebuffer(0, 0, render_size_.x, render_size_.y, rect.x, rect.y, rect.x + rect.z, rect.y + rect.w, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			state_cache_.BindFramebuffer(0);
+		}
+		if(profiler_)
+			profiler_->End(post_scope_);
+	}
+
+	// Record the commands of every pass into command_lists_, executed in order
+	// The draw list is split into contiguous ranges recorded in parallel, gbuffer is nullptr unless the deferred path is used
+	void RenderingEngineGL::RecordCommands(FramebufferGL const * gbuffer)
+	{
+		size_t num_items { draw_list_.GetItems().size() };
+		size_t num_workers { std::min<size_t>(num_items / MIN_DRAWS_PER_WORKER, std::max(std::thread::hardware_concurrency(), 1u)) };
+		num_workers = std::max<size_t>(num_workers, 1);
+
+		// The first list holds the deferred passes, each of the others holds a range of the draw list
+		command_lists_.resize(num_workers + 1);
+		for(auto & list : command_lists_)
+			list.Clear();
+
+		// Point the shared binding points at the view's ranges of the stream buffer before anything is drawn
+		GLuint uniform_buffer { uniform_stream_.GetBuffer() };
+		if(frame_block_offset_ >= 0)
+			command_lists_[0].BindUniformBlock(shader::FRAME_UNIFORM_BLOCK_BINDING, uniform_buffer,
+				static_cast<uint32_t>(frame_block_offset_), sizeof(shader::FrameUniformBlockGL));
+		if(light_block_offset_ >= 0)
+			command_lists_[0].BindUniformBlock(shader::LIGHT_UNIFORM_BLOCK_BINDING, uniform_buffer,
+				static_cast<uint32_t>(light_block_offset_), sizeof(shader::LightUniformBlockGL));
+
+		if(gbuffer)
+			RecordDeferred(command_lists_[0], *gbuffer);
+
+		bool deferred { gbuffer != nullptr };
+		size_t draws_per_worker { (num_items + num_workers - 1) / num_workers };
+		if(num_workers == 1)
+		{
+			RecordForward(command_lists_[1], 0, num_items, deferred);
+		}
+		else
+		{
+			std::vector<std::future<void>> workers;
+			workers.reserve(num_workers - 1);
+			size_t w { 2 };
+			for(size_t begin = draws_per_worker; begin < num_items; begin += draws_per_worker, ++w)
+				workers.push_back(std::async(std::launch::async, &RenderingEngineGL::RecordForward, this,
+					std::ref(command_lists_[w]), begin, std::min(begin + draws_per_worker, num_items), deferred));
+			RecordForward(command_lists_[1], 0, std::min(draws_per_worker, num_items), deferred);
+			for(auto & worker : workers)
+				worker.get();
+		}
+	}
+
+	// Record the render passes and the draws [begin, end) of the draw list
+	// A pass is started by the range containing its first draw, passes without draws by the range before them
+	void RenderingEngineGL::RecordForward(RenderCommandList & list, size_t begin, size_t end, bool deferred) const
+	{
+		auto const & render_passes { render_pool_.GetRenderPasses() };
+		auto const & draw_items { draw_list_.GetItems() };
+
+		// Draw items are sorted by pass first so the pass's draws are contiguous
+		// Whilst profiling, the scope of the current material group is measured until the next group starts or the range ends
+		uint32_t next_pass { begin == 0 ? 0 : draw_items[begin - 1].pass_ + 1 };
+		uint32_t scope { GpuProfiler::NO_SCOPE };
+		for(size_t d = begin; d < end; ++d)
+		{
+			if(next_pass <= draw_items[d].pass_ && scope != GpuProfiler::NO_SCOPE)
 			{
-				// Set the blend settings
-				if(shader_group.enable_blend_)
-				{
-					glEnable(GL_BLEND);
-					glBlendFunc(shader_group.blend_fac_, shader_group.blend_func_);
-				}
-				else
-				{
-					glDisable(GL_BLEND);
-				}
+				list.EndTimer(scope);
+				scope = GpuProfiler::NO_SCOPE;
+			}
+			for(; next_pass <= draw_items[d].pass_; ++next_pass)
+				RecordPassBegin(list, render_passes[next_pass], deferred, scene_fbo_);
 
-				// Bind the shader used by the shader group
-				glUseProgram(shader_group.shader_prog_);
+			if(deferred && IsDeferred(draw_items[d]))
+				continue;
 
-				// Pass the lights to the shader program
-				glUniform1i(glGetUniformLocation(shader_group.shader_prog_, "numPointLights"), std::min(static_cast<int>(render_pool_.GetPointLights().size()), 16));
-				for(size_t l = 0; l < render_pool_.GetPointLights().size() && l < 16; l++)
-				{
-					auto const & light = render_pool_.GetPointLights()[l];
-					glUniform3f(glGetUniformLocation(shader_group.shader_prog_, std::string{"pointLights[" + std::to_string(l) + "].position"}.c_str()), light.position_.x, light.position_.y, light.position_.z);
-					glUniform3f(glGetUniformLocation(shader_group.shader_prog_, std::string{"pointLights[" + std::to_string(l) + "].color"}.c_str()), light.color_.x, light.color_.y, light.color_.z);
-				}
-				glUniform1i(glGetUniformLocation(shader_group.shader_prog_, "numDirLights"), std::min(static_cast<int>(render_pool_.GetDirLights().size()), 16));
-				for(size_t l = 0; l < render_pool_.GetDirLights().size() && l < 16; l++)
-				{
-					auto const & light = render_pool_.GetDirLights()[l];
-					glUniform3f(glGetUniformLocation(shader_group.shader_prog_, std::string{"dirLights[" + std::to_string(l) + "].direction"}.c_str()), light.direction_.x, light.direction_.y, light.direction_.z);
-					glUniform3f(glGetUniformLocation(shader_group.shader_prog_, std::string{"dirLights[" + std::to_string(l) + "].color"}.c_str()), light.color_.x, light.color_.y, light.color_.z);
-				}
+			uint32_t item_scope { item_scopes_.empty() ? GpuProfiler::NO_SCOPE : item_scopes_[d] };
+			if(item_scope != scope)
+			{
+				if(scope != GpuProfiler::NO_SCOPE)
+					list.EndTimer(scope);
+				if(item_scope != GpuProfiler::NO_SCOPE)
+					list.BeginTimer(item_scope);
+				scope = item_scope;
+			}
+
+			auto const & shader_group { render_passes[draw_items[d].pass_].material_groups_[draw_items[d].material_group_] };
+
+			// Set the blend settings and bind the shader used by the shader group
+			list.SetBlend(shader_group.enable_blend_, shader_group.blend_fac_, shader_group.blend_func_);
+			RecordDrawItem(list, draw_items[d], shader_group.shader_prog_);
+		}
+		if(scope != GpuProfiler::NO_SCOPE)
+			list.EndTimer(scope);
+
+		if(end == draw_items.size())
+		{
+			for(; next_pass < render_passes.size(); ++next_pass)
+				RecordPassBegin(list, render_passes[next_pass], deferred, scene_fbo_);
+		}
+	}
+
+	// Record binding a render pass's fbo, clearing it and setting its depth settings
+	// Passes which render to the default framebuffer are redirected to scene_fbo
+	void RenderingEngineGL::RecordPassBegin(RenderCommandList & list, RenderPassGL const & render_pass, bool deferred, GLuint scene_fbo)
+	{
+		// The default framebuffer already holds the lit deferred geometry, so must not be cleared
+		list.BindFramebuffer(render_pass.fbo_ == 0 ? scene_fbo : render_pass.fbo_);
+		if(render_pass.clear_ && !(deferred && render_pass.fbo_ == 0))
+			list.ClearBuffers(render_pass.clear_mode_);
+		list.SetDepthTest(render_pass.enable_depth_test_, render_pass.depth_func_);
+	}
+
+	// Record the draw(s) of a single draw item using the shader program prog
+	void RenderingEngineGL::RecordDrawItem(RenderCommandList & list, DrawItemGL const & item, GLuint prog) const
+	{
+		auto const & shader_group { render_pool_.GetRenderPasses()[item.pass_].material_groups_[item.material_group_] };
+		auto const & render_group { shader_group.render_groups_[item.render_group_] };
+
+		list.SetPipeline(prog);
+		list.BindVertexArray(render_group.vao_);
+
+		// Render groups with an instance buffer are drawn with a single instanced draw call
+		if(render_group.instance_vbo_ != 0)
+		{
+			// Bind the textures shared by every instance
+			for(GLuint t = 0; t < render_group.texture_stride_; ++t)
+				list.BindTexture(t, render_group.texture_target_, render_group.textures_[t]);
+
+			if(render_group.ibo_ == 0)
+				list.Draw(render_group.render_primitive_, render_group.first_, render_group.count_, item.num_instances_, item.first_instance_);
+			else if(render_group.lods_.empty())
+				list.DrawIndexed(render_group.render_primitive_, render_group.count_, item.num_instances_, item.first_instance_);
+			else
+			{
+				RenderGroupGL::LodGL const & lod { render_group.lods_[item.lod_] };
+				list.DrawIndexed(render_group.render_primitive_, lod.count_, item.num_instances_, item.first_instance_, lod.first_index_);
+			}
+			return;
+		}
+
+		size_t end_instance { item.first_instance_ + item.num_instances_ };
+		for(size_t i = item.first_instance_; i < end_instance; ++i)
+		{
+			// Pass the cached world transform of the object to the shader program
+			list.SetUniformMat4(shader_group.uniforms_.world_transform_, render_group.GetInstanceData(i));
+
+			// Bind the textures
+			for(GLuint t = 0; t < render_group.texture_stride_; ++t)
+				list.BindTexture(t, render_group.texture_target_, render_group.textures_[i * render_group.texture_stride_ + t]);
+
+			// Render the object
+			if(render_group.ibo_ == 0)
+				list.Draw(render_group.render_primitive_, render_group.first_, render_group.count_);
+			else
+				list.DrawIndexed(render_group.render_primitive_, render_group.count_);
+		}
+	}
+
+	// Returns true iff a draw item is drawn by the geometry pass when the deferred render path is used
+	// Only opaque, instanced groups of the default framebuffer whose shader has a G-buffer program are deferred
+	bool RenderingEngineGL::IsDeferred(DrawItemGL const & item) const
+	{
+		auto const & render_pass { render_pool_.GetRenderPasses()[item.pass_] };
+		auto const & material_group { render_pass.material_groups_[item.material_group_] };
+		// The G-buffer program has no world transform uniform, so groups drawn one instance at a time stay forward
+		return render_pass.fbo_ == 0 && !material_group.enable_blend_ && material_group.gbuffer_shader_prog_ != 0
+			&& material_group.render_groups_[item.render_group_].instance_vbo_ != 0;
+	}
+
+	// Create the G-buffer and lighting program of the deferred render path if they don't exist yet
+	// Returns nullptr if either is unavailable, in which case every item is drawn forward
+	FramebufferGL const * RenderingEngineGL::PrepareDeferred()
+	{
+		FramebufferGL const * gbuffer { render_pool_.GetGBuffer() };
+		if(!gbuffer)
+			return nullptr;
+
+		if(!deferred_lighting_prog_)
+		{
+			deferred_lighting_prog_ = ose::make_unique<shader::DeferredLightingShaderProgGLSL>();
+			deferred_lighting_prog_->CreateShaderProg();
+			// The programs set their sampler uniforms whilst in use
+			state_cache_.Invalidate();
+		}
+		if(deferred_lighting_prog_->GetShaderProgId() == 0)
+			return nullptr;
+		return gbuffer;
+	}
+
+	// Record drawing the deferred items to the G-buffer, lighting the G-buffer into the default framebuffer and copying its depth
+	void RenderingEngineGL::RecordDeferred(RenderCommandList & list, FramebufferGL const & gbuffer) const
+	{
+		// Geometry pass, write the surface properties of every opaque mesh to the G-buffer
+		// Pixels not written keep a zero normal, which the lighting pass skips
+		if(deferred_geometry_scope_ != GpuProfiler::NO_SCOPE)
+			list.BeginTimer(deferred_geometry_scope_);
+		list.BindFramebuffer(gbuffer.GetFbo());
+		list.ClearBuffers(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		list.SetDepthTest(true, GL_LEQUAL);
+		list.SetBlend(false, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		for(auto const & item : draw_list_.GetItems())
+		{
+			if(IsDeferred(item))
+				RecordDrawItem(list, item, render_pool_.GetRenderPasses()[item.pass_].material_groups_[item.material_group_].gbuffer_shader_prog_);
+		}
+		if(deferred_geometry_scope_ != GpuProfiler::NO_SCOPE)
+			list.EndTimer(deferred_geometry_scope_);
+
+		// Lighting pass, a single full screen triangle shades each covered pixel with the lights of its cluster
+		if(deferred_lighting_scope_ != GpuProfiler::NO_SCOPE)
+			list.BeginTimer(deferred_lighting_scope_);
+		list.BindFramebuffer(scene_fbo_);
+		list.ClearBuffers(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		list.SetDepthTest(false, GL_LEQUAL);
+		list.SetPipeline(deferred_lighting_prog_->GetShaderProgId());
+		list.BindVertexArray(fullscreen_vao_);
+		list.BindTexture(0, GL_TEXTURE_2D, gbuffer.GetPosBuffer());
+		list.BindTexture(1, GL_TEXTURE_2D, gbuffer.GetNormBuffer());
+		list.BindTexture(2, GL_TEXTURE_2D, gbuffer.GetColBuffer());
+		list.Draw(GL_TRIANGLES, 0, 3);
+
+		// Copy the G-buffer's depth to the framebuffer the scene is rendered to s.t. forward draws are hidden behind deferred geometry
+		// Requires the default framebuffer to have a matching depth format (24 bit depth, 8 bit stencil)
+		list.BlitDepth(gbuffer.GetFbo(), scene_fbo_, render_size_.x, render_size_.y);
+		if(deferred_lighting_scope_ != GpuProfiler::NO_SCOPE)
+			list.EndTimer(deferred_lighting_scope_);
+	}
+
+	// Choose the resolution the scene is rendered at this frame from the GPU time of previous frames
+	// Sets render_size_ and scene_fbo_, the scene is rendered straight to the window when dynamic resolution is disabled
+	void RenderingEngineGL::UpdateRenderScale()
+	{
+		int fbwidth { GetFramebufferWidth() };
+		int fbheight { GetFramebufferHeight() };
+		auto now { std::chrono::steady_clock::now() };
+		bool has_last_frame { last_frame_start_ != std::chrono::steady_clock::time_point {} };
+		float frame_ms { std::chrono::duration<float, std::milli>(now - last_frame_start_).count() };
+		last_frame_start_ = now;
+
+		if(!IsDynamicResolutionEnabled() || fbwidth <= 0 || fbheight <= 0)
+		{
+			dynamic_resolution_.Reset();
+			scene_fbo_ = 0;
+			render_scale_ = 1.0f;
+			render_size_ = { fbwidth, fbheight };
+			return;
+		}
+
+		// The scene target is the size of the window, s.t. every scale fits in it
+		if(!scene_target_)
+		{
+			scene_target_ = ose::make_unique<RenderTargetGL>(fbwidth, fbheight);
+		}
+		else if(scene_target_->GetWidth() != fbwidth || scene_target_->GetHeight() != fbheight)
+		{
+			scene_target_->Resize(fbwidth, fbheight);
+			dynamic_resolution_.Reset();
+		}
+
+		// Without timer queries the interval between frames is used, which matches the GPU time whilst the GPU is the bottleneck
+		dynamic_resolution_.SetTargetFrameTime(GetTargetFrameTime());
+		dynamic_resolution_.SetScaleRange(GetMinRenderScale(), 1.0f);
+		float gpu_ms;
+		if(gpu_timer_.IsSupported())
+		{
+			if(gpu_timer_.Poll(gpu_ms))
+				dynamic_resolution_.Update(gpu_ms);
+		}
+		else if(has_last_frame)
+		{
+			dynamic_resolution_.Update(frame_ms);
+		}
+
+		scene_fbo_ = scene_target_->GetFbo();
+		render_scale_ = dynamic_resolution_.GetScale();
+		render_size_ = { std::max(static_cast<int>(std::lround(fbwidth * render_scale_)), 1),
+			std::max(static_cast<int>(std::lround(fbheight * render_scale_)), 1) };
+	}
 
-				// Pass the view projection matrix to the shader program
-				glm::mat4 view_proj = projection_matrix_ * active_camera.GetGlobalTransform().GetInverseTransformMatrix();
-				glUniformMatrix4fv(glGetUniformLocation(shader_group.shader_prog_, "viewProjMatrix"), 1, GL_FALSE, glm::value_ptr(view_proj));
+	// Draw the scene target to fbo (the size of the window), scaling it up with the upscale filter
+	void RenderingEngineGL::Upscale(GLuint fbo)
+	{
+		if(!upscale_prog_)
+		{
+			upscale_prog_ = ose::make_unique<shader::UpscaleShaderProgGLSL>();
+			upscale_prog_->CreateShaderProg();
+			// The program sets its sampler uniform whilst in use
+			state_cache_.Invalidate();
+		}
 
-				// Pass the camera position to the shader program
-				glUniform3f(glGetUniformLocation(shader_group.shader_prog_, "cameraPos"), active_camera.GetGlobalTransform().GetTranslation().x,
-					active_camera.GetGlobalTransform().GetTranslation().y, active_camera.GetGlobalTransform().GetTranslation().z);
+		int fbwidth { GetFramebufferWidth() };
+		int fbheight { GetFramebufferHeight() };
+		glViewport(0, 0, fbwidth, fbheight);
 
-				// Render the render objects one by one
-				for(auto const & render_group : shader_group.render_groups_)
+		// If the program failed to build the scene is still scaled up, without sharpening
+		if(upscale_prog_->GetShaderProgId() == 0)
+		{
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, scene_fbo_);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+			glBlitFramebuffer(0, 0, render_size_.x, render_size_.y, 0, 0, fbwidth, fbheight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+			glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+			state_cache_.Invalidate();
+			return;
+		}
+
+		float target_width { static_cast<float>(scene_target_->GetWidth()) };
+		float target_height { static_cast<float>(scene_target_->GetHeight()) };
+		state_cache_.BindFramebuffer(fbo);
+		state_cache_.SetDepthTest(false, GL_LEQUAL);
+		state_cache_.SetBlend(false, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		state_cache_.UseProgram(upscale_prog_->GetShaderProgId());
+		state_cache_.BindVertexArray(fullscreen_vao_);
+		state_cache_.BindTexture(0, GL_TEXTURE_2D, scene_target_->GetColourTexture());
+		glUniform4f(upscale_prog_->GetSourceRectLocation(), render_size_.x / target_width, render_size_.y / target_height,
+			1.0f / target_width, 1.0f / target_height);
+		glUniform1f(upscale_prog_->GetSharpnessLocation(), GetUpscaleFilter() == EUpscaleFilter::SHARPEN ? SHARPEN_STRENGTH : 0.0f);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+	}
+
+	// Start measuring the GPU time of this frame's passes if the rendering engine has a frame profile
+	// The results of an earlier frame which have become available are added to the frame profile
+	void RenderingEngineGL::BeginProfiling()
+	{
+		FrameProfile * profile { GetFrameProfile() };
+		if(profile && !gpu_profiler_ && GpuTimerQueriesGL::IsSupported())
+			gpu_profiler_ = ose::make_unique<GpuProfiler>(ose::make_unique<GpuTimerQueriesGL>());
+		profiler_ = profile ? gpu_profiler_.get() : nullptr;
+		executor_.SetProfiler(profiler_);
+		if(!profiler_)
+			return;
+
+		// Results arrive a frame late, so are added to the frame they were measured in rather than the current frame
+		if(profiler_->BeginFrame(profile->GetCurrentFrame()))
+			profile->AddSamples(profiler_->GetResultsFrame(), profiler_->GetResults());
+	}
+
+	// Add the profiler scopes of a view: one for each deferred pass, forward pass and material group, upscaling and post-processing
+	// Each draw item is assigned its material group's scope, the scopes of camera layers are grouped under a scope per layer
+	void RenderingEngineGL::AddViewScopes(ViewGL const & view, size_t index, bool deferred)
+	{
+		item_scopes_.clear();
+		deferred_geometry_scope_ = GpuProfiler::NO_SCOPE;
+		deferred_lighting_scope_ = GpuProfiler::NO_SCOPE;
+		upscale_scope_ = GpuProfiler::NO_SCOPE;
+		post_scope_ = GpuProfiler::NO_SCOPE;
+		if(!profiler_)
+			return;
+
+		uint32_t view_scope { index == 0 ? GpuProfiler::NO_SCOPE : profiler_->AddScope("Camera " + std::to_string(index)) };
+		if(deferred)
+		{
+			deferred_geometry_scope_ = profiler_->AddScope("Deferred geometry", view_scope);
+			deferred_lighting_scope_ = profiler_->AddScope("Deferred lighting", view_scope);
+		}
+
+		// Draw items are sorted by pass, so each pass's scope is added once, before the scopes of its material groups
+		auto const & draw_items { draw_list_.GetItems() };
+		item_scopes_.resize(draw_items.size(), GpuProfiler::NO_SCOPE);
+		std::map<uint32_t, uint32_t> group_scopes;
+		uint32_t pass_scope { GpuProfiler::NO_SCOPE };
+		uint32_t scope_pass { 0 };
+		for(size_t d = 0; d < draw_items.size(); ++d)
+		{
+			DrawItemGL const & item { draw_items[d] };
+			if(deferred && IsDeferred(item))
+				continue;
+			if(pass_scope == GpuProfiler::NO_SCOPE || item.pass_ != scope_pass)
+			{
+				pass_scope = profiler_->AddScope("Pass " + std::to_string(item.pass_), view_scope);
+				scope_pass = item.pass_;
+				group_scopes.clear();
+			}
+			auto [iter, inserted] { group_scopes.try_emplace(item.material_group_, GpuProfiler::NO_SCOPE) };
+			if(inserted)
+				iter->second = profiler_->AddScope("Group " + std::to_string(item.material_group_), pass_scope);
+			item_scopes_[d] = iter->second;
+		}
+
+		if(view.upscale_)
+			upscale_scope_ = profiler_->AddScope("Upscale", view_scope);
+		if(!view.post_passes_.empty() || view.scene_target_ != TransientTargetAllocator::NO_TARGET)
+			post_scope_ = profiler_->AddScope("Post", view_scope);
+	}
+
+	// Draw the latest CPU and GPU timings of the frame profile as stacked bars in the top left of the window
+	void RenderingEngineGL::DrawProfilerOverlay()
+	{
+		if(!overlay_prog_)
+		{
+			overlay_prog_ = ose::make_unique<shader::OverlayShaderProgGLSL>();
+			overlay_prog_->CreateShaderProg();
+		}
+		if(overlay_prog_->GetShaderProgId() == 0)
+			return;
+
+		// The current frame's CPU timings are incomplete, so the previous frame's are drawn
+		FrameProfile const & profile { *GetFrameProfile() };
+		std::vector<ProfileSample> const * cpu_samples { profile.GetSamples(profile.GetCurrentFrame() - 1) };
+
+		// The top row is each stage of the CPU frame, the bottom row is each measured GPU scope (scopes without children)
+		std::vector<float> rows[2];
+		if(cpu_samples)
+		{
+			for(auto const & sample : *cpu_samples)
+			{
+				if(sample.source_ == EProfileSource::CPU && sample.depth_ == 1)
+					rows[0].push_back(sample.ms_);
+			}
+		}
+		if(profiler_)
+		{
+			auto const & gpu_samples { profiler_->GetResults() };
+			for(size_t i = 1; i < gpu_samples.size(); ++i)
+			{
+				if(i + 1 == gpu_samples.size() || gpu_samples[i + 1].depth_ <= gpu_samples[i].depth_)
+					rows[1].push_back(gpu_samples[i].ms_);
+			}
+		}
+
+		int fbwidth { GetFramebufferWidth() };
+		int fbheight { GetFramebufferHeight() };
+		glViewport(0, 0, fbwidth, fbheight);
+		state_cache_.BindFramebuffer(0);
+		state_cache_.SetDepthTest(false, GL_LEQUAL);
+		state_cache_.SetBlend(true, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		state_cache_.UseProgram(overlay_prog_->GetShaderProgId());
+		state_cache_.BindVertexArray(fullscreen_vao_);
+
+		// Rectangles are given in pixels from the top left of the window
+		auto draw_rect = [this, fbwidth, fbheight](float x, float y, float width, float height, glm::vec4 const & colour) {
+			glUniform4f(overlay_prog_->GetRectLocation(), x / fbwidth * 2.0f - 1.0f, 1.0f - (y + height) / fbheight * 2.0f,
+				(x + width) / fbwidth * 2.0f - 1.0f, 1.0f - y / fbheight * 2.0f);
+			glUniform4fv(overlay_prog_->GetColourLocation(), 1, glm::value_ptr(colour));
+			glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		};
+
+		static glm::vec4 const palette[] {
+			{ 0.90f, 0.30f, 0.25f, 0.9f }, { 0.95f, 0.65f, 0.20f, 0.9f }, { 0.35f, 0.75f, 0.30f, 0.9f },
+			{ 0.25f, 0.55f, 0.90f, 0.9f }, { 0.65f, 0.40f, 0.85f, 0.9f }, { 0.30f, 0.80f, 0.80f, 0.9f }
+		};
+		constexpr float MARGIN { 8.0f };
+		constexpr float ROW_HEIGHT { 10.0f };
+		constexpr float ROW_GAP { 4.0f };
+		float width { fbwidth * OVERLAY_WIDTH };
+		float px_per_ms { width / (2.0f * GetTargetFrameTime()) };
+
+		draw_rect(MARGIN - 2.0f, MARGIN - 2.0f, width + 4.0f, 2.0f * ROW_HEIGHT + ROW_GAP + 4.0f, { 0.0f, 0.0f, 0.0f, 0.5f });
+		for(size_t r = 0; r < 2; ++r)
+		{
+			float x { MARGIN };
+			float y { MARGIN + r * (ROW_HEIGHT + ROW_GAP) };
+			for(size_t i = 0; i < rows[r].size() && x < MARGIN + width; ++i)
+			{
+				float bar { std::min(rows[r][i] * px_per_ms, MARGIN + width - x) };
+				draw_rect(x, y, bar, ROW_HEIGHT, palette[i % std::size(palette)]);
+				x += bar;
+			}
+		}
+
+		// Mark the target frame time, halfway along the bars
+		draw_rect(MARGIN + width * 0.5f - 1.0f, MARGIN - 2.0f, 2.0f, 2.0f * ROW_HEIGHT + ROW_GAP + 4.0f, { 1.0f, 1.0f, 1.0f, 0.9f });
+	}
+
+	// Build the sorted list of draws for the current frame
+	// Instances outside the view frustum are culled before their draws are added
+	void RenderingEngineGL::BuildDrawList(glm::mat4 const & view_proj, Frustum const & frustum)
+	{
+		draw_list_.Clear();
+
+		auto const & render_passes { render_pool_.GetRenderPasses() };
+		for(uint32_t p = 0; p < render_passes.size(); ++p)
+		{
+			auto const & material_groups { render_passes[p].material_groups_ };
+			for(uint32_t m = 0; m < material_groups.size(); ++m)
+			{
+				auto const & material_group { material_groups[m] };
+				for(uint32_t r = 0; r < material_group.render_groups_.size(); ++r)
 				{
-					for(size_t i = 0; i < render_group.transforms_.size(); ++i)
+					auto const & render_group { material_group.render_groups_[r] };
+					// Groups with no vertices, e.g. tile chunks which are empty or haven't been built, are never drawn
+					if(render_group.GetNumInstances() == 0 || render_group.count_ == 0)
+						continue;
+
+					// Groups whose vertex data or textures are still in the upload queue are skipped until they are ready
+					if(!render_group.IsUploaded())
+						continue;
+
+					// Test every instance's world bounds against the frustum in a single batch
+					uint32_t num_instances { static_cast<uint32_t>(render_group.GetNumInstances()) };
+					visibility_.resize(num_instances);
+					size_t num_visible { frustum.CullAABBs(render_group.world_bounds_.data(), num_instances, visibility_.data()) };
+
+					// Then test the meshes inside the frustum against the occluders
+					if(render_group.type_ == ERenderObjectType::MESH_RENDERER && occlusion_buffer_.HasOccluders() && num_visible > 0)
+					{
+						size_t num_unoccluded { occlusion_buffer_.CullAABBs(render_group.world_bounds_.data(), num_instances, visibility_.data()) };
+						cull_stats_.occluded_instances_ += static_cast<uint32_t>(num_visible - num_unoccluded);
+						num_visible = num_unoccluded;
+					}
+					cull_stats_.visible_instances_ += static_cast<uint32_t>(num_visible);
+					cull_stats_.culled_instances_ += num_instances - static_cast<uint32_t>(num_visible);
+					if(num_visible == 0)
+						continue;
+
+					if(render_group.type_ == ERenderObjectType::MESH_RENDERER && !render_group.textures_.empty())
+						RequestTextureSizes(render_group, view_proj);
+
+					GLuint texture { render_group.textures_.empty() ? 0 : render_group.textures_[0] };
+
+					// Add a draw for each run of visible instances, runs are also split where the level of detail changes
+					// Without base instance support instanced draws must start at instance 0, so the whole group is drawn
+					bool split_runs { render_group.instance_vbo_ == 0 || base_instance_supported_ };
+					uint8_t const * lods { render_group.lods_.empty() ? nullptr : render_group.instance_lods_.data() };
+					InstanceRuns::Build(visibility_.data(), lods, num_instances, split_runs, runs_);
+					for(auto const & run : runs_)
 					{
-						// Pass the world transform of the object to the shader program
-						glm::mat4 tMat { render_group.transforms_[i]->GetTransformMatrix() };
-						glUniformMatrix4fv(glGetUniformLocation(shader_group.shader_prog_, "worldTransform"), 1, GL_FALSE, glm::value_ptr(tMat));
-
-						// Bind the textures
-						for(size_t t = 0; t < render_group.texture_stride_; ++t)
-						{
-							glActiveTexture(GL_TEXTURE0 + t);
-							glBindTexture(GL_TEXTURE_2D, render_group.textures_[i * render_group.texture_stride_ + t]);
-						}
-
-						// Render the object
-						glBindVertexArray(render_group.vao_);
-						if(render_group.ibo_ == 0)
-							glDrawArrays(render_group.render_primitive_, render_group.first_, render_group.count_);
-						else
-							glDrawElements(render_group.render_primitive_, render_group.count_, GL_UNSIGNED_INT, 0);
+						// The depth of a draw is that of its first instance in normalised device coordinates
+						glm::vec4 clip_pos { view_proj * glm::vec4(render_group.transforms_[run.first_]->GetTranslation(), 1.0f) };
+						float depth { clip_pos.w != 0.0f ? (clip_pos.z / clip_pos.w) * 0.5f + 0.5f : 0.0f };
+
+						uint64_t key { DrawListGL::MakeKey(p, material_group.enable_blend_, material_group.shader_prog_, m, texture, depth) };
+						draw_list_.Push(key, p, m, r, run.first_, run.count_, run.lod_);
+						++cull_stats_.draws_;
 					}
 				}
 			}
 		}
-		glBindVertexArray(0);
+
+		draw_list_.Sort();
+	}
+
+	// Rasterize the occluders inside the view frustum into the occlusion buffer
+	// Only reads the render pool's occluders, so can run on a worker whilst the OpenGL thread updates GPU buffers
+	void RenderingEngineGL::RasterizeOccluders(glm::mat4 const & view_proj, Frustum const & frustum)
+	{
+		occlusion_buffer_.Begin(view_proj);
+		for(auto const & occluder : render_pool_.GetOccluders())
+		{
+			glm::mat4 world { occluder.transform_->GetTransformMatrix() };
+			if(!frustum.Intersects(occluder.local_bounds_.Transformed(world)))
+				continue;
+			std::vector<float> const & positions { occluder.mesh_->GetPositionData() };
+			occlusion_buffer_.RasterizeTriangles(world, positions.data(), positions.size(), occluder.indices_.data(), occluder.indices_.size());
+		}
+	}
+
+	// Request the on-screen size of the largest visible instance of a render group for each of the group's textures
+	// Uses the visibility of the group's instances, so must be called after the group has been culled
+	void RenderingEngineGL::RequestTextureSizes(RenderGroupGL const & render_group, glm::mat4 const & view_proj)
+	{
+		// The projected diameter of an instance's bounding sphere approximates the screen size of a texture mapped across it once
+		// clip w is the view depth for perspective projections and 1 for orthographic projections
+		float pixels_per_unit { projection_matrix_[1][1] * 0.5f * static_cast<float>(render_size_.y) };
+		float screen_size { 0.0f };
+		for(size_t i = 0; i < render_group.GetNumInstances(); ++i)
+		{
+			if(!visibility_[i])
+				continue;
+			AABB const & bounds { render_group.world_bounds_[i] };
+			float diameter { 2.0f * glm::length(bounds.GetExtents()) };
+			float w { (view_proj * glm::vec4(bounds.GetCenter(), 1.0f)).w };
+			screen_size = std::max(screen_size, diameter * pixels_per_unit / std::max(w, 0.0001f));
+		}
+
+		TextureStreamerGL & texture_streamer { render_pool_.GetTextureStreamer() };
+		for(GLuint texture : render_group.textures_)
+			texture_streamer.RequestSize(texture, screen_size);
+	}
+
+	// Upload the camera and light data to the shared uniform buffers
+	// Point lights are assigned to clusters and uploaded to the cluster buffer textures
+	void RenderingEngineGL::UpdateUniformBuffers(Camera const & active_camera, glm::mat4 const & view, glm::mat4 const & view_proj)
+	{
+		shader::FrameUniformBlockGL frame_data;
+		frame_data.view_proj_matrix_ = view_proj;
+		frame_data.camera_pos_ = glm::vec4(active_camera.GetGlobalTransform().GetTranslation(), 1.0f);
+		frame_block_offset_ = uniform_stream_.Upload(&frame_data, sizeof(frame_data), uniform_alignment_);
+
+		auto const & point_lights { render_pool_.GetPointLights() };
+		auto const & dir_lights { render_pool_.GetDirLights() };
+		shader::LightUniformBlockGL light_data;
+		int32_t num_point_lights { static_cast<int32_t>(std::min(point_lights.size(), LightClustersGL::MAX_POINT_LIGHTS)) };
+		int32_t num_dir_lights { std::min(static_cast<int32_t>(dir_lights.size()), shader::MAX_UNIFORM_BLOCK_DIR_LIGHTS) };
+		for(int32_t l = 0; l < num_dir_lights; ++l)
+		{
+			light_data.dir_lights_[l].direction_ = glm::vec4(dir_lights[l].direction_, 0.0f);
+			light_data.dir_lights_[l].color_ = glm::vec4(dir_lights[l].color_, 1.0f);
+		}
+		light_data.num_lights_ = glm::ivec4(num_point_lights, num_dir_lights, 0, 0);
+		light_block_offset_ = uniform_stream_.Upload(&light_data, sizeof(light_data), uniform_alignment_);
+
+		// The ranges are bound by the view's first command list, so must be visible to the GPU before it is executed
+		uniform_stream_.Flush();
+
+		light_clusters_.Update(view, point_lights);
 	}
 
 	// Load OpenGL functions using GLEW
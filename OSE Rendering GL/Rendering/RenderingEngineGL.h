@@ -4,14 +4,43 @@
 #include "OSE-Core/EngineDependencies/glm/glm.hpp"
 #include "RenderPoolGL.h"
 #include "TextureGL.h"
+#include "DrawListGL.h"
+#include "StateCacheGL.h"
+#include "StreamBufferGL.h"
+#include "RenderCommandExecutorGL.h"
+#include "RenderTargetGL.h"
+#include "RenderTargetPoolGL.h"
+#include "PostChainGL.h"
+#include "GpuTimerGL.h"
+#include "GpuTimerQueriesGL.h"
+#include "Lights/LightClustersGL.h"
+#include "OSE-Core/Math/OcclusionBuffer.h"
+#include "OSE-Core/Rendering/DynamicResolution.h"
+#include "OSE-Core/Rendering/InstanceRuns.h"
+#include "Shader/Shaders/DeferredLightingShaderProgGLSL.h"
+#include "Shader/Shaders/UpscaleShaderProgGLSL.h"
+#include "Shader/Shaders/OverlayShaderProgGLSL.h"
+#include <chrono>
 
 namespace ose
 {
 	class Camera;
+	class Frustum;
 }
 
 namespace ose::rendering
 {
+	// Number of instances and draws which survived culling during a frame
+	struct CullStatsGL
+	{
+		uint32_t visible_instances_ { 0 };
+		uint32_t culled_instances_ { 0 };
+		uint32_t draws_ { 0 };
+
+		// Number of the culled instances which were inside the view frustum but hidden by occluders
+		uint32_t occluded_instances_ { 0 };
+	};
+
 	class RenderingEngineGL final : public RenderingEngine
 	{
 	public:
@@ -19,10 +48,23 @@ namespace ose::rendering
 		~RenderingEngineGL();
 
 		// Render one frame to the screen
-		void Render(Camera const & active_camera) override;
+		// The active camera fills the window, then each camera layer is rendered to a texture and drawn to its viewport in order
+		void Render(Camera const & active_camera, std::vector<Camera const *> const & camera_layers) override;
+
+		// Give the rendering engine a context which shares GPU objects with its own, s.t. shader variants can be built on a worker thread
+		void SetWorkerContext(std::function<void()> make_current, std::function<void()> release) override;
 
 		// Get a reference to the render pool, s.t. new render objects can be added
 		RenderPool & GetRenderPool() override { return render_pool_; }
+
+		// Get the culling statistics of the last frame rendered, summed over every camera
+		CullStatsGL const & GetCullStats() const { return cull_stats_; }
+
+		// Get the number of bytes of GPU memory used by transient render targets, i.e. camera layers and post-processing images
+		size_t GetTransientTargetMemory() const { return target_pool_.GetMemorySize(); }
+
+		// Get the fraction of the window's width and height the last frame was rendered at, 1 unless dynamic resolution is enabled
+		float GetRenderScale() const { return render_scale_; }
 		
 	private:
 		// Load OpenGL functions using GLEW
@@ -35,6 +77,214 @@ namespace ose::rendering
 		// The pool of object rendered each engine update
 		RenderPoolGL render_pool_;
 
+		// Number of bytes of per-frame uniform data which can be streamed each frame
+		static constexpr size_t UNIFORM_STREAM_FRAME_CAPACITY { 16384 };
+
+		// Uniform blocks shared by every shader program are written to a new range of the stream buffer each frame
+		// s.t. the CPU never has to wait for the GPU to finish reading the previous frame's data
+		StreamBufferGL uniform_stream_;
+
+		// Required alignment of uniform buffer ranges
+		size_t uniform_alignment_ { 256 };
+
+		// Offsets of the view's frame and light uniform blocks in the stream buffer, -1 if their upload failed
+		// The blocks' binding points are set by the first command list of the view
+		GLintptr frame_block_offset_ { -1 };
+		GLintptr light_block_offset_ { -1 };
+
+		// Upload the camera and light data to the shared uniform buffers
+		// Point lights are assigned to clusters and uploaded to the cluster buffer textures
+		void UpdateUniformBuffers(Camera const & active_camera, glm::mat4 const & view, glm::mat4 const & view_proj);
+
+		// Per-cluster point light lists, s.t. each fragment only shades the lights which reach it
+		LightClustersGL light_clusters_;
+
+		// Per-frame list of draws sorted to minimise state changes
+		DrawListGL draw_list_;
+
+		// Cache of the OpenGL state set whilst rendering
+		StateCacheGL state_cache_;
+
+		// Build the sorted list of draws for the current frame
+		// Instances outside the view frustum, and meshes hidden by the occluders, are culled before their draws are added
+		void BuildDrawList(glm::mat4 const & view_proj, Frustum const & frustum);
+
+		// Rasterize the occluders inside the view frustum into the occlusion buffer
+		// Only reads the render pool's occluders, so can run on a worker whilst the OpenGL thread updates GPU buffers
+		void RasterizeOccluders(glm::mat4 const & view_proj, Frustum const & frustum);
+
+		// CPU depth buffer of the occluders, mesh instances are tested against it after frustum culling
+		OcclusionBuffer occlusion_buffer_;
+
+		// Per-instance visibility of the render group currently being culled, reused between render groups
+		std::vector<uint8_t> visibility_;
+
+		// Runs of instances of the render group currently being culled, reused between render groups
+		std::vector<InstanceRun> runs_;
+
+		// Request the on-screen size of the largest visible instance of a render group for each of the group's textures
+		// Uses the visibility of the group's instances, so must be called after the group has been culled
+		void RequestTextureSizes(RenderGroupGL const & render_group, glm::mat4 const & view_proj);
+
+		// Culling statistics of the last frame
+		CullStatsGL cull_stats_;
+
+		// Minimum number of draws recorded by each worker, below this recording on one thread is faster
+		static constexpr size_t MIN_DRAWS_PER_WORKER { 256 };
+
+		// Commands of the current frame, recorded on worker threads then executed in order on the OpenGL thread
+		std::vector<RenderCommandList> command_lists_;
+
+		// Replays the command lists through the state cache
+		RenderCommandExecutorGL executor_ { state_cache_ };
+
+		// Record the commands of every pass into command_lists_, executed in order
+		// The draw list is split into contiguous ranges recorded in parallel, gbuffer is nullptr unless the deferred path is used
+		void RecordCommands(FramebufferGL const * gbuffer);
+
+		// Record the render passes and the draws [begin, end) of the draw list
+		// A pass is started by the range containing its first draw, passes without draws by the range before them
+		void RecordForward(RenderCommandList & list, size_t begin, size_t end, bool deferred) const;
+
+		// Record binding a render pass's fbo, clearing it and setting its depth settings
+		// Passes which render to the default framebuffer are redirected to scene_fbo
+		static void RecordPassBegin(RenderCommandList & list, RenderPassGL const & render_pass, bool deferred, GLuint scene_fbo);
+
+		// Record the draw(s) of a single draw item using the shader program prog
+		void RecordDrawItem(RenderCommandList & list, DrawItemGL const & item, GLuint prog) const;
+
+		// Returns true iff a draw item is drawn by the geometry pass when the deferred render path is used
+		// Only opaque, instanced groups of the default framebuffer whose shader has a G-buffer program are deferred
+		bool IsDeferred(DrawItemGL const & item) const;
+
+		// Create the G-buffer and lighting program of the deferred render path if they don't exist yet
+		// Returns nullptr if either is unavailable, in which case every item is drawn forward
+		FramebufferGL const * PrepareDeferred();
+
+		// Record drawing the deferred items to the G-buffer, lighting the G-buffer into the default framebuffer and copying its depth
+		void RecordDeferred(RenderCommandList & list, FramebufferGL const & gbuffer) const;
+
+		// Full screen lighting pass program of the deferred render path, created the first time the path is used
+		uptr<shader::DeferredLightingShaderProgGLSL> deferred_lighting_prog_;
+
+		// Empty vertex array bound for the full screen triangle, whose vertices are generated from gl_VertexID
+		GLuint fullscreen_vao_ { 0 };
+
+		// A camera rendered this frame, and where its image is drawn
+		struct ViewGL
+		{
+			Camera const * camera_ { nullptr };
+
+			// Size the view's projection matrix is built for, the window for the active camera
+			glm::ivec2 projection_size_ { 0, 0 };
+
+			// Size the scene is rendered at
+			glm::ivec2 render_size_ { 0, 0 };
+
+			// Rect of the window the view's image is drawn to, bottom left corner (xy) and size (zw) in pixels
+			glm::ivec4 window_rect_ { 0, 0, 0, 0 };
+
+			// Transient target the scene is rendered to, NO_TARGET if it is rendered to the window or the dynamic resolution scene target
+			uint32_t scene_target_ { TransientTargetAllocator::NO_TARGET };
+
+			// True iff the scene is rendered to the dynamic resolution scene target, then scaled up to upscale_target_
+			bool upscale_ { false };
+
+			// Transient target the scene is scaled up to before it is post-processed, NO_TARGET for the window
+			uint32_t upscale_target_ { TransientTargetAllocator::NO_TARGET };
+
+			// Post-processing passes of the view's image, the last pass draws to window_rect_
+			std::vector<PostPassGL> post_passes_;
+		};
+
+		// Plan this frame's views and the transient targets they use, before anything is drawn
+		// Planning the whole frame first lets targets whose lifetimes don't overlap share memory, even between views
+		void PlanViews(Camera const & active_camera, std::vector<Camera const *> const & camera_layers);
+
+		// Render the scene from a view's camera to its target, then post-process it or copy it to its rect of the window
+		void RenderView(ViewGL const & view, size_t index);
+
+		// Views of the current frame, the active camera's view first
+		std::vector<ViewGL> views_;
+
+		// Assigns the frame's transient targets to physical targets from their lifetimes, and the pool which keeps them between frames
+		TransientTargetAllocator transient_allocator_;
+		RenderTargetPoolGL target_pool_;
+
+		// Draws the post-processing passes of each view
+		PostChainGL post_chain_;
+
+		// Size the projection matrix was last built for, the projection is rebuilt when a view of a different size is rendered
+		glm::ivec2 projection_size_ { 0, 0 };
+
+		// Choose the resolution the scene is rendered at this frame from the GPU time of previous frames
+		// Sets render_size_ and scene_fbo_, the scene is rendered straight to the window when dynamic resolution is disabled
+		void UpdateRenderScale();
+
+		// Draw the scene target to fbo (the size of the window), scaling it up with the upscale filter
+		void Upscale(GLuint fbo);
+
+		// Chooses the render scale from the measured GPU frame time
+		DynamicResolution dynamic_resolution_;
+
+		// Measures the GPU time of each frame, when timer queries are unsupported the interval between frames is used instead
+		GpuTimerGL gpu_timer_;
+
+		// Time the last frame started rendering, used to measure the interval between frames
+		std::chrono::steady_clock::time_point last_frame_start_;
+
+		// Offscreen target the scene is rendered to when dynamic resolution is enabled, the size of the window
+		// The scene only covers its bottom left render_size_ pixels, s.t. changing the scale never reallocates it
+		uptr<RenderTargetGL> scene_target_;
+
+		// Program which scales the scene target up to the window, created the first time dynamic resolution is used
+		uptr<shader::UpscaleShaderProgGLSL> upscale_prog_;
+
+		// Strength of the sharpen applied by EUpscaleFilter::SHARPEN, between 0 and 1
+		static constexpr float SHARPEN_STRENGTH { 0.5f };
+
+		// Framebuffer the passes of the default framebuffer render to this frame, 0 unless dynamic resolution is enabled
+		GLuint scene_fbo_ { 0 };
+
+		// Size (in pixels) the scene is rendered at this frame, and its fraction of the window's size
+		glm::ivec2 render_size_ { 0, 0 };
+		float render_scale_ { 1.0f };
+
+		// Start measuring the GPU time of this frame's passes if the rendering engine has a frame profile
+		// The results of an earlier frame which have become available are added to the frame profile
+		void BeginProfiling();
+
+		// Add the profiler scopes of a view: one for each deferred pass, forward pass and material group, upscaling and post-processing
+		// Each draw item is assigned its material group's scope, the scopes of camera layers are grouped under a scope per layer
+		void AddViewScopes(ViewGL const & view, size_t index, bool deferred);
+
+		// Draw the latest CPU and GPU timings of the frame profile as stacked bars in the top left of the window
+		void DrawProfilerOverlay();
+
+		// Measures the GPU time of each scope, created the first time a frame profile is set
+		uptr<GpuProfiler> gpu_profiler_;
+
+		// Profiler measuring the current frame, nullptr unless a frame profile is set and timer queries are supported
+		GpuProfiler * profiler_ { nullptr };
+
+		// Profiler scope of each draw item of the current view, empty unless profiling
+		std::vector<uint32_t> item_scopes_;
+
+		// Profiler scopes of the current view's full screen passes
+		uint32_t deferred_geometry_scope_ { GpuProfiler::NO_SCOPE };
+		uint32_t deferred_lighting_scope_ { GpuProfiler::NO_SCOPE };
+		uint32_t upscale_scope_ { GpuProfiler::NO_SCOPE };
+		uint32_t post_scope_ { GpuProfiler::NO_SCOPE };
+
+		// Program drawing the profiler overlay's bars, created the first time the overlay is drawn
+		uptr<shader::OverlayShaderProgGLSL> overlay_prog_;
+
+		// The overlay's bars are this fraction of the window's width at twice the target frame time
+		static constexpr float OVERLAY_WIDTH { 0.33f };
+
+		// True iff draws can start from an instance other than 0 (GL 4.2 or ARB_base_instance)
+		bool base_instance_supported_ { false };
+
 		// Child functions to update the projection matrix to either orthographic or perspective
 		void UpdateOrthographicProjectionMatrix(int fbwidth, int fbheight) override;
 		void UpdatePerspectiveProjectionMatrix(float hfov_deg, int fbwidth, int fbheight, float znear, float zfar) override;
@@ -2,6 +2,7 @@
 #include "RenderingFactoryGL.h"
 #include "RenderingEngineGL.h"
 #include "TextureGL.h"
+#include "TextureAtlasGL.h"
 #include "Shader/ShaderProgGLSL.h"
 
 // TODO - Remove
@@ -22,6 +23,11 @@ namespace ose::rendering
 		return ose::make_unique<TextureGL>(name, path);
 	}
 
+	uptr<TextureAtlas> RenderingFactoryGL::NewTextureAtlas(int32_t layer_width, int32_t layer_height, int32_t padding)
+	{
+		return ose::make_unique<TextureAtlasGL>(layer_width, layer_height, padding);
+	}
+
 	uptr<ShaderProg> RenderingFactoryGL::NewShaderProg(uptr<ShaderGraph> shader_graph)
 	{
 		// TODO - Remove tests for specific shader graphs once shader graph implementation is finished
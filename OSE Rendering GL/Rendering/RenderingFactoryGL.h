@@ -4,6 +4,7 @@
 namespace ose
 {
 	class Texture;
+	class TextureAtlas;
 	class RenderingEngine;
 }
 
@@ -21,6 +22,7 @@ namespace ose::rendering
 
 		virtual uptr<RenderingEngine> NewRenderingEngine(int fbwidth, int fbheight);
 		virtual uptr<Texture> NewTexture(std::string const & name, std::string const & path);
+		virtual uptr<TextureAtlas> NewTextureAtlas(int32_t layer_width, int32_t layer_height, int32_t padding);
 		virtual uptr<ShaderProg> NewShaderProg(uptr<ShaderGraph> shader_graph);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+#include "OSE-Core/Resources/Texture/TextureAtlasRegion.h"
+
+namespace ose::rendering
+{
+	// Engine data given to a sprite renderer once it has been added to the render pool
+	struct SpriteRendererDataGL
+	{
+		// ID of the sprite renderer within the render pool
+		uint32_t component_id_;
+
+		// The layer and UV rect of the sprite's texture within the texture array it is rendered from
+		TextureAtlasRegion region_;
+	};
+}
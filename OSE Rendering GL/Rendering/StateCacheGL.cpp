@@ -0,0 +1,100 @@
+#include "pch.h"
+#include "StateCacheGL.h"
+
+namespace ose::rendering
+{
+	// Forget all cached state, the next call to each setter will always reach OpenGL
+	void StateCacheGL::Invalidate()
+	{
+		fbo_ = UNKNOWN;
+		prog_ = UNKNOWN;
+		vao_ = UNKNOWN;
+		active_texture_unit_ = UNKNOWN;
+		std::fill(std::begin(textures_), std::end(textures_), UNKNOWN);
+		std::fill(std::begin(texture_targets_), std::end(texture_targets_), UNKNOWN);
+		blend_enabled_ = UNKNOWN;
+		blend_sfactor_ = UNKNOWN;
+		blend_dfactor_ = UNKNOWN;
+		depth_test_enabled_ = UNKNOWN;
+		depth_func_ = UNKNOWN;
+	}
+
+	void StateCacheGL::BindFramebuffer(GLuint fbo)
+	{
+		if(fbo_ == fbo)
+			return;
+		glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+		fbo_ = fbo;
+	}
+
+	void StateCacheGL::UseProgram(GLuint prog)
+	{
+		if(prog_ == prog)
+			return;
+		glUseProgram(prog);
+		prog_ = prog;
+	}
+
+	void StateCacheGL::BindVertexArray(GLuint vao)
+	{
+		if(vao_ == vao)
+			return;
+		glBindVertexArray(vao);
+		vao_ = vao;
+	}
+
+	void StateCacheGL::BindTexture(GLuint unit, GLenum target, GLuint texture)
+	{
+		// Units beyond those tracked are always bound
+		if(unit < MAX_TEXTURE_UNITS)
+		{
+			if(textures_[unit] == texture && texture_targets_[unit] == target)
+				return;
+			textures_[unit] = texture;
+			texture_targets_[unit] = target;
+		}
+		if(active_texture_unit_ != unit)
+		{
+			glActiveTexture(GL_TEXTURE0 + unit);
+			active_texture_unit_ = unit;
+		}
+		glBindTexture(target, texture);
+	}
+
+	void StateCacheGL::SetBlend(bool enable, GLenum sfactor, GLenum dfactor)
+	{
+		GLuint enabled { enable ? 1u : 0u };
+		if(blend_enabled_ != enabled)
+		{
+			if(enable)
+				glEnable(GL_BLEND);
+			else
+				glDisable(GL_BLEND);
+			blend_enabled_ = enabled;
+		}
+		if(enable && (blend_sfactor_ != sfactor || blend_dfactor_ != dfactor))
+		{
+			glBlendFunc(sfactor, dfactor);
+			blend_sfactor_ = sfactor;
+			blend_dfactor_ = dfactor;
+		}
+	}
+
+	void StateCacheGL::SetDepthTest(bool enable, GLenum func)
+	{
+		GLuint enabled { enable ? 1u : 0u };
+		if(depth_test_enabled_ != enabled)
+		{
+			if(enable)
+				glEnable(GL_DEPTH_TEST);
+			else
+				glDisable(GL_DEPTH_TEST);
+			depth_test_enabled_ = enabled;
+		}
+		if(enable && depth_func_ != func)
+		{
+			glDepthFunc(func);
+			depth_func_ = func;
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+namespace ose::rendering
+{
+	// Tracks the OpenGL state set by the rendering engine s.t. redundant state changes can be skipped
+	// The cache must be invalidated whenever state may have been changed by code outside the cache
+	class StateCacheGL
+	{
+	public:
+		// Maximum number of texture units tracked by the cache
+		static constexpr size_t MAX_TEXTURE_UNITS { 16 };
+
+		StateCacheGL() { Invalidate(); }
+
+		// Forget all cached state, the next call to each setter will always reach OpenGL
+		void Invalidate();
+
+		void BindFramebuffer(GLuint fbo);
+		void UseProgram(GLuint prog);
+		void BindVertexArray(GLuint vao);
+		void BindTexture(GLuint unit, GLenum target, GLuint texture);
+		void SetBlend(bool enable, GLenum sfactor, GLenum dfactor);
+		void SetDepthTest(bool enable, GLenum func);
+
+	private:
+		// Value used for state which is unknown
+		static constexpr GLuint UNKNOWN { ~0u };
+
+		GLuint fbo_ { UNKNOWN };
+		GLuint prog_ { UNKNOWN };
+		GLuint vao_ { UNKNOWN };
+
+		GLuint active_texture_unit_ { UNKNOWN };
+		GLuint textures_[MAX_TEXTURE_UNITS];
+		GLenum texture_targets_[MAX_TEXTURE_UNITS];
+
+		// 0 = disabled, 1 = enabled, UNKNOWN = unknown
+		GLuint blend_enabled_ { UNKNOWN };
+		GLenum blend_sfactor_ { UNKNOWN };
+		GLenum blend_dfactor_ { UNKNOWN };
+
+		GLuint depth_test_enabled_ { UNKNOWN };
+		GLenum depth_func_ { UNKNOWN };
+	};
+}
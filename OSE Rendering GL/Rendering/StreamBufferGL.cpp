@@ -0,0 +1,154 @@
+#include "pch.h"
+#include "StreamBufferGL.h"
+
+namespace ose::rendering
+{
+	StreamBufferGL::StreamBufferGL() : ring_(ose::make_unique<FrameFencesGL>(), NUM_FRAMES)
+	{
+
+	}
+
+	StreamBufferGL::~StreamBufferGL()
+	{
+		if(buffer_)
+		{
+			if(persistent_)
+			{
+				glBindBuffer(target_, buffer_);
+				glUnmapBuffer(target_);
+				glBindBuffer(target_, 0);
+			}
+			glDeleteBuffers(1, &buffer_);
+		}
+	}
+
+	// Create a buffer of capacity bytes for the target, must be called once OpenGL has been initialised
+	// frame_capacity is the number of bytes a single frame may use, the buffer is NUM_FRAMES times larger when persistently mapped
+	void StreamBufferGL::Init(GLenum target, size_t frame_capacity)
+	{
+		target_ = target;
+		persistent_ = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+
+		glGenBuffers(1, &buffer_);
+		glBindBuffer(target_, buffer_);
+		if(persistent_)
+		{
+			// Coherent mapping means writes are visible to the GPU without flushing, the fences prevent overwriting data in use
+			size_t capacity { frame_capacity * NUM_FRAMES };
+			GLbitfield flags { GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+			glBufferStorage(target_, capacity, nullptr, flags);
+			mapped_ = static_cast<uint8_t *>(glMapBufferRange(target_, 0, capacity, flags));
+			if(mapped_)
+			{
+				ring_.Reset(capacity);
+				glBindBuffer(target_, 0);
+				return;
+			}
+			// The storage is immutable, so the buffer must be recreated to fall back to orphaning
+			LOG_ERROR("Failed to persistently map stream buffer, falling back to orphaning");
+			glBindBuffer(target_, 0);
+			glDeleteBuffers(1, &buffer_);
+			glGenBuffers(1, &buffer_);
+			glBindBuffer(target_, buffer_);
+			persistent_ = false;
+		}
+
+		// When orphaning every frame gets fresh storage from the driver, so only one frame's worth of space is needed
+		glBufferData(target_, frame_capacity, nullptr, GL_STREAM_DRAW);
+		staging_.resize(frame_capacity);
+		ring_.Reset(frame_capacity);
+		glBindBuffer(target_, 0);
+	}
+
+	// Start a new frame, waits for the GPU if it is still reading the oldest frame's data
+	void StreamBufferGL::BeginFrame()
+	{
+		if(!buffer_)
+			return;
+
+		if(persistent_)
+		{
+			// Release frames the GPU has already finished with, and wait if the CPU is too far ahead
+			ring_.BeginFrame();
+			return;
+		}
+
+		// Orphan the buffer, draws of previous frames keep reading the storage they were issued with
+		glBindBuffer(target_, buffer_);
+		glBufferData(target_, ring_.GetCapacity(), nullptr, GL_STREAM_DRAW);
+		glBindBuffer(target_, 0);
+		ring_.Reset(ring_.GetCapacity());
+		flush_begin_ = flush_end_ = 0;
+	}
+
+	// Allocate size bytes aligned to alignment (a power of 2) for the current frame
+	// The returned pointer is only valid until the end of the frame, ptr_ is nullptr if the frame's capacity is used up
+	StreamAllocationGL StreamBufferGL::Allocate(size_t size, size_t alignment)
+	{
+		// The ring may be full of frames the GPU is still reading, in which case the allocation waits for them
+		size_t offset { ring_.Allocate(size, alignment) };
+		if(offset == RingAllocator::INVALID_OFFSET)
+		{
+			DEBUG_LOG("Stream buffer is full, failed to allocate", size, "bytes");
+			return {};
+		}
+
+		if(persistent_)
+			return { mapped_ + offset, static_cast<GLintptr>(offset) };
+
+		// Allocations never wrap when orphaning since the ring is reset every frame
+		if(flush_begin_ == flush_end_)
+			flush_begin_ = offset;
+		flush_end_ = offset + size;
+		return { staging_.data() + offset, static_cast<GLintptr>(offset) };
+	}
+
+	// Copy data into a new allocation, returns the offset of the data or -1 if allocation failed
+	GLintptr StreamBufferGL::Upload(void const * data, size_t size, size_t alignment)
+	{
+		StreamAllocationGL alloc { Allocate(size, alignment) };
+		if(!alloc.ptr_)
+			return -1;
+		std::memcpy(alloc.ptr_, data, size);
+		return alloc.offset_;
+	}
+
+	// Make the data written since the last flush visible to the GPU, must be called before drawing from it
+	// Does nothing when the buffer is persistently mapped
+	void StreamBufferGL::Flush()
+	{
+		if(persistent_ || flush_begin_ == flush_end_)
+			return;
+
+		// The range has not been used by any draw since the buffer was orphaned, so the map never has to synchronise
+		size_t size { flush_end_ - flush_begin_ };
+		glBindBuffer(target_, buffer_);
+		void * dst { glMapBufferRange(target_, flush_begin_, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT) };
+		if(dst)
+		{
+			std::memcpy(dst, staging_.data() + flush_begin_, size);
+			glUnmapBuffer(target_);
+		}
+		else
+		{
+			glBufferSubData(target_, flush_begin_, size, staging_.data() + flush_begin_);
+		}
+		glBindBuffer(target_, 0);
+		flush_begin_ = flush_end_ = 0;
+	}
+
+	// Fence the current frame's data, the frame's ranges are reused once the GPU has passed the fence
+	void StreamBufferGL::EndFrame()
+	{
+		if(!buffer_)
+			return;
+
+		if(!persistent_)
+		{
+			Flush();
+			return;
+		}
+
+		ring_.EndFrame();
+	}
+}
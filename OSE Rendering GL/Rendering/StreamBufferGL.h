@@ -0,0 +1,75 @@
+#pragma once
+#include "OSE-Core/Rendering/FencedRingAllocator.h"
+#include "FrameFencesGL.h"
+
+namespace ose::rendering
+{
+	// A range of a stream buffer written by the CPU this frame
+	struct StreamAllocationGL
+	{
+		// Where the data should be written, nullptr if the allocation failed
+		void * ptr_ { nullptr };
+
+		// Offset of the range in the stream buffer, used to bind or draw from the range
+		GLintptr offset_ { 0 };
+	};
+
+	// Buffer for data which is rewritten every frame, e.g. per-frame uniforms and dynamic vertices
+	// Each frame's data is sub-allocated from a ring of NUM_FRAMES frames s.t. the CPU never writes a range the GPU is reading
+	// With GL 4.4 or ARB_buffer_storage the buffer is persistently mapped and each frame is fenced
+	// Otherwise the buffer is orphaned at the start of each frame and the frame's data is copied into it by Flush()
+	class StreamBufferGL
+	{
+	public:
+		// Number of frames the CPU may be ahead of the GPU before it waits
+		static constexpr uint32_t NUM_FRAMES { 3 };
+
+		StreamBufferGL();
+		~StreamBufferGL();
+
+		StreamBufferGL(StreamBufferGL const &) = delete;
+		StreamBufferGL & operator=(StreamBufferGL const &) = delete;
+
+		// Create a buffer of capacity bytes for the target, must be called once OpenGL has been initialised
+		// frame_capacity is the number of bytes a single frame may use, the buffer is NUM_FRAMES times larger when persistently mapped
+		void Init(GLenum target, size_t frame_capacity);
+
+		// Start a new frame, waits for the GPU if it is still reading the oldest frame's data
+		void BeginFrame();
+
+		// Allocate size bytes aligned to alignment (a power of 2) for the current frame
+		// The returned pointer is only valid until the end of the frame, ptr_ is nullptr if the frame's capacity is used up
+		StreamAllocationGL Allocate(size_t size, size_t alignment);
+
+		// Copy data into a new allocation, returns the offset of the data or -1 if allocation failed
+		GLintptr Upload(void const * data, size_t size, size_t alignment);
+
+		// Make the data written since the last flush visible to the GPU, must be called before drawing from it
+		// Does nothing when the buffer is persistently mapped
+		void Flush();
+
+		// Fence the current frame's data, the frame's ranges are reused once the GPU has passed the fence
+		void EndFrame();
+
+		GLuint GetBuffer() const { return buffer_; }
+
+		// Returns true iff the buffer is persistently mapped rather than orphaned each frame
+		bool IsPersistent() const { return persistent_; }
+
+	private:
+		GLenum target_ { GL_ARRAY_BUFFER };
+		GLuint buffer_ { 0 };
+		bool persistent_ { false };
+
+		// Sub-allocates the buffer by frame, each frame is fenced when the buffer is persistently mapped
+		FencedRingAllocator ring_;
+
+		// Persistently mapped pointer to the whole buffer, or the CPU copy of the frame's data when orphaning
+		uint8_t * mapped_ { nullptr };
+		std::vector<uint8_t> staging_;
+
+		// Range [flush_begin_, flush_end_) of the staging buffer written since the last flush, only used when orphaning
+		size_t flush_begin_ { 0 };
+		size_t flush_end_ { 0 };
+	};
+}
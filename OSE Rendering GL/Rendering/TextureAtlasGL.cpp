@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "TextureAtlasGL.h"
+#include "UploadQueueGL.h"
+
+namespace ose::rendering
+{
+	// create the texture array in GPU memory
+	// the CPU copy of the atlas image data is freed once uploaded, therefore, the atlas must be re-packed before being re-created
+	void TextureAtlasGL::CreateTextureAtlas()
+	{
+		// first, make sure any existing texture is freed
+		DestroyTextureAtlas();
+
+		if(num_layers_ == 0 || img_data_.empty())
+		{
+			LOG_ERROR("Failed to create texture atlas, atlas has not been packed");
+			return;
+		}
+
+		// then, create the new OpenGL texture array with one layer per atlas layer
+		glGenTextures(1, &gl_tex_id_);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, gl_tex_id_);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, layer_width_, layer_height_, num_layers_, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+		// TODO - add support for Anisotropic filtering
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GetGlFilterMode(meta_data_.min_filter_mode_));
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GetGlFilterMode(meta_data_.mag_filter_mode_));
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		if(meta_data_.mip_mapping_enabled_)
+		{
+			// Mip levels below the padding size would blend neighbouring textures together
+			int32_t max_level { GetMaxSafeMipLevel() };
+			if(max_level >= 0)
+				glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, max_level);
+		}
+
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+		// the image data is handed to the upload queue, which owns it until it is stored in GPU memory
+		// the mip chain is generated once the layers have been copied
+		TextureUploadGL region;
+		region.target_ = GL_TEXTURE_2D_ARRAY;
+		region.width_ = layer_width_;
+		region.height_ = layer_height_;
+		region.depth_ = num_layers_;
+		region.generate_mipmap_ = meta_data_.mip_mapping_enabled_;
+		auto data { std::make_shared<std::vector<unsigned char>>(std::move(img_data_)) };
+		img_data_ = {};
+		UploadQueueGL::QueueTexture(gl_tex_id_, region, data->size(), [data](uint8_t * dst) { std::memcpy(dst, data->data(), data->size()); });
+	}
+
+	// free the texture array from GPU memory
+	// IMPORTANT - failure to call this may result in GPU memory leaks
+	void TextureAtlasGL::DestroyTextureAtlas()
+	{
+		// check that the gl_tex_id_ is valid
+		if(gl_tex_id_ != 0)
+		{
+			UploadQueueGL::CancelTexture(gl_tex_id_);
+			// if it is valid, free it then set the variable to 0
+			glDeleteTextures(1, &gl_tex_id_);
+			gl_tex_id_ = 0;
+		}
+	}
+
+	// Convert an engine filter mode to an OpenGL filter mode
+	GLint TextureAtlasGL::GetGlFilterMode(ETextureFilterMode mode)
+	{
+		switch(mode)
+		{
+		case ETextureFilterMode::NEAREST:
+			return GL_NEAREST;
+		case ETextureFilterMode::LINEAR_MIPMAP_NEAREST:
+			return GL_LINEAR_MIPMAP_NEAREST;
+		case ETextureFilterMode::LINEAR_MIPMAP_LINEAR:
+			return GL_LINEAR_MIPMAP_LINEAR;
+		case ETextureFilterMode::NEAREST_MIPMAP_NEAREST:
+			return GL_NEAREST_MIPMAP_NEAREST;
+		case ETextureFilterMode::NEAREST_MIPMAP_LINEAR:
+			return GL_NEAREST_MIPMAP_LINEAR;
+		case ETextureFilterMode::LINEAR:
+		default:
+			return GL_LINEAR;
+		}
+	}
+}
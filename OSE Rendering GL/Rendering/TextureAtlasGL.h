@@ -0,0 +1,31 @@
+#pragma once
+#include "OSE-Core/Resources/Texture/TextureAtlas.h"
+
+namespace ose::rendering
+{
+	// A texture atlas stored in GPU memory as a 2D texture array, one array layer per atlas layer
+	class TextureAtlasGL : public TextureAtlas
+	{
+	public:
+		TextureAtlasGL(int32_t layer_width, int32_t layer_height, int32_t padding) : TextureAtlas(layer_width, layer_height, padding) {}
+		~TextureAtlasGL() {}
+	private:
+		// default to 0, i.e. no texture
+		uint32_t gl_tex_id_ { 0 };
+	public:
+		// get the OpenGL texture ID (of a GL_TEXTURE_2D_ARRAY texture)
+		uint32_t GetGlTexId() const { return gl_tex_id_; }
+
+		// create the texture array in GPU memory
+		// the CPU copy of the atlas image data is freed once uploaded, therefore, the atlas must be re-packed before being re-created
+		void CreateTextureAtlas() override;
+
+		// free the texture array from GPU memory
+		// IMPORTANT - failure to call this may result in GPU memory leaks
+		void DestroyTextureAtlas() override;
+
+	private:
+		// Convert an engine filter mode to an OpenGL filter mode
+		static GLint GetGlFilterMode(ETextureFilterMode mode);
+	};
+}
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "TextureGL.h"
+#include "UploadQueueGL.h"
 
 namespace ose::rendering
 {
@@ -13,12 +14,40 @@ namespace ose::rendering
 		// then, create the new OpenGL texture
 		glGenTextures(1, &gl_tex_id_);
 
+		// block compressed textures are uploaded as they were loaded, so need driver support
+		bool compressed { compressed_image_ && !compressed_image_->levels_.empty() };
+		if(compressed && !GLEW_EXT_texture_compression_s3tc)
+		{
+			DestroyTexture();
+			throw std::runtime_error("Failed to create texture " + name_ + ", S3TC compressed textures are not supported");
+		}
+
 		// set the contents of the texture
+		// mip mapped textures only upload the coarse end of their mip chain, finer levels are streamed in when they are needed
 		glBindTexture(GL_TEXTURE_2D, gl_tex_id_);
-		if(channels_ == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width_, height_, 0, GL_RGBA, GL_UNSIGNED_BYTE, img_data_);
-		else if(channels_ == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width_, height_, 0, GL_RGB, GL_UNSIGNED_BYTE, img_data_);
+		bool streamed { compressed || (meta_data_.mip_mapping_enabled_ && img_data_ && (channels_ == 3 || channels_ == 4)) };
+		if(streamed)
+		{
+			// compressed containers hold their mip chain, otherwise it is built from the loaded image
+			if(compressed)
+				num_levels_ = static_cast<int32_t>(compressed_image_->levels_.size());
+			else
+				BuildMipChain();
+			initial_level_ = 0;
+			while(initial_level_ < num_levels_ - 1 && std::max(GetLevelWidth(initial_level_), GetLevelHeight(initial_level_)) > STREAM_INITIAL_SIZE)
+				++initial_level_;
+			for(int32_t level = num_levels_ - 1; level >= initial_level_; --level)
+				QueueLevelData(level);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, initial_level_);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, num_levels_ - 1);
+		}
+		else
+		{
+			num_levels_ = 1;
+			initial_level_ = 0;
+			if(img_data_ && (channels_ == 3 || channels_ == 4))
+				QueueLevelData(0);
+		}
 
 		// TODO - add support for Anisotropic filtering
 		// set min filter mode
@@ -67,10 +96,6 @@ namespace ose::rendering
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST_MIPMAP_LINEAR);
 			break;
 		}
-
-		if(meta_data_.mip_mapping_enabled_) {
-			glGenerateMipmap(GL_TEXTURE_2D);
-		}
 	}
 
 	// free the texture from GPU memory
@@ -81,9 +106,116 @@ namespace ose::rendering
 		// check that the gl_tex_id_ is valid
 		if(gl_tex_id_ != 0)
 		{
+			// uploads which have not been copied may be reading the image data which is about to be freed
+			UploadQueueGL::CancelTexture(gl_tex_id_);
 			// if it is valid, free it then set the variable to 0
 			glDeleteTextures(1, &gl_tex_id_);
 			gl_tex_id_ = 0;
 		}
+		mip_data_.clear();
+		num_levels_ = 1;
+		initial_level_ = 0;
+	}
+
+	// Upload a level of the mip chain and make it the finest level sampled
+	// The level must be one finer than the current finest level, leaves the texture bound to GL_TEXTURE_2D
+	void TextureGL::UploadLevel(int32_t level) const
+	{
+		if(gl_tex_id_ == 0 || level < 0 || level >= num_levels_)
+			return;
+		glBindTexture(GL_TEXTURE_2D, gl_tex_id_);
+		UploadLevelData(level);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+	}
+
+	// Free the GPU memory of a level and stop sampling it
+	// The level must be the current finest level, leaves the texture bound to GL_TEXTURE_2D
+	void TextureGL::EvictLevel(int32_t level) const
+	{
+		if(gl_tex_id_ == 0 || level < 0 || level >= num_levels_ - 1)
+			return;
+		glBindTexture(GL_TEXTURE_2D, gl_tex_id_);
+		// Levels below the base level are ignored by texture completeness, so respecifying one as empty frees its storage
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level + 1);
+		if(compressed_image_)
+		{
+			glCompressedTexImage2D(GL_TEXTURE_2D, level, GetCompressedFormat(), 0, 0, 0, 0, nullptr);
+		}
+		else
+		{
+			GLenum format { channels_ == 4 ? GLenum(GL_RGBA) : GLenum(GL_RGB) };
+			glTexImage2D(GL_TEXTURE_2D, level, format, 0, 0, 0, format, GL_UNSIGNED_BYTE, nullptr);
+		}
+	}
+
+	// Get the number of bytes of GPU memory used by a level
+	size_t TextureGL::GetLevelSize(int32_t level) const
+	{
+		if(compressed_image_)
+			return compressed_image_->levels_[level].size();
+		return static_cast<size_t>(GetLevelWidth(level)) * GetLevelHeight(level) * channels_;
+	}
+
+	// Get the OpenGL internal format of a block compressed texture
+	GLenum TextureGL::GetCompressedFormat() const
+	{
+		return compressed_image_->format_ == ETextureCompression::BC1 ? GLenum(GL_COMPRESSED_RGB_S3TC_DXT1_EXT) : GLenum(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+	}
+
+	// Fill mip_data_ with every level below the loaded image by averaging 2x2 blocks of the level above
+	void TextureGL::BuildMipChain()
+	{
+		num_levels_ = 1;
+		while((std::max(width_, height_) >> num_levels_) > 0)
+			++num_levels_;
+
+		mip_data_.clear();
+		mip_data_.resize(num_levels_ - 1);
+		for(int32_t level = 1; level < num_levels_; ++level)
+			DownsampleImage(GetLevelData(level - 1), GetLevelWidth(level - 1), GetLevelHeight(level - 1), channels_, mip_data_[level - 1]);
+	}
+
+	// Upload a level of the mip chain to the bound texture
+	void TextureGL::UploadLevelData(int32_t level) const
+	{
+		if(compressed_image_)
+		{
+			auto const & blocks { compressed_image_->levels_[level] };
+			glCompressedTexImage2D(GL_TEXTURE_2D, level, GetCompressedFormat(), GetLevelWidth(level), GetLevelHeight(level), 0,
+				static_cast<GLsizei>(blocks.size()), blocks.data());
+			return;
+		}
+		GLenum format { channels_ == 4 ? GLenum(GL_RGBA) : GLenum(GL_RGB) };
+		// Rows of RGB levels are not 4 byte aligned
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage2D(GL_TEXTURE_2D, level, format, GetLevelWidth(level), GetLevelHeight(level), 0, format, GL_UNSIGNED_BYTE, GetLevelData(level));
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	}
+
+	// Specify the storage of a level of the mip chain on the bound texture and queue the upload of its image data
+	// The texture is not drawn until the upload queue has copied every queued level
+	void TextureGL::QueueLevelData(int32_t level)
+	{
+		TextureUploadGL region;
+		region.level_ = level;
+		region.width_ = GetLevelWidth(level);
+		region.height_ = GetLevelHeight(level);
+		size_t size { GetLevelSize(level) };
+		unsigned char const * data;
+		if(compressed_image_)
+		{
+			region.format_ = GetCompressedFormat();
+			region.compressed_ = true;
+			data = compressed_image_->levels_[level].data();
+			glCompressedTexImage2D(GL_TEXTURE_2D, level, region.format_, region.width_, region.height_, 0, static_cast<GLsizei>(size), nullptr);
+		}
+		else
+		{
+			region.format_ = channels_ == 4 ? GLenum(GL_RGBA) : GLenum(GL_RGB);
+			data = GetLevelData(level);
+			glTexImage2D(GL_TEXTURE_2D, level, region.format_, region.width_, region.height_, 0, region.format_, GL_UNSIGNED_BYTE, nullptr);
+		}
+		// The image data outlives the upload since destroying the texture cancels it
+		UploadQueueGL::QueueTexture(gl_tex_id_, region, size, [data, size](uint8_t * dst) { std::memcpy(dst, data, size); });
 	}
 }
@@ -6,6 +6,10 @@ namespace ose::rendering
 	class TextureGL : public Texture
 	{
 	public:
+		// Mip levels no larger than this (in either dimension) are uploaded when the texture is created
+		// Finer levels are uploaded by the texture streamer once the texture is drawn large enough to need them
+		static constexpr int32_t STREAM_INITIAL_SIZE { 64 };
+
 		// Texture is an abstract class, the full class will contain render library specific data
 		TextureGL(std::string const & name, std::string const & path) : Texture(name, path) {}
 	private:
@@ -23,5 +27,49 @@ namespace ose::rendering
 		// IMPORTANT - cannot be called from destructor since the ResourceManager is multithreaded but the rendering context is not
 		// IMPORTANT - failure to call this may result in GPU memory leaks
 		void DestroyTexture() override;
+
+		// Get the number of levels in the texture's mip chain, 1 if the texture is not mip mapped
+		int32_t GetNumLevels() const { return num_levels_; }
+
+		// Get the finest level uploaded when the texture was created, levels below it are only uploaded by the texture streamer
+		int32_t GetInitialLevel() const { return initial_level_; }
+
+		int32_t GetLevelWidth(int32_t level) const { return std::max(1, width_ >> level); }
+		int32_t GetLevelHeight(int32_t level) const { return std::max(1, height_ >> level); }
+
+		// Get the number of bytes of GPU memory used by a level
+		size_t GetLevelSize(int32_t level) const;
+
+		// Upload a level of the mip chain and make it the finest level sampled
+		// The level must be one finer than the current finest level, leaves the texture bound to GL_TEXTURE_2D
+		void UploadLevel(int32_t level) const;
+
+		// Free the GPU memory of a level and stop sampling it
+		// The level must be the current finest level, leaves the texture bound to GL_TEXTURE_2D
+		void EvictLevel(int32_t level) const;
+
+	private:
+		// Get the image data of a level of the mip chain, level 0 is the loaded image
+		unsigned char const * GetLevelData(int32_t level) const { return level == 0 ? img_data_ : mip_data_[level - 1].data(); }
+
+		// Fill mip_data_ with every level below the loaded image by averaging 2x2 blocks of the level above
+		void BuildMipChain();
+
+		// Upload a level of the mip chain to the bound texture
+		void UploadLevelData(int32_t level) const;
+
+		// Specify the storage of a level of the mip chain on the bound texture and queue the upload of its image data
+		// The texture is not drawn until the upload queue has copied every queued level
+		void QueueLevelData(int32_t level);
+
+		// Get the OpenGL internal format of a block compressed texture
+		GLenum GetCompressedFormat() const;
+
+		int32_t num_levels_ { 1 };
+		int32_t initial_level_ { 0 };
+
+		// Image data of levels 1 onwards, kept s.t. levels can be re-uploaded after they have been evicted
+		// Unused by compressed textures, whose containers already hold their mip chain
+		std::vector<std::vector<unsigned char>> mip_data_;
 	};
 }
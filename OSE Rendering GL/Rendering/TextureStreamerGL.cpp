@@ -0,0 +1,139 @@
+#include "pch.h"
+#include "TextureStreamerGL.h"
+
+namespace ose::rendering
+{
+	// Start streaming a texture, textures added more than once are reference counted
+	// Textures which are not mip mapped are always fully resident and are ignored
+	void TextureStreamerGL::AddTexture(TextureGL const * texture)
+	{
+		if(!texture || texture->GetGlTexId() == 0 || texture->GetNumLevels() <= 1)
+			return;
+
+		StreamedTextureGL & entry { textures_[texture->GetGlTexId()] };
+		if(entry.ref_count_++ > 0)
+			return;
+
+		entry.texture_ = texture;
+		entry.resident_level_ = texture->GetInitialLevel();
+		entry.requested_level_ = entry.resident_level_;
+		for(int32_t level = entry.resident_level_; level < texture->GetNumLevels(); ++level)
+			resident_bytes_ += texture->GetLevelSize(level);
+	}
+
+	// Stop streaming a texture once it has been removed as many times as it was added
+	// The texture's streamed levels are evicted s.t. textures which are no longer drawn don't use GPU memory
+	void TextureStreamerGL::RemoveTexture(GLuint tex_id)
+	{
+		auto iter { textures_.find(tex_id) };
+		if(iter == textures_.end() || --iter->second.ref_count_ > 0)
+			return;
+
+		StreamedTextureGL & entry { iter->second };
+		EvictTo(entry, entry.texture_->GetInitialLevel());
+		for(int32_t level = entry.resident_level_; level < entry.texture_->GetNumLevels(); ++level)
+			resident_bytes_ -= entry.texture_->GetLevelSize(level);
+		textures_.erase(iter);
+	}
+
+	// Request that a texture is drawn at a size on screen (in pixels) this frame
+	// Must be called between calls to Update, the finest level requested during a frame is streamed in
+	void TextureStreamerGL::RequestSize(GLuint tex_id, float screen_size)
+	{
+		auto iter { textures_.find(tex_id) };
+		if(iter == textures_.end())
+			return;
+
+		// Each level halves the size of the texture, so the level whose size matches the screen size is log2 of the ratio
+		StreamedTextureGL & entry { iter->second };
+		TextureGL const & texture { *entry.texture_ };
+		float texture_size { static_cast<float>(std::max(texture.GetWidth(), texture.GetHeight())) };
+		int32_t level { screen_size > 0.0f ? static_cast<int32_t>(std::floor(std::log2(texture_size / screen_size))) : texture.GetNumLevels() - 1 };
+		level = std::clamp(level, 0, texture.GetNumLevels() - 1);
+
+		if(entry.last_used_frame_ != frame_)
+			entry.requested_level_ = level;
+		else
+			entry.requested_level_ = std::min(entry.requested_level_, level);
+		entry.last_used_frame_ = frame_;
+	}
+
+	// Upload the levels requested during the last frame and evict levels to stay within the budget
+	void TextureStreamerGL::Update()
+	{
+		// Find the textures which were drawn last frame with too coarse a level
+		pending_.clear();
+		for(auto & [tex_id, entry] : textures_)
+		{
+			if(entry.last_used_frame_ == frame_ && entry.requested_level_ < entry.resident_level_)
+				pending_.push_back(&entry);
+		}
+
+		// The textures missing the most levels are the most blurred, so are streamed first
+		std::sort(pending_.begin(), pending_.end(), [](StreamedTextureGL const * a, StreamedTextureGL const * b) {
+			return a->resident_level_ - a->requested_level_ > b->resident_level_ - b->requested_level_;
+		});
+
+		// At most one level of each texture is uploaded per frame s.t. the upload limit is shared between textures
+		size_t uploaded { 0 };
+		for(StreamedTextureGL * entry : pending_)
+		{
+			int32_t level { entry->resident_level_ - 1 };
+			size_t size { entry->texture_->GetLevelSize(level) };
+			if(uploaded > 0 && uploaded + size > MAX_UPLOAD_BYTES_PER_FRAME)
+				break;
+			if(!MakeSpace(size))
+				continue;
+
+			entry->texture_->UploadLevel(level);
+			entry->resident_level_ = level;
+			resident_bytes_ += size;
+			uploaded += size;
+		}
+
+		// The budget may have been lowered since the last frame
+		MakeSpace(0);
+
+		++frame_;
+	}
+
+	// Evict the finest levels of the least recently used textures until needed more bytes can be made resident
+	// Levels which were requested last frame are never evicted
+	bool TextureStreamerGL::MakeSpace(size_t needed)
+	{
+		if(budget_ == 0 || resident_bytes_ + needed <= budget_)
+			return true;
+
+		lru_.clear();
+		for(auto & [tex_id, entry] : textures_)
+		{
+			if(entry.resident_level_ < entry.texture_->GetInitialLevel())
+				lru_.push_back(&entry);
+		}
+		std::sort(lru_.begin(), lru_.end(), [](StreamedTextureGL const * a, StreamedTextureGL const * b) {
+			return a->last_used_frame_ < b->last_used_frame_;
+		});
+
+		for(StreamedTextureGL * entry : lru_)
+		{
+			// Textures drawn last frame keep the levels they need but lose any finer levels left over from earlier frames
+			int32_t keep { entry->last_used_frame_ == frame_ ? entry->requested_level_ : entry->texture_->GetInitialLevel() };
+			while(entry->resident_level_ < keep && resident_bytes_ + needed > budget_)
+				EvictTo(*entry, entry->resident_level_ + 1);
+			if(resident_bytes_ + needed <= budget_)
+				return true;
+		}
+		return false;
+	}
+
+	// Evict every level of a texture finer than a level
+	void TextureStreamerGL::EvictTo(StreamedTextureGL & entry, int32_t level)
+	{
+		while(entry.resident_level_ < level)
+		{
+			entry.texture_->EvictLevel(entry.resident_level_);
+			resident_bytes_ -= entry.texture_->GetLevelSize(entry.resident_level_);
+			++entry.resident_level_;
+		}
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "TextureGL.h"
+
+namespace ose::rendering
+{
+	// Streams the fine mip levels of mesh textures in and out of GPU memory
+	// Each frame the rendering engine requests the on-screen size each visible texture is drawn at,
+	// the streamer then uploads the levels required to draw it without magnification whilst keeping the total size
+	// of the resident levels within a budget by evicting the finest levels of the least recently used textures
+	class TextureStreamerGL
+	{
+	public:
+		// Maximum number of bytes of texture data uploaded per frame, s.t. streaming never causes a frame spike
+		static constexpr size_t MAX_UPLOAD_BYTES_PER_FRAME { 4 * 1024 * 1024 };
+
+		// Start streaming a texture, textures added more than once are reference counted
+		// Textures which are not mip mapped are always fully resident and are ignored
+		void AddTexture(TextureGL const * texture);
+
+		// Stop streaming a texture once it has been removed as many times as it was added
+		// The texture's streamed levels are evicted s.t. textures which are no longer drawn don't use GPU memory
+		void RemoveTexture(GLuint tex_id);
+
+		// Request that a texture is drawn at a size on screen (in pixels) this frame
+		// Must be called between calls to Update, the finest level requested during a frame is streamed in
+		void RequestSize(GLuint tex_id, float screen_size);
+
+		// Upload the levels requested during the last frame and evict levels to stay within the budget
+		// Leaves an arbitrary texture bound to GL_TEXTURE_2D, so must be called before the state cache is invalidated
+		void Update();
+
+		// Set the maximum number of bytes of texture data kept resident, 0 for no limit
+		// The coarse levels uploaded when a texture is created are always resident, so the budget may be exceeded by them alone
+		void SetBudget(size_t budget) { budget_ = budget; }
+		size_t GetBudget() const { return budget_; }
+
+		// Get the number of bytes of texture data currently resident
+		size_t GetResidentBytes() const { return resident_bytes_; }
+
+	private:
+		struct StreamedTextureGL
+		{
+			TextureGL const * texture_ { nullptr };
+			uint32_t ref_count_ { 0 };
+
+			// Finest level currently uploaded
+			int32_t resident_level_ { 0 };
+
+			// Finest level requested during the frame last_used_frame_
+			int32_t requested_level_ { 0 };
+			uint64_t last_used_frame_ { 0 };
+		};
+
+		// Evict the finest levels of the least recently used textures until needed more bytes can be made resident
+		// Levels which were requested last frame are never evicted
+		// Returns true iff the bytes fit within the budget
+		bool MakeSpace(size_t needed);
+
+		// Evict every level of a texture finer than a level
+		void EvictTo(StreamedTextureGL & entry, int32_t level);
+
+		// Streamed textures, keyed by OpenGL texture id since render groups only store texture ids
+		std::unordered_map<GLuint, StreamedTextureGL> textures_;
+
+		// Textures which need finer levels, reused between frames
+		std::vector<StreamedTextureGL *> pending_;
+
+		// Textures sorted from least to most recently used, reused between calls to MakeSpace
+		std::vector<StreamedTextureGL *> lru_;
+
+		size_t budget_ { 0 };
+		size_t resident_bytes_ { 0 };
+
+		// Incremented by every call to Update
+		uint64_t frame_ { 1 };
+	};
+}
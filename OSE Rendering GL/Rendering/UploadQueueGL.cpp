@@ -0,0 +1,380 @@
+#include "pch.h"
+#include "UploadQueueGL.h"
+#include <chrono>
+
+namespace ose::rendering
+{
+	// Create the staging buffer and start the worker threads
+	void UploadQueueGL::Start(uint32_t num_workers)
+	{
+		if(IsRunning())
+			Stop();
+
+		// The workers write into the staging buffer whilst the OpenGL thread draws, which requires persistent mapping
+		if(!(GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage))
+		{
+			LOG("Persistently mapped buffers are not supported, GPU uploads will be copied when they are queued");
+			return;
+		}
+
+		GLbitfield flags { GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+		glGenBuffers(1, &staging_buffer_);
+		glBindBuffer(GL_COPY_READ_BUFFER, staging_buffer_);
+		glBufferStorage(GL_COPY_READ_BUFFER, STAGING_CAPACITY, nullptr, flags);
+		staging_ptr_ = static_cast<uint8_t *>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, STAGING_CAPACITY, flags));
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		if(!staging_ptr_)
+		{
+			LOG_ERROR("Failed to map the upload staging buffer, GPU uploads will be copied when they are queued");
+			glDeleteBuffers(1, &staging_buffer_);
+			staging_buffer_ = 0;
+			return;
+		}
+		staging_ring_.Reset(STAGING_CAPACITY);
+		staging_batches_.clear();
+		first_batch_ = 0;
+		open_batch_jobs_ = 0;
+
+		stop_ = false;
+		for(uint32_t i = 0; i < std::max(num_workers, 1u); ++i)
+			workers_.emplace_back(&UploadQueueGL::WorkerLoop);
+	}
+
+	// Stop the worker threads and free the staging buffer, queued uploads are discarded
+	void UploadQueueGL::Stop()
+	{
+		if(!IsRunning())
+			return;
+		{
+			std::lock_guard<std::mutex> lock { mutex_ };
+			stop_ = true;
+		}
+		job_added_.notify_all();
+		for(auto & worker : workers_)
+			worker.join();
+		workers_.clear();
+
+		fill_queue_.clear();
+		waiting_.clear();
+		in_flight_.clear();
+		for(auto & batch : copied_)
+			glDeleteSync(batch.fence_);
+		copied_.clear();
+		pending_buffers_.clear();
+		pending_textures_.clear();
+
+		glBindBuffer(GL_COPY_READ_BUFFER, staging_buffer_);
+		glUnmapBuffer(GL_COPY_READ_BUFFER);
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		glDeleteBuffers(1, &staging_buffer_);
+		staging_buffer_ = 0;
+		staging_ptr_ = nullptr;
+	}
+
+	// Queue an upload of size bytes to the start of a buffer with at least size bytes of storage
+	// The fill function must only read data which outlives the upload (or is owned by the function)
+	void UploadQueueGL::QueueBuffer(GLuint buffer, size_t size, UploadFillGL fill)
+	{
+		uptr<UploadJobGL> job { ose::make_unique<UploadJobGL>() };
+		job->name_ = buffer;
+		job->size_ = size;
+		job->fill_ = std::move(fill);
+		Queue(std::move(job));
+	}
+
+	// Queue an upload of size bytes to a region of a texture
+	// The fill function must only read data which outlives the upload (or is owned by the function)
+	void UploadQueueGL::QueueTexture(GLuint texture, TextureUploadGL const & region, size_t size, UploadFillGL fill)
+	{
+		uptr<UploadJobGL> job { ose::make_unique<UploadJobGL>() };
+		job->name_ = texture;
+		job->texture_ = true;
+		job->region_ = region;
+		job->size_ = size;
+		job->fill_ = std::move(fill);
+		Queue(std::move(job));
+	}
+
+	// Discard the uploads to a buffer or texture which have not yet been copied, must be called before the object is deleted
+	// Blocks whilst a worker is filling one of the object's uploads
+	void UploadQueueGL::CancelBuffer(GLuint buffer)
+	{
+		Cancel(buffer, false);
+	}
+
+	void UploadQueueGL::CancelTexture(GLuint texture)
+	{
+		Cancel(texture, true);
+	}
+
+	// Mark the uploads whose copies have completed as ready, then copy filled uploads until budget_ms has passed
+	// At least one filled upload is copied each frame s.t. the queue always progresses
+	// Leaves arbitrary textures bound, so must be called before the state cache is invalidated
+	void UploadQueueGL::Update(float budget_ms)
+	{
+		if(!IsRunning())
+			return;
+
+		// Retire the batches of copies the GPU has finished, oldest first
+		while(!copied_.empty())
+		{
+			GLenum result { glClientWaitSync(copied_.front().fence_, 0, 0) };
+			if(result == GL_TIMEOUT_EXPIRED)
+				break;
+			if(result == GL_WAIT_FAILED)
+				LOG_ERROR("Failed to wait for upload fence");
+			glDeleteSync(copied_.front().fence_);
+			for(auto const & job : copied_.front().jobs_)
+			{
+				Retire(*job);
+				ReleaseStaging(*job);
+			}
+			copied_.pop_front();
+		}
+
+		// Staging memory freed by retired uploads can be given to waiting uploads
+		AllocateStaging();
+
+		// Copy filled uploads in the order they were queued until the budget is used up
+		// An upload still being filled holds back the uploads queued after it, s.t. newer data for the same buffer or texture is never
+		// overwritten by older data
+		auto start { std::chrono::steady_clock::now() };
+		auto budget { std::chrono::duration<float, std::milli>(budget_ms) };
+		bool copied_any { false };
+		CopyBatchGL batch;
+		for(auto it = in_flight_.begin(); it != in_flight_.end(); )
+		{
+			UploadJobGL & job { **it };
+			if(!job.cancelled_)
+			{
+				if(!job.filled_.load(std::memory_order_acquire))
+					break;
+				if(copied_any && std::chrono::steady_clock::now() - start >= budget)
+					break;
+				Copy(job);
+				copied_any = true;
+				// Data staged in CPU memory is copied by the driver during the call
+				job.heap_ = {};
+			}
+			// Cancelled uploads keep their staging memory until the copies issued before them have completed
+			batch.jobs_.push_back(std::move(*it));
+			it = in_flight_.erase(it);
+		}
+
+		if(!batch.jobs_.empty())
+		{
+			batch.fence_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			copied_.push_back(std::move(batch));
+		}
+	}
+
+	// Add an upload to the queue, or copy it immediately if the queue is not running
+	void UploadQueueGL::Queue(uptr<UploadJobGL> job)
+	{
+		if(job->size_ == 0)
+			return;
+
+		if(!IsRunning())
+		{
+			job->heap_.resize(job->size_);
+			job->fill_(job->heap_.data());
+			Copy(*job);
+			return;
+		}
+
+		++(job->texture_ ? pending_textures_ : pending_buffers_)[job->name_];
+		waiting_.push_back(std::move(job));
+		AllocateStaging();
+	}
+
+	// Give the uploads waiting for staging memory their memory and pass them to the workers
+	void UploadQueueGL::AllocateStaging()
+	{
+		// Staging alignment, large enough for any pixel or vertex format
+		constexpr size_t STAGING_ALIGNMENT { 64 };
+
+		size_t num_added { 0 };
+		while(!waiting_.empty())
+		{
+			uptr<UploadJobGL> & job { waiting_.front() };
+			if(!job->cancelled_)
+			{
+				if(job->size_ > STAGING_CAPACITY)
+				{
+					job->heap_.resize(job->size_);
+					job->dst_ = job->heap_.data();
+				}
+				else
+				{
+					// Uploads are staged in the order they were queued, so later uploads wait for earlier ones to fit
+					size_t offset { staging_ring_.Allocate(job->size_, STAGING_ALIGNMENT) };
+					if(offset == RingAllocator::INVALID_OFFSET)
+						break;
+					job->staging_offset_ = offset;
+					job->dst_ = staging_ptr_ + offset;
+					job->batch_ = first_batch_ + staging_batches_.size();
+					++open_batch_jobs_;
+				}
+
+				std::lock_guard<std::mutex> lock { mutex_ };
+				fill_queue_.push_back(job.get());
+				++num_added;
+				in_flight_.push_back(std::move(job));
+			}
+			waiting_.pop_front();
+		}
+
+		// Close the batch s.t. its staging memory can be released once every upload in it has completed
+		if(open_batch_jobs_ > 0)
+		{
+			staging_ring_.EndFrame();
+			staging_batches_.push_back(open_batch_jobs_);
+			open_batch_jobs_ = 0;
+		}
+
+		if(num_added == 1)
+			job_added_.notify_one();
+		else if(num_added > 1)
+			job_added_.notify_all();
+	}
+
+	// Issue the copy of a filled upload into its buffer or texture
+	void UploadQueueGL::Copy(UploadJobGL const & job)
+	{
+		bool staged { job.staging_offset_ != RingAllocator::INVALID_OFFSET };
+
+		if(!job.texture_)
+		{
+			// The copy targets are used s.t. no vertex array or element array bindings are disturbed
+			glBindBuffer(GL_COPY_WRITE_BUFFER, job.name_);
+			if(staged)
+			{
+				glBindBuffer(GL_COPY_READ_BUFFER, staging_buffer_);
+				glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, job.staging_offset_, 0, job.size_);
+				glBindBuffer(GL_COPY_READ_BUFFER, 0);
+			}
+			else
+			{
+				glBufferSubData(GL_COPY_WRITE_BUFFER, 0, job.size_, job.heap_.data());
+			}
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+			return;
+		}
+
+		// When the staging buffer is bound as the unpack buffer, the pixel pointer is an offset into it
+		TextureUploadGL const & region { job.region_ };
+		void const * pixels { staged ? reinterpret_cast<void const *>(job.staging_offset_) : job.heap_.data() };
+		GLsizei size { static_cast<GLsizei>(job.size_) };
+		if(staged)
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staging_buffer_);
+		glBindTexture(region.target_, job.name_);
+		// Rows of RGB levels are not 4 byte aligned
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		if(region.target_ == GL_TEXTURE_2D_ARRAY)
+		{
+			if(region.compressed_)
+				glCompressedTexSubImage3D(region.target_, region.level_, 0, 0, 0, region.width_, region.height_, region.depth_, region.format_, size, pixels);
+			else
+				glTexSubImage3D(region.target_, region.level_, 0, 0, 0, region.width_, region.height_, region.depth_, region.format_, region.type_, pixels);
+		}
+		else
+		{
+			if(region.compressed_)
+				glCompressedTexSubImage2D(region.target_, region.level_, 0, 0, region.width_, region.height_, region.format_, size, pixels);
+			else
+				glTexSubImage2D(region.target_, region.level_, 0, 0, region.width_, region.height_, region.format_, region.type_, pixels);
+		}
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		if(staged)
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		if(region.generate_mipmap_)
+			glGenerateMipmap(region.target_);
+	}
+
+	// Release the staging memory of an upload once it is no longer read by the GPU
+	void UploadQueueGL::ReleaseStaging(UploadJobGL const & job)
+	{
+		if(job.staging_offset_ == RingAllocator::INVALID_OFFSET)
+			return;
+		--staging_batches_[job.batch_ - first_batch_];
+		while(!staging_batches_.empty() && staging_batches_.front() == 0)
+		{
+			staging_ring_.ReleaseFrame();
+			staging_batches_.pop_front();
+			++first_batch_;
+		}
+	}
+
+	// Mark an upload's object as having one fewer pending upload
+	void UploadQueueGL::Retire(UploadJobGL const & job)
+	{
+		// Cancelling an upload already removed it from the pending count
+		if(job.cancelled_)
+			return;
+		auto & pending { job.texture_ ? pending_textures_ : pending_buffers_ };
+		auto iter { pending.find(job.name_) };
+		if(iter != pending.end() && --iter->second == 0)
+			pending.erase(iter);
+	}
+
+	// Cancel every upload to an object which has not been copied
+	void UploadQueueGL::Cancel(GLuint name, bool texture)
+	{
+		auto & pending { texture ? pending_textures_ : pending_buffers_ };
+		if(pending.erase(name) == 0)
+			return;
+
+		auto matches = [name, texture](uptr<UploadJobGL> const & job) { return job->name_ == name && job->texture_ == texture; };
+
+		std::unique_lock<std::mutex> lock { mutex_ };
+		for(auto & job : waiting_)
+		{
+			if(matches(job))
+				job->cancelled_ = true;
+		}
+		for(auto & job : in_flight_)
+		{
+			if(!matches(job))
+				continue;
+			// The fill may be reading data which is about to be freed, so must finish before the upload is cancelled
+			job_filled_.wait(lock, [&job] { return !job->filling_; });
+			job->cancelled_ = true;
+			fill_queue_.erase(std::remove(fill_queue_.begin(), fill_queue_.end(), job.get()), fill_queue_.end());
+		}
+		for(auto & batch : copied_)
+		{
+			for(auto & job : batch.jobs_)
+			{
+				if(matches(job))
+					job->cancelled_ = true;
+			}
+		}
+	}
+
+	// Fill uploads until the queue is stopped
+	void UploadQueueGL::WorkerLoop()
+	{
+		std::unique_lock<std::mutex> lock { mutex_ };
+		while(true)
+		{
+			job_added_.wait(lock, [] { return stop_ || !fill_queue_.empty(); });
+			if(stop_)
+				break;
+
+			UploadJobGL * job { fill_queue_.front() };
+			fill_queue_.pop_front();
+			job->filling_ = true;
+
+			// Filling can take many milliseconds so the queue is unlocked whilst the job runs
+			lock.unlock();
+			job->fill_(job->dst_);
+			// Release anything the fill function owns
+			job->fill_ = nullptr;
+			lock.lock();
+
+			job->filling_ = false;
+			job->filled_.store(true, std::memory_order_release);
+			job_filled_.notify_all();
+		}
+	}
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include "OSE-Core/Rendering/RingAllocator.h"
+#include <mutex>
+#include <thread>
+#include <deque>
+#include <atomic>
+#include <condition_variable>
+
+namespace ose::rendering
+{
+	// Writes the data of an upload into staging memory of the upload's size, called on a worker thread
+	using UploadFillGL = std::function<void(uint8_t * dst)>;
+
+	// Region of a texture an upload is copied into, the texture's storage must already have been specified
+	struct TextureUploadGL
+	{
+		// GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY
+		GLenum target_ { GL_TEXTURE_2D };
+		int32_t level_ { 0 };
+		int32_t width_ { 0 };
+		int32_t height_ { 0 };
+
+		// Number of layers, only used by GL_TEXTURE_2D_ARRAY
+		int32_t depth_ { 1 };
+
+		// Pixel format and type of the data, format_ is the internal format when the data is block compressed
+		GLenum format_ { GL_RGBA };
+		GLenum type_ { GL_UNSIGNED_BYTE };
+		bool compressed_ { false };
+
+		// Generate the texture's mip chain from the level once it has been copied
+		bool generate_mipmap_ { false };
+	};
+
+	// Moves the CPU side of creating GPU resources off the frame
+	// Worker threads write each upload's data into a persistently mapped staging buffer, then the OpenGL thread copies
+	// the filled uploads into their buffers and textures for up to a time budget per frame
+	// A resource is ready to be drawn once the fence following its last copy has signalled
+	// If the queue has not been started (or the staging buffer cannot be mapped) uploads are copied when they are queued
+	// IMPORTANT - other than the fill functions everything is called on the OpenGL thread
+	class UploadQueueGL
+	{
+	public:
+		// Number of bytes of staging memory, uploads larger than this are staged in their own CPU memory
+		static constexpr size_t STAGING_CAPACITY { 16 * 1024 * 1024 };
+
+		// Create the staging buffer and start the worker threads
+		static void Start(uint32_t num_workers);
+
+		// Stop the worker threads and free the staging buffer, queued uploads are discarded
+		static void Stop();
+
+		// Queue an upload of size bytes to the start of a buffer with at least size bytes of storage
+		// The fill function must only read data which outlives the upload (or is owned by the function)
+		static void QueueBuffer(GLuint buffer, size_t size, UploadFillGL fill);
+
+		// Queue an upload of size bytes to a region of a texture
+		// The fill function must only read data which outlives the upload (or is owned by the function)
+		static void QueueTexture(GLuint texture, TextureUploadGL const & region, size_t size, UploadFillGL fill);
+
+		// Discard the uploads to a buffer or texture which have not yet been copied, must be called before the object is deleted
+		// Blocks whilst a worker is filling one of the object's uploads
+		static void CancelBuffer(GLuint buffer);
+		static void CancelTexture(GLuint texture);
+
+		// Mark the uploads whose copies have completed as ready, then copy filled uploads until budget_ms has passed
+		// At least one filled upload is copied each frame s.t. the queue always progresses
+		// Leaves arbitrary textures bound, so must be called before the state cache is invalidated
+		static void Update(float budget_ms);
+
+		// Returns true iff no uploads to the buffer or texture are waiting to be copied or for their copies to complete
+		// Must not be called concurrently with Update, but may be called from many threads at once
+		static bool IsBufferReady(GLuint buffer) { return pending_buffers_.empty() || pending_buffers_.count(buffer) == 0; }
+		static bool IsTextureReady(GLuint texture) { return pending_textures_.empty() || pending_textures_.count(texture) == 0; }
+
+		// Returns true iff any resource is not yet ready
+		static bool HasPending() { return !pending_buffers_.empty() || !pending_textures_.empty(); }
+
+		// Returns true iff uploads are staged by the worker threads
+		static bool IsRunning() { return !workers_.empty(); }
+
+	private:
+		struct UploadJobGL
+		{
+			GLuint name_ { 0 };
+
+			// The upload is to a buffer if texture_ is false
+			bool texture_ { false };
+			TextureUploadGL region_;
+			size_t size_ { 0 };
+			UploadFillGL fill_;
+
+			// Where the data is written, either in the staging buffer (at staging_offset_) or in heap_
+			uint8_t * dst_ { nullptr };
+			size_t staging_offset_ { RingAllocator::INVALID_OFFSET };
+			std::vector<uint8_t> heap_;
+
+			// Index of the staging batch the upload's staging memory belongs to
+			uint64_t batch_ { 0 };
+
+			// Set by the worker once the data has been written, s.t. Update can poll without locking
+			std::atomic<bool> filled_ { false };
+
+			// Guarded by mutex_, only the OpenGL thread cancels uploads
+			bool filling_ { false };
+			bool cancelled_ { false };
+		};
+
+		// Uploads whose copies were issued in the same frame, fenced once the frame's copies have been issued
+		struct CopyBatchGL
+		{
+			GLsync fence_ { nullptr };
+			std::vector<uptr<UploadJobGL>> jobs_;
+		};
+
+		// Add an upload to the queue, or copy it immediately if the queue is not running
+		static void Queue(uptr<UploadJobGL> job);
+
+		// Give the uploads waiting for staging memory their memory and pass them to the workers
+		static void AllocateStaging();
+
+		// Issue the copy of a filled upload into its buffer or texture
+		static void Copy(UploadJobGL const & job);
+
+		// Release the staging memory of an upload once it is no longer read by the GPU
+		static void ReleaseStaging(UploadJobGL const & job);
+
+		// Mark an upload's object as having one fewer pending upload
+		static void Retire(UploadJobGL const & job);
+
+		// Cancel every upload to an object which has not been copied
+		static void Cancel(GLuint name, bool texture);
+
+		// Fill uploads until the queue is stopped
+		static void WorkerLoop();
+
+		static inline std::vector<std::thread> workers_;
+
+		// Staging buffer, persistently mapped into staging_ptr_
+		static inline GLuint staging_buffer_ { 0 };
+		static inline uint8_t * staging_ptr_ { nullptr };
+		static inline RingAllocator staging_ring_;
+
+		// Number of uploads in each closed batch of the staging ring which still own their staging memory, oldest first
+		// The ring's oldest frame is released once its count reaches 0
+		static inline std::deque<uint32_t> staging_batches_;
+		static inline uint64_t first_batch_ { 0 };
+		static inline uint32_t open_batch_jobs_ { 0 };
+
+		// Uploads waiting for staging memory, then uploads which are being filled or waiting to be copied, oldest first
+		static inline std::deque<uptr<UploadJobGL>> waiting_;
+		static inline std::deque<uptr<UploadJobGL>> in_flight_;
+
+		// Uploads whose copies have been issued but may not have completed, oldest first
+		static inline std::deque<CopyBatchGL> copied_;
+
+		// Number of uploads to each buffer and texture which have not completed
+		static inline std::unordered_map<GLuint, uint32_t> pending_buffers_;
+		static inline std::unordered_map<GLuint, uint32_t> pending_textures_;
+
+		// Guards the fill queue, the filling and cancelled flags of every job and the stop flag
+		static inline std::mutex mutex_;
+		static inline std::condition_variable job_added_;
+		static inline std::condition_variable job_filled_;
+		static inline std::deque<UploadJobGL *> fill_queue_;
+		static inline bool stop_ { false };
+	};
+}
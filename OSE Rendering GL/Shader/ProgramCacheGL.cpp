@@ -0,0 +1,141 @@
+#include "pch.h"
+#include "ProgramCacheGL.h"
+#include "OSE-Core/File System/FileSystemUtil.h"
+
+namespace ose::shader
+{
+	// Returns true iff the driver supports retrieving program binaries (GL 4.1 or ARB_get_program_binary)
+	bool ProgramCacheGL::IsSupported()
+	{
+		if(!(GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary))
+			return false;
+		// Some drivers support the extension but no binary formats
+		GLint num_formats { 0 };
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+		return num_formats > 0;
+	}
+
+	// Set the directory the cache files are written to, defaults to ShaderCache next to the executable
+	void ProgramCacheGL::SetDirectory(std::string const & directory)
+	{
+		std::lock_guard<std::mutex> lock { mutex_ };
+		directory_ = directory;
+	}
+
+	// Get the cache key of a program built from vertex and fragment source code
+	uint64_t ProgramCacheGL::HashSource(char const * vert_source, char const * frag_source)
+	{
+		// The sources are separated by their null terminators s.t. moving text between them changes the key
+		uint64_t hash { Hash(vert_source, std::strlen(vert_source) + 1) };
+		return Hash(frag_source, std::strlen(frag_source) + 1, hash);
+	}
+
+	// Create a program from the binary cached for a key
+	// Returns 0 if there is no usable binary, in which case the program must be built from source
+	GLuint ProgramCacheGL::Load(uint64_t key)
+	{
+		if(!IsSupported())
+			return 0;
+
+		std::string path { GetPath(key) };
+		std::ifstream file { path, std::ios::binary };
+		if(!file)
+			return 0;
+
+		FileHeader header;
+		if(!file.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic_ != FILE_MAGIC
+			|| header.version_ != FILE_VERSION || header.key_ != key || header.driver_hash_ != GetDriverHash())
+		{
+			// The file is stale (written by another driver) or not a cache file, it will be overwritten once the program is built
+			return 0;
+		}
+
+		std::vector<char> binary(header.binary_length_);
+		if(!file.read(binary.data(), binary.size()))
+			return 0;
+
+		GLuint prog { glCreateProgram() };
+		glProgramBinary(prog, header.binary_format_, binary.data(), static_cast<GLsizei>(binary.size()));
+
+		// Drivers may reject a binary even if it was written by the same driver version, e.g. after a hardware change
+		GLint is_linked { 0 };
+		glGetProgramiv(prog, GL_LINK_STATUS, &is_linked);
+		if(is_linked == GL_FALSE)
+		{
+			DEBUG_LOG("Cached program binary", path, "was rejected by the driver");
+			glDeleteProgram(prog);
+			file.close();
+			std::remove(path.c_str());
+			return 0;
+		}
+		return prog;
+	}
+
+	// Write the binary of a linked program to the cache
+	// The program should have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set
+	void ProgramCacheGL::Store(uint64_t key, GLuint prog)
+	{
+		if(!IsSupported())
+			return;
+
+		GLint length { 0 };
+		glGetProgramiv(prog, GL_PROGRAM_BINARY_LENGTH, &length);
+		if(length <= 0)
+			return;
+
+		FileHeader header { FILE_MAGIC, FILE_VERSION, GetDriverHash(), key, 0, 0 };
+		std::vector<char> binary(length);
+		GLenum format { 0 };
+		glGetProgramBinary(prog, length, &length, &format, binary.data());
+		header.binary_format_ = format;
+		header.binary_length_ = static_cast<uint32_t>(length);
+
+		std::string path { GetPath(key) };
+		fs::CreateDirs(fs::GetParentPath(path));
+		std::ofstream file { path, std::ios::binary | std::ios::trunc };
+		if(!file.write(reinterpret_cast<char const *>(&header), sizeof(header)) || !file.write(binary.data(), length))
+			LOG_ERROR("Failed to write program binary", path);
+	}
+
+	// Get the hash of the vendor, renderer and version strings, binaries are only valid for the driver which wrote them
+	uint64_t ProgramCacheGL::GetDriverHash()
+	{
+		std::lock_guard<std::mutex> lock { mutex_ };
+		if(driver_hash_ == 0)
+		{
+			uint64_t hash { Hash(nullptr, 0) };
+			for(GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+			{
+				char const * str { reinterpret_cast<char const *>(glGetString(name)) };
+				if(str)
+					hash = Hash(str, std::strlen(str) + 1, hash);
+			}
+			driver_hash_ = hash;
+		}
+		return driver_hash_;
+	}
+
+	// Get the path of the cache file of a key
+	std::string ProgramCacheGL::GetPath(uint64_t key)
+	{
+		std::lock_guard<std::mutex> lock { mutex_ };
+		if(directory_.empty())
+			directory_ = fs::GetExecutableDirectory() + "/ShaderCache";
+
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+		return directory_ + "/" + name;
+	}
+
+	// 64-bit FNV-1a, stable between runs unlike std::hash
+	uint64_t ProgramCacheGL::Hash(void const * data, size_t size, uint64_t hash)
+	{
+		unsigned char const * bytes { static_cast<unsigned char const *>(data) };
+		for(size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+}
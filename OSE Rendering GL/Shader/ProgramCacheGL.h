@@ -0,0 +1,59 @@
+#pragma once
+#include <mutex>
+
+namespace ose::shader
+{
+	// Persists linked programs to disk with glGetProgramBinary s.t. later runs can skip compiling and linking
+	// Programs are keyed by a hash of their final source code (including any defines)
+	// Cached binaries are ignored if they were written by a different driver or the driver rejects them
+	class ProgramCacheGL
+	{
+	public:
+		// Identifies a program cache file and the layout of its header
+		static constexpr uint32_t FILE_MAGIC { 0x4750534F };
+		static constexpr uint32_t FILE_VERSION { 1 };
+
+		// Returns true iff the driver supports retrieving program binaries (GL 4.1 or ARB_get_program_binary)
+		static bool IsSupported();
+
+		// Set the directory the cache files are written to, defaults to ShaderCache next to the executable
+		static void SetDirectory(std::string const & directory);
+
+		// Get the cache key of a program built from vertex and fragment source code
+		static uint64_t HashSource(char const * vert_source, char const * frag_source);
+
+		// Create a program from the binary cached for a key
+		// Returns 0 if there is no usable binary, in which case the program must be built from source
+		static GLuint Load(uint64_t key);
+
+		// Write the binary of a linked program to the cache
+		// The program should have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set
+		static void Store(uint64_t key, GLuint prog);
+
+	private:
+		// Header at the start of each cache file, followed by the program binary
+		struct FileHeader
+		{
+			uint32_t magic_;
+			uint32_t version_;
+			uint64_t driver_hash_;
+			uint64_t key_;
+			uint32_t binary_format_;
+			uint32_t binary_length_;
+		};
+
+		// Get the hash of the vendor, renderer and version strings, binaries are only valid for the driver which wrote them
+		static uint64_t GetDriverHash();
+
+		// Get the path of the cache file of a key
+		static std::string GetPath(uint64_t key);
+
+		// 64-bit FNV-1a, stable between runs unlike std::hash
+		static uint64_t Hash(void const * data, size_t size, uint64_t hash = 14695981039346656037ull);
+
+		// Guards the directory and driver hash, programs may be built on a worker thread with a shared context
+		static inline std::mutex mutex_;
+		static inline std::string directory_;
+		static inline uint64_t driver_hash_ { 0 };
+	};
+}
@@ -0,0 +1,84 @@
+#include "pch.h"
+#include "ShaderCompilerGL.h"
+
+namespace ose::shader
+{
+	// Start the worker thread
+	// make_current is called on the worker thread before any job is run and must make the shared context current
+	// release is called on the worker thread before it exits and must release the shared context
+	void ShaderCompilerGL::Start(std::function<void()> make_current, std::function<void()> release)
+	{
+		if(worker_.joinable())
+			Stop();
+		stop_ = false;
+		worker_ = std::thread(&ShaderCompilerGL::WorkerLoop, std::move(make_current), std::move(release));
+	}
+
+	// Run any jobs which are still queued, then stop the worker thread
+	void ShaderCompilerGL::Stop()
+	{
+		if(!worker_.joinable())
+			return;
+		{
+			std::lock_guard<std::mutex> lock { mutex_ };
+			stop_ = true;
+		}
+		job_added_.notify_one();
+		worker_.join();
+	}
+
+	// Add a job to the queue, the job is run on the worker thread with the shared context current
+	// The job must call glFinish (or fence) before publishing its results s.t. they are complete in the main context
+	void ShaderCompilerGL::Submit(std::function<void()> job)
+	{
+		if(!worker_.joinable())
+		{
+			job();
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock { mutex_ };
+			jobs_.push_back(std::move(job));
+		}
+		job_added_.notify_one();
+	}
+
+	// Block until every submitted job has finished
+	void ShaderCompilerGL::WaitIdle()
+	{
+		std::unique_lock<std::mutex> lock { mutex_ };
+		idle_.wait(lock, [] { return jobs_.empty() && !busy_; });
+	}
+
+	// Run jobs until the worker is stopped and the queue is empty
+	void ShaderCompilerGL::WorkerLoop(std::function<void()> make_current, std::function<void()> release)
+	{
+		if(make_current)
+			make_current();
+
+		std::unique_lock<std::mutex> lock { mutex_ };
+		while(true)
+		{
+			job_added_.wait(lock, [] { return stop_ || !jobs_.empty(); });
+			if(jobs_.empty())
+				break;
+
+			std::function<void()> job { std::move(jobs_.front()) };
+			jobs_.pop_front();
+			busy_ = true;
+
+			// Compiling can take many milliseconds so the queue is unlocked whilst the job runs
+			lock.unlock();
+			job();
+			lock.lock();
+
+			busy_ = false;
+			if(jobs_.empty())
+				idle_.notify_all();
+		}
+		lock.unlock();
+
+		if(release)
+			release();
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <mutex>
+#include <thread>
+#include <deque>
+#include <condition_variable>
+
+namespace ose::shader
+{
+	// Builds shader programs on a worker thread with its own OpenGL context (sharing objects with the main context)
+	// s.t. compiling a new shader variant never stalls the frame which first requires it
+	// If the worker has not been started (e.g. the windowing library cannot create shared contexts) jobs are run immediately
+	class ShaderCompilerGL
+	{
+	public:
+		// Start the worker thread
+		// make_current is called on the worker thread before any job is run and must make the shared context current
+		// release is called on the worker thread before it exits and must release the shared context
+		static void Start(std::function<void()> make_current, std::function<void()> release);
+
+		// Run any jobs which are still queued, then stop the worker thread
+		static void Stop();
+
+		// Add a job to the queue, the job is run on the worker thread with the shared context current
+		// The job must call glFinish (or fence) before publishing its results s.t. they are complete in the main context
+		static void Submit(std::function<void()> job);
+
+		// Block until every submitted job has finished
+		static void WaitIdle();
+
+		// Returns true iff jobs are run on the worker thread
+		static bool IsRunning() { return worker_.joinable(); }
+
+	private:
+		// Run jobs until the worker is stopped and the queue is empty
+		static void WorkerLoop(std::function<void()> make_current, std::function<void()> release);
+
+		static inline std::thread worker_;
+
+		// Guards the queue, the busy flag and the stop flag
+		static inline std::mutex mutex_;
+		static inline std::condition_variable job_added_;
+		static inline std::condition_variable idle_;
+		static inline std::deque<std::function<void()>> jobs_;
+		static inline bool busy_ { false };
+		static inline bool stop_ { false };
+	};
+}
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "ShaderProgGLSL.h"
 #include "ShaderLayer.h"
+#include "ProgramCacheGL.h"
 #include "OSE-Core/Shader/EShaderType.h"
 
 #include "OSE-Core/Shader/Nodes/BRDFNode.h"
@@ -49,6 +50,121 @@ namespace ose::shader
 			glDeleteShader(shader_prog_);
 	}
 
+	// Resolve the uniform locations of a newly linked program and bind its uniform blocks to the shared binding points
+	void ShaderProgGLSL::OnProgramLinked(GLuint prog)
+	{
+		uniforms_.world_transform_ = glGetUniformLocation(prog, "worldTransform");
+		BindSharedUniforms(prog);
+	}
+
+	// Bind the uniform blocks and light cluster samplers of a program to the shared binding points and texture units
+	// The program must be in use s.t. its sampler uniforms can be set
+	void ShaderProgGLSL::BindSharedUniforms(GLuint prog)
+	{
+		// Programs which don't use a block get GL_INVALID_INDEX and are skipped
+		GLuint frame_block { glGetUniformBlockIndex(prog, "FrameData") };
+		if(frame_block != GL_INVALID_INDEX)
+			glUniformBlockBinding(prog, frame_block, FRAME_UNIFORM_BLOCK_BINDING);
+		GLuint light_block { glGetUniformBlockIndex(prog, "LightData") };
+		if(light_block != GL_INVALID_INDEX)
+			glUniformBlockBinding(prog, light_block, LIGHT_UNIFORM_BLOCK_BINDING);
+		GLuint cluster_block { glGetUniformBlockIndex(prog, "ClusterData") };
+		if(cluster_block != GL_INVALID_INDEX)
+			glUniformBlockBinding(prog, cluster_block, CLUSTER_UNIFORM_BLOCK_BINDING);
+
+		// The light cluster samplers always read from the same units, see UniformBlocksGL.h
+		GLint cluster_lights { glGetUniformLocation(prog, "clusterLights") };
+		if(cluster_lights != -1)
+			glUniform1i(cluster_lights, CLUSTER_LIGHTS_TEXTURE_UNIT);
+		GLint light_indices { glGetUniformLocation(prog, "lightIndices") };
+		if(light_indices != -1)
+			glUniform1i(light_indices, LIGHT_INDICES_TEXTURE_UNIT);
+		GLint point_lights { glGetUniformLocation(prog, "pointLights") };
+		if(point_lights != -1)
+			glUniform1i(point_lights, POINT_LIGHTS_TEXTURE_UNIT);
+	}
+
+	// Compile a shader object from source code, returns 0 and logs the info log if compilation fails
+	GLuint ShaderProgGLSL::CompileShader(GLenum type, char const * source)
+	{
+		GLuint shader { glCreateShader(type) };
+		glShaderSource(shader, 1, &source, NULL);
+		glCompileShader(shader);
+
+		GLint is_compiled { 0 };
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &is_compiled);
+		if(is_compiled == GL_FALSE)
+		{
+			GLint max_length { 0 };
+			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &max_length);
+
+			// The max_length includes the NULL character
+			std::vector<GLchar> error_log(std::max(max_length, 1));
+			glGetShaderInfoLog(shader, max_length, &max_length, &error_log[0]);
+			LOG_ERROR(std::string(error_log.begin(), error_log.end()));
+
+			glDeleteShader(shader);
+			return 0;
+		}
+		return shader;
+	}
+
+	// Link a program from a vertex and fragment shader, returns 0 and logs the info log if linking fails
+	// The shader objects are deleted whether or not linking succeeds
+	GLuint ShaderProgGLSL::LinkProgram(GLuint vert, GLuint frag)
+	{
+		if(vert == 0 || frag == 0)
+		{
+			glDeleteShader(vert);
+			glDeleteShader(frag);
+			return 0;
+		}
+
+		GLuint prog { glCreateProgram() };
+		// The hint must be set before linking for the binary to be retrievable by the program cache
+		if(ProgramCacheGL::IsSupported())
+			glProgramParameteri(prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glAttachShader(prog, vert);
+		glAttachShader(prog, frag);
+		glLinkProgram(prog);
+		glDetachShader(prog, vert);
+		glDetachShader(prog, frag);
+		glDeleteShader(vert);
+		glDeleteShader(frag);
+
+		GLint is_linked { 0 };
+		glGetProgramiv(prog, GL_LINK_STATUS, &is_linked);
+		if(is_linked == GL_FALSE)
+		{
+			GLint max_length { 0 };
+			glGetProgramiv(prog, GL_INFO_LOG_LENGTH, &max_length);
+
+			// The max_length includes the NULL character
+			std::vector<GLchar> error_log(std::max(max_length, 1));
+			glGetProgramInfoLog(prog, max_length, &max_length, &error_log[0]);
+			LOG_ERROR(std::string(error_log.begin(), error_log.end()));
+
+			glDeleteProgram(prog);
+			return 0;
+		}
+		return prog;
+	}
+
+	// Build a program from vertex and fragment source code, returns 0 if compiling or linking fails
+	// The program binary is loaded from the program cache if available, otherwise the built program is added to the cache
+	GLuint ShaderProgGLSL::BuildProgram(char const * vert_source, char const * frag_source)
+	{
+		uint64_t key { ProgramCacheGL::HashSource(vert_source, frag_source) };
+		GLuint prog { ProgramCacheGL::Load(key) };
+		if(prog != 0)
+			return prog;
+
+		prog = LinkProgram(CompileShader(GL_VERTEX_SHADER, vert_source), CompileShader(GL_FRAGMENT_SHADER, frag_source));
+		if(prog != 0)
+			ProgramCacheGL::Store(key, prog);
+		return prog;
+	}
+
 	// Split the shader graph nodes into layers
 	// All nodes in a layer can be computed simultaneously
 	void ShaderProgGLSL::CreateLayers(std::vector<ShaderLayer> & layers, std::vector<ShaderNode *> & expended_nodes)
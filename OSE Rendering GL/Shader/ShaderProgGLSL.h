@@ -1,6 +1,8 @@
 #pragma once
 #include "OSE-Core/Shader/ShaderProg.h"
 #include "OSE-Core/Shader/ShaderNode.h"
+#include "UniformBlocksGL.h"
+#include "ShaderVariantGL.h"
 
 namespace ose::shader
 {
@@ -21,6 +23,18 @@ namespace ose::shader
 		// Get the shader program id
 		uint32_t GetShaderProgId() const { return shader_prog_; }
 
+		// Get the locations of the uniforms set by the rendering engine
+		ShaderUniformsGL const & GetUniforms() const { return uniforms_; }
+
+		// Get the program which writes the shader's surface properties to the G-buffer in the deferred render path
+		// Returns 0 if the shader can only be used by the forward render path
+		virtual GLuint GetGBufferShaderProgId() const { return 0; }
+
+		// Get the variant of the shader compiled for a set of features (bit mask of EShaderFeature)
+		// Variants may still be building when returned, see ShaderVariantGL::ready_
+		// Returns nullptr if the shader has no variants, in which case the shader program is used for every material
+		virtual ShaderVariantGL const * GetVariant(uint32_t features) const { return nullptr; }
+
 	private:
 		// Split the shader graph nodes into layers
 		// All nodes in a layer can be computed simultaneously
@@ -38,8 +52,30 @@ namespace ose::shader
 		//uint32_t CreateShaderObject();
 
 	protected:
+		// Resolve the uniform locations of a newly linked program and bind its uniform blocks to the shared binding points
+		// The program must be in use s.t. its sampler uniforms can be set
+		void OnProgramLinked(GLuint prog);
+
+		// Bind the uniform blocks and light cluster samplers of a program to the shared binding points and texture units
+		// The program must be in use s.t. its sampler uniforms can be set
+		static void BindSharedUniforms(GLuint prog);
+
+		// Compile a shader object from source code, returns 0 and logs the info log if compilation fails
+		static GLuint CompileShader(GLenum type, char const * source);
+
+		// Link a program from a vertex and fragment shader, returns 0 and logs the info log if linking fails
+		// The shader objects are deleted whether or not linking succeeds
+		static GLuint LinkProgram(GLuint vert, GLuint frag);
+
+		// Build a program from vertex and fragment source code, returns 0 if compiling or linking fails
+		// The program binary is loaded from the program cache if available, otherwise the built program is added to the cache
+		static GLuint BuildProgram(char const * vert_source, char const * frag_source);
+
 		// OpenGL shader program id
 		uint32_t shader_prog_ { 0 };
+
+		// Locations of the uniforms set by the rendering engine
+		ShaderUniformsGL uniforms_;
 	};
 }
 
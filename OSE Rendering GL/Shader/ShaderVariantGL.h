@@ -0,0 +1,24 @@
+#pragma once
+#include <atomic>
+#include "UniformBlocksGL.h"
+
+namespace ose::shader
+{
+	// A permutation of a shader program compiled with the defines of a set of shader features
+	// Variants may be compiled on the shader compiler's worker thread, their programs must not be used until ready_ is set
+	struct ShaderVariantGL
+	{
+		// Bit mask of EShaderFeature the variant was compiled with
+		uint32_t features_ { 0 };
+
+		// Set once the variant has finished building, prog_ is 0 if building failed
+		std::atomic<bool> ready_ { false };
+
+		// Forward program and G-buffer program (0 if the variant can only be drawn forward)
+		GLuint prog_ { 0 };
+		GLuint gbuffer_prog_ { 0 };
+
+		// Locations of the uniforms set by the rendering engine
+		ShaderUniformsGL uniforms_;
+	};
+}
@@ -1,48 +1,40 @@
 #include "pch.h"
 #include "BRDFShaderProgGLSL.h"
+#include "../ShaderCompilerGL.h"
+#include "OSE-Core/Shader/EShaderFeature.h"
 
 namespace ose::shader
 {
-	BRDFShaderProgGLSL::BRDFShaderProgGLSL() : ShaderProgGLSL(nullptr)
-	{
-
-	}
-
-	BRDFShaderProgGLSL::~BRDFShaderProgGLSL()
-	{
-
-	}
-
-	// Build an OpenGL shader object from a shader graph
-	void BRDFShaderProgGLSL::CreateShaderProg()
+	namespace
 	{
-		if(shader_prog_)
-			return;
-
-		// Builds the deferred rendering shader
-		GLuint vert = glCreateShader(GL_VERTEX_SHADER);
-		char const * vert_source =
+		// Meshes are drawn instanced, the world transform and normal matrix are per-instance attributes
+		// Layout matches RenderGroupGL::MESH_INSTANCE_STRIDE
+		constexpr char const * VERT_SOURCE =
 			"#version 330\n"
 			"layout(location = 0) in vec3 position;\n"
 			"layout(location = 1) in vec3 normal;\n"
 			"layout(location = 2) in vec2 uv;\n"
 			"layout(location = 3) in vec3 tangent;\n"
+			"layout(location = 4) in mat4 worldTransform;\n"
+			"layout(location = 8) in mat3 normalMatrix;\n"
 			"out vec2 vertexUV;\n"
 			"out vec3 vertexNormal;\n"
 			"out vec3 vertexWorldPos;\n"
 			"out mat3 vertexTBN;\n"
-			"uniform mat4 viewProjMatrix;\n"
-			"uniform mat4 worldTransform;\n"
+			"layout(std140) uniform FrameData {\n"
+			"	mat4 viewProjMatrix;\n"
+			"	vec4 cameraPos;\n"
+			"};\n"
 			"uniform sampler2D texSampler;\n"
 			"void main() {\n"
 			"	vertexUV = uv;\n"
 			"	vertexWorldPos = vec3(worldTransform * vec4(position, 1.0));\n"
 
-				// TODO - Confirm that this is the correct transform (possibly should be model transform)
-			"	vertexNormal = mat3(transpose(inverse(worldTransform))) * normal;\n"
+				// The normal matrix is precomputed on the CPU when the instance's transform changes
+			"	vertexNormal = normalMatrix * normal;\n"
 
 			"	vec3 T = normalize(vec3(worldTransform * vec4(tangent, 0.0)));\n"
-			"	vec3 N = normalize(vec3(worldTransform * vec4(normal, 0.0)));\n"
+			"	vec3 N = normalize(vertexNormal);\n"
 				// Orthogonalise T wrt. N then calculate the bi-tangent vector B and the TBN matrix
 			"	T = normalize(T - dot(T, N) * N);\n"
 			"	vec3 B = cross(N, T);\n"
@@ -51,40 +43,9 @@ namespace ose::shader
 			"	gl_Position = (viewProjMatrix * worldTransform) * vec4(position, 1.0);\n"
 			"}\n"
 			;
-			/*"#version 330\n"
-			"layout (location = 0) in vec2 position;\n"
-			"layout (location = 1) in vec2 texCoords;\n"
-			"out vec2 TexCoords;\n"
-			"void main() {\n"
-			"	gl_Position = vec4(position.x, position.y, 0.0, 1.0);\n"
-			"	TexCoords = texCoords;\n"
-			"}\n"
-			;*/
-		glShaderSource(vert, 1, &vert_source, NULL);
-		glCompileShader(vert);
-
-		GLint isCompiled = 0;
-		glGetShaderiv(vert, GL_COMPILE_STATUS, &isCompiled);
-		if(isCompiled == GL_FALSE)
-		{
-			GLint maxLength = 0;
-			glGetShaderiv(vert, GL_INFO_LOG_LENGTH, &maxLength);
-
-			// The maxLength includes the NULL character
-			std::vector<GLchar> errorLog(maxLength);
-			glGetShaderInfoLog(vert, maxLength, &maxLength, &errorLog[0]);
-			std::string msg(errorLog.begin(), errorLog.end());
-			LOG_ERROR(msg);
-
-			// Provide the infolog in whatever manor you deem best.
-			// Exit with failure.
-			glDeleteShader(vert); // Don't leak the shader.
-			return;
-		}
 
-		GLuint frag = glCreateShader(GL_FRAGMENT_SHADER);
-		char const * frag_source =
-			"#version 330\n"
+		// Forward program, the version and feature defines are prepended by GetHeader
+		constexpr char const * FORWARD_FRAG_BODY =
 			"in vec2 vertexUV;\n"
 			"in vec3 vertexNormal;\n"
 			"in vec3 vertexWorldPos;\n"
@@ -97,21 +58,31 @@ namespace ose::shader
 			"uniform sampler2D roughnessMap;\n"
 			"uniform sampler2D aoMap;\n"
 
-			"struct PointLight {\n"
-			"	vec3 position;\n"
-			"	vec3 color;\n"
+			// Light and camera data are shared by every program through uniform blocks, see UniformBlocksGL.h
+			"struct DirLight {\n"
+			"	vec4 direction;\n"
+			"	vec4 color;\n"
+			"};\n"
+
+			"layout(std140) uniform LightData {\n"
+			"	DirLight dirLights[16];\n"
+			"	ivec4 numLights;\n"
 			"};\n"
-			"uniform PointLight pointLights[16];\n"
-			"uniform int numPointLights;\n"
 
-			"struct DirLight {\n"
-			"	vec3 direction;\n"
-			"	vec3 color;\n"
+			// Point lights are read from the lists of the fragment's cluster, see LightClustersGL
+			"layout(std140) uniform ClusterData {\n"
+			"	mat4 viewMatrix;\n"
+			"	vec4 clusterScale;\n"
+			"	ivec4 clusterDims;\n"
 			"};\n"
-			"uniform DirLight dirLights[16];\n"
-			"uniform int numDirLights;\n"
+			"uniform usamplerBuffer clusterLights;\n"
+			"uniform usamplerBuffer lightIndices;\n"
+			"uniform samplerBuffer pointLights;\n"
 
-			"uniform vec3 cameraPos;\n"
+			"layout(std140) uniform FrameData {\n"
+			"	mat4 viewProjMatrix;\n"
+			"	vec4 cameraPos;\n"
+			"};\n"
 
 			"float pi = 3.14159265359;\n"
 
@@ -155,27 +126,52 @@ namespace ose::shader
 			"}\n"
 
 			"void main() {\n"
-				// Get the fragment properties from the map textures
-			"	vec3 albedo = texture(albedoMap, vertexUV).rgb;\n"
+				// Get the fragment properties from the map textures, materials without the maps use the vertex normal and constants
+			"	vec4 albedoSample = texture(albedoMap, vertexUV);\n"
+			"#ifdef FEATURE_ALPHA_TEST\n"
+			"	if(albedoSample.a < 0.5) discard;\n"
+			"#endif\n"
+			"	vec3 albedo = albedoSample.rgb;\n"
+			"#ifdef FEATURE_NORMAL_MAP\n"
 			"	vec3 normal = getNormalFromNormalMap();\n"
+			"#else\n"
+			"	vec3 normal = vertexNormal;\n"
+			"#endif\n"
+			"#ifdef FEATURE_PBR_MAPS\n"
 			"	float metallic = texture(metallicMap, vertexUV).r;\n"
 			"	float roughness = texture(roughnessMap, vertexUV).r;\n"
 			"	float ao = texture(aoMap, vertexUV).r;\n"
+			"#else\n"
+			"	float metallic = 0.0;\n"
+			"	float roughness = 0.5;\n"
+			"	float ao = 1.0;\n"
+			"#endif\n"
 				// Normalise the vertex direction and normal
-			"	vec3 V = normalize(cameraPos - vertexWorldPos);\n"
+			"	vec3 V = normalize(cameraPos.xyz - vertexWorldPos);\n"
 			"	vec3 N = normalize(normal);\n"
 				// For non-metallic surfaces, F0 is always 0.04
 			"	vec3 F0 = vec3(0.04);\n"
 			"	F0 = mix(F0, albedo, metallic);\n"
-				// Calculate the illumination from each point light
 			"	vec3 Lo = vec3(0.0);\n"
-			"	for(int i = 0; i < numPointLights && i < 16; ++i) {\n"
+			"#ifdef FEATURE_POINT_LIGHTS\n"
+				// Find the cluster containing the fragment
+			"	float viewDepth = -(viewMatrix * vec4(vertexWorldPos, 1.0)).z;\n"
+			"	ivec3 cluster = ivec3(ivec2(gl_FragCoord.xy * clusterScale.xy), int(log(max(viewDepth, 0.0001)) * clusterScale.z + clusterScale.w));\n"
+			"	cluster = clamp(cluster, ivec3(0), clusterDims.xyz - 1);\n"
+			"	uvec2 lightRange = texelFetch(clusterLights, cluster.x + clusterDims.x * (cluster.y + clusterDims.y * cluster.z)).xy;\n"
+				// Calculate the illumination from each point light in the cluster
+			"	for(uint l = 0u; l < lightRange.y; ++l) {\n"
+			"		int light = int(texelFetch(lightIndices, int(lightRange.x + l)).r);\n"
+			"		vec4 lightPosRadius = texelFetch(pointLights, light * 2);\n"
+			"		vec3 lightColor = texelFetch(pointLights, light * 2 + 1).rgb;\n"
 					// Calculate the radiance at the fragment due to the light source
-			"		vec3 L = normalize(pointLights[i].position - vertexWorldPos);\n"
+			"		vec3 L = normalize(lightPosRadius.xyz - vertexWorldPos);\n"
 			"		vec3 H = normalize(V + L);\n"
-			"		float distance = length(pointLights[i].position - vertexWorldPos);\n"
-			"		float attenuation = 1.0 / (distance * distance);\n"
-			"		vec3 radiance = pointLights[i].color.rgb * attenuation;\n"
+			"		float distance = length(lightPosRadius.xyz - vertexWorldPos);\n"
+					// Fade the inverse square falloff to zero at the light's radius s.t. lights don't pop at cluster boundaries
+			"		float window = clamp(1.0 - pow(distance / lightPosRadius.w, 4.0), 0.0, 1.0);\n"
+			"		float attenuation = window * window / (distance * distance);\n"
+			"		vec3 radiance = lightColor * attenuation;\n"
 					// Calculate the Cook-Torrance BRDF
 			"		float NDF = distributionGGX(N, H, roughness);\n"
 			"		float G = geometrySmith(N, V, L, roughness);\n"
@@ -192,10 +188,12 @@ namespace ose::shader
 			"		float NdotL = max(dot(N, L), 0.0);\n"
 			"		Lo += (kD * albedo / pi + specular) * radiance * NdotL;\n"
 			"	}\n"
+			"#endif\n"
+			"#ifdef FEATURE_DIR_LIGHTS\n"
 				// Calculate the illumination from each direction light
-			"	for(int i = 0; i < numDirLights && i < 16; ++i) {\n"
+			"	for(int i = 0; i < numLights.y && i < 16; ++i) {\n"
 					// Calculate the radiance at the fragment due to the light source
-			"		vec3 L = normalize(dirLights[i].direction);\n"
+			"		vec3 L = normalize(dirLights[i].direction.xyz);\n"
 			"		vec3 H = normalize(V + L);\n"
 			"		vec3 radiance = dirLights[i].color.rgb;\n"
 					// Calculate the Cook-Torrance BRDF
@@ -214,6 +212,7 @@ namespace ose::shader
 			"		float NdotL = max(dot(N, L), 0.0);\n"
 			"		Lo += (kD * albedo / pi + specular) * radiance * NdotL;\n"
 			"	}\n"
+			"#endif\n"
 				// Add ambient light to the fragment
 			"	vec3 ambient = vec3(0.03) * albedo * ao;\n"
 			"	vec3 color = ambient + Lo;\n"
@@ -222,108 +221,176 @@ namespace ose::shader
 			"	color = pow(color, vec3(1.0 / 2.2));\n"
 				// Set the output color
 			"	fragColor = vec4(color, 1.0);\n"
-		//	"   fragColor = vec4(1, 1, 1, 1);\n"
-		//	"	fragColor = vec4(N, 1);\n"
 			"}\n"
 			;
-		/*	"#version 330\n"
-			"in vec2 TexCoords;\n"
-			"out vec4 outColor;\n"
-			"uniform sampler2D gPos;\n"
-			"uniform sampler2D gNormal;\n"
-			"uniform sampler2D gColourSpec;\n"
-			"struct PointLight {\n"
-			"	vec4 position;\n"
-			"	vec4 color;\n"
-			"	float intensity;\n"
-			"};\n"
-			"uniform PointLight pointLights[16];\n"
-			"uniform int numPointLights;\n"
+
+		// Writes the surface properties lit by DeferredLightingShaderProgGLSL
+		// Layout matches the colour attachments of FramebufferGL
+		constexpr char const * GBUFFER_FRAG_BODY =
+			"in vec2 vertexUV;\n"
+			"in vec3 vertexNormal;\n"
+			"in vec3 vertexWorldPos;\n"
+			"in mat3 vertexTBN;\n"
+			"layout(location = 0) out vec4 gPosition;\n"
+			"layout(location = 1) out vec4 gNormal;\n"
+			"layout(location = 2) out vec4 gAlbedo;\n"
+
+			"uniform sampler2D albedoMap;\n"
+			"uniform sampler2D normalMap;\n"
+			"uniform sampler2D metallicMap;\n"
+			"uniform sampler2D roughnessMap;\n"
+			"uniform sampler2D aoMap;\n"
+
 			"void main() {\n"
-			"	vec3 fragPos	   = texture(gPos, TexCoords).rgb;\n"
-			"	vec3 surfaceNormal = texture(gNormal, TexCoords).rgb;\n"
-			"	vec4 texColor	   = vec4(texture(gColourSpec, TexCoords).rgb, 1.0);\n"
-			"	float shininess	   = texture(gColourSpec, TexCoords).a;\n"
-			"	vec4 color = vec4(0, 0, 0, 1);\n"
-			"	for(int i = 0; i < 16 && i < numPointLights; ++i) {\n"
-			"		color += pointLights[i].color;\n"
-			"	}\n"
-			"	color *= texColor;\n"
-			//"	float gamma = 2.2;\n"
-			//"	colour.rgb = pow(colour.rgb, vec3(1.0/gamma));\n"
-			//"	colour = vec4(1, 1, 0, 1);\n"
-			"	outColor = color;\n"
+			"	vec4 albedo = texture(albedoMap, vertexUV);\n"
+			"#ifdef FEATURE_ALPHA_TEST\n"
+			"	if(albedo.a < 0.5) discard;\n"
+			"#endif\n"
+			"#ifdef FEATURE_NORMAL_MAP\n"
+			"	vec3 normal = normalize(vertexTBN * (texture(normalMap, vertexUV).xyz * 2.0 - 1.0));\n"
+			"#else\n"
+			"	vec3 normal = normalize(vertexNormal);\n"
+			"#endif\n"
+			"#ifdef FEATURE_PBR_MAPS\n"
+			"	gPosition = vec4(vertexWorldPos, texture(metallicMap, vertexUV).r);\n"
+			"	gNormal = vec4(normal, texture(roughnessMap, vertexUV).r);\n"
+			"	gAlbedo = vec4(albedo.rgb, texture(aoMap, vertexUV).r);\n"
+			"#else\n"
+			"	gPosition = vec4(vertexWorldPos, 0.0);\n"
+			"	gNormal = vec4(normal, 0.5);\n"
+			"	gAlbedo = vec4(albedo.rgb, 1.0);\n"
+			"#endif\n"
 			"}\n"
 			;
-			*/
+	}
 
-		glShaderSource(frag, 1, &frag_source, NULL);
-		glCompileShader(frag);
+	BRDFShaderProgGLSL::BRDFShaderProgGLSL() : ShaderProgGLSL(nullptr)
+	{
 
-		isCompiled = 0;
-		glGetShaderiv(frag, GL_COMPILE_STATUS, &isCompiled);
-		if(isCompiled == GL_FALSE)
-		{
-			GLint maxLength = 0;
-			glGetShaderiv(frag, GL_INFO_LOG_LENGTH, &maxLength);
+	}
+
+	BRDFShaderProgGLSL::~BRDFShaderProgGLSL()
+	{
 
-			// The maxLength includes the NULL character
-			std::vector<GLchar> errorLog(maxLength);
-			glGetShaderInfoLog(frag, maxLength, &maxLength, &errorLog[0]);
-			std::string msg(errorLog.begin(), errorLog.end());
-			LOG_ERROR(msg);
+	}
 
-			// Exit with failure.
-			glDeleteShader(frag); // Don't leak the shader.
+	// Build an OpenGL shader object from a shader graph
+	// Only the default variant is built immediately, other variants are built when a material first requests them
+	void BRDFShaderProgGLSL::CreateShaderProg()
+	{
+		if(shader_prog_)
 			return;
-		}
 
-		GLuint prog = glCreateProgram();
-		glAttachShader(prog, vert);
-		glAttachShader(prog, frag);
-		glLinkProgram(prog);
+		auto variant { ose::make_unique<ShaderVariantGL>() };
+		variant->features_ = SHADER_FEATURE_DEFAULT;
+		BuildVariant(*variant);
+		variant->ready_ = true;
+		if(variant->prog_ == 0)
+			return;
 
-		GLint isLinked = 0;
-		glGetProgramiv(prog, GL_LINK_STATUS, (int *)&isLinked);
-		if (isLinked == GL_FALSE)
-		{
-			GLint maxLength = 0;
-			glGetProgramiv(prog, GL_INFO_LOG_LENGTH, &maxLength);
+		shader_prog_ = variant->prog_;
+		gbuffer_shader_prog_ = variant->gbuffer_prog_;
+		uniforms_ = variant->uniforms_;
+		variants_.emplace(SHADER_FEATURE_DEFAULT, std::move(variant));
+	}
 
-			// The maxLength includes the NULL character
-			std::vector<GLchar> errorLog(maxLength);
-			glGetProgramInfoLog(prog, maxLength, &maxLength, &errorLog[0]);
-			std::string msg(errorLog.begin(), errorLog.end());
-			LOG_ERROR(msg);
+	// Get the variant of the shader compiled for a set of features (bit mask of EShaderFeature)
+	// If the variant has not been requested before it is submitted to the shader compiler
+	ShaderVariantGL const * BRDFShaderProgGLSL::GetVariant(uint32_t features) const
+	{
+		if(shader_prog_ == 0)
+			return nullptr;
+
+		features &= ALL_FEATURES;
+		auto iter { variants_.find(features) };
+		if(iter != variants_.end())
+			return iter->second.get();
+
+		ShaderVariantGL * variant { variants_.emplace(features, ose::make_unique<ShaderVariantGL>()).first->second.get() };
+		variant->features_ = features;
+		ShaderCompilerGL::Submit([variant]() {
+			BuildVariant(*variant);
+			// The programs must be complete before the main context can use them
+			glFinish();
+			variant->ready_.store(true, std::memory_order_release);
+		});
+		return variant;
+	}
+
+	// Get the defines which enable a set of features, prefixed by the version directive
+	std::string BRDFShaderProgGLSL::GetHeader(uint32_t features)
+	{
+		std::string header { "#version 330\n" };
+		if(features & SHADER_FEATURE_NORMAL_MAP)
+			header += "#define FEATURE_NORMAL_MAP\n";
+		if(features & SHADER_FEATURE_PBR_MAPS)
+			header += "#define FEATURE_PBR_MAPS\n";
+		if(features & SHADER_FEATURE_POINT_LIGHTS)
+			header += "#define FEATURE_POINT_LIGHTS\n";
+		if(features & SHADER_FEATURE_DIR_LIGHTS)
+			header += "#define FEATURE_DIR_LIGHTS\n";
+		if(features & SHADER_FEATURE_ALPHA_TEST)
+			header += "#define FEATURE_ALPHA_TEST\n";
+		return header;
+	}
 
-			// We don't need the program anymore.
-			glDeleteProgram(prog);
+	// Build the forward and G-buffer programs of a variant, may be called on the shader compiler's worker thread
+	void BRDFShaderProgGLSL::BuildVariant(ShaderVariantGL & variant)
+	{
+		std::string header { GetHeader(variant.features_) };
 
-			// Don't leak shaders either.
-			glDeleteShader(vert);
-			glDeleteShader(frag);
+		GLuint prog { BuildProgram(VERT_SOURCE, (header + FORWARD_FRAG_BODY).c_str()) };
+		if(prog == 0)
+		{
+			LOG_ERROR("Failed to build BRDF shader variant", variant.features_);
 			return;
 		}
+		SetSamplers(prog);
+		variant.uniforms_.world_transform_ = glGetUniformLocation(prog, "worldTransform");
+		variant.prog_ = prog;
 
-		glDetachShader(prog, vert);
-		glDetachShader(prog, frag);
-		glDeleteShader(vert);
-		glDeleteShader(frag);
+		// The deferred lighting pass shades every light, so variants which exclude a type of light are always drawn forward
+		uint32_t constexpr ALL_LIGHTS { SHADER_FEATURE_POINT_LIGHTS | SHADER_FEATURE_DIR_LIGHTS };
+		if((variant.features_ & ALL_LIGHTS) != ALL_LIGHTS)
+			return;
 
+		GLuint gbuffer_prog { BuildProgram(VERT_SOURCE, (header + GBUFFER_FRAG_BODY).c_str()) };
+		if(gbuffer_prog == 0)
+		{
+			LOG_ERROR("Failed to build the G-buffer program of BRDF shader variant", variant.features_, ", it will be drawn by the forward path");
+			return;
+		}
+		SetSamplers(gbuffer_prog);
+		variant.gbuffer_prog_ = gbuffer_prog;
+	}
+
+	// Assign the material maps to their texture units and bind the shared uniform blocks
+	void BRDFShaderProgGLSL::SetSamplers(GLuint prog)
+	{
+		// Maps which are compiled out of a variant have no location and are skipped by glUniform1i
 		glUseProgram(prog);
 		glUniform1i(glGetUniformLocation(prog, "albedoMap"), 0);
 		glUniform1i(glGetUniformLocation(prog, "normalMap"), 1);
 		glUniform1i(glGetUniformLocation(prog, "metallicMap"), 2);
 		glUniform1i(glGetUniformLocation(prog, "roughnessMap"), 3);
 		glUniform1i(glGetUniformLocation(prog, "aoMap"), 4);
-
-		shader_prog_ = prog;
+		BindSharedUniforms(prog);
 	}
 
 	// Destroy the OpenGL shader object
 	void BRDFShaderProgGLSL::DestroyShaderProg()
 	{
-		if(shader_prog_)
-			glDeleteProgram(shader_prog_);
+		// Variants still being built reference this shader's variant map
+		ShaderCompilerGL::WaitIdle();
+		for(auto const & [features, variant] : variants_)
+		{
+			if(variant->prog_)
+				glDeleteProgram(variant->prog_);
+			if(variant->gbuffer_prog_)
+				glDeleteProgram(variant->gbuffer_prog_);
+		}
+		variants_.clear();
+		shader_prog_ = 0;
+		gbuffer_shader_prog_ = 0;
 	}
 }
@@ -10,9 +10,37 @@ namespace ose::shader
 		virtual ~BRDFShaderProgGLSL();
 
 		// Build an OpenGL shader object from a shader graph
+		// Only the default variant is built immediately, other variants are built when a material first requests them
 		void CreateShaderProg() override;
 
 		// Destroy the OpenGL shader object
 		void DestroyShaderProg() override;
+
+		// Get the program which writes the surface properties to the G-buffer in the deferred render path
+		GLuint GetGBufferShaderProgId() const override { return gbuffer_shader_prog_; }
+
+		// Get the variant of the shader compiled for a set of features (bit mask of EShaderFeature)
+		// If the variant has not been requested before it is submitted to the shader compiler
+		ShaderVariantGL const * GetVariant(uint32_t features) const override;
+
+	private:
+		// Every feature the shader has a define for, other bits of a feature mask are ignored
+		static constexpr uint32_t ALL_FEATURES { 0x1F };
+
+		// Get the defines which enable a set of features, prefixed by the version directive
+		static std::string GetHeader(uint32_t features);
+
+		// Build the forward and G-buffer programs of a variant, may be called on the shader compiler's worker thread
+		static void BuildVariant(ShaderVariantGL & variant);
+
+		// Assign the material maps to their texture units and bind the shared uniform blocks
+		static void SetSamplers(GLuint prog);
+
+		// Program used by the geometry pass of the deferred render path by the default variant, 0 if it failed to build
+		GLuint gbuffer_shader_prog_ { 0 };
+
+		// Variants requested so far, including the default variant, keyed by their feature mask
+		// Only accessed on the main thread, variants are never removed until the shader is destroyed s.t. pointers stay valid
+		mutable std::unordered_map<uint32_t, uptr<ShaderVariantGL>> variants_;
 	};
 }
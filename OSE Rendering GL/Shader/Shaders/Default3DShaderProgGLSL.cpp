@@ -20,17 +20,19 @@ namespace ose::shader
 			return;
 
 		// TEST - Builds default 3d shader
-		GLuint vert = glCreateShader(GL_VERTEX_SHADER);
 		char const * vert_source =
 			"#version 330\n"
 			"layout(location = 0) in vec3 position;\n"
 			"layout(location = 1) in vec3 normal;\n"
 			"layout(location = 2) in vec2 uv;\n"
+			"layout(location = 4) in mat4 worldTransform;\n"
 			"out vec2 vertexUV;\n"
 			"out vec3 vertexNormal;\n"
 			"out vec3 vertexCamSpacePos;\n"
-			"uniform mat4 viewProjMatrix;\n"
-			"uniform mat4 worldTransform;\n"
+			"layout(std140) uniform FrameData {\n"
+			"	mat4 viewProjMatrix;\n"
+			"	vec4 cameraPos;\n"
+			"};\n"
 			"uniform sampler2D texSampler;\n"
 			"void main() {\n"
 			"	vertexUV = uv;\n"
@@ -39,29 +41,6 @@ namespace ose::shader
 			"	gl_Position = (viewProjMatrix * worldTransform) * vec4(position, 1.0);\n"
 			"}\n"
 			;
-		glShaderSource(vert, 1, &vert_source, NULL);
-		glCompileShader(vert);
-
-		GLint isCompiled = 0;
-		glGetShaderiv(vert, GL_COMPILE_STATUS, &isCompiled);
-		if(isCompiled == GL_FALSE)
-		{
-			GLint maxLength = 0;
-			glGetShaderiv(vert, GL_INFO_LOG_LENGTH, &maxLength);
-
-			// The maxLength includes the NULL character
-			std::vector<GLchar> errorLog(maxLength);
-			glGetShaderInfoLog(vert, maxLength, &maxLength, &errorLog[0]);
-			std::string msg(errorLog.begin(), errorLog.end());
-			LOG_ERROR(msg);
-
-			// Provide the infolog in whatever manor you deem best.
-			// Exit with failure.
-			glDeleteShader(vert); // Don't leak the shader.
-			return;
-		}
-
-		GLuint frag = glCreateShader(GL_FRAGMENT_SHADER);
 		char const * frag_source =
 			"#version 330\n"
 			"layout(location = 0) out vec3 gPos;\n"
@@ -84,62 +63,14 @@ namespace ose::shader
 			//"	fragColor = vec4(1, 0, 0, 1);\n"
 			"}\n"
 			;
-		glShaderSource(frag, 1, &frag_source, NULL);
-		glCompileShader(frag);
-
-		isCompiled = 0;
-		glGetShaderiv(frag, GL_COMPILE_STATUS, &isCompiled);
-		if(isCompiled == GL_FALSE)
-		{
-			GLint maxLength = 0;
-			glGetShaderiv(frag, GL_INFO_LOG_LENGTH, &maxLength);
-
-			// The maxLength includes the NULL character
-			std::vector<GLchar> errorLog(maxLength);
-			glGetShaderInfoLog(frag, maxLength, &maxLength, &errorLog[0]);
-
-			// Provide the infolog in whatever manor you deem best.
-			// Exit with failure.
-			glDeleteShader(frag); // Don't leak the shader.
+		GLuint prog { BuildProgram(vert_source, frag_source) };
+		if(prog == 0)
 			return;
-		}
-
-		GLuint prog = glCreateProgram();
-		glAttachShader(prog, vert);
-		glAttachShader(prog, frag);
-		glLinkProgram(prog);
-
-		GLint isLinked = 0;
-		glGetProgramiv(prog, GL_LINK_STATUS, (int *)&isLinked);
-		if (isLinked == GL_FALSE)
-		{
-			GLint maxLength = 0;
-			glGetProgramiv(prog, GL_INFO_LOG_LENGTH, &maxLength);
-
-			// The maxLength includes the NULL character
-			std::vector<GLchar> infoLog(maxLength);
-			glGetProgramInfoLog(prog, maxLength, &maxLength, &infoLog[0]);
-
-			// We don't need the program anymore.
-			glDeleteProgram(prog);
-			// Don't leak shaders either.
-			glDeleteShader(vert);
-			glDeleteShader(frag);
-
-			// Use the infoLog as you see fit.
-
-			// In this simple program, we'll just leave
-			return;
-		}
-
-		glDetachShader(prog, vert);
-		glDetachShader(prog, frag);
-		glDeleteShader(vert);
-		glDeleteShader(frag);
 
 		glUseProgram(prog);
 		glUniform1i(glGetUniformLocation(prog, "texSampler"), 0);
 
+		OnProgramLinked(prog);
 		shader_prog_ = prog;
 	}
 
@@ -0,0 +1,208 @@
+#include "pch.h"
+#include "DeferredLightingShaderProgGLSL.h"
+
+namespace ose::shader
+{
+	DeferredLightingShaderProgGLSL::DeferredLightingShaderProgGLSL() : ShaderProgGLSL(nullptr)
+	{
+
+	}
+
+	DeferredLightingShaderProgGLSL::~DeferredLightingShaderProgGLSL()
+	{
+
+	}
+
+	// Build an OpenGL shader object from a shader graph
+	void DeferredLightingShaderProgGLSL::CreateShaderProg()
+	{
+		if(shader_prog_)
+			return;
+
+		// A single triangle covering the screen is generated from the vertex ID, no vertex buffer is required
+		char const * vert_source =
+			"#version 330\n"
+			"void main() {\n"
+			"	vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);\n"
+			"	gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);\n"
+			"}\n"
+			;
+
+		// Reads the G-buffer written by BRDFShaderProgGLSL's G-buffer program
+		// The BRDF matches the forward path s.t. switching path does not change the lit result
+		char const * frag_source =
+			"#version 330\n"
+			"out vec4 fragColor;\n"
+
+			"uniform sampler2D gPosition;\n"
+			"uniform sampler2D gNormal;\n"
+			"uniform sampler2D gAlbedo;\n"
+
+			// Light and camera data are shared by every program through uniform blocks, see UniformBlocksGL.h
+			"struct DirLight {\n"
+			"	vec4 direction;\n"
+			"	vec4 color;\n"
+			"};\n"
+
+			"layout(std140) uniform LightData {\n"
+			"	DirLight dirLights[16];\n"
+			"	ivec4 numLights;\n"
+			"};\n"
+
+			// Point lights are read from the lists of the fragment's cluster, see LightClustersGL
+			"layout(std140) uniform ClusterData {\n"
+			"	mat4 viewMatrix;\n"
+			"	vec4 clusterScale;\n"
+			"	ivec4 clusterDims;\n"
+			"};\n"
+			"uniform usamplerBuffer clusterLights;\n"
+			"uniform usamplerBuffer lightIndices;\n"
+			"uniform samplerBuffer pointLights;\n"
+
+			"layout(std140) uniform FrameData {\n"
+			"	mat4 viewProjMatrix;\n"
+			"	vec4 cameraPos;\n"
+			"};\n"
+
+			"float pi = 3.14159265359;\n"
+
+			// Approximates the ratio of reflection (specular) to refraction (diffuse)
+			"vec3 fresnelSchlick(float cosTheta, vec3 F0) {\n"
+			"	return F0 + (1.0 - F0) * pow(1.0 - cosTheta, 5.0);\n"
+			"}\n"
+
+			"float distributionGGX(vec3 N, vec3 H, float roughness) {\n"
+			"	float a = roughness * roughness;\n"
+			"	float a2 = a * a;\n"
+			"	float NdotH = max(dot(N, H), 0.0);\n"
+			"	float NdotH2 = NdotH * NdotH;\n"
+			"	float num = a2;\n"
+			"	float denom = (NdotH2 * (a2 - 1.0) + 1.0);\n"
+			"	denom = pi * denom * denom;\n"
+			"	return num / denom;\n"
+			"}\n"
+
+			"float geometrySchlickGGX(float NdotV, float roughness) {\n"
+			"	float r = roughness + 1.0;\n"
+			"	float k = (r * r) / 8.0;\n"
+			"	float num = NdotV;\n"
+			"	float denom = NdotV * (1.0 - k) + k;\n"
+			"	return num / denom;\n"
+			"}\n"
+
+			"float geometrySmith(vec3 N, vec3 V, vec3 L, float roughness) {\n"
+			"	float NdotV = max(dot(N, V), 0.0);\n"
+			"	float NdotL = max(dot(N, L), 0.0);\n"
+			"	float ggx2 = geometrySchlickGGX(NdotV, roughness);\n"
+			"	float ggx1 = geometrySchlickGGX(NdotL, roughness);\n"
+			"	return ggx1 * ggx2;\n"
+			"}\n"
+
+			"void main() {\n"
+			"	ivec2 texel = ivec2(gl_FragCoord.xy);\n"
+			"	vec4 normalRoughness = texelFetch(gNormal, texel, 0);\n"
+				// Pixels not covered by the geometry pass have a zero normal, leave them to the forward passes
+			"	if(normalRoughness.xyz == vec3(0.0))\n"
+			"		discard;\n"
+			"	vec4 posMetallic = texelFetch(gPosition, texel, 0);\n"
+			"	vec4 albedoAO = texelFetch(gAlbedo, texel, 0);\n"
+			"	vec3 worldPos = posMetallic.xyz;\n"
+			"	vec3 albedo = albedoAO.rgb;\n"
+			"	float metallic = posMetallic.w;\n"
+			"	float roughness = normalRoughness.w;\n"
+			"	float ao = albedoAO.a;\n"
+			"	vec3 V = normalize(cameraPos.xyz - worldPos);\n"
+			"	vec3 N = normalize(normalRoughness.xyz);\n"
+				// For non-metallic surfaces, F0 is always 0.04
+			"	vec3 F0 = vec3(0.04);\n"
+			"	F0 = mix(F0, albedo, metallic);\n"
+				// Find the cluster containing the fragment
+			"	float viewDepth = -(viewMatrix * vec4(worldPos, 1.0)).z;\n"
+			"	ivec3 cluster = ivec3(ivec2(gl_FragCoord.xy * clusterScale.xy), int(log(max(viewDepth, 0.0001)) * clusterScale.z + clusterScale.w));\n"
+			"	cluster = clamp(cluster, ivec3(0), clusterDims.xyz - 1);\n"
+			"	uvec2 lightRange = texelFetch(clusterLights, cluster.x + clusterDims.x * (cluster.y + clusterDims.y * cluster.z)).xy;\n"
+				// Calculate the illumination from each point light in the cluster
+			"	vec3 Lo = vec3(0.0);\n"
+			"	for(uint l = 0u; l < lightRange.y; ++l) {\n"
+			"		int light = int(texelFetch(lightIndices, int(lightRange.x + l)).r);\n"
+			"		vec4 lightPosRadius = texelFetch(pointLights, light * 2);\n"
+			"		vec3 lightColor = texelFetch(pointLights, light * 2 + 1).rgb;\n"
+					// Calculate the radiance at the fragment due to the light source
+			"		vec3 L = normalize(lightPosRadius.xyz - worldPos);\n"
+			"		vec3 H = normalize(V + L);\n"
+			"		float distance = length(lightPosRadius.xyz - worldPos);\n"
+					// Fade the inverse square falloff to zero at the light's radius s.t. lights don't pop at cluster boundaries
+			"		float window = clamp(1.0 - pow(distance / lightPosRadius.w, 4.0), 0.0, 1.0);\n"
+			"		float attenuation = window * window / (distance * distance);\n"
+			"		vec3 radiance = lightColor * attenuation;\n"
+					// Calculate the Cook-Torrance BRDF
+			"		float NDF = distributionGGX(N, H, roughness);\n"
+			"		float G = geometrySmith(N, V, L, roughness);\n"
+			"		vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);\n"
+					// Calculate the ratio of specular and diffuse lighting
+			"		vec3 kS = F;\n"
+			"		vec3 kD = vec3(1.0) - kS;\n"
+			"		kD *= 1.0 - metallic;\n"
+					// Calculate the specular highlight
+			"		vec3 num = NDF * G * F;\n"
+			"		float denom = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0);\n"
+			"		vec3 specular = num / max(denom, 0.001);\n"
+					// Add to the total radiance at the frament
+			"		float NdotL = max(dot(N, L), 0.0);\n"
+			"		Lo += (kD * albedo / pi + specular) * radiance * NdotL;\n"
+			"	}\n"
+				// Calculate the illumination from each direction light
+			"	for(int i = 0; i < numLights.y && i < 16; ++i) {\n"
+					// Calculate the radiance at the fragment due to the light source
+			"		vec3 L = normalize(dirLights[i].direction.xyz);\n"
+			"		vec3 H = normalize(V + L);\n"
+			"		vec3 radiance = dirLights[i].color.rgb;\n"
+					// Calculate the Cook-Torrance BRDF
+			"		float NDF = distributionGGX(N, H, roughness);\n"
+			"		float G = geometrySmith(N, V, L, roughness);\n"
+			"		vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);\n"
+					// Calculate the ratio of specular and diffuse lighting
+			"		vec3 kS = F;\n"
+			"		vec3 kD = vec3(1.0) - kS;\n"
+			"		kD *= 1.0 - metallic;\n"
+					// Calculate the specular highlight
+			"		vec3 num = NDF * G * F;\n"
+			"		float denom = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0);\n"
+			"		vec3 specular = num / max(denom, 0.001);\n"
+					// Add to the total radiance at the frament
+			"		float NdotL = max(dot(N, L), 0.0);\n"
+			"		Lo += (kD * albedo / pi + specular) * radiance * NdotL;\n"
+			"	}\n"
+				// Add ambient light to the fragment
+			"	vec3 ambient = vec3(0.03) * albedo * ao;\n"
+			"	vec3 color = ambient + Lo;\n"
+				// Apply gamma correction
+			"	color /= (color + vec3(1.0));\n"
+			"	color = pow(color, vec3(1.0 / 2.2));\n"
+				// Set the output color
+			"	fragColor = vec4(color, 1.0);\n"
+			"}\n"
+			;
+
+		GLuint prog { BuildProgram(vert_source, frag_source) };
+		if(prog == 0)
+			return;
+
+		// The G-buffer attachments are bound to units 0 to 2 in the order of FramebufferGL's colour attachments
+		glUseProgram(prog);
+		glUniform1i(glGetUniformLocation(prog, "gPosition"), 0);
+		glUniform1i(glGetUniformLocation(prog, "gNormal"), 1);
+		glUniform1i(glGetUniformLocation(prog, "gAlbedo"), 2);
+
+		OnProgramLinked(prog);
+		shader_prog_ = prog;
+	}
+
+	// Destroy the OpenGL shader object
+	void DeferredLightingShaderProgGLSL::DestroyShaderProg()
+	{
+		if(shader_prog_)
+			glDeleteProgram(shader_prog_);
+		shader_prog_ = 0;
+	}
+}
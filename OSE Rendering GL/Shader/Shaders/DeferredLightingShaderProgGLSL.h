@@ -0,0 +1,20 @@
+#pragma once
+#include "../ShaderProgGLSL.h"
+
+namespace ose::shader
+{
+	// Lights the contents of the G-buffer in a single full screen pass
+	// Used by the lighting pass of ERenderPath::DEFERRED, point lights are read from the light clusters
+	class DeferredLightingShaderProgGLSL final : public ShaderProgGLSL
+	{
+	public:
+		DeferredLightingShaderProgGLSL();
+		virtual ~DeferredLightingShaderProgGLSL();
+
+		// Build an OpenGL shader object from a shader graph
+		void CreateShaderProg() override;
+
+		// Destroy the OpenGL shader object
+		void DestroyShaderProg() override;
+	};
+}
@@ -0,0 +1,59 @@
+#include "pch.h"
+#include "OverlayShaderProgGLSL.h"
+
+namespace ose::shader
+{
+	OverlayShaderProgGLSL::OverlayShaderProgGLSL() : ShaderProgGLSL(nullptr)
+	{
+
+	}
+
+	OverlayShaderProgGLSL::~OverlayShaderProgGLSL()
+	{
+
+	}
+
+	// Build an OpenGL shader object from a shader graph
+	void OverlayShaderProgGLSL::CreateShaderProg()
+	{
+		if(shader_prog_)
+			return;
+
+		// Vertices 0 to 3 are the corners of the rectangle in triangle strip order
+		char const * vert_source =
+			"#version 330\n"
+			"uniform vec4 rect;\n"
+			"void main() {\n"
+			"	vec2 corner = vec2(gl_VertexID & 1, (gl_VertexID >> 1) & 1);\n"
+			"	gl_Position = vec4(mix(rect.xy, rect.zw, corner), 0.0, 1.0);\n"
+			"}\n"
+			;
+
+		char const * frag_source =
+			"#version 330\n"
+			"out vec4 fragColor;\n"
+			"uniform vec4 colour;\n"
+			"void main() {\n"
+			"	fragColor = colour;\n"
+			"}\n"
+			;
+
+		GLuint prog { BuildProgram(vert_source, frag_source) };
+		if(prog == 0)
+			return;
+
+		rect_location_ = glGetUniformLocation(prog, "rect");
+		colour_location_ = glGetUniformLocation(prog, "colour");
+
+		OnProgramLinked(prog);
+		shader_prog_ = prog;
+	}
+
+	// Destroy the OpenGL shader object
+	void OverlayShaderProgGLSL::DestroyShaderProg()
+	{
+		if(shader_prog_)
+			glDeleteProgram(shader_prog_);
+		shader_prog_ = 0;
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "../ShaderProgGLSL.h"
+
+namespace ose::shader
+{
+	// Draws a single flat coloured rectangle, used by the profiler overlay
+	// The rectangle's 4 corners are generated from the vertex ID, no vertex buffer is required
+	class OverlayShaderProgGLSL final : public ShaderProgGLSL
+	{
+	public:
+		OverlayShaderProgGLSL();
+		virtual ~OverlayShaderProgGLSL();
+
+		// Build an OpenGL shader object from a shader graph
+		void CreateShaderProg() override;
+
+		// Destroy the OpenGL shader object
+		void DestroyShaderProg() override;
+
+		// Location of the vec4 uniform holding the rectangle's minimum (xy) and maximum (zw) corners in normalised device co-ordinates
+		GLint GetRectLocation() const { return rect_location_; }
+
+		// Location of the vec4 uniform holding the rectangle's colour
+		GLint GetColourLocation() const { return colour_location_; }
+
+	private:
+		GLint rect_location_ { -1 };
+		GLint colour_location_ { -1 };
+	};
+}
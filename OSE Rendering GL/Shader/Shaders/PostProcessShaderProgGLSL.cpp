@@ -0,0 +1,119 @@
+#include "pch.h"
+#include "PostProcessShaderProgGLSL.h"
+
+namespace ose::shader
+{
+	PostProcessShaderProgGLSL::PostProcessShaderProgGLSL(EPostPass pass) : ShaderProgGLSL(nullptr), pass_(pass)
+	{
+
+	}
+
+	PostProcessShaderProgGLSL::~PostProcessShaderProgGLSL()
+	{
+
+	}
+
+	// Build an OpenGL shader object from a shader graph
+	void PostProcessShaderProgGLSL::CreateShaderProg()
+	{
+		if(shader_prog_)
+			return;
+
+		// A single triangle covering the screen is generated from the vertex ID, no vertex buffer is required
+		char const * vert_source =
+			"#version 330\n"
+			"out vec2 uv;\n"
+			"void main() {\n"
+			"	vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);\n"
+			"	uv = pos;\n"
+			"	gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);\n"
+			"}\n"
+			;
+
+		char const * frag_header =
+			"#version 330\n"
+			"in vec2 uv;\n"
+			"out vec4 fragColor;\n"
+			"uniform sampler2D source;\n"
+			"uniform sampler2D bloom;\n"
+			"uniform vec2 texelSize;\n"
+			"uniform vec2 direction;\n"
+			"uniform vec4 params;\n"
+			;
+
+		char const * frag_body { "" };
+		switch(pass_)
+		{
+		// The target is half the size of the source, so 4 bilinear taps average a 4x4 block of source texels
+		// Dividing by the brightness keeps the colour of bright pixels whilst removing the part below the threshold
+		case EPostPass::BLOOM_BRIGHT:
+			frag_body =
+				"void main() {\n"
+				"	vec3 c = texture(source, uv + texelSize * vec2(-1.0, -1.0)).rgb;\n"
+				"	c += texture(source, uv + texelSize * vec2(1.0, -1.0)).rgb;\n"
+				"	c += texture(source, uv + texelSize * vec2(-1.0, 1.0)).rgb;\n"
+				"	c += texture(source, uv + texelSize * vec2(1.0, 1.0)).rgb;\n"
+				"	c *= 0.25;\n"
+				"	float brightness = max(c.r, max(c.g, c.b));\n"
+				"	fragColor = vec4(c * max(brightness - params.x, 0.0) / max(brightness, 0.0001), 1.0);\n"
+				"}\n"
+				;
+			break;
+		// 9 tap gaussian from 5 bilinear taps, each off-centre tap sits between two texels weighted by their share
+		case EPostPass::BLOOM_BLUR:
+			frag_body =
+				"void main() {\n"
+				"	vec2 step = direction * texelSize;\n"
+				"	vec3 c = texture(source, uv).rgb * 0.2270270270;\n"
+				"	c += (texture(source, uv + step * 1.3846153846).rgb + texture(source, uv - step * 1.3846153846).rgb) * 0.3162162162;\n"
+				"	c += (texture(source, uv + step * 3.2307692308).rgb + texture(source, uv - step * 3.2307692308).rgb) * 0.0702702703;\n"
+				"	fragColor = vec4(c, 1.0);\n"
+				"}\n"
+				;
+			break;
+		case EPostPass::BLOOM_COMPOSITE:
+			frag_body =
+				"void main() {\n"
+				"	vec3 c = texture(source, uv).rgb + texture(bloom, uv).rgb * params.y;\n"
+				"	fragColor = vec4(c, 1.0);\n"
+				"}\n"
+				;
+			break;
+		case EPostPass::VIGNETTE:
+			frag_body =
+				"void main() {\n"
+				"	float d = length(uv - 0.5) * 1.41421356;\n"
+				"	fragColor = vec4(texture(source, uv).rgb * (1.0 - params.z * smoothstep(0.4, 1.0, d)), 1.0);\n"
+				"}\n"
+				;
+			break;
+		default:
+			LOG_ERROR("Unknown post pass", static_cast<int>(pass_));
+			return;
+		}
+
+		std::string frag_source { std::string(frag_header) + frag_body };
+		GLuint prog { BuildProgram(vert_source, frag_source.c_str()) };
+		if(prog == 0)
+			return;
+
+		// The source image is bound to unit 0, the blurred bright image of the bloom to unit 1
+		glUseProgram(prog);
+		glUniform1i(glGetUniformLocation(prog, "source"), 0);
+		glUniform1i(glGetUniformLocation(prog, "bloom"), 1);
+		texel_size_location_ = glGetUniformLocation(prog, "texelSize");
+		direction_location_ = glGetUniformLocation(prog, "direction");
+		params_location_ = glGetUniformLocation(prog, "params");
+
+		OnProgramLinked(prog);
+		shader_prog_ = prog;
+	}
+
+	// Destroy the OpenGL shader object
+	void PostProcessShaderProgGLSL::DestroyShaderProg()
+	{
+		if(shader_prog_)
+			glDeleteProgram(shader_prog_);
+		shader_prog_ = 0;
+	}
+}
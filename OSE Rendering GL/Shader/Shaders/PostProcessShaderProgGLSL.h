@@ -0,0 +1,53 @@
+#pragma once
+#include "../ShaderProgGLSL.h"
+
+namespace ose::shader
+{
+	// Full screen pass of the post-processing chain
+	enum class EPostPass
+	{
+		// Downsample the source and keep only the brightness above the threshold (params.x)
+		BLOOM_BRIGHT,
+		// Separable gaussian blur of the source along direction
+		BLOOM_BLUR,
+		// Add the blurred bright image (unit 1) to the source, scaled by the intensity (params.y)
+		BLOOM_COMPOSITE,
+		// Darken the edges of the source by the strength (params.z)
+		VIGNETTE,
+
+		NUM_PASSES
+	};
+
+	// Draws one pass of the post-processing chain as a full screen triangle, the source image is bound to unit 0
+	// Every pass reads and writes whole textures, so the texture co-ordinates span [0, 1]
+	class PostProcessShaderProgGLSL final : public ShaderProgGLSL
+	{
+	public:
+		PostProcessShaderProgGLSL(EPostPass pass);
+		virtual ~PostProcessShaderProgGLSL();
+
+		// Build an OpenGL shader object from a shader graph
+		void CreateShaderProg() override;
+
+		// Destroy the OpenGL shader object
+		void DestroyShaderProg() override;
+
+		EPostPass GetPass() const { return pass_; }
+
+		// Location of the vec2 uniform holding the size of a texel of the source
+		GLint GetTexelSizeLocation() const { return texel_size_location_; }
+
+		// Location of the vec2 uniform holding the direction of a blur, (1, 0) or (0, 1)
+		GLint GetDirectionLocation() const { return direction_location_; }
+
+		// Location of the vec4 uniform holding the settings of the effect the pass belongs to
+		GLint GetParamsLocation() const { return params_location_; }
+
+	private:
+		EPostPass pass_;
+
+		GLint texel_size_location_ { -1 };
+		GLint direction_location_ { -1 };
+		GLint params_location_ { -1 };
+	};
+}
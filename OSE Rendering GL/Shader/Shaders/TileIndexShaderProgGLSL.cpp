@@ -0,0 +1,101 @@
+#include "pch.h"
+#include "TileIndexShaderProgGLSL.h"
+
+namespace ose::shader
+{
+	TileIndexShaderProgGLSL::TileIndexShaderProgGLSL() : ShaderProgGLSL(nullptr)
+	{
+
+	}
+
+	TileIndexShaderProgGLSL::~TileIndexShaderProgGLSL()
+	{
+
+	}
+
+	// Build an OpenGL shader object from a shader graph
+	void TileIndexShaderProgGLSL::CreateShaderProg()
+	{
+		if(shader_prog_)
+			return;
+
+		// The tilemap quad is drawn with the sprite instance attributes followed by the tileset parameters
+		// Layout matches RenderGroupGL::TILE_INDEX_INSTANCE_STRIDE
+		char const * vert_source =
+			"#version 330\n"
+			"layout(location = 0) in vec2 position;\n"
+			"layout(location = 2) in vec4 instancePosRot;\n"
+			"layout(location = 3) in vec4 instanceScaleSize;\n"
+			"layout(location = 4) in vec4 instanceUVRect;\n"
+			"layout(location = 5) in float instanceLayer;\n"
+			"layout(location = 6) in vec4 instanceTileParams;\n"
+			"out vec2 vertexMapPos;\n"
+			"flat out vec4 vertexUVRect;\n"
+			"flat out float vertexLayer;\n"
+			"flat out vec4 vertexTileParams;\n"
+			"layout(std140) uniform FrameData {\n"
+			"	mat4 viewProjMatrix;\n"
+			"	vec4 cameraPos;\n"
+			"};\n"
+			"void main() {\n"
+			"	vertexMapPos = position;\n"
+			"	vertexUVRect = instanceUVRect;\n"
+			"	vertexLayer = instanceLayer;\n"
+			"	vertexTileParams = instanceTileParams;\n"
+			"	vec2 scaled = position * instanceScaleSize.zw * instanceScaleSize.xy;\n"
+			"	float c = cos(instancePosRot.w);\n"
+			"	float s = sin(instancePosRot.w);\n"
+			"	vec2 rotated = vec2(c * scaled.x - s * scaled.y, s * scaled.x + c * scaled.y);\n"
+			"	gl_Position = viewProjMatrix * vec4(rotated + instancePosRot.xy, instancePosRot.z, 1.0);\n"
+			"}\n"
+			;
+		// vertexMapPos spans [0, 1] across the tilemap, tile (i, j) starts at (i, j) * spacing in tile units
+		// Tile values outside of the tileset are uploaded as -1 and discarded, as are the gaps between spaced tiles
+		// The tileset is sampled from mip level 0 since the derivatives are discontinuous at tile edges
+		char const * frag_source =
+			"#version 330\n"
+			"layout(location = 0) out vec4 fragColor;\n"
+			"in vec2 vertexMapPos;\n"
+			"flat in vec4 vertexUVRect;\n"
+			"flat in float vertexLayer;\n"
+			"flat in vec4 vertexTileParams;\n"
+			"uniform sampler2DArray texSampler;\n"
+			"uniform isampler2DArray tileIndices;\n"
+			"void main() {\n"
+			"	ivec2 mapSize = textureSize(tileIndices, 0).xy;\n"
+			"	vec2 tilesetSize = vertexTileParams.xy;\n"
+			"	vec2 spacing = vertexTileParams.zw;\n"
+			"	vec2 p = vertexMapPos * (vec2(mapSize - 1) * spacing + 1.0);\n"
+			"	ivec2 cell = min(ivec2(p / spacing), mapSize - 1);\n"
+			"	vec2 f = p - vec2(cell) * spacing;\n"
+			"	if(f.x > 1.0 || f.y > 1.0)\n"
+			"		discard;\n"
+			"	int value = texelFetch(tileIndices, ivec3(cell.x, mapSize.y - cell.y - 1, 0), 0).r;\n"
+			"	if(value < 0)\n"
+			"		discard;\n"
+			"	int cols = int(tilesetSize.x);\n"
+			"	vec2 atlas = vec2(value % cols, value / cols);\n"
+			"	vec2 halfPixel = 0.5 / (vec2(textureSize(texSampler, 0).xy) * vertexUVRect.zw);\n"
+			"	vec2 tileUV = clamp((atlas + vec2(f.x, 1.0 - f.y)) / tilesetSize, atlas / tilesetSize + halfPixel, (atlas + 1.0) / tilesetSize - halfPixel);\n"
+			"	fragColor = textureLod(texSampler, vec3(vertexUVRect.xy + tileUV * vertexUVRect.zw, vertexLayer), 0.0);\n"
+			"}\n"
+			;
+		GLuint prog { BuildProgram(vert_source, frag_source) };
+		if(prog == 0)
+			return;
+
+		glUseProgram(prog);
+		glUniform1i(glGetUniformLocation(prog, "texSampler"), 0);
+		glUniform1i(glGetUniformLocation(prog, "tileIndices"), 1);
+
+		OnProgramLinked(prog);
+		shader_prog_ = prog;
+	}
+
+	// Destroy the OpenGL shader object
+	void TileIndexShaderProgGLSL::DestroyShaderProg()
+	{
+		if(shader_prog_)
+			glDeleteProgram(shader_prog_);
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "../ShaderProgGLSL.h"
+
+namespace ose::shader
+{
+	// Renders a whole tilemap as a single quad, each fragment looks up its tile in a texture of tile indices
+	// Used by tile renderers in ETileRenderMode::INDEX_TEXTURE mode
+	class TileIndexShaderProgGLSL final : public ShaderProgGLSL
+	{
+	public:
+		TileIndexShaderProgGLSL();
+		virtual ~TileIndexShaderProgGLSL();
+
+		// Build an OpenGL shader object from a shader graph
+		void CreateShaderProg() override;
+
+		// Destroy the OpenGL shader object
+		void DestroyShaderProg() override;
+	};
+}
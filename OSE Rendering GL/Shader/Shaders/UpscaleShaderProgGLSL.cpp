@@ -0,0 +1,86 @@
+#include "pch.h"
+#include "UpscaleShaderProgGLSL.h"
+
+namespace ose::shader
+{
+	UpscaleShaderProgGLSL::UpscaleShaderProgGLSL() : ShaderProgGLSL(nullptr)
+	{
+
+	}
+
+	UpscaleShaderProgGLSL::~UpscaleShaderProgGLSL()
+	{
+
+	}
+
+	// Build an OpenGL shader object from a shader graph
+	void UpscaleShaderProgGLSL::CreateShaderProg()
+	{
+		if(shader_prog_)
+			return;
+
+		// A single triangle covering the screen is generated from the vertex ID, no vertex buffer is required
+		// The texture co-ordinates only span the part of the source texture the scene was rendered to
+		char const * vert_source =
+			"#version 330\n"
+			"uniform vec4 sourceRect;\n"
+			"out vec2 uv;\n"
+			"void main() {\n"
+			"	vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);\n"
+			"	uv = pos * sourceRect.xy;\n"
+			"	gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);\n"
+			"}\n"
+			;
+
+		// Every tap is clamped to the rendered part of the source, which is surrounded by stale pixels of larger frames
+		// The sharpen is a simplified contrast adaptive sharpen (AMD FidelityFX CAS): the negative lobe of the cross filter
+		// is weakened where the neighbourhood is already near black or white, s.t. edges are restored without ringing
+		char const * frag_source =
+			"#version 330\n"
+			"in vec2 uv;\n"
+			"out vec4 fragColor;\n"
+			"uniform sampler2D source;\n"
+			"uniform vec4 sourceRect;\n"
+			"uniform float sharpness;\n"
+			"vec3 tap(vec2 p) {\n"
+			"	return texture(source, clamp(p, sourceRect.zw * 0.5, sourceRect.xy - sourceRect.zw * 0.5)).rgb;\n"
+			"}\n"
+			"void main() {\n"
+			"	vec3 c = tap(uv);\n"
+			"	if(sharpness > 0.0) {\n"
+			"		vec3 n = tap(uv + vec2(0.0, sourceRect.w));\n"
+			"		vec3 s = tap(uv - vec2(0.0, sourceRect.w));\n"
+			"		vec3 e = tap(uv + vec2(sourceRect.z, 0.0));\n"
+			"		vec3 w = tap(uv - vec2(sourceRect.z, 0.0));\n"
+			"		vec3 mn = min(c, min(min(n, s), min(e, w)));\n"
+			"		vec3 mx = max(c, max(max(n, s), max(e, w)));\n"
+			"		vec3 amp = sqrt(clamp(min(mn, 1.0 - mx) / max(mx, vec3(0.0001)), 0.0, 1.0));\n"
+			"		vec3 lobe = -amp * mix(0.125, 0.2, sharpness);\n"
+			"		c = clamp((c + (n + s + e + w) * lobe) / (1.0 + 4.0 * lobe), 0.0, 1.0);\n"
+			"	}\n"
+			"	fragColor = vec4(c, 1.0);\n"
+			"}\n"
+			;
+
+		GLuint prog { BuildProgram(vert_source, frag_source) };
+		if(prog == 0)
+			return;
+
+		// The source texture is bound to unit 0
+		glUseProgram(prog);
+		glUniform1i(glGetUniformLocation(prog, "source"), 0);
+		source_rect_location_ = glGetUniformLocation(prog, "sourceRect");
+		sharpness_location_ = glGetUniformLocation(prog, "sharpness");
+
+		OnProgramLinked(prog);
+		shader_prog_ = prog;
+	}
+
+	// Destroy the OpenGL shader object
+	void UpscaleShaderProgGLSL::DestroyShaderProg()
+	{
+		if(shader_prog_)
+			glDeleteProgram(shader_prog_);
+		shader_prog_ = 0;
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "../ShaderProgGLSL.h"
+
+namespace ose::shader
+{
+	// Scales the scene, rendered to the bottom left of an offscreen target, up to the whole window in a single full screen pass
+	// Used by dynamic resolution, the filter is bilinear and optionally followed by a contrast adaptive sharpen
+	class UpscaleShaderProgGLSL final : public ShaderProgGLSL
+	{
+	public:
+		UpscaleShaderProgGLSL();
+		virtual ~UpscaleShaderProgGLSL();
+
+		// Build an OpenGL shader object from a shader graph
+		void CreateShaderProg() override;
+
+		// Destroy the OpenGL shader object
+		void DestroyShaderProg() override;
+
+		// Location of the vec4 uniform holding the fraction of the source texture rendered to (xy) and the size of a source texel (zw)
+		GLint GetSourceRectLocation() const { return source_rect_location_; }
+
+		// Location of the float uniform holding the sharpening strength, 0 for bilinear only
+		GLint GetSharpnessLocation() const { return sharpness_location_; }
+
+	private:
+		GLint source_rect_location_ { -1 };
+		GLint sharpness_location_ { -1 };
+	};
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+namespace ose::shader
+{
+	// Binding points of the uniform blocks shared by every shader program
+	constexpr GLuint FRAME_UNIFORM_BLOCK_BINDING { 0 };
+	constexpr GLuint LIGHT_UNIFORM_BLOCK_BINDING { 1 };
+	constexpr GLuint CLUSTER_UNIFORM_BLOCK_BINDING { 2 };
+
+	// Texture units of the light cluster buffer textures, the last units s.t. they never collide with material textures
+	constexpr GLuint CLUSTER_LIGHTS_TEXTURE_UNIT { 13 };
+	constexpr GLuint LIGHT_INDICES_TEXTURE_UNIT { 14 };
+	constexpr GLuint POINT_LIGHTS_TEXTURE_UNIT { 15 };
+
+	// Maximum number of direction lights in the light uniform block
+	// Point lights are not limited since they are read from buffer textures, see LightClustersGL
+	constexpr int32_t MAX_UNIFORM_BLOCK_DIR_LIGHTS { 16 };
+
+	// Per-frame camera data, matches the std140 layout of the FrameData block
+	struct FrameUniformBlockGL
+	{
+		glm::mat4 view_proj_matrix_;
+		// w is unused
+		glm::vec4 camera_pos_;
+	};
+
+	// Light data, matches the std140 layout of the LightData block
+	// vec3s are stored as vec4s since std140 pads them to 16 bytes
+	struct LightUniformBlockGL
+	{
+		struct DirLight
+		{
+			glm::vec4 direction_;
+			glm::vec4 color_;
+		};
+
+		DirLight dir_lights_[MAX_UNIFORM_BLOCK_DIR_LIGHTS];
+
+		// x = number of point lights, y = number of direction lights
+		glm::ivec4 num_lights_;
+	};
+
+	// Light cluster grid parameters, matches the std140 layout of the ClusterData block
+	struct ClusterUniformBlockGL
+	{
+		glm::mat4 view_matrix_;
+		// xy = clusters per pixel, z = depth slice scale, w = depth slice bias
+		// The slice of view depth d is log(d) * z + w, orthographic projections use z = w = 0 (a single slice)
+		glm::vec4 cluster_scale_;
+		// xyz = number of clusters along each axis, w is unused
+		glm::ivec4 cluster_dims_;
+	};
+
+	// Table of the uniform locations of a shader program which are set by the rendering engine
+	// Resolved once when the program is linked s.t. no uniform lookups are required whilst rendering
+	struct ShaderUniformsGL
+	{
+		GLint world_transform_ { -1 };
+	};
+}
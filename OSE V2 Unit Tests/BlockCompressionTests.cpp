@@ -0,0 +1,101 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../OSE V2/OSE-Core/Resources/Texture/BlockCompression.h"
+#pragma comment(lib, "../Debug/OSE V2.lib")
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace ose;
+
+namespace OSEV2UnitTests
+{
+	TEST_CLASS(BlockCompressionTests)
+	{
+	public:
+
+		// Encode then decode an RGBA image, returning the largest per channel error of any texel
+		static int32_t RoundTripError(ETextureCompression format, std::vector<unsigned char> const & img, int32_t width, int32_t height)
+		{
+			std::vector<uint8_t> blocks;
+			BlockCompression::Encode(format, img.data(), width, height, 4, blocks);
+			Assert::AreEqual(BlockCompression::GetCompressedSize(format, width, height), blocks.size());
+
+			std::vector<unsigned char> decoded;
+			BlockCompression::Decode(format, blocks.data(), width, height, decoded);
+			Assert::AreEqual(img.size(), decoded.size());
+
+			int32_t max_error { 0 };
+			for(size_t i = 0; i < img.size(); ++i)
+			{
+				// BC1 has no alpha
+				if(format == ETextureCompression::BC1 && i % 4 == 3)
+					continue;
+				max_error = std::max(max_error, std::abs(img[i] - decoded[i]));
+			}
+			return max_error;
+		}
+
+		// A texel whose colour lies on the gradient from a to b, t in [0, 1]
+		static void Lerp(unsigned char * texel, glm::vec4 const & a, glm::vec4 const & b, float t)
+		{
+			glm::vec4 c { glm::mix(a, b, t) };
+			for(int32_t i = 0; i < 4; ++i)
+				texel[i] = static_cast<unsigned char>(c[i] + 0.5f);
+		}
+
+		TEST_METHOD(TestFlatBlock)
+		{
+			std::vector<unsigned char> img(4 * 4 * 4);
+			for(size_t t = 0; t < 16; ++t)
+				Lerp(&img[t * 4], { 120, 60, 200, 255 }, { 120, 60, 200, 255 }, 0.0f);
+			// RGB565 quantisation alone is at most 4 levels in red and blue
+			Assert::IsTrue(RoundTripError(ETextureCompression::BC1, img, 4, 4) <= 4);
+		}
+
+		TEST_METHOD(TestGreyGradient)
+		{
+			std::vector<unsigned char> img(4 * 4 * 4);
+			for(size_t t = 0; t < 16; ++t)
+				Lerp(&img[t * 4], { 0, 0, 0, 255 }, { 255, 255, 255, 255 }, t / 15.0f);
+			Assert::IsTrue(RoundTripError(ETextureCompression::BC1, img, 4, 4) <= 48);
+		}
+
+		TEST_METHOD(TestHueGradient)
+		{
+			// Red to green varies along (1, -1, 0), which is orthogonal to (1, 1, 1)
+			// Only the two endpoint colours are used, so each is encoded almost exactly
+			std::vector<unsigned char> img(4 * 4 * 4);
+			for(size_t t = 0; t < 16; ++t)
+				Lerp(&img[t * 4], { 255, 0, 0, 255 }, { 0, 255, 0, 255 }, (t & 1) ? 1.0f : 0.0f);
+			Assert::IsTrue(RoundTripError(ETextureCompression::BC1, img, 4, 4) <= 8);
+
+			// A smooth red to green gradient, each texel should be at most a palette step away
+			for(size_t t = 0; t < 16; ++t)
+				Lerp(&img[t * 4], { 255, 0, 0, 255 }, { 0, 255, 0, 255 }, t / 15.0f);
+			Assert::IsTrue(RoundTripError(ETextureCompression::BC1, img, 4, 4) <= 48);
+		}
+
+		TEST_METHOD(TestAlphaGradient)
+		{
+			std::vector<unsigned char> img(4 * 4 * 4);
+			for(size_t t = 0; t < 16; ++t)
+				Lerp(&img[t * 4], { 200, 100, 50, 0 }, { 200, 100, 50, 255 }, t / 15.0f);
+			// Eight alpha levels across 255 are 36 apart, so no texel is more than half a step off
+			Assert::IsTrue(RoundTripError(ETextureCompression::BC3, img, 4, 4) <= 19);
+		}
+
+		TEST_METHOD(TestPartialBlocks)
+		{
+			// A 6x5 image is stored in 2x2 blocks, the texels past its edge are discarded when decoded
+			int32_t width { 6 };
+			int32_t height { 5 };
+			std::vector<unsigned char> img(static_cast<size_t>(width) * height * 4);
+			for(int32_t y = 0; y < height; ++y)
+			{
+				for(int32_t x = 0; x < width; ++x)
+					Lerp(&img[(static_cast<size_t>(y) * width + x) * 4], { 0, 0, 255, 255 }, { 255, 255, 0, 255 }, (x & 1) ? 1.0f : 0.0f);
+			}
+			Assert::AreEqual(size_t { 2 * 2 * 16 }, BlockCompression::GetCompressedSize(ETextureCompression::BC3, width, height));
+			Assert::IsTrue(RoundTripError(ETextureCompression::BC3, img, width, height) <= 8);
+		}
+	};
+}
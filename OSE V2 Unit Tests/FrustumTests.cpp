@@ -0,0 +1,116 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../OSE V2/OSE-Core/Math/Frustum.h"
+#include "../OSE V2/OSE-Core/Rendering/InstanceRuns.h"
+#pragma comment(lib, "../Debug/OSE V2.lib")
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace ose;
+
+namespace OSEV2UnitTests
+{
+	TEST_CLASS(FrustumTests)
+	{
+	public:
+
+		// Camera at the origin looking down -z with a 90 degree field of view, near 1 and far 100
+		static Frustum PerspectiveFrustum()
+		{
+			glm::mat4 proj { glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, 100.0f) };
+			glm::mat4 view { glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f)) };
+			return Frustum { proj * view };
+		}
+
+		TEST_METHOD(TestBoxInside)
+		{
+			Frustum frustum { PerspectiveFrustum() };
+			Assert::IsTrue(frustum.Intersects({ { -1.0f, -1.0f, -11.0f }, { 1.0f, 1.0f, -9.0f } }));
+		}
+
+		TEST_METHOD(TestBoxOutside)
+		{
+			Frustum frustum { PerspectiveFrustum() };
+			// Behind the camera, beyond the far plane, and to the side of the view
+			Assert::IsFalse(frustum.Intersects({ { -1.0f, -1.0f, 4.0f }, { 1.0f, 1.0f, 6.0f } }));
+			Assert::IsFalse(frustum.Intersects({ { -1.0f, -1.0f, -202.0f }, { 1.0f, 1.0f, -200.0f } }));
+			Assert::IsFalse(frustum.Intersects({ { 20.0f, -1.0f, -11.0f }, { 22.0f, 1.0f, -9.0f } }));
+		}
+
+		TEST_METHOD(TestBoxStraddling)
+		{
+			Frustum frustum { PerspectiveFrustum() };
+			// Crossing the right plane, the near plane and the far plane
+			Assert::IsTrue(frustum.Intersects({ { 9.0f, -1.0f, -11.0f }, { 12.0f, 1.0f, -9.0f } }));
+			Assert::IsTrue(frustum.Intersects({ { -1.0f, -1.0f, -2.0f }, { 1.0f, 1.0f, 2.0f } }));
+			Assert::IsTrue(frustum.Intersects({ { -1.0f, -1.0f, -101.0f }, { 1.0f, 1.0f, -99.0f } }));
+		}
+
+		TEST_METHOD(TestOrthographicBatch)
+		{
+			// An orthographic projection gives a box frustum, i.e. the 2D view rectangle
+			Frustum frustum { glm::ortho(0.0f, 800.0f, 0.0f, 600.0f) };
+			std::vector<AABB> boxes {
+				{ { 10.0f, 10.0f, 0.0f }, { 20.0f, 20.0f, 0.0f } },			// inside
+				{ { -20.0f, 10.0f, 0.0f }, { -10.0f, 20.0f, 0.0f } },		// left of the view
+				{ { 790.0f, 590.0f, 0.0f }, { 810.0f, 610.0f, 0.0f } },		// straddling the top right corner
+				{ { 100.0f, 700.0f, 0.0f }, { 120.0f, 720.0f, 0.0f } },		// above the view
+				{ { 400.0f, 300.0f, 0.0f }, { 400.0f, 300.0f, 0.0f } }		// a point inside
+			};
+			std::vector<uint8_t> visible(boxes.size());
+			size_t num_visible { frustum.CullAABBs(boxes.data(), boxes.size(), visible.data()) };
+
+			Assert::AreEqual(size_t { 3 }, num_visible);
+			Assert::AreEqual(uint8_t { 1 }, visible[0]);
+			Assert::AreEqual(uint8_t { 0 }, visible[1]);
+			Assert::AreEqual(uint8_t { 1 }, visible[2]);
+			Assert::AreEqual(uint8_t { 0 }, visible[3]);
+			Assert::AreEqual(uint8_t { 1 }, visible[4]);
+		}
+
+		TEST_METHOD(TestMergedDrawCount)
+		{
+			// Two visible runs separated by a small gap merge into one draw, a gap larger than the limit splits them
+			uint32_t const gap { InstanceRuns::MAX_DRAWN_CULLED_GAP };
+			std::vector<uint8_t> visible(2 * gap + 8, 0);
+			visible[0] = visible[1] = 1;
+			visible[4] = 1;						// gap of 2 culled instances, merged
+			visible[gap + 6] = 1;				// gap larger than the limit, split
+			std::vector<InstanceRun> runs;
+
+			Assert::AreEqual(size_t { 2 }, InstanceRuns::Build(visible.data(), nullptr, static_cast<uint32_t>(visible.size()), true, runs));
+			Assert::AreEqual(0u, runs[0].first_);
+			Assert::AreEqual(5u, runs[0].count_);
+			Assert::AreEqual(gap + 6, runs[1].first_);
+			Assert::AreEqual(1u, runs[1].count_);
+
+			// Without splitting, every instance up to the last visible one is drawn in one run from instance 0
+			Assert::AreEqual(size_t { 1 }, InstanceRuns::Build(visible.data(), nullptr, static_cast<uint32_t>(visible.size()), false, runs));
+			Assert::AreEqual(0u, runs[0].first_);
+			Assert::AreEqual(gap + 7, runs[0].count_);
+
+			// Nothing visible, nothing drawn
+			std::vector<uint8_t> culled(8, 0);
+			Assert::AreEqual(size_t { 0 }, InstanceRuns::Build(culled.data(), nullptr, 8, true, runs));
+		}
+
+		TEST_METHOD(TestRunsSplitByLod)
+		{
+			std::vector<uint8_t> visible { 1, 1, 1, 1, 0, 1 };
+			std::vector<uint8_t> lods { 0, 0, 1, 1, 2, 1 };
+			std::vector<InstanceRun> runs;
+
+			// Runs are split where the level of detail changes, culled instances don't split runs
+			Assert::AreEqual(size_t { 2 }, InstanceRuns::Build(visible.data(), lods.data(), 6, true, runs));
+			Assert::AreEqual(uint8_t { 0 }, runs[0].lod_);
+			Assert::AreEqual(2u, runs[0].count_);
+			Assert::AreEqual(uint8_t { 1 }, runs[1].lod_);
+			Assert::AreEqual(4u, runs[1].count_);
+
+			// A single run uses the finest visible level
+			visible = { 0, 0, 1, 1, 0, 1 };
+			Assert::AreEqual(size_t { 1 }, InstanceRuns::Build(visible.data(), lods.data(), 6, false, runs));
+			Assert::AreEqual(uint8_t { 1 }, runs[0].lod_);
+		}
+
+	};
+}
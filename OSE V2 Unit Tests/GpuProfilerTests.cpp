@@ -0,0 +1,166 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../OSE V2/OSE-Core/Rendering/GpuProfiler.h"
+#pragma comment(lib, "../Debug/OSE V2.lib")
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace ose;
+
+namespace OSEV2UnitTests
+{
+	TEST_CLASS(GpuProfilerTests)
+	{
+	public:
+
+		// Every measurement takes 1ms, so a scope's time is the number of times it (or its children) was measured
+		static uptr<NullGpuTimerQueries> OneMsQueries()
+		{
+			return ose::make_unique<NullGpuTimerQueries>([](uint32_t, uint64_t) -> uint64_t { return 1000000; });
+		}
+
+		// Find a sample by name, fails the test if there is none
+		static ProfileSample const & GetSample(GpuProfiler const & profiler, std::string const & name)
+		{
+			auto const & results { profiler.GetResults() };
+			auto iter { std::find_if(results.begin(), results.end(), [&name](ProfileSample const & s) { return s.name_ == name; }) };
+			Assert::IsTrue(iter != results.end());
+			return *iter;
+		}
+
+		static void Measure(GpuProfiler & profiler, uint32_t slot)
+		{
+			profiler.Begin(slot);
+			profiler.End(slot);
+		}
+
+		TEST_METHOD(TestPassAndMaterialGroupAggregation)
+		{
+			GpuProfiler profiler { OneMsQueries() };
+			Assert::IsFalse(profiler.BeginFrame(1));
+			uint32_t pass0 { profiler.AddScope("Pass 0") };
+			uint32_t group0 { profiler.AddScope("Group 0", pass0) };
+			uint32_t group1 { profiler.AddScope("Group 1", pass0) };
+			uint32_t pass1 { profiler.AddScope("Pass 1") };
+			uint32_t group2 { profiler.AddScope("Group 0", pass1) };
+			Measure(profiler, group0);
+			Measure(profiler, group1);
+			Measure(profiler, group2);
+
+			// Frame 1's queries are read when its query set is reused by frame 3
+			Assert::IsFalse(profiler.BeginFrame(2));
+			Assert::IsTrue(profiler.BeginFrame(3));
+			Assert::AreEqual(uint64_t { 1 }, profiler.GetResultsFrame());
+
+			auto const & results { profiler.GetResults() };
+			Assert::AreEqual(size_t { 6 }, results.size());
+			Assert::IsTrue(results[0].name_ == "Frame");
+			Assert::AreEqual(0u, results[0].depth_);
+			Assert::AreEqual(3.0f, results[0].ms_, 1e-5f);
+			Assert::AreEqual(2.0f, GetSample(profiler, "Pass 0").ms_, 1e-5f);
+			Assert::AreEqual(1u, GetSample(profiler, "Pass 0").depth_);
+			Assert::AreEqual(1.0f, GetSample(profiler, "Pass 0/Group 0").ms_, 1e-5f);
+			Assert::AreEqual(2u, GetSample(profiler, "Pass 0/Group 0").depth_);
+			Assert::AreEqual(1.0f, GetSample(profiler, "Pass 0/Group 1").ms_, 1e-5f);
+			Assert::AreEqual(1.0f, GetSample(profiler, "Pass 1").ms_, 1e-5f);
+			Assert::AreEqual(1.0f, GetSample(profiler, "Pass 1/Group 0").ms_, 1e-5f);
+			for(auto const & sample : results)
+				Assert::IsTrue(sample.source_ == EProfileSource::GPU);
+		}
+
+		TEST_METHOD(TestRepeatedScopes)
+		{
+			// A material group split between command lists is measured once per list, its time is the sum
+			GpuProfiler profiler { OneMsQueries() };
+			profiler.BeginFrame(1);
+			uint32_t pass { profiler.AddScope("Pass 0") };
+			uint32_t group { profiler.AddScope("Group 0", pass) };
+			Measure(profiler, group);
+			Measure(profiler, group);
+			Measure(profiler, group);
+			profiler.BeginFrame(2);
+			profiler.BeginFrame(3);
+
+			Assert::AreEqual(3.0f, GetSample(profiler, "Pass 0/Group 0").ms_, 1e-5f);
+			Assert::AreEqual(3.0f, GetSample(profiler, "Pass 0").ms_, 1e-5f);
+		}
+
+		TEST_METHOD(TestNestedScopes)
+		{
+			GpuProfiler profiler { OneMsQueries() };
+			profiler.BeginFrame(1);
+			uint32_t a { profiler.AddScope("A") };
+			uint32_t b { profiler.AddScope("B", a) };
+			uint32_t c { profiler.AddScope("C", b) };
+			uint32_t d { profiler.AddScope("D", a) };
+			Measure(profiler, c);
+
+			// Timer queries can't overlap, so beginning a scope whilst another is measured is ignored
+			profiler.Begin(d);
+			profiler.Begin(c);
+			profiler.End(c);
+			profiler.End(d);
+
+			// A scope left open is ended by the next frame
+			profiler.Begin(c);
+			profiler.BeginFrame(2);
+			profiler.BeginFrame(3);
+
+			Assert::AreEqual(2.0f, GetSample(profiler, "A/B/C").ms_, 1e-5f);
+			Assert::AreEqual(3u, GetSample(profiler, "A/B/C").depth_);
+			Assert::AreEqual(2.0f, GetSample(profiler, "A/B").ms_, 1e-5f);
+			Assert::AreEqual(1.0f, GetSample(profiler, "A/D").ms_, 1e-5f);
+			Assert::AreEqual(3.0f, GetSample(profiler, "A").ms_, 1e-5f);
+			Assert::AreEqual(3.0f, GetSample(profiler, "Frame").ms_, 1e-5f);
+		}
+
+		TEST_METHOD(TestLateResults)
+		{
+			uptr<NullGpuTimerQueries> owned_queries { OneMsQueries() };
+			NullGpuTimerQueries * queries { owned_queries.get() };
+			GpuProfiler profiler { std::move(owned_queries) };
+
+			// The GPU falls behind, frame 1's results aren't ready when its query set is reused, so they are dropped
+			queries->SetResultsAvailable(false);
+			for(uint64_t frame = 1; frame <= 3; ++frame)
+			{
+				Assert::IsFalse(profiler.BeginFrame(frame));
+				Measure(profiler, profiler.AddScope("Pass " + std::to_string(frame)));
+			}
+			Assert::AreEqual(uint64_t { 0 }, profiler.GetResultsFrame());
+			Assert::IsTrue(profiler.GetResults().empty());
+
+			// Once the GPU catches up, each frame's results arrive two frames after it was measured
+			queries->SetResultsAvailable(true);
+			Assert::IsTrue(profiler.BeginFrame(4));
+			Assert::AreEqual(uint64_t { 2 }, profiler.GetResultsFrame());
+			Assert::AreEqual(1.0f, GetSample(profiler, "Pass 2").ms_, 1e-5f);
+			Measure(profiler, profiler.AddScope("Pass 4"));
+
+			Assert::IsTrue(profiler.BeginFrame(5));
+			Assert::AreEqual(uint64_t { 3 }, profiler.GetResultsFrame());
+			Assert::AreEqual(1.0f, GetSample(profiler, "Pass 3").ms_, 1e-5f);
+
+			// Results which are unavailable for a frame keep the last results which were read
+			queries->SetResultsAvailable(false);
+			Assert::IsFalse(profiler.BeginFrame(6));
+			Assert::AreEqual(uint64_t { 3 }, profiler.GetResultsFrame());
+			Assert::AreEqual(1.0f, GetSample(profiler, "Pass 3").ms_, 1e-5f);
+		}
+
+		TEST_METHOD(TestDefaultTimings)
+		{
+			// By default each query measures 0.1ms times one more than its handle
+			GpuProfiler profiler { ose::make_unique<NullGpuTimerQueries>() };
+			profiler.BeginFrame(1);
+			uint32_t pass { profiler.AddScope("Pass 0") };
+			Measure(profiler, profiler.AddScope("Group 0", pass));
+			Measure(profiler, profiler.AddScope("Group 1", pass));
+			profiler.BeginFrame(2);
+			profiler.BeginFrame(3);
+
+			Assert::AreEqual(0.1f, GetSample(profiler, "Pass 0/Group 0").ms_, 1e-5f);
+			Assert::AreEqual(0.2f, GetSample(profiler, "Pass 0/Group 1").ms_, 1e-5f);
+			Assert::AreEqual(0.3f, GetSample(profiler, "Pass 0").ms_, 1e-5f);
+		}
+	};
+}
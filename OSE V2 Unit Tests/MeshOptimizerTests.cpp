@@ -0,0 +1,112 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../OSE V2/OSE-Core/Resources/Mesh/Mesh.h"
+#include "../OSE V2/OSE-Core/Resources/Mesh/MeshOptimizer.h"
+#include <random>
+#pragma comment(lib, "../Debug/OSE V2.lib")
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace ose;
+
+namespace OSEV2UnitTests
+{
+	TEST_CLASS(MeshOptimizerTests)
+	{
+	public:
+
+		typedef std::array<float, 3> Position;
+		typedef std::array<Position, 3> Triangle;
+
+		// Build a grid of size x size quads in the xy plane, with its triangles in a random order
+		static void BuildShuffledGrid(Mesh & mesh, unsigned int size)
+		{
+			unsigned int row { size + 1 };
+			mesh.SetNumVertices(static_cast<size_t>(row) * row, VDT_POSITIONS);
+			for(unsigned int v = 0; v < row * row; ++v)
+				mesh.AddVertexPosition(v * 3, static_cast<float>(v % row), static_cast<float>(v / row), 0.0f);
+
+			std::vector<std::array<unsigned int, 3>> triangles;
+			for(unsigned int y = 0; y < size; ++y)
+			{
+				for(unsigned int x = 0; x < size; ++x)
+				{
+					unsigned int v { y * row + x };
+					triangles.push_back({ v, v + 1, v + row + 1 });
+					triangles.push_back({ v, v + row + 1, v + row });
+				}
+			}
+			std::shuffle(triangles.begin(), triangles.end(), std::mt19937 { 42 });
+
+			MeshSection & section { mesh.AddMeshSection() };
+			for(auto const & tri : triangles)
+				section.AddFace(tri[0], tri[1], tri[2]);
+		}
+
+		// Get every triangle of a mesh by the positions of its corners, rotated s.t. the smallest corner is first
+		// Rotating keeps each triangle's winding, so the result only matches if no triangle was flipped
+		static std::vector<Triangle> GetTriangles(Mesh const & mesh)
+		{
+			auto const & positions { mesh.GetPositionData() };
+			std::vector<Triangle> triangles;
+			for(MeshSection const & section : mesh.GetSections())
+			{
+				auto const & indices { section.GetFaceIndices() };
+				for(size_t i = 0; i + 2 < indices.size(); i += 3)
+				{
+					Triangle tri;
+					for(size_t c = 0; c < 3; ++c)
+						tri[c] = { positions[indices[i + c] * 3], positions[indices[i + c] * 3 + 1], positions[indices[i + c] * 3 + 2] };
+					std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+					triangles.push_back(tri);
+				}
+			}
+			std::sort(triangles.begin(), triangles.end());
+			return triangles;
+		}
+
+		TEST_METHOD(TestOptimizeShuffledGrid)
+		{
+			Mesh mesh { "grid", "" };
+			BuildShuffledGrid(mesh, 16);
+			std::vector<Triangle> triangles_before { GetTriangles(mesh) };
+
+			MeshOptimizer::Stats stats { MeshOptimizer::Optimize(mesh) };
+
+			// A shuffled grid barely reuses any vertices, an optimized grid reuses most of them
+			Assert::IsTrue(stats.acmr_before_ > 1.5f);
+			Assert::IsTrue(stats.acmr_after_ <= stats.acmr_before_);
+			Assert::IsTrue(stats.acmr_after_ < 1.0f);
+			Assert::AreEqual(MeshOptimizer::ComputeACMR(mesh.GetSections()[0].GetFaceIndices(), mesh.GetNumVertices()), stats.acmr_after_);
+
+			// The same triangles are drawn, with the same winding
+			Assert::IsTrue(triangles_before == GetTriangles(mesh));
+		}
+
+		TEST_METHOD(TestVertexFetchOrder)
+		{
+			Mesh mesh { "grid", "" };
+			BuildShuffledGrid(mesh, 8);
+			MeshOptimizer::Optimize(mesh);
+
+			// Vertices are ordered by first use, so each index is at most one more than the largest index before it
+			int64_t largest { -1 };
+			for(unsigned int index : mesh.GetSections()[0].GetFaceIndices())
+			{
+				Assert::IsTrue(static_cast<int64_t>(index) <= largest + 1);
+				largest = std::max(largest, static_cast<int64_t>(index));
+			}
+		}
+
+		TEST_METHOD(TestInvalidIndicesAreLeftUnchanged)
+		{
+			Mesh mesh { "invalid", "" };
+			BuildShuffledGrid(mesh, 4);
+			mesh.GetSections()[0].AddFace(0, 1, 1000);
+			std::vector<unsigned int> indices_before { mesh.GetSections()[0].GetFaceIndices() };
+
+			MeshOptimizer::Stats stats { MeshOptimizer::Optimize(mesh) };
+			Assert::AreEqual(stats.acmr_before_, stats.acmr_after_);
+			Assert::IsTrue(indices_before == mesh.GetSections()[0].GetFaceIndices());
+		}
+	};
+}
@@ -0,0 +1,131 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../OSE V2/OSE-Core/Math/OcclusionBuffer.h"
+#include <random>
+#pragma comment(lib, "../Debug/OSE V2.lib")
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace ose;
+
+namespace OSEV2UnitTests
+{
+	TEST_CLASS(OcclusionBufferTests)
+	{
+	public:
+
+		// Camera at the origin looking down -z with a 90 degree vertical field of view, a 2:1 aspect ratio, near 1 and far 100
+		static glm::mat4 ViewProj()
+		{
+			glm::mat4 proj { glm::perspective(glm::radians(90.0f), 2.0f, 1.0f, 100.0f) };
+			glm::mat4 view { glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f)) };
+			return proj * view;
+		}
+
+		// Rasterize a 6x6 square wall facing the camera at z = -10
+		static void RasterizeWall(OcclusionBuffer & buffer)
+		{
+			float const positions[] { -3.0f, -3.0f, 0.0f, 3.0f, -3.0f, 0.0f, 3.0f, 3.0f, 0.0f, -3.0f, 3.0f, 0.0f };
+			unsigned int const indices[] { 0, 1, 2, 0, 2, 3 };
+			glm::mat4 world { glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -10.0f)) };
+			buffer.RasterizeTriangles(world, positions, 12, indices, 6);
+		}
+
+		TEST_METHOD(TestNoOccluders)
+		{
+			OcclusionBuffer buffer;
+			buffer.Begin(ViewProj());
+			Assert::IsFalse(buffer.HasOccluders());
+			Assert::IsTrue(buffer.IsVisible({ { -0.5f, -0.5f, -20.5f }, { 0.5f, 0.5f, -19.5f } }));
+		}
+
+		TEST_METHOD(TestBoxBehindOccluderIsCulled)
+		{
+			OcclusionBuffer buffer;
+			buffer.Begin(ViewProj());
+			RasterizeWall(buffer);
+			Assert::IsTrue(buffer.HasOccluders());
+			Assert::IsFalse(buffer.IsVisible({ { -0.5f, -0.5f, -20.5f }, { 0.5f, 0.5f, -19.5f } }));
+			Assert::IsFalse(buffer.IsVisible({ { -2.0f, -2.0f, -12.0f }, { 2.0f, 2.0f, -11.0f } }));
+		}
+
+		TEST_METHOD(TestBoxInFrontOfOccluderIsVisible)
+		{
+			OcclusionBuffer buffer;
+			buffer.Begin(ViewProj());
+			RasterizeWall(buffer);
+			// In front of the wall, passing through the wall, and surrounding the camera
+			Assert::IsTrue(buffer.IsVisible({ { -0.5f, -0.5f, -5.5f }, { 0.5f, 0.5f, -4.5f } }));
+			Assert::IsTrue(buffer.IsVisible({ { -0.5f, -0.5f, -11.0f }, { 0.5f, 0.5f, -9.0f } }));
+			Assert::IsTrue(buffer.IsVisible({ { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f } }));
+		}
+
+		TEST_METHOD(TestBoxBesideOccluderIsVisible)
+		{
+			OcclusionBuffer buffer;
+			buffer.Begin(ViewProj());
+			RasterizeWall(buffer);
+			// Behind the wall's plane but seen past its side, and only partly hidden by its edge
+			Assert::IsTrue(buffer.IsVisible({ { 9.5f, -0.5f, -20.5f }, { 10.5f, 0.5f, -19.5f } }));
+			Assert::IsTrue(buffer.IsVisible({ { 5.0f, -0.5f, -20.5f }, { 7.0f, 0.5f, -19.5f } }));
+		}
+
+		TEST_METHOD(TestCullBatch)
+		{
+			OcclusionBuffer buffer;
+			buffer.Begin(ViewProj());
+			RasterizeWall(buffer);
+			std::vector<AABB> boxes {
+				{ { -0.5f, -0.5f, -20.5f }, { 0.5f, 0.5f, -19.5f } },		// behind the wall
+				{ { 9.5f, -0.5f, -20.5f }, { 10.5f, 0.5f, -19.5f } },		// beside the wall
+				{ { -0.5f, -0.5f, -30.5f }, { 0.5f, 0.5f, -29.5f } },		// behind the wall, but frustum culled already
+				{ { -0.5f, -0.5f, -5.5f }, { 0.5f, 0.5f, -4.5f } }			// in front of the wall
+			};
+			std::vector<uint8_t> visible { 1, 1, 0, 1 };
+			Assert::AreEqual(size_t { 2 }, buffer.CullAABBs(boxes.data(), boxes.size(), visible.data()));
+			Assert::IsTrue(visible == std::vector<uint8_t> { 0, 1, 0, 1 });
+		}
+
+		TEST_METHOD(TestSimdMatchesScalar)
+		{
+			// Rasterize the same random occluders with and without SIMD, with a width which is not a multiple of 4
+			OcclusionBuffer simd { 101, 67 };
+			OcclusionBuffer scalar { 101, 67 };
+			scalar.SetSimdEnabled(false);
+			simd.Begin(ViewProj());
+			scalar.Begin(ViewProj());
+
+			std::mt19937 rng { 1234 };
+			std::uniform_real_distribution<float> xy { -15.0f, 15.0f };
+			std::uniform_real_distribution<float> z { -40.0f, -2.0f };
+			std::vector<float> positions;
+			std::vector<unsigned int> indices;
+			for(unsigned int v = 0; v < 60; ++v)
+			{
+				positions.insert(positions.end(), { xy(rng), xy(rng), z(rng) });
+				indices.push_back(v);
+			}
+			simd.RasterizeTriangles(glm::mat4(1.0f), positions.data(), positions.size(), indices.data(), indices.size());
+			scalar.RasterizeTriangles(glm::mat4(1.0f), positions.data(), positions.size(), indices.data(), indices.size());
+
+			for(int32_t y = 0; y < simd.GetHeight(); ++y)
+			{
+				for(int32_t x = 0; x < simd.GetWidth(); ++x)
+					Assert::AreEqual(scalar.GetDepth(x, y), simd.GetDepth(x, y));
+			}
+
+			std::vector<AABB> boxes;
+			for(int32_t i = 0; i < 200; ++i)
+			{
+				glm::vec3 centre { xy(rng), xy(rng), z(rng) };
+				boxes.push_back({ centre - glm::vec3(0.5f), centre + glm::vec3(0.5f) });
+			}
+			std::vector<uint8_t> simd_visible(boxes.size(), 1);
+			std::vector<uint8_t> scalar_visible(boxes.size(), 1);
+			size_t num_visible { simd.CullAABBs(boxes.data(), boxes.size(), simd_visible.data()) };
+			Assert::AreEqual(num_visible, scalar.CullAABBs(boxes.data(), boxes.size(), scalar_visible.data()));
+			Assert::IsTrue(simd_visible == scalar_visible);
+			// Some boxes should be hidden and some visible, otherwise the comparison proves little
+			Assert::IsTrue(num_visible > 0 && num_visible < boxes.size());
+		}
+	};
+}
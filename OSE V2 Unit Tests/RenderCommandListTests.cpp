@@ -0,0 +1,111 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../OSE V2/OSE-Core/Rendering/RenderCommandList.h"
+#pragma comment(lib, "../Debug/OSE V2.lib")
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace ose;
+
+namespace OSEV2UnitTests
+{
+	TEST_CLASS(RenderCommandListTests)
+	{
+	public:
+
+		// A frame using every command type, recorded without a render library
+		static RenderCommandList RecordFrame()
+		{
+			float const matrix[16] { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 2.0f, 0.0f, 0.0f, 0.0f, 0.0f, 3.0f, 0.0f, 4.0f, 5.0f, 6.0f, 1.0f };
+			RenderCommandList list;
+			list.BindFramebuffer(0);
+			list.ClearBuffers(0x4100);
+			list.BindUniformBlock(0, 7, 256, 128);
+			list.SetDepthTest(true, 0x0203);
+			list.SetBlend(false, 1, 0);
+			list.SetPipeline(3);
+			list.SetUniformMat4(2, matrix);
+			list.BindVertexArray(5);
+			list.BindTexture(0, 0x0DE1, 9);
+			list.BeginTimer(1);
+			list.Draw(4, 0, 6, 10, 2);
+			list.DrawIndexed(4, 36, 1, 0, 12);
+			list.EndTimer(1);
+			list.BlitDepth(11, 0, 800, 600);
+			return list;
+		}
+
+		TEST_METHOD(TestSerializeRoundTrip)
+		{
+			RenderCommandList recorded { RecordFrame() };
+			std::stringstream stream;
+			recorded.Serialize(stream);
+
+			RenderCommandList loaded;
+			Assert::IsTrue(loaded.Deserialize(stream));
+			Assert::IsTrue(loaded == recorded);
+			Assert::IsTrue(loaded.ToString() == recorded.ToString());
+		}
+
+		TEST_METHOD(TestAppendedListsRoundTrip)
+		{
+			// Lists recorded by several workers and appended in order serialize as a single list
+			RenderCommandList first { RecordFrame() };
+			RenderCommandList second;
+			second.Draw(4, 0, 3);
+			first.Append(second);
+
+			std::stringstream stream;
+			first.Serialize(stream);
+			second.Serialize(stream);
+
+			RenderCommandList loaded;
+			Assert::IsTrue(loaded.Deserialize(stream));
+			Assert::IsTrue(loaded == first);
+			Assert::IsTrue(loaded.Deserialize(stream));
+			Assert::IsTrue(loaded == second);
+		}
+
+		TEST_METHOD(TestCorruptWordCount)
+		{
+			// A count far larger than the stream is rejected before anything is allocated
+			std::stringstream stream;
+			uint64_t num_words { uint64_t(1) << 60 };
+			stream.write(reinterpret_cast<char const *>(&num_words), sizeof(num_words));
+			uint32_t word { 0 };
+			stream.write(reinterpret_cast<char const *>(&word), sizeof(word));
+
+			RenderCommandList loaded { RecordFrame() };
+			Assert::IsFalse(loaded.Deserialize(stream));
+			Assert::IsTrue(loaded.IsEmpty());
+		}
+
+		TEST_METHOD(TestTruncatedStream)
+		{
+			std::stringstream full;
+			RecordFrame().Serialize(full);
+			std::string bytes { full.str() };
+			std::stringstream truncated { bytes.substr(0, bytes.size() - 8) };
+
+			RenderCommandList loaded;
+			Assert::IsFalse(loaded.Deserialize(truncated));
+			Assert::IsTrue(loaded.IsEmpty());
+		}
+
+		TEST_METHOD(TestInvalidCommand)
+		{
+			// A command type past the last command, and a command missing its arguments
+			for(std::vector<uint32_t> const & words : { std::vector<uint32_t> { 0xFFFF }, std::vector<uint32_t> { static_cast<uint32_t>(ERenderCommand::DRAW), 4, 0 } })
+			{
+				std::stringstream stream;
+				uint64_t num_words { words.size() };
+				stream.write(reinterpret_cast<char const *>(&num_words), sizeof(num_words));
+				stream.write(reinterpret_cast<char const *>(words.data()), words.size() * sizeof(uint32_t));
+
+				RenderCommandList loaded;
+				Assert::IsFalse(loaded.Deserialize(stream));
+				Assert::IsTrue(loaded.IsEmpty());
+			}
+		}
+
+	};
+}
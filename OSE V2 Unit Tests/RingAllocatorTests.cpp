@@ -0,0 +1,154 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../OSE V2/OSE-Core/Rendering/FencedRingAllocator.h"
+#pragma comment(lib, "../Debug/OSE V2.lib")
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace ose;
+
+namespace OSEV2UnitTests
+{
+	// Fences which the test signals by hand, a blocking wait on an unsignalled fence signals it (the GPU catching up)
+	class MockFrameFences final : public FrameFences
+	{
+	public:
+		struct State
+		{
+			size_t num_inserted_ { 0 };
+			size_t num_signalled_ { 0 };
+			size_t num_popped_ { 0 };
+			size_t num_blocking_waits_ { 0 };
+		};
+
+		MockFrameFences(State & state) : state_(state) {}
+
+		void Insert() override { ++state_.num_inserted_; }
+
+		bool PopOldest(bool wait) override
+		{
+			if(state_.num_popped_ == state_.num_inserted_)
+				return false;
+			if(state_.num_popped_ == state_.num_signalled_)
+			{
+				if(!wait)
+					return false;
+				++state_.num_blocking_waits_;
+				++state_.num_signalled_;
+			}
+			++state_.num_popped_;
+			return true;
+		}
+
+		size_t GetNumFences() const override { return state_.num_inserted_ - state_.num_popped_; }
+
+	private:
+		State & state_;
+	};
+
+	TEST_CLASS(RingAllocatorTests)
+	{
+	public:
+
+		TEST_METHOD(TestAllocateAcrossWrap)
+		{
+			RingAllocator ring { 100 };
+			Assert::AreEqual(size_t { 0 }, ring.Allocate(60, 4));
+			ring.EndFrame();
+			Assert::AreEqual(size_t { 60 }, ring.Allocate(30, 4));
+			ring.EndFrame();
+			Assert::IsTrue(ring.ReleaseFrame());
+
+			// 20 bytes don't fit in [90, 100), so the allocation moves to the start and the skipped bytes are used by this frame
+			Assert::AreEqual(size_t { 0 }, ring.Allocate(20, 4));
+			Assert::AreEqual(size_t { 30 + 10 + 20 }, ring.GetUsed());
+			ring.EndFrame();
+
+			// Releasing both frames frees everything, including the skipped bytes
+			Assert::IsTrue(ring.ReleaseFrame());
+			Assert::IsTrue(ring.ReleaseFrame());
+			Assert::AreEqual(size_t { 0 }, ring.GetUsed());
+			Assert::IsFalse(ring.ReleaseFrame());
+		}
+
+		TEST_METHOD(TestAllocateIntoInUseRegionFails)
+		{
+			RingAllocator ring { 100 };
+			Assert::AreEqual(size_t { 0 }, ring.Allocate(50, 1));
+			ring.EndFrame();
+			Assert::AreEqual(size_t { 50 }, ring.Allocate(40, 1));
+			// Only 10 bytes are free at the end and the start is still in use
+			Assert::AreEqual(RingAllocator::INVALID_OFFSET, ring.Allocate(20, 1));
+		}
+
+		TEST_METHOD(TestBlocksUntilOldestFenceSignalled)
+		{
+			MockFrameFences::State fences;
+			FencedRingAllocator ring { ose::make_unique<MockFrameFences>(fences), 3 };
+			ring.Reset(100);
+
+			ring.BeginFrame();
+			Assert::AreEqual(size_t { 0 }, ring.Allocate(40, 1));
+			ring.EndFrame();
+			ring.BeginFrame();
+			Assert::AreEqual(size_t { 40 }, ring.Allocate(40, 1));
+			ring.EndFrame();
+			Assert::AreEqual(size_t { 2 }, fences.num_inserted_);
+			Assert::AreEqual(size_t { 0 }, fences.num_blocking_waits_);
+
+			// The ring only has 20 free bytes, so the allocation waits for the oldest frame's fence, and only that one
+			ring.BeginFrame();
+			Assert::AreEqual(size_t { 0 }, ring.Allocate(30, 1));
+			Assert::AreEqual(size_t { 1 }, fences.num_blocking_waits_);
+			Assert::AreEqual(size_t { 1 }, fences.num_popped_);
+			Assert::AreEqual(size_t { 1 }, ring.GetNumFramesInFlight());
+		}
+
+		TEST_METHOD(TestBeginFrameReleasesSignalledFrames)
+		{
+			MockFrameFences::State fences;
+			FencedRingAllocator ring { ose::make_unique<MockFrameFences>(fences), 2 };
+			ring.Reset(100);
+
+			ring.BeginFrame();
+			ring.Allocate(10, 1);
+			ring.EndFrame();
+			fences.num_signalled_ = 1;
+
+			// A signalled frame is released without waiting
+			ring.BeginFrame();
+			Assert::AreEqual(size_t { 0 }, ring.GetNumFramesInFlight());
+			Assert::AreEqual(size_t { 0 }, fences.num_blocking_waits_);
+
+			// The CPU may only be max_frames ahead, so the third frame waits for the first
+			ring.Allocate(10, 1);
+			ring.EndFrame();
+			ring.BeginFrame();
+			ring.Allocate(10, 1);
+			ring.EndFrame();
+			Assert::AreEqual(size_t { 2 }, ring.GetNumFramesInFlight());
+			ring.BeginFrame();
+			Assert::AreEqual(size_t { 1 }, fences.num_blocking_waits_);
+			Assert::AreEqual(size_t { 1 }, ring.GetNumFramesInFlight());
+		}
+
+		TEST_METHOD(TestAllocationLargerThanRing)
+		{
+			MockFrameFences::State fences;
+			FencedRingAllocator ring { ose::make_unique<MockFrameFences>(fences), 3 };
+			ring.Reset(100);
+			ring.BeginFrame();
+			ring.Allocate(10, 1);
+			ring.EndFrame();
+
+			// Fails immediately, waiting for the GPU can't make room
+			ring.BeginFrame();
+			Assert::AreEqual(RingAllocator::INVALID_OFFSET, ring.Allocate(101, 1));
+			Assert::AreEqual(size_t { 0 }, fences.num_blocking_waits_);
+			Assert::AreEqual(size_t { 1 }, ring.GetNumFramesInFlight());
+
+			// A whole ring fits once every frame has been released
+			Assert::AreEqual(size_t { 0 }, ring.Allocate(100, 1));
+		}
+
+	};
+}
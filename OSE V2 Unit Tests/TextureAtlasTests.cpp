@@ -0,0 +1,94 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../OSE V2/OSE-Core/Resources/Texture/Texture.h"
+#include "../OSE V2/OSE-Core/Resources/Texture/TextureAtlas.h"
+#include "../OSE V2/OSE-Core/Resources/Texture/BlockCompression.h"
+#pragma comment(lib, "../Debug/OSE V2.lib")
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace ose;
+
+namespace OSEV2UnitTests
+{
+	// Texture and atlas without a GPU representation
+	class CpuTexture : public Texture
+	{
+	public:
+		CpuTexture(std::string const & name) : Texture(name, name) {}
+		void CreateTexture() override {}
+		void DestroyTexture() override {}
+	};
+
+	class CpuTextureAtlas : public TextureAtlas
+	{
+	public:
+		CpuTextureAtlas(int32_t layer_width, int32_t layer_height, int32_t padding) : TextureAtlas(layer_width, layer_height, padding) {}
+		void CreateTextureAtlas() override {}
+		void DestroyTextureAtlas() override {}
+	};
+
+	TEST_CLASS(TextureAtlasTests)
+	{
+	public:
+
+		// Get the RGBA texel at pixel (x, y) of an atlas layer
+		static unsigned char const * GetTexel(TextureAtlas const & atlas, int32_t layer, int32_t x, int32_t y)
+		{
+			size_t layer_size { static_cast<size_t>(atlas.GetLayerWidth()) * atlas.GetLayerHeight() * 4 };
+			return atlas.GetImgData().data() + layer * layer_size + (static_cast<size_t>(y) * atlas.GetLayerWidth() + x) * 4;
+		}
+
+		TEST_METHOD(TestPackUncompressed)
+		{
+			std::vector<unsigned char> img(8 * 8 * 4, 0);
+			for(size_t i = 0; i < img.size(); i += 4)
+				img[i] = img[i + 3] = 255;
+			CpuTexture texture { "red" };
+			texture.SetImgData(img.data(), 8, 8, 4);
+
+			CpuTextureAtlas atlas { 64, 64, 2 };
+			Assert::IsTrue(atlas.AddTexture(&texture));
+			atlas.Pack();
+			Assert::AreEqual(1, atlas.GetNumLayers());
+
+			// The texture is drawn from inside its padding, which repeats its border
+			TextureAtlasRegion const * region { atlas.GetRegion(&texture) };
+			Assert::IsNotNull(region);
+			int32_t x { static_cast<int32_t>(region->uv_rect_.x * 64) };
+			int32_t y { static_cast<int32_t>(region->uv_rect_.y * 64) };
+			Assert::AreEqual(uint8_t { 255 }, GetTexel(atlas, region->layer_, x, y)[0]);
+			Assert::AreEqual(uint8_t { 255 }, GetTexel(atlas, region->layer_, x - 2, y - 2)[0]);
+		}
+
+		TEST_METHOD(TestPackCompressed)
+		{
+			// A block compressed texture has no uncompressed image data, it is decoded as it is copied into the atlas
+			std::vector<unsigned char> img(8 * 8 * 4);
+			for(size_t t = 0; t < 64; ++t)
+			{
+				img[t * 4] = (t & 1) ? 255 : 0;
+				img[t * 4 + 1] = (t & 1) ? 0 : 255;
+				img[t * 4 + 2] = 0;
+				img[t * 4 + 3] = 255;
+			}
+			CpuTexture texture { "checker" };
+			texture.SetCompressedImage(CompressedImage::Encode(img.data(), 8, 8, 4, ETextureCompression::BC3, false));
+			Assert::IsNull(texture.GetImgData());
+
+			CpuTextureAtlas atlas { 64, 64, 2 };
+			Assert::IsTrue(atlas.AddTexture(&texture));
+			atlas.Pack();
+
+			TextureAtlasRegion const * region { atlas.GetRegion(&texture) };
+			Assert::IsNotNull(region);
+			int32_t x0 { static_cast<int32_t>(region->uv_rect_.x * 64) };
+			int32_t y0 { static_cast<int32_t>(region->uv_rect_.y * 64) };
+			for(int32_t t = 0; t < 64; ++t)
+			{
+				unsigned char const * texel { GetTexel(atlas, region->layer_, x0 + t % 8, y0 + t / 8) };
+				for(int32_t c = 0; c < 4; ++c)
+					Assert::IsTrue(std::abs(texel[c] - img[t * 4 + c]) <= 8);
+			}
+		}
+	};
+}
@@ -0,0 +1,149 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../OSE V2/OSE-Core/Rendering/TransientTargetAllocator.h"
+#include <random>
+#pragma comment(lib, "../Debug/OSE V2.lib")
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace ose;
+
+namespace OSEV2UnitTests
+{
+	TEST_CLASS(TransientTargetAllocatorTests)
+	{
+	public:
+
+		// Plan a scene pass followed by a chain of effects, each reading the previous image and writing a new one of the same description
+		// Returns the image target of every pass
+		static std::vector<uint32_t> PlanChain(TransientTargetAllocator & allocator, size_t num_effects, RenderTargetDesc const & desc)
+		{
+			std::vector<uint32_t> images { allocator.Create(desc) };
+			allocator.Use(images[0]);
+			for(size_t e = 0; e < num_effects; ++e)
+			{
+				allocator.BeginPass();
+				uint32_t dest { allocator.Create(desc) };
+				allocator.Use(images.back());
+				allocator.Use(dest);
+				images.push_back(dest);
+			}
+			return images;
+		}
+
+		TEST_METHOD(TestEffectChainUsesTwoTargets)
+		{
+			RenderTargetDesc desc { 1280, 720, ERenderTargetFormat::RGBA8, false };
+			for(size_t num_effects : { 2u, 3u, 8u, 31u })
+			{
+				TransientTargetAllocator allocator;
+				std::vector<uint32_t> images { PlanChain(allocator, num_effects, desc) };
+				allocator.Allocate();
+
+				// Only a pass's source and destination are alive at once, so the chain ping-pongs between two targets
+				Assert::AreEqual(size_t { 2 }, allocator.GetPhysicalDescs().size());
+				for(auto const & physical_desc : allocator.GetPhysicalDescs())
+					Assert::IsTrue(physical_desc == desc);
+				for(size_t i = 1; i < images.size(); ++i)
+					Assert::AreNotEqual(allocator.GetPhysical(images[i - 1]), allocator.GetPhysical(images[i]));
+			}
+		}
+
+		TEST_METHOD(TestDifferentDescriptionsAreNotShared)
+		{
+			TransientTargetAllocator allocator;
+			uint32_t full { allocator.Create({ 1280, 720, ERenderTargetFormat::RGBA8, false }) };
+			allocator.Use(full);
+			allocator.BeginPass();
+			uint32_t half { allocator.Create({ 640, 360, ERenderTargetFormat::RGBA16F, false }) };
+			allocator.Use(half);
+			allocator.Allocate();
+
+			// full is dead before half is written, but a physical target only holds one description
+			Assert::AreEqual(size_t { 2 }, allocator.GetPhysicalDescs().size());
+			Assert::AreNotEqual(allocator.GetPhysical(full), allocator.GetPhysical(half));
+		}
+
+		TEST_METHOD(TestUnusedTargetsHaveNoMemory)
+		{
+			TransientTargetAllocator allocator;
+			uint32_t unused { allocator.Create({ 64, 64, ERenderTargetFormat::RGBA8, false }) };
+			Assert::AreEqual(TransientTargetAllocator::NO_TARGET, allocator.Create({ 0, 64, ERenderTargetFormat::RGBA8, false }));
+			allocator.Allocate();
+			Assert::AreEqual(TransientTargetAllocator::NO_TARGET, allocator.GetPhysical(unused));
+			Assert::IsTrue(allocator.GetPhysicalDescs().empty());
+
+			// Reset removes every target s.t. the next frame is planned from scratch
+			allocator.Reset();
+			Assert::AreEqual(size_t { 0 }, allocator.GetNumTargets());
+		}
+
+		TEST_METHOD(TestOverlappingLifetimesNeverShare)
+		{
+			std::vector<RenderTargetDesc> descs {
+				{ 1280, 720, ERenderTargetFormat::RGBA8, false },
+				{ 1280, 720, ERenderTargetFormat::RGBA8, true },
+				{ 640, 360, ERenderTargetFormat::RGBA16F, false }
+			};
+			std::mt19937 rng { 7 };
+			std::uniform_int_distribution<uint32_t> pass_dist { 0, 19 };
+			std::uniform_int_distribution<size_t> desc_dist { 0, descs.size() - 1 };
+
+			for(int32_t frame = 0; frame < 20; ++frame)
+			{
+				// Random lifetimes, each target is created in its first pass and last used in its last pass
+				struct Lifetime { uint32_t first_; uint32_t last_; size_t desc_; };
+				std::vector<Lifetime> lifetimes(40);
+				for(auto & lifetime : lifetimes)
+				{
+					uint32_t a { pass_dist(rng) };
+					uint32_t b { pass_dist(rng) };
+					lifetime = { std::min(a, b), std::max(a, b), desc_dist(rng) };
+				}
+
+				TransientTargetAllocator allocator;
+				std::vector<uint32_t> targets(lifetimes.size(), TransientTargetAllocator::NO_TARGET);
+				for(uint32_t pass = 0; pass < 20; ++pass)
+				{
+					if(pass > 0)
+						allocator.BeginPass();
+					for(size_t t = 0; t < lifetimes.size(); ++t)
+					{
+						if(lifetimes[t].first_ == pass)
+							targets[t] = allocator.Create(descs[lifetimes[t].desc_]);
+						if(pass == lifetimes[t].first_ || pass == lifetimes[t].last_)
+							allocator.Use(targets[t]);
+					}
+				}
+				allocator.Allocate();
+
+				for(size_t a = 0; a < lifetimes.size(); ++a)
+				{
+					uint32_t physical { allocator.GetPhysical(targets[a]) };
+					Assert::IsTrue(physical < allocator.GetPhysicalDescs().size());
+					Assert::IsTrue(allocator.GetPhysicalDescs()[physical] == descs[lifetimes[a].desc_]);
+					for(size_t b = a + 1; b < lifetimes.size(); ++b)
+					{
+						bool overlap { lifetimes[a].first_ <= lifetimes[b].last_ && lifetimes[b].first_ <= lifetimes[a].last_ };
+						if(overlap)
+							Assert::AreNotEqual(physical, allocator.GetPhysical(targets[b]));
+					}
+				}
+
+				// Each description needs as many physical targets as its peak number of live targets, and no more
+				for(size_t d = 0; d < descs.size(); ++d)
+				{
+					size_t peak { 0 };
+					for(uint32_t pass = 0; pass < 20; ++pass)
+					{
+						size_t live { static_cast<size_t>(std::count_if(lifetimes.begin(), lifetimes.end(), [pass, d](Lifetime const & l) {
+							return l.desc_ == d && l.first_ <= pass && pass <= l.last_;
+						})) };
+						peak = std::max(peak, live);
+					}
+					auto const & physical_descs { allocator.GetPhysicalDescs() };
+					Assert::AreEqual(peak, static_cast<size_t>(std::count(physical_descs.begin(), physical_descs.end(), descs[d])));
+				}
+			}
+		}
+	};
+}
@@ -12,4 +12,7 @@
 
 #include <string>
 
+// The engine's headers expect the engine's precompiled header to be included first
+#include "../OSE V2/stdafx.h"
+
 // TODO: reference additional headers your program requires here
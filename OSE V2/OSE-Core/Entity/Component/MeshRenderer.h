@@ -19,6 +19,9 @@ namespace ose
 		Mesh const * mesh_			{ nullptr };
 		Material const * material_	{ nullptr };
 
+		// Whether the mesh hides the meshes behind it from the occlusion culler, best suited to large, simple meshes such as walls
+		bool occluder_ { false };
+
 	public:
 
 		// Set the mesh displayed by the mesh renderer
@@ -33,8 +36,16 @@ namespace ose
 		// Get the material used to shade the mesh
 		Material const * GetMaterial() const { return material_; }
 
+		// Set whether the mesh is rasterized by the occlusion culler
+		// IMPORTANT - must be set before the mesh renderer is added to the render pool
+		void SetOccluder(bool occluder) { occluder_ = occluder; }
+
+		// Returns true iff the mesh is rasterized by the occlusion culler
+		bool IsOccluder() const { return occluder_; }
+
 		// Initialise the mesh renderer
-		MeshRenderer(std::string const & name, Mesh const * m, Material const * mat) : Component(name), mesh_(m), material_(mat) {}
+		MeshRenderer(std::string const & name, Mesh const * m, Material const * mat, bool occluder = false)
+			: Component(name), mesh_(m), material_(mat), occluder_(occluder) {}
 
 		// Does nothing
 		virtual ~MeshRenderer() noexcept {}
@@ -1,5 +1,6 @@
 #pragma once
 #include "Component.h"
+#include "OSE-Core/Rendering/ETileRenderMode.h"
 
 namespace ose
 {
@@ -39,6 +40,9 @@ namespace ose
 		float spacing_x_ { 1.0f };
 		float spacing_y_ { 1.0f };
 
+		// How the tilemap is rendered, must be set before the tile renderer is added to the render pool
+		ETileRenderMode render_mode_ { ETileRenderMode::CHUNKED };
+
 	public:
 
 		Texture const * GetTexture() const { return texture_; }
@@ -52,6 +56,8 @@ namespace ose
 		float GetSpacingX() const { return spacing_x_; }
 		float GetSpacingY() const { return spacing_y_; }
 
+		ETileRenderMode GetRenderMode() const { return render_mode_; }
+
 		void SetTexture(Texture const * texture) { texture_ = texture; }
 		void SetTilemap(Tilemap const * tilemap) { tilemap_ = tilemap; }
 		void SetMaterial(Material const * material) { material_ = material; }
@@ -63,10 +69,13 @@ namespace ose
 		void SetSpacingX(float val) { if(val > 0) spacing_x_ = val; }
 		void SetSpacingY(float val) { if(val > 0) spacing_y_ = val; }
 
+		void SetRenderMode(ETileRenderMode mode) { render_mode_ = mode; }
+
 		// Initialise the tile renderer
 		TileRenderer(std::string const & name, Texture const * t, Tilemap const * tm, Material const * m,
-			int32_t num_cols, int32_t num_rows, int32_t num_tiles, float spacing_x, float spacing_y)
-			: Component(name), texture_(t), tilemap_(tm), material_(m)
+			int32_t num_cols, int32_t num_rows, int32_t num_tiles, float spacing_x, float spacing_y,
+			ETileRenderMode render_mode = ETileRenderMode::CHUNKED)
+			: Component(name), texture_(t), tilemap_(tm), material_(m), render_mode_(render_mode)
 		{
 			SetNumCols(num_cols);
 			SetNumRows(num_rows);
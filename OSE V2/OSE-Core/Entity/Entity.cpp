@@ -22,6 +22,7 @@ namespace ose
 		unique_id_ = Entity::NextEntityId();
 		tag_ = other.tag_;
 		prefab_ = other.prefab_;
+		static_ = other.static_;
 
 		local_transform_ = other.local_transform_;
 		global_transform_ = other.global_transform_;
@@ -49,4 +50,11 @@ namespace ose
 		if(game_)
 			game_->OnEntityDeactivated(*this);
 	}
+
+	// Called whenever the global transform of the entity changes, notifies the game's transform change list
+	void Entity::OnGlobalTransformChanged()
+	{
+		if(game_)
+			game_->GetTransformChangeList().Push(unique_id_, global_transform_, transform_change_frame_);
+	}
 }
@@ -30,9 +30,18 @@ namespace ose
 		void Enable();
 		void Disable();
 
+		// Static entities are not expected to move once activated
+		// Their mesh renderers are merged with other static geometry, so moving a static entity has no visual effect
+		bool IsStatic() const { return static_; }
+		void SetStatic(bool a) { static_ = a; }
+
 		// Should NEVER be called directly by a script
 		void SetGameReference(Game * game) { game_ = game; }
 
+	protected:
+		// Called whenever the global transform of the entity changes, notifies the game's transform change list
+		void OnGlobalTransformChanged() override;
+
 	private:
 		std::string name_;		// name_ need not be unique
 		EntityID unique_id_;	// unique_ID_ should be unique to a game engine execution
@@ -42,8 +51,12 @@ namespace ose
 
 		bool enabled_ { true };	// True iff the entity is enabled (i.e. it appears in the scene)
 
+		bool static_ { false };	// True iff the entity never moves, s.t. its geometry can be batched with other static geometry
+
 		Game * game_ { nullptr }; // Pointer to the game object this entity belongs to
 
+		uint32_t transform_change_frame_ { 0 }; // Index of the last frame the entity was pushed to the transform change list
+
 		// Get the next available entity ID
 		static EntityID NextEntityId()
 		{
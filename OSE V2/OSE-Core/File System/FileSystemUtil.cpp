@@ -171,6 +171,19 @@ namespace ose::fs
 		return std::filesystem::exists(path) && std::filesystem::is_regular_file(path);
 	}
 
+	// Returns true iff both files exist and the file at path was last written after the file at other_path
+	bool IsFileNewer(std::string const & path, std::string const & other_path)
+	{
+		std::error_code ec;
+		auto time { std::filesystem::last_write_time(path, ec) };
+		if(ec)
+			return false;
+		auto other_time { std::filesystem::last_write_time(other_path, ec) };
+		if(ec)
+			return false;
+		return time > other_time;
+	}
+
 	// Get the filename of a path
 	std::string GetFilenameFromPath(std::string const & path)
 	{
@@ -37,6 +37,9 @@ namespace ose
 		// Returns true iff the path exists and is a file
 		bool DoesFileExist(std::string const & path);
 
+		// Returns true iff both files exist and the file at path was last written after the file at other_path
+		bool IsFileNewer(std::string const & path, std::string const & other_path);
+
 		// Get the filename of a path
 		std::string GetFilenameFromPath(std::string const & path);
 
@@ -20,7 +20,28 @@ namespace ose
 		// Get the global camera transform (i.e. the transform to transform world transforms by to transform into camera space)
 		virtual ITransform const & GetGlobalTransform() const { return Transform::IDENTITY; }
 
+		// Set the part of the window the camera is drawn to: the bottom left corner (xy) and size (zw) as fractions of the window
+		// Only used by camera layers, the active camera always fills the window
+		void SetViewport(glm::vec4 const & viewport) { viewport_ = viewport; }
+
+		glm::vec4 const & GetViewport() const { return viewport_; }
+
+		// Set the order camera layers are drawn to the window in, layers are drawn over the active camera in increasing order
+		void SetLayer(int32_t layer) { layer_ = layer; }
+
+		int32_t GetLayer() const { return layer_; }
+
+		// Enable/disable applying the post-processing chain to the camera's image
+		void SetPostProcessing(bool enabled) { post_processing_ = enabled; }
+
+		bool IsPostProcessingEnabled() const { return post_processing_; }
+
 	protected:
 		Game * game_ { nullptr };
+
+	private:
+		glm::vec4 viewport_ { 0.0f, 0.0f, 1.0f, 1.0f };
+		int32_t layer_ { 0 };
+		bool post_processing_ { true };
 	};
 }
@@ -0,0 +1,97 @@
+#include "stdafx.h"
+#include "FrameProfile.h"
+
+namespace ose
+{
+	// Start recording a new frame, returns the number of the new frame
+	uint64_t FrameProfile::BeginFrame()
+	{
+		if(frames_.size() >= HISTORY_SIZE)
+			frames_.pop_front();
+		frames_.push_back({ ++current_frame_, {} });
+		return current_frame_;
+	}
+
+	// Add a timing to the current frame, ignored before the first frame begins
+	void FrameProfile::AddSample(ProfileSample sample)
+	{
+		if(!frames_.empty())
+			frames_.back().samples_.push_back(std::move(sample));
+	}
+
+	// Add timings to an earlier frame, ignored if the frame is no longer held
+	void FrameProfile::AddSamples(uint64_t frame, std::vector<ProfileSample> const & samples)
+	{
+		// Frames are numbered consecutively, so the frame's record can be found from the oldest frame's number
+		if(frames_.empty() || frame < frames_.front().frame_ || frame > frames_.back().frame_)
+			return;
+		auto & record { frames_[static_cast<size_t>(frame - frames_.front().frame_)] };
+		record.samples_.insert(record.samples_.end(), samples.begin(), samples.end());
+	}
+
+	// Get the timings of a frame, nullptr if the frame is not held
+	std::vector<ProfileSample> const * FrameProfile::GetSamples(uint64_t frame) const
+	{
+		if(frames_.empty() || frame < frames_.front().frame_ || frame > frames_.back().frame_)
+			return nullptr;
+		return &frames_[static_cast<size_t>(frame - frames_.front().frame_)].samples_;
+	}
+
+	// Get the mean time (in milliseconds) of a section over the held frames in which it was measured, 0 if it was never measured
+	float FrameProfile::GetAverage(EProfileSource source, std::string const & name) const
+	{
+		float total { 0.0f };
+		uint32_t count { 0 };
+		for(auto const & record : frames_)
+		{
+			for(auto const & sample : record.samples_)
+			{
+				if(sample.source_ == source && sample.name_ == name)
+				{
+					total += sample.ms_;
+					++count;
+				}
+			}
+		}
+		return count > 0 ? total / count : 0.0f;
+	}
+
+	// Get the mean timings of every section over the held frames in which they were measured, in the order they were first measured
+	std::vector<ProfileSample> FrameProfile::GetAverages() const
+	{
+		std::vector<ProfileSample> averages;
+		std::vector<uint32_t> counts;
+		std::map<std::pair<EProfileSource, std::string>, size_t> indices;
+		for(auto const & record : frames_)
+		{
+			for(auto const & sample : record.samples_)
+			{
+				auto [iter, inserted] { indices.try_emplace({ sample.source_, sample.name_ }, averages.size()) };
+				if(inserted)
+				{
+					averages.push_back({ sample.source_, sample.name_, sample.depth_, 0.0f });
+					counts.push_back(0);
+				}
+				averages[iter->second].ms_ += sample.ms_;
+				++counts[iter->second];
+			}
+		}
+		for(size_t i = 0; i < averages.size(); ++i)
+			averages[i].ms_ /= counts[i];
+		return averages;
+	}
+
+	// Write the held frames as CSV, one row per sample: frame, source, depth, section, milliseconds
+	void FrameProfile::Export(std::ostream & os) const
+	{
+		os << "frame,source,depth,section,ms\n";
+		for(auto const & record : frames_)
+		{
+			for(auto const & sample : record.samples_)
+			{
+				os << record.frame_ << ',' << (sample.source_ == EProfileSource::CPU ? "cpu" : "gpu") << ',' << sample.depth_
+					<< ",\"" << sample.name_ << "\"," << sample.ms_ << '\n';
+			}
+		}
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <deque>
+#include <chrono>
+
+namespace ose
+{
+	// Where a timing was measured
+	enum class EProfileSource
+	{
+		CPU,
+		GPU
+	};
+
+	// Time spent in a named section of a frame
+	struct ProfileSample
+	{
+		EProfileSource source_ { EProfileSource::CPU };
+
+		// Name of the section, nested sections are prefixed with their parent's name, e.g. "Pass 0/Group 1"
+		std::string name_;
+
+		// Depth of nesting, 0 for the whole frame
+		uint32_t depth_ { 0 };
+
+		float ms_ { 0.0f };
+	};
+
+	// Timings of recent frames measured on the CPU and GPU, kept in one stream s.t. they can be compared and exported together
+	// GPU timings arrive a few frames late, they are added to the frame they were measured in rather than the current frame
+	class FrameProfile
+	{
+	public:
+		// Number of frames held, the oldest frame is dropped when a new frame begins
+		static constexpr size_t HISTORY_SIZE { 120 };
+
+		// Start recording a new frame, returns the number of the new frame
+		uint64_t BeginFrame();
+
+		// Get the number of the frame being recorded, 0 before the first frame begins
+		uint64_t GetCurrentFrame() const { return current_frame_; }
+
+		// Add a timing to the current frame, ignored before the first frame begins
+		void AddSample(ProfileSample sample);
+
+		// Add timings to an earlier frame, ignored if the frame is no longer held
+		void AddSamples(uint64_t frame, std::vector<ProfileSample> const & samples);
+
+		// Get the timings of a frame, nullptr if the frame is not held
+		std::vector<ProfileSample> const * GetSamples(uint64_t frame) const;
+
+		// Get the mean time (in milliseconds) of a section over the held frames in which it was measured, 0 if it was never measured
+		float GetAverage(EProfileSource source, std::string const & name) const;
+
+		// Get the mean timings of every section over the held frames in which they were measured, in the order they were first measured
+		std::vector<ProfileSample> GetAverages() const;
+
+		// Write the held frames as CSV, one row per sample: frame, source, depth, section, milliseconds
+		void Export(std::ostream & os) const;
+
+	private:
+		struct FrameRecord
+		{
+			uint64_t frame_ { 0 };
+			std::vector<ProfileSample> samples_;
+		};
+
+		// Held frames, oldest first
+		std::deque<FrameRecord> frames_;
+
+		uint64_t current_frame_ { 0 };
+	};
+
+	// Adds the CPU time from its construction to its destruction to the current frame of a profile
+	// Does nothing if the profile is nullptr, s.t. sections can be timed unconditionally
+	class CpuProfileScope
+	{
+	public:
+		CpuProfileScope(FrameProfile * profile, char const * name, uint32_t depth = 1) : profile_(profile), name_(name), depth_(depth)
+		{
+			if(profile_)
+				start_ = std::chrono::steady_clock::now();
+		}
+
+		~CpuProfileScope()
+		{
+			if(profile_)
+				profile_->AddSample({ EProfileSource::CPU, name_,
+					depth_, std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start_).count() });
+		}
+
+		CpuProfileScope(CpuProfileScope const &) = delete;
+		CpuProfileScope & operator=(CpuProfileScope const &) = delete;
+
+	private:
+		FrameProfile * profile_;
+		char const * name_;
+		uint32_t depth_;
+		std::chrono::steady_clock::time_point start_;
+	};
+}
@@ -39,6 +39,16 @@ namespace ose
 		rendering_engine_ = std::move(RenderingFactories[0]->NewRenderingEngine(fbwidth, fbheight));
 		window_manager_->SetEngineReferences(rendering_engine_.get(), this);
 
+		// Shaders are compiled on a worker thread with its own context, s.t. frames never wait for them
+		shared_context_ = window_manager_->NewSharedContext();
+		if(shared_context_)
+		{
+			WindowManager * window_manager { window_manager_.get() };
+			void * shared_context { shared_context_ };
+			rendering_engine_->SetWorkerContext([window_manager, shared_context]() { window_manager->MakeContextCurrent(shared_context); },
+				[window_manager]() { window_manager->MakeContextCurrent(nullptr); });
+		}
+
 		scripting_engine_ = ScriptingFactories[0]->NewScriptingEngine();
 
 		time_.Init(window_manager_->GetTimeSeconds());
@@ -46,7 +56,23 @@ namespace ose
 		active_camera_ = &default_camera_;
 	}
 
-	Game::~Game() noexcept {}
+	Game::~Game() noexcept
+	{
+		// Keep the timings of the last frames for offline analysis
+		if(profiling_ && project_)
+			ExportFrameProfile(project_->GetProjectPath() + "/frame_profile.csv");
+
+		// Texture atlases are owned by the project, which outlives the window's render context
+		if(project_)
+			project_->GetResourceManager().DestroyTextureAtlases();
+
+		// The rendering engine's worker must stop using the shared context before it is destroyed
+		if(shared_context_)
+		{
+			rendering_engine_->SetWorkerContext({}, {});
+			window_manager_->DestroySharedContext(shared_context_);
+		}
+	}
 
 	// Called upon a project being activated
 	// Project is activated upon successful load
@@ -56,6 +82,10 @@ namespace ose
 		// Set the rendering settings
 		rendering_engine_->ApplyRenderingSettings(project.GetProjectSettings().rendering_settings_);
 
+		// The rendering engine adds the GPU timings of each frame to the same profile as the CPU timings
+		profiling_ = project.GetProjectSettings().rendering_settings_.profiler_;
+		rendering_engine_->SetFrameProfile(profiling_ ? &frame_profile_ : nullptr);
+
 		// Clear the input manager of inputs from previous projects then apply the default project inputs
 		ClearInputs();
 		ApplyInputSettings(project.GetInputSettings());
@@ -79,11 +109,26 @@ namespace ose
 		// Reset the chunk manager agent, e.g. find the agent using the Game::FindAllEntitiesWithName method
 		scene.ResetChunkManagerAgent(this);
 
+		// Scenes can override the project's render path, e.g. deferred shading for scenes with many lights
+		rendering_engine_->SetRenderPath(scene.GetRenderPath().value_or(project_->GetProjectSettings().rendering_settings_.render_path_));
+
+		// Write the containers of textures which request compression, they are loaded instead of the images from the next run
+		if(project_->GetProjectSettings().rendering_settings_.build_texture_containers_)
+			project_->GetResourceManager().CompressTextures();
+
 		// IMPORTANT - the following code can only be run on the same thread as the render context
 
 		// create GPU memory for the new resources
 		project_->CreateGpuResources();
 
+		// Pack the textures of the scene's sprites into atlases s.t. sprites sharing a material can be drawn together
+		std::vector<Texture const *> sprite_textures;
+		for(auto const & entity : GetEntities())
+			FindSpriteTextures(*entity, sprite_textures);
+		for(auto const & entity : scene.GetEntities())
+			FindSpriteTextures(*entity, sprite_textures);
+		project_->GetResourceManager().CreateTextureAtlases(sprite_textures);
+
 		// Initialise the non-persistent control scripts
 		scripting_engine_->GetScriptPool().ApplyControlSettings(scene.GetControlSettings());
 		scripting_engine_->InitSceneControls(this);
@@ -133,29 +178,99 @@ namespace ose
 
 		while(running_)
 		{
+			// Each stage of the frame is timed whilst profiling, the scopes do nothing when profile is nullptr
+			FrameProfile * profile { profiling_ ? &frame_profile_ : nullptr };
+			if(profile)
+				profile->BeginFrame();
+			CpuProfileScope frame_scope { profile, "Frame", 0 };
+
 			// Renders previous frame to window and poll for new event
-			window_manager_->Update();
+			{
+				CpuProfileScope scope { profile, "Window" };
+				window_manager_->Update();
+			}
 
 			// Update all timing variables
 			time_.Update(window_manager_->GetTimeSeconds());
 
 			// Update the chunks of the active scene (TODO - Do this at a fixed rate to reduce computation)
-			active_scene_->UpdateChunks();
+			{
+				CpuProfileScope scope { profile, "Chunks" };
+				active_scene_->UpdateChunks();
+			}
 
 			// Execute developer created scripts
-			scripting_engine_->Update();
+			{
+				CpuProfileScope scope { profile, "Scripts" };
+				scripting_engine_->Update();
+			}
 
-			// Update the camera
+			// Update the cameras
 			active_camera_->Update();
+			for(Camera * camera : camera_layers_)
+				camera->Update();
+			sorted_camera_layers_.assign(camera_layers_.begin(), camera_layers_.end());
+			std::stable_sort(sorted_camera_layers_.begin(), sorted_camera_layers_.end(),
+				[](Camera const * a, Camera const * b) { return a->GetLayer() < b->GetLayer(); });
+
+			// Update the render objects of entities which have moved this frame
+			{
+				CpuProfileScope scope { profile, "Transforms" };
+				rendering_engine_->GetRenderPool().ApplyTransformChanges(transform_change_list_);
+				transform_change_list_.Clear();
+			}
 
 			// Render to the back buffer
-			rendering_engine_->Render(*active_camera_);
+			{
+				CpuProfileScope scope { profile, "Render" };
+				rendering_engine_->Render(*active_camera_, sorted_camera_layers_);
+			}
 
 			// TODO - Remove once proper FPS display is implemented
-			window_manager_->SetTitle(std::to_string(time_.GetFps()));
+			// Whilst profiling the average CPU and GPU frame times are shown too, updated once a second to keep the title readable
+			if(profile && time_.GetFps() > 0 && profile->GetCurrentFrame() % static_cast<uint64_t>(time_.GetFps()) == 0)
+			{
+				std::ostringstream title;
+				title << time_.GetFps() << " fps, CPU " << profile->GetAverage(EProfileSource::CPU, "Frame") << "ms, GPU "
+					<< profile->GetAverage(EProfileSource::GPU, "Frame") << "ms";
+				window_manager_->SetTitle(title.str());
+			}
+			else if(!profile)
+			{
+				window_manager_->SetTitle(std::to_string(time_.GetFps()));
+			}
 		}
 	}
 
+	// Add a camera which is rendered to a texture each frame and drawn over the active camera in its viewport, e.g. a minimap
+	// Layers are drawn in increasing order of their layer, the camera must be removed before it is destroyed
+	void Game::AddCameraLayer(Camera * c)
+	{
+		if(c == nullptr || std::find(camera_layers_.begin(), camera_layers_.end(), c) != camera_layers_.end())
+			return;
+		c->SetGameReference(this);
+		camera_layers_.push_back(c);
+	}
+
+	// Remove a camera added by AddCameraLayer(), does nothing if the camera isn't a layer
+	void Game::RemoveCameraLayer(Camera * c)
+	{
+		camera_layers_.erase(std::remove(camera_layers_.begin(), camera_layers_.end(), c), camera_layers_.end());
+	}
+
+	// Write the timings of recent frames to a CSV file
+	void Game::ExportFrameProfile(std::string const & path) const
+	{
+		std::ofstream file { path };
+		if(!file)
+		{
+			LOG_ERROR("Failed to export frame profile to", path);
+			return;
+		}
+		frame_profile_.Export(file);
+		LOG("Exported frame profile to", path);
+	}
+
 	// Activate an entity along with activated sub-entities
 	void Game::OnEntityActivated(Entity & entity)
 	{
@@ -187,8 +302,11 @@ namespace ose
 			comp->Init();
 			DEBUG_LOG("Initialised MeshRenderer");
 
-			// then add the component to the render pool
-			rendering_engine_->GetRenderPool().AddMeshRenderer(entity.GetGlobalTransform(), comp);
+			// then add the component to the render pool, static geometry is batched rather than instanced
+			if(entity.IsStatic())
+				rendering_engine_->GetRenderPool().AddStaticMeshRenderer(entity.GetGlobalTransform(), comp);
+			else
+				rendering_engine_->GetRenderPool().AddMeshRenderer(entity.GetGlobalTransform(), comp);
 		}
 
 		for(PointLight * comp : entity.GetComponents<PointLight>())
@@ -300,6 +418,19 @@ namespace ose
 		}
 	}
 
+	// Find the textures used by the sprite and tile renderers of an entity and its sub-entities
+	void Game::FindSpriteTextures(Entity const & entity, std::vector<Texture const *> & textures)
+	{
+		for(SpriteRenderer * comp : entity.GetComponents<SpriteRenderer>())
+			textures.push_back(comp->GetTexture());
+
+		for(TileRenderer * comp : entity.GetComponents<TileRenderer>())
+			textures.push_back(comp->GetTexture());
+
+		for(auto const & sub_entity : entity.GetEntities())
+			FindSpriteTextures(*sub_entity, textures);
+	}
+
 	// Find all the entities with the given name
 	// Includes persistent entities, scene entities, and loaded chunk entities
 	std::vector<Entity *> Game::FindAllEntitiesWithName(std::string_view name) const
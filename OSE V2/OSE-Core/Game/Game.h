@@ -4,8 +4,10 @@
 #include "Scene/SceneManager.h"
 #include "OSE-Core/Entity/EntityList.h"
 #include "OSE-Core/Input/InputManager.h"
+#include "OSE-Core/Math/TransformChangeList.h"
 #include "ThreadManager.h"
 #include "Time.h"
+#include "FrameProfile.h"
 #include "Camera/Camera.h"
 #include <ctime>
 
@@ -21,6 +23,7 @@ namespace ose
 	class Component;
 	class SpriteRenderer;
 	class MeshRenderer;
+	class Texture;
 	class ScriptingEngine;
 	struct CustomObject;
 
@@ -68,9 +71,26 @@ namespace ose
 		// Get the active camera
 		Camera * GetActiveCamera() const { return active_camera_; }
 
+		// Add a camera which is rendered to a texture each frame and drawn over the active camera in its viewport, e.g. a minimap
+		// Layers are drawn in increasing order of their layer, the camera must be removed before it is destroyed
+		void AddCameraLayer(Camera * c);
+
+		// Remove a camera added by AddCameraLayer(), does nothing if the camera isn't a layer
+		void RemoveCameraLayer(Camera * c);
+
 		// Get the time object
 		Time const & GetTime() { return time_; }
 
+		// Get the CPU and GPU timings of recent frames, only recorded whilst the active project enables the profiler
+		FrameProfile const & GetFrameProfile() const { return frame_profile_; }
+
+		// Write the timings of recent frames to a CSV file
+		void ExportFrameProfile(std::string const & path) const;
+
+		// Get the list of entities whose global transform has changed this frame
+		// Should NEVER be modified directly by a script, entities push to the list when transformed
+		TransformChangeList & GetTransformChangeList() { return transform_change_list_; }
+
 		// Load a custom data file
 		uptr<CustomObject> LoadCustomDataFile(std::string const & path);
 
@@ -105,6 +125,9 @@ namespace ose
 		// Rendering engine handles all rendering of entity render objects
 		uptr<RenderingEngine> rendering_engine_;
 
+		// Hidden context sharing GPU objects with the window's context, used by the rendering engine's worker thread
+		void * shared_context_ { nullptr };
+
 		// Scripting engine handles execution of game developer created scripts
 		uptr<ScriptingEngine> scripting_engine_;
 
@@ -117,13 +140,31 @@ namespace ose
 		// The default camera
 		Camera default_camera_;
 
+		// Cameras drawn over the active camera, in the order they were added
+		std::vector<Camera *> camera_layers_;
+
+		// Camera layers in the order they are drawn, rebuilt each frame s.t. layers can be reordered at any time
+		std::vector<Camera const *> sorted_camera_layers_;
+
 		// Time handles calculation of delta time, fps etc. and provides a way for scripts to get the timing variables
 		Time time_;
 
+		// List of entities whose global transform has changed this frame, cleared once the frame has been rendered
+		TransformChangeList transform_change_list_;
+
+		// CPU time of each stage of recent frames, and the GPU time of their passes added by the rendering engine
+		FrameProfile frame_profile_;
+
+		// True iff the active project enables the profiler
+		bool profiling_ { false };
+
 		// True iff the game is currently running (paused is a subset of running)
 		bool running_;
 
 		// Called from startGame, runs a loop while running_ is true
 		void RunGame();
+
+		// Find the textures used by the sprite and tile renderers of an entity and its sub-entities
+		static void FindSpriteTextures(Entity const & entity, std::vector<Texture const *> & textures);
 	};
 }
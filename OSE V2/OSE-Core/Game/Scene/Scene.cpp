@@ -14,6 +14,7 @@ namespace ose
 	{
 		name_ = other.name_;
 		control_settings_ = other.control_settings_;
+		render_path_ = other.render_path_;
 	}
 
 	void Scene::OnChunkActivated(Chunk & chunk)
@@ -3,6 +3,8 @@
 #include "OSE-Core/Entity/EntityList.h"
 #include "OSE-Core/Scripting/ControlSettings.h"
 #include "OSE-Core/Game/Scene/Chunk/ChunkManager.h"
+#include <optional>
+#include "OSE-Core/Rendering/ERenderPath.h"
 
 namespace ose
 {
@@ -28,6 +30,12 @@ namespace ose
 		// Set the scene manager managing this scene
 		void SetSceneManager(SceneManager * s) { scene_manager_ = s; }
 
+		// Get the render path of the scene, empty if the scene uses the project's render path
+		std::optional<ERenderPath> const & GetRenderPath() const { return render_path_; }
+
+		// Override the project's render path whilst the scene is active
+		void SetRenderPath(ERenderPath render_path) { render_path_ = render_path; }
+
 		// DEBUG METHODS
 		// TODO - REMOVE WHEN READY
 		void Print();
@@ -47,6 +55,9 @@ namespace ose
 
 		// The scene manager which is managing this scene
 		SceneManager * scene_manager_ { nullptr };
+
+		// Render path of the scene, empty if the scene uses the project's render path
+		std::optional<ERenderPath> render_path_;
 	};
 }
 
@@ -0,0 +1,52 @@
+#pragma once
+
+namespace ose
+{
+	// Axis aligned bounding box
+	struct AABB
+	{
+		glm::vec3 min_ { 0.0f };
+		glm::vec3 max_ { 0.0f };
+
+		// Get the centre of the box
+		glm::vec3 GetCenter() const { return (min_ + max_) * 0.5f; }
+
+		// Get the half size of the box along each axis
+		glm::vec3 GetExtents() const { return (max_ - min_) * 0.5f; }
+
+		// Get the smallest box containing this box after it has been transformed by a matrix
+		AABB Transformed(glm::mat4 const & m) const
+		{
+			// Transform the centre, then project the extents onto each axis using the absolute rotation/scale matrix
+			glm::vec3 center { m * glm::vec4(GetCenter(), 1.0f) };
+			glm::vec3 extents { GetExtents() };
+			glm::vec3 new_extents {
+				std::abs(m[0][0]) * extents.x + std::abs(m[1][0]) * extents.y + std::abs(m[2][0]) * extents.z,
+				std::abs(m[0][1]) * extents.x + std::abs(m[1][1]) * extents.y + std::abs(m[2][1]) * extents.z,
+				std::abs(m[0][2]) * extents.x + std::abs(m[1][2]) * extents.y + std::abs(m[2][2]) * extents.z
+			};
+			return { center - new_extents, center + new_extents };
+		}
+
+		// Get the smallest box containing both this box and another
+		AABB Merged(AABB const & other) const
+		{
+			return { glm::min(min_, other.min_), glm::max(max_, other.max_) };
+		}
+
+		// Get the smallest box containing a list of xyz positions
+		static AABB FromPositions(std::vector<float> const & positions)
+		{
+			if(positions.size() < 3)
+				return {};
+			AABB box { { positions[0], positions[1], positions[2] }, { positions[0], positions[1], positions[2] } };
+			for(size_t i = 3; i + 2 < positions.size(); i += 3)
+			{
+				glm::vec3 p { positions[i], positions[i + 1], positions[i + 2] };
+				box.min_ = glm::min(box.min_, p);
+				box.max_ = glm::max(box.max_, p);
+			}
+			return box;
+		}
+	};
+}
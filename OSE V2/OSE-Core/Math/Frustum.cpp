@@ -0,0 +1,99 @@
+#include "stdafx.h"
+#include "Frustum.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#define OSE_FRUSTUM_SSE
+#endif
+
+namespace ose
+{
+	// Construct the frustum of a view projection matrix
+	Frustum::Frustum(glm::mat4 const & view_proj)
+	{
+		// Extract the planes from the rows of the matrix (Gribb/Hartmann)
+		glm::mat4 m { glm::transpose(view_proj) };
+		glm::vec4 planes[6] {
+			m[3] + m[0],	// left
+			m[3] - m[0],	// right
+			m[3] + m[1],	// bottom
+			m[3] - m[1],	// top
+			m[3] + m[2],	// near
+			m[3] - m[2]		// far
+		};
+		for(size_t i = 0; i < 6; ++i)
+		{
+			float len { glm::length(glm::vec3(planes[i])) };
+			if(len > 0.0f)
+				planes[i] /= len;
+			nx_[i] = planes[i].x;
+			ny_[i] = planes[i].y;
+			nz_[i] = planes[i].z;
+			d_[i] = planes[i].w;
+		}
+	}
+
+	// Returns true iff the box is at least partially inside the frustum
+	bool Frustum::Intersects(AABB const & box) const
+	{
+		uint8_t visible;
+		return CullAABBs(&box, 1, &visible) == 1;
+	}
+
+	// Test a batch of boxes against the frustum, 4 planes are tested at a time using SIMD where available
+	// visible[i] is set to 1 if boxes[i] is at least partially inside the frustum, else 0
+	// Returns the number of visible boxes
+	size_t Frustum::CullAABBs(AABB const * boxes, size_t count, uint8_t * visible) const
+	{
+		size_t num_visible { 0 };
+
+#ifdef OSE_FRUSTUM_SSE
+		__m128 const sign_mask { _mm_set1_ps(-0.0f) };
+		__m128 const zero { _mm_setzero_ps() };
+		__m128 const nx[2] { _mm_load_ps(nx_), _mm_load_ps(nx_ + 4) };
+		__m128 const ny[2] { _mm_load_ps(ny_), _mm_load_ps(ny_ + 4) };
+		__m128 const nz[2] { _mm_load_ps(nz_), _mm_load_ps(nz_ + 4) };
+		__m128 const d[2] { _mm_load_ps(d_), _mm_load_ps(d_ + 4) };
+		__m128 const abs_nx[2] { _mm_andnot_ps(sign_mask, nx[0]), _mm_andnot_ps(sign_mask, nx[1]) };
+		__m128 const abs_ny[2] { _mm_andnot_ps(sign_mask, ny[0]), _mm_andnot_ps(sign_mask, ny[1]) };
+		__m128 const abs_nz[2] { _mm_andnot_ps(sign_mask, nz[0]), _mm_andnot_ps(sign_mask, nz[1]) };
+
+		for(size_t i = 0; i < count; ++i)
+		{
+			glm::vec3 c { boxes[i].GetCenter() };
+			glm::vec3 e { boxes[i].GetExtents() };
+			__m128 cx { _mm_set1_ps(c.x) }, cy { _mm_set1_ps(c.y) }, cz { _mm_set1_ps(c.z) };
+			__m128 ex { _mm_set1_ps(e.x) }, ey { _mm_set1_ps(e.y) }, ez { _mm_set1_ps(e.z) };
+
+			// The box is outside if, for any plane, the signed distance of its centre plus its projected radius is negative
+			int outside { 0 };
+			for(size_t p = 0; p < 2; ++p)
+			{
+				__m128 dist { _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], cx), _mm_mul_ps(ny[p], cy)), _mm_add_ps(_mm_mul_ps(nz[p], cz), d[p])) };
+				__m128 radius { _mm_add_ps(_mm_add_ps(_mm_mul_ps(abs_nx[p], ex), _mm_mul_ps(abs_ny[p], ey)), _mm_mul_ps(abs_nz[p], ez)) };
+				outside |= _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(dist, radius), zero));
+			}
+
+			visible[i] = outside ? 0 : 1;
+			num_visible += visible[i];
+		}
+#else
+		for(size_t i = 0; i < count; ++i)
+		{
+			glm::vec3 c { boxes[i].GetCenter() };
+			glm::vec3 e { boxes[i].GetExtents() };
+			bool outside { false };
+			for(size_t p = 0; p < 6 && !outside; ++p)
+			{
+				float dist { nx_[p] * c.x + ny_[p] * c.y + nz_[p] * c.z + d_[p] };
+				float radius { std::abs(nx_[p]) * e.x + std::abs(ny_[p]) * e.y + std::abs(nz_[p]) * e.z };
+				outside = dist + radius < 0.0f;
+			}
+			visible[i] = outside ? 0 : 1;
+			num_visible += visible[i];
+		}
+#endif
+
+		return num_visible;
+	}
+}
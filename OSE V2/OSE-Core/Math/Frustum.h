@@ -0,0 +1,32 @@
+#pragma once
+#include "AABB.h"
+
+namespace ose
+{
+	// View frustum defined by the 6 planes of a view projection matrix
+	// Orthographic projections produce a box shaped frustum, i.e. the view rectangle extruded along the view direction
+	class Frustum
+	{
+	public:
+		Frustum() {}
+
+		// Construct the frustum of a view projection matrix
+		Frustum(glm::mat4 const & view_proj);
+
+		// Returns true iff the box is at least partially inside the frustum
+		bool Intersects(AABB const & box) const;
+
+		// Test a batch of boxes against the frustum, 4 planes are tested at a time using SIMD where available
+		// visible[i] is set to 1 if boxes[i] is at least partially inside the frustum, else 0
+		// Returns the number of visible boxes
+		size_t CullAABBs(AABB const * boxes, size_t count, uint8_t * visible) const;
+
+	private:
+		// Planes stored structure of arrays, padded to 8 planes with planes which always pass
+		// A point p is inside plane i iff nx[i]*p.x + ny[i]*p.y + nz[i]*p.z + d[i] >= 0
+		alignas(16) float nx_[8] { 0 };
+		alignas(16) float ny_[8] { 0 };
+		alignas(16) float nz_[8] { 0 };
+		alignas(16) float d_[8] { 1, 1, 1, 1, 1, 1, 1, 1 };
+	};
+}
@@ -0,0 +1,287 @@
+#include "stdafx.h"
+#include "OcclusionBuffer.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#define OSE_OCCLUSION_SSE
+#endif
+
+namespace ose
+{
+	OcclusionBuffer::OcclusionBuffer(int32_t width, int32_t height)
+		: width_(std::max(width, 1)), height_(std::max(height, 1)), stride_((std::max(width, 1) + 3) & ~3),
+		depth_(static_cast<size_t>(stride_) * height_, 1.0f)
+	{
+
+	}
+
+	// Clear the buffer to the far plane and set the view projection matrix occluders and boxes are projected with
+	void OcclusionBuffer::Begin(glm::mat4 const & view_proj)
+	{
+		view_proj_ = view_proj;
+		std::fill(depth_.begin(), depth_.end(), 1.0f);
+		has_occluders_ = false;
+	}
+
+	// Rasterize the triangles of an occluder mesh into the buffer, keeping the nearest depth at each pixel
+	// positions is a list of xyz positions in the mesh's local space, every 3 indices make a triangle
+	// Triangles are drawn regardless of winding and are clipped against the near plane
+	void OcclusionBuffer::RasterizeTriangles(glm::mat4 const & world, float const * positions, size_t num_positions,
+		unsigned int const * indices, size_t num_indices)
+	{
+		glm::mat4 world_view_proj { view_proj_ * world };
+		size_t num_vertices { num_positions / 3 };
+		clip_positions_.resize(num_vertices);
+		for(size_t v = 0; v < num_vertices; ++v)
+			clip_positions_[v] = world_view_proj * glm::vec4(positions[v * 3], positions[v * 3 + 1], positions[v * 3 + 2], 1.0f);
+
+		for(size_t i = 0; i + 2 < num_indices; i += 3)
+		{
+			if(indices[i] >= num_vertices || indices[i + 1] >= num_vertices || indices[i + 2] >= num_vertices)
+				continue;
+			glm::vec4 const tri[3] { clip_positions_[indices[i]], clip_positions_[indices[i + 1]], clip_positions_[indices[i + 2]] };
+
+			// Skip triangles entirely outside one of the side or far planes
+			bool outside { false };
+			for(int axis = 0; axis < 3 && !outside; ++axis)
+			{
+				outside = (tri[0][axis] > tri[0].w && tri[1][axis] > tri[1].w && tri[2][axis] > tri[2].w)
+					|| (axis < 2 && tri[0][axis] < -tri[0].w && tri[1][axis] < -tri[1].w && tri[2][axis] < -tri[2].w);
+			}
+			if(outside)
+				continue;
+
+			// Clip the triangle against the near plane (z >= -w), leaving at most a quad
+			glm::vec4 poly[4];
+			size_t num_poly { 0 };
+			for(size_t v = 0; v < 3; ++v)
+			{
+				glm::vec4 const & cur { tri[v] };
+				glm::vec4 const & next { tri[(v + 1) % 3] };
+				float cur_dist { cur.z + cur.w };
+				float next_dist { next.z + next.w };
+				if(cur_dist >= 0.0f)
+					poly[num_poly++] = cur;
+				if((cur_dist >= 0.0f) != (next_dist >= 0.0f))
+					poly[num_poly++] = glm::mix(cur, next, cur_dist / (cur_dist - next_dist));
+			}
+			if(num_poly < 3)
+				continue;
+
+			bool behind { false };
+			for(size_t v = 0; v < num_poly; ++v)
+				behind |= poly[v].w <= 0.0f;
+			if(behind)
+				continue;
+
+			glm::vec3 a { ToScreen(poly[0]) };
+			glm::vec3 b { ToScreen(poly[1]) };
+			for(size_t v = 2; v < num_poly; ++v)
+			{
+				glm::vec3 c { ToScreen(poly[v]) };
+				RasterizeTriangle(a, b, c);
+				b = c;
+			}
+		}
+	}
+
+	// Returns true iff any part of a world space box may be in front of the occluders
+	bool OcclusionBuffer::IsVisible(AABB const & box) const
+	{
+		uint8_t visible { 1 };
+		return CullAABBs(&box, 1, &visible) == 1;
+	}
+
+	// Test a batch of world space boxes against the buffer
+	// Only boxes with visible[i] set are tested (e.g. those which passed frustum culling), visible[i] is cleared if boxes[i] is hidden
+	// Returns the number of visible boxes
+	size_t OcclusionBuffer::CullAABBs(AABB const * boxes, size_t count, uint8_t * visible) const
+	{
+		size_t num_visible { 0 };
+		for(size_t i = 0; i < count; ++i)
+		{
+			if(!visible[i])
+				continue;
+			++num_visible;
+			if(!has_occluders_)
+				continue;
+
+			// Find the screen rectangle and nearest depth of the box's corners
+			// Boxes crossing the near plane surround the camera, so can never be hidden
+			glm::vec2 rect_min { std::numeric_limits<float>::max() };
+			glm::vec2 rect_max { std::numeric_limits<float>::lowest() };
+			float min_depth { 1.0f };
+			bool crosses_near { false };
+			for(int corner = 0; corner < 8 && !crosses_near; ++corner)
+			{
+				glm::vec4 pos {
+					(corner & 1) ? boxes[i].max_.x : boxes[i].min_.x,
+					(corner & 2) ? boxes[i].max_.y : boxes[i].min_.y,
+					(corner & 4) ? boxes[i].max_.z : boxes[i].min_.z,
+					1.0f
+				};
+				glm::vec4 clip { view_proj_ * pos };
+				crosses_near = clip.w <= 0.0f || clip.z < -clip.w;
+				glm::vec3 screen { ToScreen(clip) };
+				rect_min = glm::min(rect_min, glm::vec2(screen));
+				rect_max = glm::max(rect_max, glm::vec2(screen));
+				min_depth = std::min(min_depth, screen.z);
+			}
+			if(crosses_near)
+				continue;
+
+			// Every pixel the rectangle touches is tested, boxes off the edge of the screen are left visible
+			int32_t x0 { std::max(0, static_cast<int32_t>(std::floor(rect_min.x))) };
+			int32_t y0 { std::max(0, static_cast<int32_t>(std::floor(rect_min.y))) };
+			int32_t x1 { std::min(width_ - 1, static_cast<int32_t>(std::floor(rect_max.x))) };
+			int32_t y1 { std::min(height_ - 1, static_cast<int32_t>(std::floor(rect_max.y))) };
+			if(x0 > x1 || y0 > y1)
+				continue;
+
+			// The box is visible if any pixel's occluder depth is at or behind the box's nearest point
+			if(!IsRectVisible(x0, y0, x1, y1, min_depth))
+			{
+				visible[i] = 0;
+				--num_visible;
+			}
+		}
+		return num_visible;
+	}
+
+	// Rasterize a triangle whose vertices are in screen space (pixels xy, depth z)
+	void OcclusionBuffer::RasterizeTriangle(glm::vec3 const & a, glm::vec3 const & b, glm::vec3 const & c)
+	{
+		// Wind the triangle counter-clockwise s.t. every edge function is positive inside it
+		float area { (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x) };
+		glm::vec3 const & v1 { area < 0.0f ? c : b };
+		glm::vec3 const & v2 { area < 0.0f ? b : c };
+		area = std::abs(area);
+		if(area < 1e-8f)
+			return;
+
+		int32_t x0 { std::max(0, static_cast<int32_t>(std::floor(std::min({ a.x, v1.x, v2.x })))) };
+		int32_t y0 { std::max(0, static_cast<int32_t>(std::floor(std::min({ a.y, v1.y, v2.y })))) };
+		int32_t x1 { std::min(width_ - 1, static_cast<int32_t>(std::ceil(std::max({ a.x, v1.x, v2.x })))) };
+		int32_t y1 { std::min(height_ - 1, static_cast<int32_t>(std::ceil(std::max({ a.y, v1.y, v2.y })))) };
+		if(x0 > x1 || y0 > y1)
+			return;
+		has_occluders_ = true;
+
+		// Edge functions w(p) = dx * p.x + dy * p.y + k, each the weight of the vertex opposite the edge
+		glm::vec3 const edge_dx { v1.y - v2.y, v2.y - a.y, a.y - v1.y };
+		glm::vec3 const edge_dy { v2.x - v1.x, a.x - v2.x, v1.x - a.x };
+		glm::vec3 const edge_k {
+			v1.x * v2.y - v1.y * v2.x,
+			v2.x * a.y - v2.y * a.x,
+			a.x * v1.y - a.y * v1.x
+		};
+
+		// Depth is linear in screen space, z(p) = depth_dx * p.x + depth_dy * p.y + depth_k
+		glm::vec3 const z { a.z / area, v1.z / area, v2.z / area };
+		float const depth_dx { glm::dot(edge_dx, z) };
+		float const depth_dy { glm::dot(edge_dy, z) };
+		float const depth_k { glm::dot(edge_k, z) };
+
+#ifdef OSE_OCCLUSION_SSE
+		if(simd_enabled_)
+		{
+			// Process 4 pixels at a time from a multiple of 4, the row padding means this never writes outside the buffer
+			// Pixels left of x0 or right of x1 are only written if they are inside the triangle, which is still correct
+			__m128 const zero { _mm_setzero_ps() };
+			__m128 const lane_offsets { _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f) };
+			__m128 const e0_dx { _mm_set1_ps(edge_dx.x) }, e1_dx { _mm_set1_ps(edge_dx.y) }, e2_dx { _mm_set1_ps(edge_dx.z) };
+			__m128 const z_dx { _mm_set1_ps(depth_dx) };
+			int32_t first { x0 & ~3 };
+			for(int32_t y = y0; y <= y1; ++y)
+			{
+				float py { y + 0.5f };
+				__m128 const e0_row { _mm_set1_ps(edge_dy.x * py + edge_k.x) };
+				__m128 const e1_row { _mm_set1_ps(edge_dy.y * py + edge_k.y) };
+				__m128 const e2_row { _mm_set1_ps(edge_dy.z * py + edge_k.z) };
+				__m128 const z_row { _mm_set1_ps(depth_dy * py + depth_k) };
+				float * row { depth_.data() + static_cast<size_t>(y) * stride_ };
+				for(int32_t x = first; x <= x1; x += 4)
+				{
+					__m128 px { _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lane_offsets) };
+					__m128 e0 { _mm_add_ps(_mm_mul_ps(e0_dx, px), e0_row) };
+					__m128 e1 { _mm_add_ps(_mm_mul_ps(e1_dx, px), e1_row) };
+					__m128 e2 { _mm_add_ps(_mm_mul_ps(e2_dx, px), e2_row) };
+					__m128 inside { _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero)) };
+					if(_mm_movemask_ps(inside) == 0)
+						continue;
+					__m128 depth { _mm_add_ps(_mm_mul_ps(z_dx, px), z_row) };
+					__m128 old { _mm_loadu_ps(row + x) };
+					__m128 nearest { _mm_min_ps(old, depth) };
+					_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, old)));
+				}
+			}
+			return;
+		}
+#endif
+		// The row terms are summed first, in the same order as the SIMD path, s.t. both paths give identical depths
+		for(int32_t y = y0; y <= y1; ++y)
+		{
+			float py { y + 0.5f };
+			glm::vec3 const e_row { edge_dy * py + edge_k };
+			float const z_row { depth_dy * py + depth_k };
+			float * row { depth_.data() + static_cast<size_t>(y) * stride_ };
+			for(int32_t x = x0; x <= x1; ++x)
+			{
+				float px { x + 0.5f };
+				glm::vec3 e { edge_dx * px + e_row };
+				if(e.x < 0.0f || e.y < 0.0f || e.z < 0.0f)
+					continue;
+				row[x] = std::min(row[x], depth_dx * px + z_row);
+			}
+		}
+	}
+
+	// Returns true iff the occluder depth of any pixel in the rectangle [x0, x1] x [y0, y1] is at or behind depth
+	bool OcclusionBuffer::IsRectVisible(int32_t x0, int32_t y0, int32_t x1, int32_t y1, float depth) const
+	{
+#ifdef OSE_OCCLUSION_SSE
+		if(simd_enabled_)
+		{
+			__m128 const box_depth { _mm_set1_ps(depth) };
+			int32_t first { x0 & ~3 };
+			for(int32_t y = y0; y <= y1; ++y)
+			{
+				float const * row { depth_.data() + static_cast<size_t>(y) * stride_ };
+				for(int32_t x = first; x <= x1; x += 4)
+				{
+					// Lanes outside of [x0, x1] are ignored
+					int lanes { 0xF };
+					if(x < x0)
+						lanes &= 0xF << (x0 - x);
+					if(x + 3 > x1)
+						lanes &= 0xF >> (x + 3 - x1);
+					if((_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), box_depth)) & lanes) != 0)
+						return true;
+				}
+			}
+			return false;
+		}
+#endif
+		for(int32_t y = y0; y <= y1; ++y)
+		{
+			float const * row { depth_.data() + static_cast<size_t>(y) * stride_ };
+			for(int32_t x = x0; x <= x1; ++x)
+			{
+				if(row[x] >= depth)
+					return true;
+			}
+		}
+		return false;
+	}
+
+	// Convert a clip space position in front of the near plane to screen space
+	glm::vec3 OcclusionBuffer::ToScreen(glm::vec4 const & clip) const
+	{
+		glm::vec3 ndc { glm::vec3(clip) / clip.w };
+		return {
+			(ndc.x * 0.5f + 0.5f) * static_cast<float>(width_),
+			(ndc.y * 0.5f + 0.5f) * static_cast<float>(height_),
+			ndc.z * 0.5f + 0.5f
+		};
+	}
+}
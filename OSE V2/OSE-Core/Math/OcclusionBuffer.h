@@ -0,0 +1,75 @@
+#pragma once
+#include "AABB.h"
+
+namespace ose
+{
+	// Low resolution depth buffer rasterized on the CPU from a few large occluder meshes
+	// Boxes whose nearest depth is behind the occluders at every pixel they cover are hidden, s.t. they don't have to be drawn
+	// Rasterization and testing use SIMD where available (4 pixels at a time) and make no render library calls,
+	// so the buffer can be filled on any thread and gives the same result on every platform
+	class OcclusionBuffer
+	{
+	public:
+		static constexpr int32_t DEFAULT_WIDTH { 256 };
+		static constexpr int32_t DEFAULT_HEIGHT { 128 };
+
+		OcclusionBuffer(int32_t width = DEFAULT_WIDTH, int32_t height = DEFAULT_HEIGHT);
+
+		// Clear the buffer to the far plane and set the view projection matrix occluders and boxes are projected with
+		void Begin(glm::mat4 const & view_proj);
+
+		// Rasterize the triangles of an occluder mesh into the buffer, keeping the nearest depth at each pixel
+		// positions is a list of xyz positions in the mesh's local space, every 3 indices make a triangle
+		// Triangles are drawn regardless of winding and are clipped against the near plane
+		void RasterizeTriangles(glm::mat4 const & world, float const * positions, size_t num_positions,
+			unsigned int const * indices, size_t num_indices);
+
+		// Returns true iff any part of a world space box may be in front of the occluders
+		bool IsVisible(AABB const & box) const;
+
+		// Test a batch of world space boxes against the buffer
+		// Only boxes with visible[i] set are tested (e.g. those which passed frustum culling), visible[i] is cleared if boxes[i] is hidden
+		// Returns the number of visible boxes
+		size_t CullAABBs(AABB const * boxes, size_t count, uint8_t * visible) const;
+
+		// Returns true iff anything has been rasterized since Begin() was called
+		bool HasOccluders() const { return has_occluders_; }
+
+		int32_t GetWidth() const { return width_; }
+		int32_t GetHeight() const { return height_; }
+
+		// Get the depth ([0, 1], 1 being the far plane) stored at a pixel, (0, 0) is the bottom left pixel
+		float GetDepth(int32_t x, int32_t y) const { return depth_[static_cast<size_t>(y) * stride_ + x]; }
+
+		// The SIMD paths can be disabled, e.g. to check they give the same result as the scalar paths
+		// Has no effect on platforms without SIMD support, which always use the scalar paths
+		void SetSimdEnabled(bool enabled) { simd_enabled_ = enabled; }
+
+	private:
+		// Rasterize a triangle whose vertices are in screen space (pixels xy, depth z)
+		void RasterizeTriangle(glm::vec3 const & a, glm::vec3 const & b, glm::vec3 const & c);
+
+		// Returns true iff the occluder depth of any pixel in the rectangle [x0, x1] x [y0, y1] is at or behind depth
+		bool IsRectVisible(int32_t x0, int32_t y0, int32_t x1, int32_t y1, float depth) const;
+
+		// Convert a clip space position in front of the near plane to screen space
+		glm::vec3 ToScreen(glm::vec4 const & clip) const;
+
+		int32_t width_;
+		int32_t height_;
+
+		// Number of floats per row, a multiple of 4 s.t. rows can be processed 4 pixels at a time
+		int32_t stride_;
+
+		std::vector<float> depth_;
+
+		glm::mat4 view_proj_ { 1.0f };
+
+		bool has_occluders_ { false };
+
+		bool simd_enabled_ { true };
+
+		// Clip space positions of the occluder being rasterized, reused between occluders
+		std::vector<glm::vec4> clip_positions_;
+	};
+}
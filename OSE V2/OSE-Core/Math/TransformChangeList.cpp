@@ -0,0 +1,28 @@
+#include "stdafx.h"
+#include "TransformChangeList.h"
+
+namespace ose
+{
+	TransformChangeList::TransformChangeList() {}
+
+	TransformChangeList::~TransformChangeList() {}
+
+	// Record that the global transform of an entity has changed
+	// last_frame is owned by the caller and is used to ignore repeat changes within a single frame without a lookup
+	void TransformChangeList::Push(uint32_t entity_id, ITransform const & transform, uint32_t & last_frame)
+	{
+		if(last_frame == frame_)
+			return;
+		last_frame = frame_;
+		changes_.push_back({ entity_id, &transform });
+	}
+
+	// Clear the list of changes and begin a new frame
+	void TransformChangeList::Clear()
+	{
+		changes_.clear();
+		// Skip 0 on wrap around s.t. newly created entities are never treated as already pushed
+		if(++frame_ == 0)
+			frame_ = 1;
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+namespace ose
+{
+	class ITransform;
+
+	// A single entry of the transform change list
+	struct TransformChange
+	{
+		// Unique id of the entity whose global transform changed
+		uint32_t entity_id_;
+
+		// The global transform of the entity (owned by the entity)
+		ITransform const * transform_;
+	};
+
+	// List of the entities whose global transform has changed during the current frame
+	// Filled by transformable entities, consumed by the render pool (and any other system caching transforms) once per frame
+	class TransformChangeList
+	{
+	public:
+		TransformChangeList();
+		~TransformChangeList();
+		TransformChangeList(TransformChangeList const & other) = delete;
+		TransformChangeList & operator=(TransformChangeList const & other) = delete;
+		TransformChangeList(TransformChangeList && other) noexcept = default;
+		TransformChangeList & operator=(TransformChangeList && other) noexcept = default;
+
+		// Record that the global transform of an entity has changed
+		// last_frame is owned by the caller and is used to ignore repeat changes within a single frame without a lookup
+		void Push(uint32_t entity_id, ITransform const & transform, uint32_t & last_frame);
+
+		// Get the list of changes made during the current frame
+		std::vector<TransformChange> const & GetChanges() const { return changes_; }
+
+		// Returns true iff no transforms have changed during the current frame
+		bool IsEmpty() const { return changes_.empty(); }
+
+		// Clear the list of changes and begin a new frame
+		void Clear();
+
+	private:
+		// List of changes made during the current frame, each entity appears at most once
+		std::vector<TransformChange> changes_;
+
+		// Index of the current frame, starts at 1 s.t. a last_frame of 0 never matches
+		uint32_t frame_ { 1 };
+	};
+}
@@ -264,11 +264,15 @@ namespace ose
 		// Get a pointer to the parent transformable element
 		virtual Transformable * GetParentTransformable() const = 0;
 
+		// Called whenever the global transform of the transformable changes, including changes inherited from a parent
+		virtual void OnGlobalTransformChanged() {}
+
 	private:
 
 		void GlobalTranslate(glm::vec3 const & translation)
 		{
 			global_transform_.Translate(translation);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalTranslate(translation);
 		}
@@ -276,6 +280,7 @@ namespace ose
 		void GlobalTranslate(float x, float y, float z)
 		{
 			global_transform_.Translate(x, y, z);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalTranslate(x, y, z);
 		}
@@ -283,6 +288,7 @@ namespace ose
 		void GlobalTranslate2d(glm::vec2 const & translation)
 		{
 			global_transform_.Translate2d(translation);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalTranslate2d(translation);
 		}
@@ -290,6 +296,7 @@ namespace ose
 		void GlobalTranslate2d(float x, float y)
 		{
 			global_transform_.Translate2d(x, y);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalTranslate2d(x, y);
 		}
@@ -297,6 +304,7 @@ namespace ose
 		void GlobalRotate(glm::quat const & change)
 		{
 			global_transform_.Rotate(change);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalRotate(change);
 		}
@@ -304,6 +312,7 @@ namespace ose
 		void GlobalRotate(glm::vec3 const & change)
 		{
 			global_transform_.Rotate(change);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalRotate(change);
 		}
@@ -311,6 +320,7 @@ namespace ose
 		void GlobalRotate(float pitch, float yaw, float roll)
 		{
 			global_transform_.Rotate(pitch, yaw, roll);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalRotate(pitch, yaw, roll);
 		}
@@ -318,6 +328,7 @@ namespace ose
 		void GlobalRotateDeg(glm::vec3 const & change)
 		{
 			global_transform_.RotateDeg(change);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalRotateDeg(change);
 		}
@@ -325,6 +336,7 @@ namespace ose
 		void GlobalRotateDeg(float pitch, float yaw, float roll)
 		{
 			global_transform_.RotateDeg(pitch, yaw, roll);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalRotateDeg(pitch, yaw, roll);
 		}
@@ -332,6 +344,7 @@ namespace ose
 		void GlobalRotate2d(float rotation)
 		{
 			global_transform_.Rotate2d(rotation);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalRotate2d(rotation);
 		}
@@ -339,6 +352,7 @@ namespace ose
 		void GlobalRotate2dDeg(float rotation)
 		{
 			global_transform_.Rotate2dDeg(rotation);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalRotate2dDeg(rotation);
 		}
@@ -346,6 +360,7 @@ namespace ose
 		void GlobalScale(float scalar)
 		{
 			global_transform_.Scale(scalar);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalScale(scalar);
 		}
@@ -353,6 +368,7 @@ namespace ose
 		void GlobalScale(glm::vec3 const & multiplier)
 		{
 			global_transform_.Scale(multiplier);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalScale(multiplier);
 		}
@@ -360,6 +376,7 @@ namespace ose
 		void GlobalScale(float x, float y, float z)
 		{
 			global_transform_.Scale(x, y, z);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalScale(x, y, z);
 		}
@@ -367,6 +384,7 @@ namespace ose
 		void GlobalScale2d(glm::vec2 const & multiplier)
 		{
 			global_transform_.Scale2d(multiplier);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalScale2d(multiplier);
 		}
@@ -374,6 +392,7 @@ namespace ose
 		void GlobalScale2d(float x, float y)
 		{
 			global_transform_.Scale2d(x, y);
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->GlobalScale2d(x, y);
 		}
@@ -385,6 +404,7 @@ namespace ose
 				global_transform_.SetTranslation(parent->GetGlobalTransform().GetTranslation() + local_transform_.GetTranslation());
 			else
 				global_transform_.SetTranslation(local_transform_.GetTranslation());
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->SetGlobalTranslation();
 		}
@@ -396,6 +416,7 @@ namespace ose
 				global_transform_.SetOrientation(parent->GetGlobalTransform().GetOrientation() * local_transform_.GetOrientation());
 			else
 				global_transform_.SetOrientation(local_transform_.GetOrientation());
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->SetGlobalOrientation();
 		}
@@ -407,6 +428,7 @@ namespace ose
 				global_transform_.SetScale(parent->GetGlobalTransform().GetScale() * local_transform_.GetScale());
 			else
 				global_transform_.SetScale(local_transform_.GetScale());
+			OnGlobalTransformChanged();
 			for(auto & child : GetChildTransformables())
 				child->SetGlobalScale();
 		}
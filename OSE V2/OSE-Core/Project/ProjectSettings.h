@@ -1,6 +1,9 @@
 #pragma once
 
 #include "OSE-Core/Rendering/EProjectionMode.h"
+#include "OSE-Core/Rendering/ERenderPath.h"
+#include "OSE-Core/Rendering/EUpscaleFilter.h"
+#include "OSE-Core/Rendering/PostEffect.h"
 
 namespace ose
 {
@@ -9,6 +12,40 @@ namespace ose
 		// Global settings
 		EProjectionMode projection_mode_ { EProjectionMode::ORTHOGRAPHIC };
 
+		// Render path used by scenes which don't specify their own
+		ERenderPath render_path_ { ERenderPath::FORWARD };
+
+		// Maximum GPU memory (in MiB) used by streamed texture mip levels, 0 for no limit
+		uint32_t texture_budget_mb_ { 0 };
+
+		// Write a block compressed container for each texture whose meta data requests compression as scenes are activated
+		// Intended for development builds, shipped projects only load the containers
+		bool build_texture_containers_ { false };
+
+		// Time (in milliseconds) spent copying staged texture and buffer uploads into GPU memory each frame
+		float upload_budget_ms_ { 2.0f };
+
+		// Size (in world units) of the grid cells static geometry is batched in, each cell is culled as a whole
+		float static_batch_cell_size_ { 32.0f };
+
+		// Largest error (in pixels) a mesh's level of detail may have on screen, 0 always draws meshes at full detail
+		float lod_screen_error_ { 1.0f };
+
+		// Lower the resolution the scene is rendered at whilst the GPU takes longer than target_frame_time_ms_ to render a frame
+		// The scene is then scaled up to the window with upscale_filter_
+		bool dynamic_resolution_ { false };
+		float target_frame_time_ms_ { 16.6f };
+		float min_render_scale_ { 0.5f };
+		EUpscaleFilter upscale_filter_ { EUpscaleFilter::BILINEAR };
+
+		// Record the CPU time of each stage of a frame and the GPU time of each render pass and material group
+		// The timings are exported to the project directory when the game exits, and drawn over the scene iff profiler_overlay_
+		bool profiler_ { false };
+		bool profiler_overlay_ { true };
+
+		// Effects applied to the image of each camera after its scene has been rendered, in order
+		std::vector<PostEffect> post_effects_;
+
 		// EProjectionMode::PERSPECTIVE settings
 		float znear_	{ 0.01f };
 		float zfar_		{ 100.0f };
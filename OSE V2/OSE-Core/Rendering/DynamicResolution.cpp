@@ -0,0 +1,60 @@
+#include "stdafx.h"
+#include "DynamicResolution.h"
+
+namespace ose
+{
+	// Set the range of the render scale, the scale is clamped to the new range
+	void DynamicResolution::SetScaleRange(float min_scale, float max_scale)
+	{
+		max_scale_ = std::clamp(max_scale, SCALE_STEP, 1.0f);
+		min_scale_ = std::clamp(min_scale, SCALE_STEP, max_scale_);
+		scale_ = std::clamp(scale_, min_scale_, max_scale_);
+	}
+
+	// Add a measurement of the time (in milliseconds) the GPU took to render a frame at the current scale
+	// Returns true iff the scale changed
+	bool DynamicResolution::Update(float frame_ms)
+	{
+		if(frame_ms <= 0.0f)
+			return false;
+
+		// Frames slower than the average are weighted more heavily, s.t. the scale drops quickly under load but recovers slowly
+		if(smoothed_ms_ <= 0.0f)
+			smoothed_ms_ = frame_ms;
+		else
+			smoothed_ms_ += (frame_ms - smoothed_ms_) * (frame_ms > smoothed_ms_ ? 0.5f : 0.1f);
+
+		if(settle_frames_ > 0)
+		{
+			--settle_frames_;
+			return false;
+		}
+
+		// Predict the scale which would take the target time, then round it down to a step
+		// The scale is only raised once it would stay below the target after the step, s.t. it doesn't oscillate between two steps
+		float predicted { scale_ * std::sqrt(target_ms_ * HEADROOM / smoothed_ms_) };
+		float new_scale { scale_ };
+		if(smoothed_ms_ > target_ms_)
+			new_scale = std::floor(predicted / SCALE_STEP + 0.001f) * SCALE_STEP;
+		else if(predicted >= scale_ + SCALE_STEP)
+			new_scale = std::round(scale_ / SCALE_STEP + 1.0f) * SCALE_STEP;
+		new_scale = std::clamp(new_scale, min_scale_, max_scale_);
+
+		if(std::abs(new_scale - scale_) < SCALE_STEP * 0.5f)
+			return false;
+
+		// Measurements at the old scale no longer predict the frame time at the new scale
+		smoothed_ms_ *= (new_scale * new_scale) / (scale_ * scale_);
+		scale_ = new_scale;
+		settle_frames_ = SETTLE_FRAMES;
+		return true;
+	}
+
+	// Return to the largest scale and forget the measurements, e.g. when the window is resized
+	void DynamicResolution::Reset()
+	{
+		scale_ = max_scale_;
+		smoothed_ms_ = 0.0f;
+		settle_frames_ = 0;
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+namespace ose
+{
+	// Chooses the scale the scene is rendered at s.t. the GPU's frame time stays below a target
+	// The GPU time is assumed to be proportional to the number of pixels rendered, i.e. to the square of the scale
+	// Measurements are smoothed and the scale changes in steps, s.t. a single slow frame or timing noise doesn't make the resolution flicker
+	class DynamicResolution
+	{
+	public:
+		// Size of a step of the render scale, the scale is always a multiple of this
+		static constexpr float SCALE_STEP { 0.05f };
+
+		// The scale is chosen s.t. the predicted frame time is this fraction of the target, leaving room for the scene to get busier
+		static constexpr float HEADROOM { 0.9f };
+
+		// Number of measurements after a change of scale before the scale can change again
+		// Covers the frames in flight whose timings were measured at the old scale
+		static constexpr uint32_t SETTLE_FRAMES { 4 };
+
+		// Set the frame time (in milliseconds) to stay below
+		void SetTargetFrameTime(float ms) { target_ms_ = std::max(ms, 0.1f); }
+
+		float GetTargetFrameTime() const { return target_ms_; }
+
+		// Set the range of the render scale, the scale is clamped to the new range
+		void SetScaleRange(float min_scale, float max_scale);
+
+		float GetMinScale() const { return min_scale_; }
+		float GetMaxScale() const { return max_scale_; }
+
+		// Get the current render scale, the fraction of the window's width and height which is rendered
+		float GetScale() const { return scale_; }
+
+		// Get the smoothed frame time (in milliseconds) the scale was last chosen from
+		float GetSmoothedFrameTime() const { return smoothed_ms_; }
+
+		// Add a measurement of the time (in milliseconds) the GPU took to render a frame at the current scale
+		// Returns true iff the scale changed
+		bool Update(float frame_ms);
+
+		// Return to the largest scale and forget the measurements, e.g. when the window is resized
+		void Reset();
+
+	private:
+		float target_ms_ { 16.6f };
+		float min_scale_ { 0.5f };
+		float max_scale_ { 1.0f };
+		float scale_ { 1.0f };
+
+		// Exponential moving average of the measured frame times, 0 until the first measurement
+		float smoothed_ms_ { 0.0f };
+
+		// Number of measurements to ignore before the scale can change again
+		uint32_t settle_frames_ { 0 };
+	};
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace ose
+{
+	// Type of an effect of the post-processing chain, applied to a camera's image after the scene has been rendered
+	enum class EPostEffect
+	{
+		// Bright parts of the image are blurred and added back, s.t. light appears to bleed around them
+		BLOOM,
+		// The edges of the image are darkened
+		VIGNETTE
+	};
+}
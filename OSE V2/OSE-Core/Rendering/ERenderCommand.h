@@ -0,0 +1,40 @@
+#pragma once
+
+namespace ose
+{
+	// Type of a command recorded in a RenderCommandList
+	// Enum and handle arguments are the values of the render library which executes the list
+	enum class ERenderCommand : uint32_t
+	{
+		// framebuffer
+		BIND_FRAMEBUFFER,
+		// buffer mask
+		CLEAR,
+		// enable, depth function
+		SET_DEPTH_TEST,
+		// enable, source factor, destination factor
+		SET_BLEND,
+		// shader program
+		SET_PIPELINE,
+		// vertex array
+		BIND_VERTEX_ARRAY,
+		// texture unit, texture target, texture
+		BIND_TEXTURE,
+		// binding point, buffer, offset, size
+		BIND_UNIFORM_BLOCK,
+		// uniform location, 16 floats (column major)
+		SET_UNIFORM_MAT4,
+		// primitive, first vertex, vertex count, instance count, first instance
+		DRAW,
+		// primitive, index count, instance count, first instance, first index
+		DRAW_INDEXED,
+		// source framebuffer, destination framebuffer, width, height
+		BLIT_DEPTH,
+		// profiler scope slot
+		BEGIN_TIMER,
+		// profiler scope slot
+		END_TIMER,
+
+		NUM_COMMANDS
+	};
+}
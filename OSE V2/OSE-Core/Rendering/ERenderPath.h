@@ -0,0 +1,13 @@
+#pragma once
+
+namespace ose
+{
+	// How opaque 3D geometry is lit by the rendering engine
+	enum class ERenderPath
+	{
+		// Every object is shaded by its material's shader as it is drawn
+		FORWARD,
+		// Opaque objects are drawn to a G-buffer then lit once per pixel, avoiding lighting overdrawn fragments
+		DEFERRED
+	};
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace ose
+{
+	// Format of the colour attachment of a render target
+	enum class ERenderTargetFormat
+	{
+		// 8 bits per channel, the format of the window
+		RGBA8,
+		// 16 bit float per channel, for intermediate images whose values may exceed 1 or would band at 8 bits, e.g. bloom
+		RGBA16F
+	};
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace ose
+{
+	// How a tile renderer's tilemap is turned into geometry by the render pool
+	enum class ETileRenderMode
+	{
+		// The tilemap is split into chunks of per-tile quads, built on the CPU as they come close to the camera
+		CHUNKED,
+		// The tile values are uploaded to an integer texture and the whole tilemap is drawn as a single quad
+		// The fragment shader looks up each pixel's tile, so the vertex cost does not depend on the size of the tilemap
+		INDEX_TEXTURE
+	};
+}
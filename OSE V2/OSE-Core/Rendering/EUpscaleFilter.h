@@ -0,0 +1,13 @@
+#pragma once
+
+namespace ose
+{
+	// How a scene rendered below the window's resolution is scaled up to the window
+	enum class EUpscaleFilter
+	{
+		// Each pixel is interpolated from the 4 nearest rendered pixels
+		BILINEAR,
+		// Bilinear followed by a contrast adaptive sharpen, which restores edges softened by the upscale
+		SHARPEN
+	};
+}
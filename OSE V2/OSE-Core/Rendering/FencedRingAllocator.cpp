@@ -0,0 +1,63 @@
+#include "stdafx.h"
+#include "FencedRingAllocator.h"
+
+namespace ose
+{
+	// max_frames is the number of frames the CPU may be ahead of the GPU before BeginFrame waits
+	FencedRingAllocator::FencedRingAllocator(uptr<FrameFences> fences, uint32_t max_frames)
+		: fences_(std::move(fences)), max_frames_(std::max(max_frames, 1u))
+	{
+
+	}
+
+	// Discard every allocation and set the size of the ring, frames in flight are waited for first
+	void FencedRingAllocator::Reset(size_t capacity)
+	{
+		while(ReleaseOldestFrame(true))
+			;
+		ring_.Reset(capacity);
+	}
+
+	// Start a new frame, releases the frames the GPU has finished with and waits if the CPU is max_frames ahead
+	void FencedRingAllocator::BeginFrame()
+	{
+		while(ReleaseOldestFrame(false))
+			;
+		while(ring_.GetNumFramesInFlight() >= max_frames_ && ReleaseOldestFrame(true))
+			;
+	}
+
+	// Allocate size bytes aligned to alignment (a power of 2) for the current frame
+	// Waits for the oldest frames in flight until the allocation fits
+	// Returns RingAllocator::INVALID_OFFSET if the allocation can never fit, e.g. it is larger than the ring
+	size_t FencedRingAllocator::Allocate(size_t size, size_t alignment)
+	{
+		// Waiting for the GPU can't make room for an allocation larger than the ring
+		if(size == 0 || size > ring_.GetCapacity())
+			return RingAllocator::INVALID_OFFSET;
+
+		// The ring may be full of frames the GPU is still reading, wait for them before giving up
+		size_t offset { ring_.Allocate(size, alignment) };
+		while(offset == RingAllocator::INVALID_OFFSET && ReleaseOldestFrame(true))
+			offset = ring_.Allocate(size, alignment);
+		return offset;
+	}
+
+	// Close the current frame and fence it
+	void FencedRingAllocator::EndFrame()
+	{
+		ring_.EndFrame();
+		fences_->Insert();
+	}
+
+	// Release the oldest frame in flight once the GPU has passed its fence
+	// If wait is false the frame is only released if the GPU has already passed the fence
+	// Returns true if a frame was released
+	bool FencedRingAllocator::ReleaseOldestFrame(bool wait)
+	{
+		if(ring_.GetNumFramesInFlight() == 0 || !fences_->PopOldest(wait))
+			return false;
+		ring_.ReleaseFrame();
+		return true;
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "RingAllocator.h"
+#include "FrameFences.h"
+
+namespace ose
+{
+	// Ring allocator whose frames are released once the GPU has passed the fence inserted at the end of each frame
+	// Used by buffers which the CPU writes whilst the GPU reads earlier frames, e.g. persistently mapped stream buffers
+	class FencedRingAllocator
+	{
+	public:
+		// max_frames is the number of frames the CPU may be ahead of the GPU before BeginFrame waits
+		FencedRingAllocator(uptr<FrameFences> fences, uint32_t max_frames);
+
+		// Discard every allocation and set the size of the ring, frames in flight are waited for first
+		void Reset(size_t capacity);
+
+		// Start a new frame, releases the frames the GPU has finished with and waits if the CPU is max_frames ahead
+		void BeginFrame();
+
+		// Allocate size bytes aligned to alignment (a power of 2) for the current frame
+		// Waits for the oldest frames in flight until the allocation fits
+		// Returns RingAllocator::INVALID_OFFSET if the allocation can never fit, e.g. it is larger than the ring
+		size_t Allocate(size_t size, size_t alignment);
+
+		// Close the current frame and fence it
+		void EndFrame();
+
+		// Get the number of closed frames whose allocations have not been released
+		size_t GetNumFramesInFlight() const { return ring_.GetNumFramesInFlight(); }
+
+		size_t GetUsed() const { return ring_.GetUsed(); }
+		size_t GetCapacity() const { return ring_.GetCapacity(); }
+
+	private:
+		// Release the oldest frame in flight once the GPU has passed its fence
+		// If wait is false the frame is only released if the GPU has already passed the fence
+		// Returns true if a frame was released
+		bool ReleaseOldestFrame(bool wait);
+
+		RingAllocator ring_;
+		uptr<FrameFences> fences_;
+		uint32_t max_frames_;
+	};
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace ose
+{
+	// Fences of a render library, each marking the point in the command stream at which a frame's commands end
+	// Fences are waited for in the order they were inserted
+	class FrameFences
+	{
+	public:
+		virtual ~FrameFences() = default;
+
+		// Insert a fence after the commands submitted so far
+		virtual void Insert() = 0;
+
+		// Remove the oldest fence once the GPU has passed it
+		// If wait is true blocks until the GPU has passed it, otherwise returns false if it has not been passed yet
+		// Returns false if there are no fences
+		virtual bool PopOldest(bool wait) = 0;
+
+		// Get the number of fences which have not been removed
+		virtual size_t GetNumFences() const = 0;
+	};
+}
@@ -0,0 +1,112 @@
+#include "stdafx.h"
+#include "GpuProfiler.h"
+
+namespace ose
+{
+	void NullGpuTimerQueries::EndQuery(uint32_t query)
+	{
+		uint64_t count { ++counts_[query] };
+		results_[query] = timing_ ? timing_(query, count) : (query + 1) * 100000ull;
+	}
+
+	bool NullGpuTimerQueries::TryGetResult(uint32_t query, uint64_t & ns)
+	{
+		if(!available_ || counts_[query] == 0)
+			return false;
+		ns = results_[query];
+		return true;
+	}
+
+	GpuProfiler::GpuProfiler(uptr<GpuTimerQueries> queries) : queries_(std::move(queries)) {}
+
+	// Start a new frame, removing the previous frame's scopes
+	// The results of the frame which last used this frame's query set are read first, returns true iff they were available
+	bool GpuProfiler::BeginFrame(uint64_t frame)
+	{
+		if(active_ != NO_SCOPE)
+			End(active_);
+
+		current_ = &sets_[frame % NUM_FRAMES];
+		bool read { current_->frame_ != 0 && ReadResults(*current_) };
+		if(read)
+			results_frame_ = current_->frame_;
+
+		current_->frame_ = frame;
+		current_->scopes_.clear();
+		current_->num_used_ = 0;
+		return read;
+	}
+
+	// Add a scope to the current frame, parent must have been added before it
+	// Returns the scope's slot, used to begin and end it
+	uint32_t GpuProfiler::AddScope(std::string const & name, uint32_t parent)
+	{
+		if(!current_)
+			return NO_SCOPE;
+		uint32_t slot { static_cast<uint32_t>(current_->scopes_.size()) };
+		if(parent >= slot)
+			parent = NO_SCOPE;
+		current_->scopes_.push_back({ parent == NO_SCOPE ? name : current_->scopes_[parent].name_ + "/" + name, parent, {} });
+		return slot;
+	}
+
+	// Start measuring a scope, ignored if another scope is being measured
+	void GpuProfiler::Begin(uint32_t slot)
+	{
+		if(!current_ || slot >= current_->scopes_.size() || active_ != NO_SCOPE)
+			return;
+		if(current_->num_used_ == current_->queries_.size())
+			current_->queries_.push_back(queries_->CreateQuery());
+		uint32_t measurement { static_cast<uint32_t>(current_->num_used_++) };
+		current_->scopes_[slot].measurements_.push_back(measurement);
+		queries_->BeginQuery(current_->queries_[measurement]);
+		active_ = slot;
+	}
+
+	// Stop measuring a scope
+	void GpuProfiler::End(uint32_t slot)
+	{
+		if(!current_ || slot >= current_->scopes_.size() || slot != active_)
+			return;
+		queries_->EndQuery(current_->queries_[current_->scopes_[slot].measurements_.back()]);
+		active_ = NO_SCOPE;
+	}
+
+	// Read the results of a query set into results_, returns false if any is unavailable
+	bool GpuProfiler::ReadResults(QuerySet const & set)
+	{
+		std::vector<uint64_t> totals(set.scopes_.size(), 0);
+		for(size_t i = 0; i < set.scopes_.size(); ++i)
+		{
+			for(uint32_t measurement : set.scopes_[i].measurements_)
+			{
+				uint64_t ns { 0 };
+				if(!queries_->TryGetResult(set.queries_[measurement], ns))
+					return false;
+				totals[i] += ns;
+			}
+		}
+
+		// Parents are added before their children, so visiting scopes in reverse adds every child to its parent's total before the parent is added to its own parent
+		uint64_t frame_total { 0 };
+		for(size_t i = set.scopes_.size(); i-- > 0; )
+		{
+			if(set.scopes_[i].parent_ == NO_SCOPE)
+				frame_total += totals[i];
+			else
+				totals[set.scopes_[i].parent_] += totals[i];
+		}
+
+		results_.clear();
+		results_.push_back({ EProfileSource::GPU, "Frame", 0, frame_total / 1000000.0f });
+		std::vector<uint32_t> depths(set.scopes_.size(), 1);
+		for(size_t i = 0; i < set.scopes_.size(); ++i)
+		{
+			Scope const & scope { set.scopes_[i] };
+			if(scope.parent_ != NO_SCOPE)
+				depths[i] = depths[scope.parent_] + 1;
+			results_.push_back({ EProfileSource::GPU, scope.name_, depths[i], totals[i] / 1000000.0f });
+		}
+		return true;
+	}
+}
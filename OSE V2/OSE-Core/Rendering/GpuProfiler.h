@@ -0,0 +1,129 @@
+#pragma once
+#include "OSE-Core/Game/FrameProfile.h"
+
+namespace ose
+{
+	// Elapsed time queries of a render library, measured by the GpuProfiler
+	// Only one query may be active at a time, results are read without waiting
+	class GpuTimerQueries
+	{
+	public:
+		virtual ~GpuTimerQueries() = default;
+
+		// Create a query, returns its handle
+		virtual uint32_t CreateQuery() = 0;
+
+		// Start measuring the commands submitted from now on
+		virtual void BeginQuery(uint32_t query) = 0;
+
+		// Stop measuring
+		virtual void EndQuery(uint32_t query) = 0;
+
+		// Get the time (in nanoseconds) measured by a query if the GPU has finished executing the measured commands
+		// Returns false if the result is not available yet
+		virtual bool TryGetResult(uint32_t query, uint64_t & ns) = 0;
+	};
+
+	// Timer queries which return synthetic timings without a GPU, s.t. the profiler can be used (and tested) without a render library
+	class NullGpuTimerQueries final : public GpuTimerQueries
+	{
+	public:
+		// Function giving the synthetic time (in nanoseconds) of a query, given the query and the number of times it has been measured
+		using TimingFunction = std::function<uint64_t(uint32_t query, uint64_t count)>;
+
+		// By default each query measures 0.1ms times one more than its handle
+		NullGpuTimerQueries(TimingFunction timing = nullptr) : timing_(std::move(timing)) {}
+
+		// Set whether results are available, unavailable results simulate a GPU which hasn't finished the measured commands
+		void SetResultsAvailable(bool available) { available_ = available; }
+
+		uint32_t CreateQuery() override { counts_.push_back(0); results_.push_back(0); return static_cast<uint32_t>(counts_.size() - 1); }
+		void BeginQuery(uint32_t query) override {}
+		void EndQuery(uint32_t query) override;
+		bool TryGetResult(uint32_t query, uint64_t & ns) override;
+
+	private:
+		TimingFunction timing_;
+
+		// Number of times each query has been measured, and its last result
+		std::vector<uint64_t> counts_;
+		std::vector<uint64_t> results_;
+
+		bool available_ { true };
+	};
+
+	// Measures the GPU time of named scopes of a frame, e.g. render passes and the material groups within them
+	// Each frame's queries are read when the same query set is reused NUM_FRAMES frames later, i.e. with a frame of latency
+	// s.t. the CPU never waits for the GPU; if a result is still unavailable by then the frame's results are dropped
+	// Elapsed time queries can't be nested, so only scopes without children are measured
+	// The time of a scope with children is the sum of its children's times
+	// A scope may be begun more than once a frame (e.g. a material group split between command lists), its time is the sum of each measurement
+	class GpuProfiler
+	{
+	public:
+		// Number of frames whose queries can be in flight at once
+		static constexpr uint32_t NUM_FRAMES { 2 };
+
+		// Parent of top level scopes
+		static constexpr uint32_t NO_SCOPE { ~0u };
+
+		GpuProfiler(uptr<GpuTimerQueries> queries);
+
+		// Start a new frame, removing the previous frame's scopes
+		// The results of the frame which last used this frame's query set are read first, returns true iff they were available
+		bool BeginFrame(uint64_t frame);
+
+		// Add a scope to the current frame, parent must have been added before it
+		// Returns the scope's slot, used to begin and end it
+		uint32_t AddScope(std::string const & name, uint32_t parent = NO_SCOPE);
+
+		// Start measuring a scope, ignored if another scope is being measured
+		void Begin(uint32_t slot);
+
+		// Stop measuring a scope
+		void End(uint32_t slot);
+
+		// Get the timings of the most recent frame whose results were available
+		// Names are prefixed with their parents' names, the first sample is the total of every top level scope ("Frame", depth 0)
+		std::vector<ProfileSample> const & GetResults() const { return results_; }
+
+		// Get the number of the frame GetResults() was measured in, 0 if no results have been read
+		uint64_t GetResultsFrame() const { return results_frame_; }
+
+	private:
+		struct Scope
+		{
+			std::string name_;
+			uint32_t parent_ { NO_SCOPE };
+
+			// Indices of the set's queries which measured the scope
+			std::vector<uint32_t> measurements_;
+		};
+
+		// Scopes of a frame and the queries which measured them
+		// Queries are kept between the frames which use the set, s.t. they are only created the first time a frame makes this many measurements
+		struct QuerySet
+		{
+			uint64_t frame_ { 0 };
+			std::vector<Scope> scopes_;
+			std::vector<uint32_t> queries_;
+			size_t num_used_ { 0 };
+		};
+
+		// Read the results of a query set into results_, returns false if any is unavailable
+		bool ReadResults(QuerySet const & set);
+
+		uptr<GpuTimerQueries> queries_;
+
+		QuerySet sets_[NUM_FRAMES];
+
+		// Set of the current frame
+		QuerySet * current_ { nullptr };
+
+		// Slot of the scope being measured
+		uint32_t active_ { NO_SCOPE };
+
+		std::vector<ProfileSample> results_;
+		uint64_t results_frame_ { 0 };
+	};
+}
@@ -0,0 +1,60 @@
+#include "stdafx.h"
+#include "InstanceRuns.h"
+
+namespace ose
+{
+	// Build the runs of a group of count instances, visible[i] is non-zero iff instance i is visible
+	// lods is the level of detail of each instance, nullptr if the group has no levels of detail
+	// Runs are split where the level of detail changes, unless split_runs is false in which case every instance is drawn in
+	// a single run starting at instance 0 using the finest level of any visible instance
+	// Returns the number of runs, no runs are built if no instance is visible
+	size_t InstanceRuns::Build(uint8_t const * visible, uint8_t const * lods, uint32_t count, bool split_runs,
+		std::vector<InstanceRun> & runs, uint32_t max_gap)
+	{
+		runs.clear();
+
+		// When the whole group is drawn in one draw it uses the finest level of any visible instance
+		uint8_t group_lod { 0 };
+		if(lods && !split_runs)
+		{
+			group_lod = UINT8_MAX;
+			for(uint32_t v = 0; v < count; ++v)
+			{
+				if(visible[v])
+					group_lod = std::min(group_lod, lods[v]);
+			}
+		}
+
+		uint32_t i { 0 };
+		while(i < count)
+		{
+			// Find the start of the next run
+			while(i < count && !visible[i])
+				++i;
+			if(i == count)
+				break;
+
+			// Extend the run until a large enough gap of culled instances, or an instance with a different level of detail, is found
+			uint32_t first { i };
+			uint32_t last { i };
+			uint8_t lod { lods && split_runs ? lods[i] : group_lod };
+			while(i < count && (!split_runs || i - last <= max_gap))
+			{
+				if(visible[i])
+				{
+					if(split_runs && lods && lods[i] != lod)
+						break;
+					last = i;
+				}
+				++i;
+			}
+			if(!split_runs)
+				first = 0;
+
+			runs.push_back({ first, last - first + 1, lod });
+			i = last + 1;
+		}
+
+		return runs.size();
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+namespace ose
+{
+	// Run of consecutive instances of a render group drawn by a single draw, may include culled instances
+	struct InstanceRun
+	{
+		uint32_t first_ { 0 };
+		uint32_t count_ { 0 };
+
+		// Level of detail the run is drawn at
+		uint8_t lod_ { 0 };
+	};
+
+	// Splits the visible instances of a render group into the runs they are drawn with
+	// Culled instances between visible instances are drawn anyway when the gap is small, s.t. fewer draws are submitted
+	class InstanceRuns
+	{
+	public:
+		// Invisible instances separated by fewer than this many instances are drawn anyway to save a draw call
+		static constexpr uint32_t MAX_DRAWN_CULLED_GAP { 16 };
+
+		// Build the runs of a group of count instances, visible[i] is non-zero iff instance i is visible
+		// lods is the level of detail of each instance, nullptr if the group has no levels of detail
+		// Runs are split where the level of detail changes, unless split_runs is false in which case every instance is drawn in
+		// a single run starting at instance 0 using the finest level of any visible instance
+		// Returns the number of runs, no runs are built if no instance is visible
+		static size_t Build(uint8_t const * visible, uint8_t const * lods, uint32_t count, bool split_runs,
+			std::vector<InstanceRun> & runs, uint32_t max_gap = MAX_DRAWN_CULLED_GAP);
+	};
+}
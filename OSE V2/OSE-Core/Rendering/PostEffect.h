@@ -0,0 +1,18 @@
+#pragma once
+#include "EPostEffect.h"
+
+namespace ose
+{
+	// An effect of the post-processing chain and its settings, effects are applied in the order of the chain
+	struct PostEffect
+	{
+		EPostEffect type_ { EPostEffect::BLOOM };
+
+		// EPostEffect::BLOOM, brightness above which pixels bloom and the strength the bloom is added back with
+		float threshold_ { 0.8f };
+		float intensity_ { 0.6f };
+
+		// EPostEffect::VIGNETTE, fraction the corners of the image are darkened by
+		float strength_ { 0.4f };
+	};
+}
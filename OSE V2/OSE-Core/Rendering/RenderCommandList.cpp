@@ -0,0 +1,145 @@
+#include "stdafx.h"
+#include "RenderCommandList.h"
+
+namespace ose
+{
+	// Get the number of argument words of a command type
+	uint32_t RenderCommandList::GetNumArgs(ERenderCommand command)
+	{
+		switch(command)
+		{
+		case ERenderCommand::BIND_FRAMEBUFFER:		return 1;
+		case ERenderCommand::CLEAR:					return 1;
+		case ERenderCommand::SET_DEPTH_TEST:		return 2;
+		case ERenderCommand::SET_BLEND:				return 3;
+		case ERenderCommand::SET_PIPELINE:			return 1;
+		case ERenderCommand::BIND_VERTEX_ARRAY:		return 1;
+		case ERenderCommand::BIND_TEXTURE:			return 3;
+		case ERenderCommand::BIND_UNIFORM_BLOCK:	return 4;
+		case ERenderCommand::SET_UNIFORM_MAT4:		return 17;
+		case ERenderCommand::DRAW:					return 5;
+		case ERenderCommand::DRAW_INDEXED:			return 5;
+		case ERenderCommand::BLIT_DEPTH:			return 4;
+		case ERenderCommand::BEGIN_TIMER:			return 1;
+		case ERenderCommand::END_TIMER:				return 1;
+		default:									return 0;
+		}
+	}
+
+	// Set a mat4 uniform of the current pipeline, value points to 16 floats in column major order
+	void RenderCommandList::SetUniformMat4(int32_t location, float const * value)
+	{
+		words_.push_back(static_cast<uint32_t>(ERenderCommand::SET_UNIFORM_MAT4));
+		words_.push_back(static_cast<uint32_t>(location));
+		size_t first { words_.size() };
+		words_.resize(first + 16);
+		std::memcpy(words_.data() + first, value, 16 * sizeof(float));
+	}
+
+	// Write the list to a binary stream (number of words followed by the words)
+	void RenderCommandList::Serialize(std::ostream & os) const
+	{
+		uint64_t num_words { words_.size() };
+		os.write(reinterpret_cast<char const *>(&num_words), sizeof(num_words));
+		os.write(reinterpret_cast<char const *>(words_.data()), words_.size() * sizeof(uint32_t));
+	}
+
+	// Replace the list with one read from a binary stream written by Serialize()
+	// Returns false and leaves the list empty if the stream does not hold a valid list
+	bool RenderCommandList::Deserialize(std::istream & is)
+	{
+		// Streams which can't be measured are read this many words at a time, s.t. a corrupt count can't cause a huge allocation
+		constexpr uint64_t READ_CHUNK_WORDS { 1 << 16 };
+
+		words_.clear();
+		uint64_t num_words { 0 };
+		if(!is.read(reinterpret_cast<char *>(&num_words), sizeof(num_words)))
+			return false;
+
+		// The word count is untrusted, so is checked against the rest of the stream before anything is allocated
+		std::streampos start { is.tellg() };
+		if(start != std::streampos(-1))
+		{
+			is.seekg(0, std::ios::end);
+			uint64_t remaining { static_cast<uint64_t>(is.tellg() - start) };
+			is.seekg(start);
+			if(num_words > remaining / sizeof(uint32_t))
+			{
+				LOG_ERROR("Failed to deserialize render command list, the stream is shorter than the list");
+				return false;
+			}
+		}
+
+		bool read { true };
+		while(read && words_.size() < num_words)
+		{
+			size_t offset { words_.size() };
+			size_t chunk { static_cast<size_t>(std::min(num_words - offset, READ_CHUNK_WORDS)) };
+			words_.resize(offset + chunk);
+			read = static_cast<bool>(is.read(reinterpret_cast<char *>(words_.data() + offset), chunk * sizeof(uint32_t)));
+		}
+		if(!read || !IsValid())
+		{
+			LOG_ERROR("Failed to deserialize render command list");
+			words_.clear();
+			return false;
+		}
+		return true;
+	}
+
+	// Get a human readable listing of the commands, one per line, e.g. for comparing recorded frames
+	std::string RenderCommandList::ToString() const
+	{
+		static char const * const names[] {
+			"BIND_FRAMEBUFFER", "CLEAR", "SET_DEPTH_TEST", "SET_BLEND", "SET_PIPELINE", "BIND_VERTEX_ARRAY",
+			"BIND_TEXTURE", "BIND_UNIFORM_BLOCK", "SET_UNIFORM_MAT4", "DRAW", "DRAW_INDEXED", "BLIT_DEPTH",
+			"BEGIN_TIMER", "END_TIMER"
+		};
+		static_assert(std::size(names) == static_cast<size_t>(ERenderCommand::NUM_COMMANDS));
+
+		std::ostringstream ss;
+		for(size_t w = 0; w < words_.size(); )
+		{
+			ERenderCommand command { static_cast<ERenderCommand>(words_[w]) };
+			uint32_t num_args { GetNumArgs(command) };
+			if(words_[w] >= static_cast<uint32_t>(ERenderCommand::NUM_COMMANDS) || w + num_args >= words_.size())
+			{
+				ss << "INVALID " << words_[w] << '\n';
+				break;
+			}
+			ss << names[words_[w]];
+			if(command == ERenderCommand::SET_UNIFORM_MAT4)
+			{
+				// Print the matrix values rather than their bit patterns
+				ss << ' ' << static_cast<int32_t>(words_[w + 1]);
+				for(uint32_t a = 2; a <= num_args; ++a)
+				{
+					float value;
+					std::memcpy(&value, &words_[w + a], sizeof(value));
+					ss << ' ' << value;
+				}
+			}
+			else
+			{
+				for(uint32_t a = 1; a <= num_args; ++a)
+					ss << ' ' << words_[w + a];
+			}
+			ss << '\n';
+			w += 1 + num_args;
+		}
+		return ss.str();
+	}
+
+	// Returns true iff the word stream is a sequence of valid commands with the correct number of arguments
+	bool RenderCommandList::IsValid() const
+	{
+		size_t w { 0 };
+		while(w < words_.size())
+		{
+			if(words_[w] >= static_cast<uint32_t>(ERenderCommand::NUM_COMMANDS))
+				return false;
+			w += 1 + GetNumArgs(static_cast<ERenderCommand>(words_[w]));
+		}
+		return w == words_.size();
+	}
+}
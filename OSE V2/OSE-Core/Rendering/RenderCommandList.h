@@ -0,0 +1,83 @@
+#pragma once
+#include "ERenderCommand.h"
+
+namespace ose
+{
+	// A list of rendering commands which can be recorded on any thread and executed later by the render library
+	// Commands are stored as a flat stream of 32-bit words (the command type followed by its arguments)
+	// s.t. lists can be appended, serialized and compared without knowing which render library recorded them
+	class RenderCommandList
+	{
+	public:
+		RenderCommandList() = default;
+		~RenderCommandList() = default;
+		RenderCommandList(RenderCommandList const &) = default;
+		RenderCommandList & operator=(RenderCommandList const &) = default;
+		RenderCommandList(RenderCommandList &&) noexcept = default;
+		RenderCommandList & operator=(RenderCommandList &&) noexcept = default;
+
+		// Get the number of argument words of a command type
+		static uint32_t GetNumArgs(ERenderCommand command);
+
+		// Remove every command, the storage is kept s.t. recording the next frame does not reallocate
+		void Clear() { words_.clear(); }
+
+		// Returns true iff no commands have been recorded
+		bool IsEmpty() const { return words_.empty(); }
+
+		// Append the commands of another list to the end of this list
+		void Append(RenderCommandList const & other) { words_.insert(words_.end(), other.words_.begin(), other.words_.end()); }
+
+		void BindFramebuffer(uint32_t fbo) { Push(ERenderCommand::BIND_FRAMEBUFFER, { fbo }); }
+		void ClearBuffers(uint32_t mask) { Push(ERenderCommand::CLEAR, { mask }); }
+		void SetDepthTest(bool enable, uint32_t func) { Push(ERenderCommand::SET_DEPTH_TEST, { enable ? 1u : 0u, func }); }
+		void SetBlend(bool enable, uint32_t sfactor, uint32_t dfactor) { Push(ERenderCommand::SET_BLEND, { enable ? 1u : 0u, sfactor, dfactor }); }
+		void SetPipeline(uint32_t prog) { Push(ERenderCommand::SET_PIPELINE, { prog }); }
+		void BindVertexArray(uint32_t vao) { Push(ERenderCommand::BIND_VERTEX_ARRAY, { vao }); }
+		void BindTexture(uint32_t unit, uint32_t target, uint32_t texture) { Push(ERenderCommand::BIND_TEXTURE, { unit, target, texture }); }
+		void BindUniformBlock(uint32_t binding, uint32_t buffer, uint32_t offset, uint32_t size) { Push(ERenderCommand::BIND_UNIFORM_BLOCK, { binding, buffer, offset, size }); }
+		void Draw(uint32_t primitive, uint32_t first, uint32_t count, uint32_t num_instances = 1, uint32_t first_instance = 0)
+		{
+			Push(ERenderCommand::DRAW, { primitive, first, count, num_instances, first_instance });
+		}
+		void DrawIndexed(uint32_t primitive, uint32_t count, uint32_t num_instances = 1, uint32_t first_instance = 0, uint32_t first_index = 0)
+		{
+			Push(ERenderCommand::DRAW_INDEXED, { primitive, count, num_instances, first_instance, first_index });
+		}
+		void BlitDepth(uint32_t src_fbo, uint32_t dst_fbo, uint32_t width, uint32_t height) { Push(ERenderCommand::BLIT_DEPTH, { src_fbo, dst_fbo, width, height }); }
+		void BeginTimer(uint32_t slot) { Push(ERenderCommand::BEGIN_TIMER, { slot }); }
+		void EndTimer(uint32_t slot) { Push(ERenderCommand::END_TIMER, { slot }); }
+
+		// Set a mat4 uniform of the current pipeline, value points to 16 floats in column major order
+		void SetUniformMat4(int32_t location, float const * value);
+
+		// Get the recorded word stream, each command is its type followed by GetNumArgs(type) arguments
+		std::vector<uint32_t> const & GetWords() const { return words_; }
+
+		// Write the list to a binary stream (number of words followed by the words)
+		void Serialize(std::ostream & os) const;
+
+		// Replace the list with one read from a binary stream written by Serialize()
+		// Returns false and leaves the list empty if the stream does not hold a valid list
+		bool Deserialize(std::istream & is);
+
+		// Get a human readable listing of the commands, one per line, e.g. for comparing recorded frames
+		std::string ToString() const;
+
+		bool operator==(RenderCommandList const & other) const { return words_ == other.words_; }
+		bool operator!=(RenderCommandList const & other) const { return words_ != other.words_; }
+
+	private:
+		// Append a command and its arguments to the word stream
+		void Push(ERenderCommand command, std::initializer_list<uint32_t> args)
+		{
+			words_.push_back(static_cast<uint32_t>(command));
+			words_.insert(words_.end(), args);
+		}
+
+		// Returns true iff the word stream is a sequence of valid commands with the correct number of arguments
+		bool IsValid() const;
+
+		std::vector<uint32_t> words_;
+	};
+}
@@ -9,6 +9,7 @@ namespace ose
 	class MeshRenderer;
 	class PointLight;
 	class DirLight;
+	class TransformChangeList;
 
 	class RenderPool
 	{
@@ -28,6 +29,10 @@ namespace ose
 		// Add a mesh renderer component to the render pool
 		virtual void AddMeshRenderer(ITransform const & t, MeshRenderer * mr) = 0;
 
+		// Add a mesh renderer component of a static entity to the render pool
+		// Static mesh renderers sharing a material are merged into batches before the next frame is drawn
+		virtual void AddStaticMeshRenderer(ITransform const & t, MeshRenderer * mr) = 0;
+
 		// Add a point light component to the render pool
 		virtual void AddPointLight(ITransform const & t, PointLight * pl) = 0;
 
@@ -48,6 +53,9 @@ namespace ose
 
 		// Remove a direction light component from the render pool
 		virtual void RemoveDirLight(DirLight * dl) = 0;
+
+		// Update the render objects of all entities whose global transform changed this frame
+		virtual void ApplyTransformChanges(TransformChangeList const & changes) = 0;
 	};
 }
 
@@ -21,6 +21,17 @@ namespace ose
 		znear_ = rendering_settings.znear_;
 		zfar_ = rendering_settings.zfar_;
 		hfov_deg_ = rendering_settings.hfov_;
+		render_path_ = rendering_settings.render_path_;
+		texture_budget_ = static_cast<size_t>(rendering_settings.texture_budget_mb_) * 1024 * 1024;
+		upload_budget_ms_ = rendering_settings.upload_budget_ms_;
+		static_batch_cell_size_ = rendering_settings.static_batch_cell_size_;
+		lod_screen_error_ = rendering_settings.lod_screen_error_;
+		dynamic_resolution_ = rendering_settings.dynamic_resolution_;
+		target_frame_time_ms_ = rendering_settings.target_frame_time_ms_;
+		min_render_scale_ = rendering_settings.min_render_scale_;
+		upscale_filter_ = rendering_settings.upscale_filter_;
+		profiler_overlay_ = rendering_settings.profiler_overlay_;
+		post_effects_ = rendering_settings.post_effects_;
 		UpdateProjectionMatrix();
 	}
 
@@ -55,18 +66,24 @@ namespace ose
 
 	void RenderingEngine::UpdateProjectionMatrix()
 	{
-		if(fbwidth_ != 0 && fbheight_ != 0)		//minimisation and tabbing out need not cause a frame buffer update
+		UpdateProjectionMatrix(fbwidth_, fbheight_);
+	}
+
+	// update the projection matrix for a view of the given size rather than the window, e.g. a camera layer's viewport
+	void RenderingEngine::UpdateProjectionMatrix(int width, int height)
+	{
+		if(width != 0 && height != 0)		//minimisation and tabbing out need not cause a frame buffer update
 		{
 			switch(projection_mode_)
 			{
 			case EProjectionMode::ORTHOGRAPHIC:
 			{
-				UpdateOrthographicProjectionMatrix(fbwidth_, fbheight_);
+				UpdateOrthographicProjectionMatrix(width, height);
 				break;
 			}
 			case EProjectionMode::PERSPECTIVE:
 			{
-				UpdatePerspectiveProjectionMatrix(hfov_deg_, fbwidth_, fbheight_, znear_, zfar_);
+				UpdatePerspectiveProjectionMatrix(hfov_deg_, width, height, znear_, zfar_);
 				break;
 			}
 			}
@@ -2,6 +2,9 @@
 
 //#include "OSE-Core/EngineReferences.h"
 #include "EProjectionMode.h"
+#include "ERenderPath.h"
+#include "EUpscaleFilter.h"
+#include "PostEffect.h"
 //#include "OSE-Core/Engine/Engine.h"
 //#include "OSE-Core/Entity/Entity.h"
 //#include "OSE-Core/Entity/SpriteRenderer.h"
@@ -11,6 +14,7 @@ namespace ose
 {
 	struct RenderingSettings;
 	class Camera;
+	class FrameProfile;
 
 	/// Templated on the type of pool on which the rendering engine acts
 	class RenderingEngine
@@ -20,7 +24,8 @@ namespace ose
 		virtual ~RenderingEngine();
 
 		// Render one frame to the screen
-		virtual void Render(Camera const & active_camera) = 0;
+		// The active camera fills the window, then each camera layer is rendered to a texture and drawn to its viewport in order
+		virtual void Render(Camera const & active_camera, std::vector<Camera const *> const & camera_layers) = 0;
 
 		// Apply rendering settings to the rendering engine
 		void ApplyRenderingSettings(RenderingSettings const & rendering_settings);
@@ -32,6 +37,76 @@ namespace ose
 
 		void SetFramebufferSize(int width, int height);
 
+		// Set how opaque 3D geometry is lit, the render path takes effect from the next frame
+		void SetRenderPath(ERenderPath render_path) { render_path_ = render_path; }
+
+		ERenderPath GetRenderPath() const { return render_path_; }
+
+		// Set the maximum number of bytes of GPU memory used by streamed textures, 0 for no limit
+		void SetTextureBudget(size_t bytes) { texture_budget_ = bytes; }
+
+		size_t GetTextureBudget() const { return texture_budget_; }
+
+		// Set the time (in milliseconds) spent copying staged uploads into GPU resources each frame
+		void SetUploadBudget(float ms) { upload_budget_ms_ = ms; }
+
+		float GetUploadBudget() const { return upload_budget_ms_; }
+
+		// Set the size (in world units) of the grid cells static geometry is batched in
+		// Only affects static geometry which is added after the size is set
+		void SetStaticBatchCellSize(float size) { static_batch_cell_size_ = size; }
+
+		float GetStaticBatchCellSize() const { return static_batch_cell_size_; }
+
+		// Set the largest error (in pixels) a mesh's level of detail may have on screen, 0 always draws meshes at full detail
+		void SetLodScreenError(float pixels) { lod_screen_error_ = pixels; }
+
+		float GetLodScreenError() const { return lod_screen_error_; }
+
+		// Enable/disable lowering the resolution the scene is rendered at whilst the GPU is slower than the target frame time
+		void SetDynamicResolution(bool enabled) { dynamic_resolution_ = enabled; }
+
+		bool IsDynamicResolutionEnabled() const { return dynamic_resolution_; }
+
+		// Set the GPU time (in milliseconds) dynamic resolution keeps each frame below
+		void SetTargetFrameTime(float ms) { target_frame_time_ms_ = ms; }
+
+		float GetTargetFrameTime() const { return target_frame_time_ms_; }
+
+		// Set the smallest fraction of the window's width and height dynamic resolution may render the scene at
+		void SetMinRenderScale(float scale) { min_render_scale_ = scale; }
+
+		float GetMinRenderScale() const { return min_render_scale_; }
+
+		// Set how a scene rendered below the window's resolution is scaled up to the window
+		void SetUpscaleFilter(EUpscaleFilter filter) { upscale_filter_ = filter; }
+
+		EUpscaleFilter GetUpscaleFilter() const { return upscale_filter_; }
+
+		// Set the profile the GPU time of each render pass and material group is added to, nullptr disables GPU profiling
+		// The profile must outlive the rendering engine or be unset first
+		void SetFrameProfile(FrameProfile * profile) { frame_profile_ = profile; }
+
+		FrameProfile * GetFrameProfile() const { return frame_profile_; }
+
+		// Enable/disable drawing the timings of the frame profile over the scene
+		void SetProfilerOverlay(bool enabled) { profiler_overlay_ = enabled; }
+
+		bool IsProfilerOverlayEnabled() const { return profiler_overlay_; }
+
+		// Set the effects applied to each camera's image after its scene has been rendered, in order
+		void SetPostEffects(std::vector<PostEffect> effects) { post_effects_ = std::move(effects); }
+
+		std::vector<PostEffect> const & GetPostEffects() const { return post_effects_; }
+
+		int GetFramebufferWidth() const { return fbwidth_; }
+		int GetFramebufferHeight() const { return fbheight_; }
+
+		// Give the rendering engine a context which shares GPU objects with its own, s.t. GPU resources can be created on a worker thread
+		// make_current is called on the worker thread to bind the context, release is called before the worker exits
+		// Passing empty functions stops the worker, the context must not be destroyed before then
+		virtual void SetWorkerContext(std::function<void()> make_current, std::function<void()> release) {}
+
 		// Get a reference to the render pool, s.t. new render objects can be added
 		// NOTE - No render pool object exists in generic RenderEngine, required pool must be member of sub-class
 		virtual RenderPool & GetRenderPool() = 0;
@@ -40,10 +115,41 @@ namespace ose
 		// update the projection matrix based on the projection mode
 		void UpdateProjectionMatrix();
 
+		// update the projection matrix for a view of the given size rather than the window, e.g. a camera layer's viewport
+		void UpdateProjectionMatrix(int width, int height);
+
 	private:
 		// how the scene will be projected, e.g. ORTHOGRAPHIC, PERSPECTIVE
 		EProjectionMode projection_mode_;
 
+		// how opaque 3D geometry is lit, e.g. FORWARD, DEFERRED
+		ERenderPath render_path_ { ERenderPath::FORWARD };
+
+		// maximum GPU memory used by streamed textures (in bytes), 0 for no limit
+		size_t texture_budget_ { 0 };
+
+		// time spent copying staged uploads each frame (in milliseconds), at least one upload is copied per frame
+		float upload_budget_ms_ { 2.0f };
+
+		// size of the grid cells static geometry is batched in (in world units)
+		float static_batch_cell_size_ { 32.0f };
+
+		// largest on screen error of a mesh's level of detail (in pixels)
+		float lod_screen_error_ { 1.0f };
+
+		// dynamic resolution settings, the render scale is chosen by the render library from its measured GPU time
+		bool dynamic_resolution_ { false };
+		float target_frame_time_ms_ { 16.6f };
+		float min_render_scale_ { 0.5f };
+		EUpscaleFilter upscale_filter_ { EUpscaleFilter::BILINEAR };
+
+		// profile GPU timings are added to, nullptr unless profiling is enabled
+		FrameProfile * frame_profile_ { nullptr };
+		bool profiler_overlay_ { true };
+
+		// post-processing chain applied to each camera's image
+		std::vector<PostEffect> post_effects_;
+
 		// width and height of the window framebuffer
 		int fbwidth_, fbheight_;
 
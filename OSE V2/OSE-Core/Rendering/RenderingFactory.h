@@ -3,6 +3,7 @@
 namespace ose
 {
 	class Texture;
+	class TextureAtlas;
 	class RenderingEngine;
 	class ShaderProg;
 	class ShaderGraph;
@@ -19,6 +20,7 @@ namespace ose
 
 		virtual uptr<RenderingEngine> NewRenderingEngine(int fbwidth, int fbheight) = 0;
 		virtual uptr<Texture> NewTexture(std::string const & name, std::string const & path) = 0;
+		virtual uptr<TextureAtlas> NewTextureAtlas(int32_t layer_width, int32_t layer_height, int32_t padding) = 0;
 		virtual uptr<ShaderProg> NewShaderProg(uptr<ShaderGraph> shader_graph) = 0;
 	};
 }
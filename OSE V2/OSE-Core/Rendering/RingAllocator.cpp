@@ -0,0 +1,87 @@
+#include "stdafx.h"
+#include "RingAllocator.h"
+
+namespace ose
+{
+	RingAllocator::RingAllocator(size_t capacity) : capacity_(capacity)
+	{
+
+	}
+
+	// Discard every allocation and set the size of the ring
+	void RingAllocator::Reset(size_t capacity)
+	{
+		capacity_ = capacity;
+		head_ = 0;
+		tail_ = 0;
+		used_ = 0;
+		frame_size_ = 0;
+		frames_.clear();
+	}
+
+	// Allocate size bytes aligned to alignment (a power of 2) for the current frame
+	// An allocation which would cross the end of the ring is moved to the start, the skipped bytes belong to the current frame
+	// Returns INVALID_OFFSET if the free space cannot hold the allocation
+	size_t RingAllocator::Allocate(size_t size, size_t alignment)
+	{
+		if(size == 0 || size > capacity_ || used_ >= capacity_)
+			return INVALID_OFFSET;
+
+		// An empty ring restarts at 0 s.t. the largest possible allocation fits
+		// Frames in flight record where they ended, so the ring is only moved once none are left
+		if(used_ == 0 && frames_.empty())
+		{
+			head_ = 0;
+			tail_ = 0;
+		}
+
+		size_t offset { (head_ + alignment - 1) & ~(alignment - 1) };
+		if(head_ >= tail_)
+		{
+			// The free space is [head_, capacity_) followed by [0, tail_)
+			if(offset + size > capacity_)
+			{
+				if(size > tail_)
+					return INVALID_OFFSET;
+				offset = 0;
+				// The bytes at the end of the ring are skipped
+				used_ += capacity_ - head_;
+				frame_size_ += capacity_ - head_;
+				head_ = 0;
+			}
+		}
+		else if(offset + size > tail_)
+		{
+			// The free space is [head_, tail_)
+			return INVALID_OFFSET;
+		}
+
+		size_t allocated { offset + size - head_ };
+		used_ += allocated;
+		frame_size_ += allocated;
+		head_ = offset + size;
+		if(head_ == capacity_)
+			head_ = 0;
+		return offset;
+	}
+
+	// Close the current frame, its allocations stay in use until ReleaseFrame() is called for it
+	void RingAllocator::EndFrame()
+	{
+		frames_.push_back({ head_, frame_size_ });
+		frame_size_ = 0;
+	}
+
+	// Free the allocations of the oldest closed frame
+	// Returns false if there are no closed frames
+	bool RingAllocator::ReleaseFrame()
+	{
+		if(frames_.empty())
+			return false;
+		FrameRange const & frame { frames_.front() };
+		tail_ = frame.end_;
+		used_ -= frame.size_;
+		frames_.pop_front();
+		return true;
+	}
+}
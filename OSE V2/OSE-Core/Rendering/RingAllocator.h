@@ -0,0 +1,61 @@
+#pragma once
+#include <deque>
+
+namespace ose
+{
+	// Sub-allocates ranges of a fixed size ring buffer, each range being owned by the frame it was allocated in
+	// Frames are released oldest first once the GPU has finished with them, freeing their ranges for reuse
+	// The allocator only tracks offsets and makes no OpenGL calls, the owner is responsible for fencing each frame
+	class RingAllocator
+	{
+	public:
+		// Offset returned when an allocation does not fit in the free space of the ring
+		static constexpr size_t INVALID_OFFSET { ~size_t(0) };
+
+		RingAllocator(size_t capacity = 0);
+
+		// Discard every allocation and set the size of the ring
+		void Reset(size_t capacity);
+
+		// Allocate size bytes aligned to alignment (a power of 2) for the current frame
+		// An allocation which would cross the end of the ring is moved to the start, the skipped bytes belong to the current frame
+		// Returns INVALID_OFFSET if the free space cannot hold the allocation
+		size_t Allocate(size_t size, size_t alignment);
+
+		// Close the current frame, its allocations stay in use until ReleaseFrame() is called for it
+		void EndFrame();
+
+		// Free the allocations of the oldest closed frame
+		// Returns false if there are no closed frames
+		bool ReleaseFrame();
+
+		// Get the number of closed frames whose allocations have not been released
+		size_t GetNumFramesInFlight() const { return frames_.size(); }
+
+		// Get the number of bytes in use, including alignment padding and bytes skipped when wrapping
+		size_t GetUsed() const { return used_; }
+
+		size_t GetCapacity() const { return capacity_; }
+
+	private:
+		// Offset one past the last allocated byte of a closed frame, and the number of bytes the frame used
+		struct FrameRange
+		{
+			size_t end_;
+			size_t size_;
+		};
+
+		size_t capacity_ { 0 };
+
+		// Allocations are made at head_ and freed from tail_, the ring is full when used_ == capacity_
+		size_t head_ { 0 };
+		size_t tail_ { 0 };
+		size_t used_ { 0 };
+
+		// Number of bytes used by the current frame
+		size_t frame_size_ { 0 };
+
+		// Closed frames in the order they were closed
+		std::deque<FrameRange> frames_;
+	};
+}
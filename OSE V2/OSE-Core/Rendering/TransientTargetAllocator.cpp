@@ -0,0 +1,86 @@
+#include "stdafx.h"
+#include "TransientTargetAllocator.h"
+
+namespace ose
+{
+	// Remove every target and pass, the storage is kept s.t. planning the next frame does not reallocate
+	void TransientTargetAllocator::Reset()
+	{
+		targets_.clear();
+		physical_.clear();
+		physical_descs_.clear();
+		current_pass_ = 0;
+	}
+
+	// Create a virtual target, returns its handle
+	uint32_t TransientTargetAllocator::Create(RenderTargetDesc const & desc)
+	{
+		if(desc.width_ <= 0 || desc.height_ <= 0)
+			return NO_TARGET;
+		targets_.push_back({ desc, current_pass_, current_pass_, false });
+		return static_cast<uint32_t>(targets_.size() - 1);
+	}
+
+	// Mark a target as read or written by the current pass, extending its lifetime to the current pass
+	void TransientTargetAllocator::Use(uint32_t target)
+	{
+		if(target >= targets_.size())
+			return;
+		VirtualTarget & t { targets_[target] };
+		if(!t.used_)
+			t.first_pass_ = current_pass_;
+		t.last_pass_ = current_pass_;
+		t.used_ = true;
+	}
+
+	// Assign every virtual target a physical target, targets whose lifetimes don't overlap share physical targets
+	void TransientTargetAllocator::Allocate()
+	{
+		physical_.assign(targets_.size(), NO_TARGET);
+		physical_descs_.clear();
+
+		// Visiting targets in order of their first pass, a target can take any physical target whose last user finished before it starts
+		// This greedy assignment needs exactly the peak number of simultaneously live targets of each description
+		std::vector<uint32_t> order(targets_.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) { return targets_[a].first_pass_ < targets_[b].first_pass_; });
+
+		// Physical targets in use and the last pass of their current user, and the free physical targets of each description
+		std::vector<std::pair<uint32_t, uint32_t>> live;
+		std::multimap<RenderTargetDesc, uint32_t> free;
+		for(uint32_t t : order)
+		{
+			VirtualTarget const & target { targets_[t] };
+			// Targets which are never used don't need memory
+			if(!target.used_)
+				continue;
+
+			for(size_t i = 0; i < live.size(); )
+			{
+				if(targets_[live[i].second].last_pass_ < target.first_pass_)
+				{
+					free.emplace(physical_descs_[live[i].first], live[i].first);
+					live[i] = live.back();
+					live.pop_back();
+				}
+				else
+				{
+					++i;
+				}
+			}
+
+			auto iter { free.find(target.desc_) };
+			if(iter != free.end())
+			{
+				physical_[t] = iter->second;
+				free.erase(iter);
+			}
+			else
+			{
+				physical_[t] = static_cast<uint32_t>(physical_descs_.size());
+				physical_descs_.push_back(target.desc_);
+			}
+			live.push_back({ physical_[t], t });
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "ERenderTargetFormat.h"
+#include <tuple>
+
+namespace ose
+{
+	// Size and format of a render target, targets with equal descriptions are interchangeable
+	struct RenderTargetDesc
+	{
+		int width_ { 0 };
+		int height_ { 0 };
+		ERenderTargetFormat format_ { ERenderTargetFormat::RGBA8 };
+
+		// True iff the target has a depth (24 bit) + stencil (8 bit) attachment
+		bool depth_ { false };
+
+		bool operator==(RenderTargetDesc const & other) const
+		{
+			return width_ == other.width_ && height_ == other.height_ && format_ == other.format_ && depth_ == other.depth_;
+		}
+		bool operator!=(RenderTargetDesc const & other) const { return !(*this == other); }
+		bool operator<(RenderTargetDesc const & other) const
+		{
+			return std::tie(width_, height_, format_, depth_) < std::tie(other.width_, other.height_, other.format_, other.depth_);
+		}
+	};
+
+	// Assigns the transient render targets of a frame's passes to as few physical targets as possible
+	// Each virtual target lives from the first to the last pass which uses it, once its last pass has run its physical target
+	// is reused by the next virtual target with the same description, s.t. memory scales with the peak number of live targets
+	// rather than with the number of passes or effects
+	class TransientTargetAllocator
+	{
+	public:
+		// Returned by Create() when a target can't be created
+		static constexpr uint32_t NO_TARGET { ~0u };
+
+		// Remove every target and pass, the storage is kept s.t. planning the next frame does not reallocate
+		void Reset();
+
+		// Create a virtual target, returns its handle
+		uint32_t Create(RenderTargetDesc const & desc);
+
+		// Start the next pass, targets used from now on are used by this pass
+		void BeginPass() { ++current_pass_; }
+
+		// Mark a target as read or written by the current pass, extending its lifetime to the current pass
+		void Use(uint32_t target);
+
+		// Assign every virtual target a physical target, targets whose lifetimes don't overlap share physical targets
+		void Allocate();
+
+		// Get the physical target a virtual target was assigned by Allocate()
+		uint32_t GetPhysical(uint32_t target) const { return physical_[target]; }
+
+		// Get the descriptions of the physical targets required by the frame
+		std::vector<RenderTargetDesc> const & GetPhysicalDescs() const { return physical_descs_; }
+
+		size_t GetNumTargets() const { return targets_.size(); }
+
+	private:
+		struct VirtualTarget
+		{
+			RenderTargetDesc desc_;
+
+			// First and last pass which use the target
+			uint32_t first_pass_ { 0 };
+			uint32_t last_pass_ { 0 };
+			bool used_ { false };
+		};
+
+		std::vector<VirtualTarget> targets_;
+
+		// Physical target of each virtual target, set by Allocate()
+		std::vector<uint32_t> physical_;
+
+		std::vector<RenderTargetDesc> physical_descs_;
+
+		// Index of the current pass, incremented by BeginPass()
+		uint32_t current_pass_ { 0 };
+	};
+}
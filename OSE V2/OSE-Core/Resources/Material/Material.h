@@ -1,5 +1,6 @@
 #pragma once
 #include "OSE-Core/Rendering/EBlendMode.h"
+#include "OSE-Core/Shader/EShaderFeature.h"
 
 namespace ose
 {
@@ -29,6 +30,10 @@ namespace ose
 		void SetBlendMode(EBlendMode mode) { blend_mode_ = mode; }
 		EBlendMode GetBlendMode() const { return blend_mode_; }
 
+		// Set the shader features (bit mask of EShaderFeature) the material uses, selecting the variant of its shader it is drawn with
+		void SetShaderFeatures(uint32_t features) { shader_features_ = features; }
+		uint32_t GetShaderFeatures() const { return shader_features_; }
+
 		std::vector<Texture const *> const & GetTextures() const { return textures_; }
 
 		ShaderProg const * GetShaderProg() const { return shader_prog_; }
@@ -40,6 +45,8 @@ namespace ose
 
 		EBlendMode blend_mode_ { EBlendMode::OPAQUE };
 
+		uint32_t shader_features_ { SHADER_FEATURE_DEFAULT };
+
 		std::vector<Texture const *> textures_;
 
 		ShaderProg const * shader_prog_ { nullptr };
@@ -1,4 +1,5 @@
 #pragma once
+#include "MeshMetaData.h"
 
 namespace ose
 {
@@ -28,6 +29,9 @@ namespace ose
 		// Getters for the mesh section data
 		std::vector<unsigned int> const & GetFaceIndices() const { return face_indices_; }
 
+		// Replace the faces of the section, e.g. once they have been reordered
+		void SetFaceIndices(std::vector<unsigned int> face_indices) { face_indices_ = std::move(face_indices); }
+
 	private:
 		// Array of indices to faces
 		// A face is composed of 3 consecutive indices starting at an index which is a multiple of 3
@@ -35,6 +39,16 @@ namespace ose
 		std::vector<unsigned int> face_indices_;
 	};
 
+	// A simplified version of a mesh which indexes the mesh's vertices
+	struct MeshLod
+	{
+		// Indices of the simplified triangles of every mesh section, 3 per triangle
+		std::vector<unsigned int> indices_;
+
+		// Approximate distance the simplified surface deviates from the full detail mesh, relative to the radius of the mesh's bounds
+		float error_ { 0.0f };
+	};
+
 	class Mesh
 	{
 	public:
@@ -44,6 +58,10 @@ namespace ose
 		// Get the path of the mesh file
 		std::string const & GetPath() const { return path_; }
 
+		// Set/get the import settings of the mesh
+		void SetMetaData(MeshMetaData const & meta_data) { meta_data_ = meta_data; }
+		MeshMetaData const & GetMetaData() const { return meta_data_; }
+
 		// Reserve space for vertex arrays
 		inline void SetNumVertices(size_t n, int types)
 		{
@@ -105,6 +123,42 @@ namespace ose
 
 		// Get the array of mesh sections which make up the mesh
 		std::vector<MeshSection> const & GetSections() const { return sections_; }
+		std::vector<MeshSection> & GetSections() { return sections_; }
+
+		// Move every vertex v to index remap[v], remap must be a permutation of the vertices
+		// The faces of every section and level of detail are updated to reference the moved vertices
+		void RemapVertices(std::vector<unsigned int> const & remap)
+		{
+			auto remap_array = [&remap](std::vector<float> & data, size_t n) {
+				if(data.size() < remap.size() * n)
+					return;
+				std::vector<float> remapped(data.size());
+				for(size_t v = 0; v < remap.size(); ++v)
+					std::copy_n(data.begin() + v * n, n, remapped.begin() + remap[v] * n);
+				data = std::move(remapped);
+			};
+			remap_array(positions_, 3);
+			remap_array(tex_coords_, 2);
+			remap_array(normals_, 3);
+			remap_array(tangents_, 3);
+
+			auto remap_indices = [&remap](std::vector<unsigned int> indices) {
+				for(unsigned int & index : indices)
+					index = remap[index];
+				return indices;
+			};
+			for(MeshSection & section : sections_)
+				section.SetFaceIndices(remap_indices(section.GetFaceIndices()));
+			for(MeshLod & lod : lods_)
+				lod.indices_ = remap_indices(std::move(lod.indices_));
+		}
+
+		// Set the simplified levels of detail of the mesh, finest first
+		void SetLods(std::vector<MeshLod> lods) { lods_ = std::move(lods); }
+
+		// Get the simplified levels of detail of the mesh, finest first
+		// The full detail mesh (level 0) is made of the mesh's sections, so is not included
+		std::vector<MeshLod> const & GetLods() const { return lods_; }
 
 	private:
 		
@@ -112,6 +166,9 @@ namespace ose
 		std::string name_;
 		std::string path_;
 
+		// Import settings of the mesh, loaded from the mesh's meta file
+		MeshMetaData meta_data_;
+
 		// Number of vertices in the mesh
 		// Sum of no. vertices in each mesh section
 		size_t num_vertices_;
@@ -125,5 +182,8 @@ namespace ose
 
 		// Array of mesh sections
 		std::vector<MeshSection> sections_;
+
+		// Simplified levels of detail, empty if the mesh is only drawn at full detail
+		std::vector<MeshLod> lods_;
 	};
 }
@@ -0,0 +1,111 @@
+#include "stdafx.h"
+#include "MeshLodChain.h"
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include "OSE-Core/Math/AABB.h"
+
+namespace ose
+{
+	// Generate the LOD chain of a mesh, the chain is empty if the mesh is too small to be worth simplifying
+	MeshLodChain MeshLodChain::Generate(Mesh const & mesh)
+	{
+		MeshLodChain chain;
+		chain.num_vertices_ = static_cast<uint32_t>(mesh.GetPositionData().size() / 3);
+		chain.vertex_hash_ = HashVertices(mesh);
+
+		std::vector<unsigned int> indices;
+		for(MeshSection const & section : mesh.GetSections())
+			indices.insert(indices.end(), section.GetFaceIndices().begin(), section.GetFaceIndices().end());
+		if(indices.size() < MIN_TRIANGLES * 3)
+			return chain;
+
+		// Errors are stored relative to the radius of the mesh's bounds, s.t. they can be compared with the mesh's size on screen
+		float radius { glm::length(AABB::FromPositions(mesh.GetPositionData()).GetExtents()) };
+
+		// Every level is simplified from the full detail mesh s.t. its error is measured against the original surface
+		size_t target { indices.size() };
+		for(uint32_t level = 1; level < MAX_LODS; ++level)
+		{
+			target = target / 6 * 3;
+			float error;
+			std::vector<unsigned int> lod_indices { MeshSimplifier::Simplify(mesh.GetPositionData(), indices, target, error) };
+
+			// Stop once the mesh can't be simplified much further, e.g. when most of its vertices are on borders
+			size_t previous { chain.lods_.empty() ? indices.size() : chain.lods_.back().indices_.size() };
+			if(lod_indices.size() * 5 > previous * 4)
+				break;
+			target = lod_indices.size();
+			chain.lods_.push_back({ MeshOptimizer::OptimizeVertexCache(lod_indices, chain.num_vertices_), radius > 0.0f ? error / radius : 0.0f });
+		}
+		return chain;
+	}
+
+	// Get the FNV-1a hash of the vertex positions of a mesh, in order
+	uint32_t MeshLodChain::HashVertices(Mesh const & mesh)
+	{
+		uint32_t hash { 2166136261u };
+		auto const & positions { mesh.GetPositionData() };
+		auto const * bytes { reinterpret_cast<uint8_t const *>(positions.data()) };
+		for(size_t i = 0; i < positions.size() * sizeof(float); ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	// Write the chain to a file, returns false if the file could not be written
+	bool MeshLodChain::Write(std::string const & path) const
+	{
+		std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if(!out)
+			return false;
+
+		ContainerHeader header { CONTAINER_MAGIC, CONTAINER_VERSION, num_vertices_, vertex_hash_, static_cast<uint32_t>(lods_.size()) };
+		out.write(reinterpret_cast<char const *>(&header), sizeof(header));
+		for(auto const & lod : lods_)
+		{
+			uint32_t num_indices { static_cast<uint32_t>(lod.indices_.size()) };
+			out.write(reinterpret_cast<char const *>(&lod.error_), sizeof(lod.error_));
+			out.write(reinterpret_cast<char const *>(&num_indices), sizeof(num_indices));
+			out.write(reinterpret_cast<char const *>(lod.indices_.data()), lod.indices_.size() * sizeof(unsigned int));
+		}
+		return static_cast<bool>(out);
+	}
+
+	// Read the chain from a file, returns false if the file could not be read or is not a valid LOD chain
+	bool MeshLodChain::Read(std::string const & path)
+	{
+		std::ifstream in(path, std::ios::in | std::ios::binary);
+		if(!in)
+			return false;
+
+		ContainerHeader header;
+		if(!in.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic_ != CONTAINER_MAGIC || header.version_ != CONTAINER_VERSION
+			|| header.num_lods_ >= MAX_LODS)
+			return false;
+
+		// Every index must reference a vertex of the mesh, s.t. a truncated or corrupt file is never drawn
+		std::vector<MeshLod> lods(header.num_lods_);
+		for(auto & lod : lods)
+		{
+			uint32_t num_indices;
+			if(!in.read(reinterpret_cast<char *>(&lod.error_), sizeof(lod.error_)) || !in.read(reinterpret_cast<char *>(&num_indices), sizeof(num_indices))
+				|| num_indices % 3 != 0 || num_indices > header.num_vertices_ * 6u + 3u)
+				return false;
+			lod.indices_.resize(num_indices);
+			if(!in.read(reinterpret_cast<char *>(lod.indices_.data()), num_indices * sizeof(unsigned int)))
+				return false;
+			for(unsigned int index : lod.indices_)
+			{
+				if(index >= header.num_vertices_)
+					return false;
+			}
+		}
+
+		num_vertices_ = header.num_vertices_;
+		vertex_hash_ = header.vertex_hash_;
+		lods_ = std::move(lods);
+		return true;
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "Mesh.h"
+
+namespace ose
+{
+	// The simplified levels of detail of a mesh, generated when the mesh is first imported and cached in a (.olod) file next to it
+	// Layout (little-endian): ContainerHeader, then for each level its float error, uint32 index count and indices, finest first
+	struct MeshLodChain
+	{
+		// Identifies a LOD chain file and the layout of its header
+		static constexpr uint32_t CONTAINER_MAGIC { 0x444F4C4F };
+		static constexpr uint32_t CONTAINER_VERSION { 2 };
+
+		// Extension appended to the path of the mesh file to get the path of its LOD chain
+		static constexpr char const * CONTAINER_EXTENSION { ".olod" };
+
+		// Maximum number of levels of detail, including the full detail mesh
+		static constexpr uint32_t MAX_LODS { 4 };
+
+		// Meshes with fewer triangles than this are cheap enough to always draw at full detail
+		static constexpr size_t MIN_TRIANGLES { 128 };
+
+		// Number of vertices of the mesh the chain was generated from, s.t. a chain is never used with a different mesh
+		uint32_t num_vertices_ { 0 };
+
+		// Hash of the vertex positions of the mesh the chain was generated from, s.t. a chain is never used once the vertices are reordered
+		uint32_t vertex_hash_ { 0 };
+
+		// Simplified levels, each with roughly half the triangles of the level before it
+		std::vector<MeshLod> lods_;
+
+		// Generate the LOD chain of a mesh, the chain is empty if the mesh is too small to be worth simplifying
+		static MeshLodChain Generate(Mesh const & mesh);
+
+		// Get the FNV-1a hash of the vertex positions of a mesh, in order
+		static uint32_t HashVertices(Mesh const & mesh);
+
+		// Write the chain to a file, returns false if the file could not be written
+		bool Write(std::string const & path) const;
+
+		// Read the chain from a file, returns false if the file could not be read or is not a valid LOD chain
+		bool Read(std::string const & path);
+
+	private:
+		struct ContainerHeader
+		{
+			uint32_t magic_;
+			uint32_t version_;
+			uint32_t num_vertices_;
+			uint32_t vertex_hash_;
+			uint32_t num_lods_;
+		};
+	};
+}
@@ -4,6 +4,10 @@ namespace ose
 {
 	struct MeshMetaData
 	{
+		// Reorder the mesh's triangles and vertices for the GPU's vertex cache, overdraw and vertex fetch when it is imported
+		bool optimize_ { true };
 
+		// Store normals and tangents as packed 10 bit integers and texture co-ordinates as half floats, s.t. each vertex is 24 bytes rather than 44
+		bool compact_vertices_ { false };
 	};
 }
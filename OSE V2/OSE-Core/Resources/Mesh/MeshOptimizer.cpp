@@ -0,0 +1,307 @@
+#include "stdafx.h"
+#include "MeshOptimizer.h"
+#include "Mesh.h"
+
+namespace ose
+{
+	// Optimize every section of a mesh, the mesh's vertices are reordered
+	MeshOptimizer::Stats MeshOptimizer::Optimize(Mesh & mesh)
+	{
+		Stats stats;
+		size_t num_vertices { mesh.GetPositionData().size() / 3 };
+		auto get_indices { [&mesh]() {
+			std::vector<unsigned int> indices;
+			for(MeshSection const & section : mesh.GetSections())
+				indices.insert(indices.end(), section.GetFaceIndices().begin(), section.GetFaceIndices().end());
+			return indices;
+		} };
+
+		// Reordering a mesh with invalid faces would read out of bounds, so it is left as it was loaded
+		std::vector<unsigned int> indices { get_indices() };
+		stats.acmr_before_ = stats.acmr_after_ = ComputeACMR(indices, num_vertices);
+		if(std::any_of(indices.begin(), indices.end(), [num_vertices](unsigned int index) { return index >= num_vertices; }))
+			return stats;
+
+		for(MeshSection & section : mesh.GetSections())
+		{
+			std::vector<unsigned int> section_indices { OptimizeVertexCache(section.GetFaceIndices(), num_vertices) };
+			section.SetFaceIndices(OptimizeOverdraw(section_indices, mesh.GetPositionData()));
+		}
+		mesh.RemapVertices(OptimizeVertexFetch(get_indices(), num_vertices));
+
+		stats.acmr_after_ = ComputeACMR(get_indices(), num_vertices);
+		return stats;
+	}
+
+	// Reorder triangles to maximise the number of vertices which are reused from the post-transform vertex cache
+	std::vector<unsigned int> MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int> const & indices, size_t num_vertices)
+	{
+		size_t num_triangles { indices.size() / 3 };
+		for(size_t i = 0; i < num_triangles * 3; ++i)
+		{
+			if(indices[i] >= num_vertices)
+				return indices;
+		}
+
+		// Each vertex's live triangles are kept at the front of its range of the adjacency list
+		std::vector<uint32_t> num_live_triangles(num_vertices, 0);
+		for(size_t i = 0; i < num_triangles * 3; ++i)
+			++num_live_triangles[indices[i]];
+		std::vector<uint32_t> offsets(num_vertices + 1, 0);
+		for(size_t v = 0; v < num_vertices; ++v)
+			offsets[v + 1] = offsets[v] + num_live_triangles[v];
+		std::vector<uint32_t> adjacency(num_triangles * 3);
+		{
+			std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+			for(size_t i = 0; i < num_triangles * 3; ++i)
+				adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+
+		std::vector<int> cache_positions(num_vertices, -1);
+		std::vector<float> vertex_scores(num_vertices);
+		for(size_t v = 0; v < num_vertices; ++v)
+			vertex_scores[v] = VertexScore(-1, num_live_triangles[v]);
+		std::vector<float> triangle_scores(num_triangles);
+		std::vector<uint8_t> emitted(num_triangles, 0);
+		size_t best { num_triangles };
+		for(size_t t = 0; t < num_triangles; ++t)
+		{
+			triangle_scores[t] = vertex_scores[indices[t * 3 + 0]] + vertex_scores[indices[t * 3 + 1]] + vertex_scores[indices[t * 3 + 2]];
+			if(best == num_triangles || triangle_scores[t] > triangle_scores[best])
+				best = t;
+		}
+
+		std::vector<unsigned int> result;
+		result.reserve(num_triangles * 3);
+		std::vector<unsigned int> cache;
+		std::vector<unsigned int> new_cache;
+		size_t next_unemitted { 0 };
+		while(best < num_triangles)
+		{
+			unsigned int const * tri { &indices[best * 3] };
+			result.insert(result.end(), tri, tri + 3);
+			emitted[best] = 1;
+
+			for(uint32_t c = 0; c < 3; ++c)
+			{
+				unsigned int v { tri[c] };
+				uint32_t * begin { &adjacency[offsets[v]] };
+				uint32_t * end { begin + num_live_triangles[v] };
+				std::iter_swap(std::find(begin, end, static_cast<uint32_t>(best)), end - 1);
+				--num_live_triangles[v];
+			}
+
+			// The triangle's vertices move to the front of the LRU cache, pushing the least recently used vertices out
+			new_cache.assign(tri, tri + 3);
+			for(unsigned int v : cache)
+			{
+				if(v != tri[0] && v != tri[1] && v != tri[2])
+					new_cache.push_back(v);
+			}
+			for(size_t i = 0; i < new_cache.size(); ++i)
+				cache_positions[new_cache[i]] = i < VERTEX_CACHE_SIZE ? static_cast<int>(i) : -1;
+
+			// Only the triangles of vertices which were or are in the cache change score, the next triangle is the best of them
+			best = num_triangles;
+			for(unsigned int v : new_cache)
+				vertex_scores[v] = VertexScore(cache_positions[v], num_live_triangles[v]);
+			for(unsigned int v : new_cache)
+			{
+				for(uint32_t i = offsets[v]; i < offsets[v] + num_live_triangles[v]; ++i)
+				{
+					uint32_t t { adjacency[i] };
+					triangle_scores[t] = vertex_scores[indices[t * 3 + 0]] + vertex_scores[indices[t * 3 + 1]] + vertex_scores[indices[t * 3 + 2]];
+					if(best == num_triangles || triangle_scores[t] > triangle_scores[best])
+						best = t;
+				}
+			}
+			if(new_cache.size() > VERTEX_CACHE_SIZE)
+				new_cache.resize(VERTEX_CACHE_SIZE);
+			cache.swap(new_cache);
+
+			// When no cached vertex has a live triangle, continue from the next triangle which has not been drawn
+			if(best == num_triangles)
+			{
+				while(next_unemitted < num_triangles && emitted[next_unemitted])
+					++next_unemitted;
+				best = next_unemitted;
+			}
+		}
+		return result;
+	}
+
+	// Reorder clusters of cache optimized triangles s.t. the clusters facing away from the mesh's centre are drawn first
+	// Clusters are only split where this increases the ACMR by less than threshold, s.t. the cache optimization is preserved
+	std::vector<unsigned int> MeshOptimizer::OptimizeOverdraw(std::vector<unsigned int> const & indices, std::vector<float> const & positions,
+		float threshold)
+	{
+		size_t num_vertices { positions.size() / 3 };
+		size_t num_triangles { indices.size() / 3 };
+		if(num_triangles < 2)
+			return indices;
+		for(size_t i = 0; i < num_triangles * 3; ++i)
+		{
+			if(indices[i] >= num_vertices)
+				return indices;
+		}
+
+		// FIFO cache simulated with timestamps, a vertex is cached if it was transformed within the last ACMR_CACHE_SIZE misses
+		std::vector<uint32_t> timestamps(num_vertices, 0);
+		uint32_t time { ACMR_CACHE_SIZE + 1 };
+		auto count_misses { [&](unsigned int const * tri) {
+			uint32_t misses { 0 };
+			for(uint32_t c = 0; c < 3; ++c)
+			{
+				if(time - timestamps[tri[c]] > ACMR_CACHE_SIZE)
+				{
+					timestamps[tri[c]] = time++;
+					++misses;
+				}
+			}
+			return misses;
+		} };
+		float acmr { ComputeACMR(indices, num_vertices) };
+
+		// A cluster ends where a triangle shares no cached vertices (hard boundary), or where restarting with an empty cache
+		// costs little because the cluster so far is already about as efficient as the whole mesh (soft boundary)
+		std::vector<size_t> cluster_starts { 0 };
+		uint32_t cluster_misses { 0 };
+		for(size_t t = 0; t < num_triangles; ++t)
+		{
+			uint32_t misses { count_misses(&indices[t * 3]) };
+			size_t cluster_triangles { t - cluster_starts.back() };
+			if(misses == 3 && cluster_triangles > 0)
+			{
+				cluster_starts.push_back(t);
+				cluster_misses = 0;
+				cluster_triangles = 0;
+			}
+			cluster_misses += misses;
+			++cluster_triangles;
+			if(t + 1 < num_triangles && static_cast<float>(cluster_misses) <= threshold * acmr * static_cast<float>(cluster_triangles))
+			{
+				cluster_starts.push_back(t + 1);
+				cluster_misses = 0;
+				time += ACMR_CACHE_SIZE + 1;
+			}
+		}
+		cluster_starts.push_back(num_triangles);
+
+		// Each cluster is sorted by how far it faces out from the centre of the mesh, weighted by triangle area
+		auto get_position { [&positions](unsigned int v) { return glm::vec3 { positions[v * 3 + 0], positions[v * 3 + 1], positions[v * 3 + 2] }; } };
+		size_t num_clusters { cluster_starts.size() - 1 };
+		std::vector<glm::vec3> cluster_centroids(num_clusters, glm::vec3 { 0.0f });
+		std::vector<glm::vec3> cluster_normals(num_clusters, glm::vec3 { 0.0f });
+		glm::vec3 mesh_centroid { 0.0f };
+		float mesh_area { 0.0f };
+		for(size_t c = 0; c < num_clusters; ++c)
+		{
+			float cluster_area { 0.0f };
+			for(size_t t = cluster_starts[c]; t < cluster_starts[c + 1]; ++t)
+			{
+				glm::vec3 a { get_position(indices[t * 3 + 0]) };
+				glm::vec3 b { get_position(indices[t * 3 + 1]) };
+				glm::vec3 cc { get_position(indices[t * 3 + 2]) };
+				glm::vec3 normal { glm::cross(b - a, cc - a) };
+				float area { glm::length(normal) };
+				cluster_centroids[c] += (a + b + cc) * (area / 3.0f);
+				cluster_normals[c] += normal;
+				cluster_area += area;
+			}
+			mesh_centroid += cluster_centroids[c];
+			mesh_area += cluster_area;
+			if(cluster_area > 0.0f)
+				cluster_centroids[c] /= cluster_area;
+		}
+		if(mesh_area > 0.0f)
+			mesh_centroid /= mesh_area;
+
+		std::vector<float> sort_keys(num_clusters, 0.0f);
+		for(size_t c = 0; c < num_clusters; ++c)
+		{
+			float normal_length { glm::length(cluster_normals[c]) };
+			if(normal_length > 0.0f)
+				sort_keys[c] = glm::dot(cluster_centroids[c] - mesh_centroid, cluster_normals[c] / normal_length);
+		}
+		std::vector<size_t> order(num_clusters);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&sort_keys](size_t a, size_t b) { return sort_keys[a] > sort_keys[b]; });
+
+		std::vector<unsigned int> result;
+		result.reserve(num_triangles * 3);
+		for(size_t c : order)
+			result.insert(result.end(), indices.begin() + cluster_starts[c] * 3, indices.begin() + cluster_starts[c + 1] * 3);
+		return result;
+	}
+
+	// Get the vertex remap which orders vertices by their first use in indices, unused vertices are moved to the end
+	// Vertex v should move to remap[v]
+	std::vector<unsigned int> MeshOptimizer::OptimizeVertexFetch(std::vector<unsigned int> const & indices, size_t num_vertices)
+	{
+		constexpr unsigned int unassigned { std::numeric_limits<unsigned int>::max() };
+		std::vector<unsigned int> remap(num_vertices, unassigned);
+		unsigned int next { 0 };
+		for(unsigned int index : indices)
+		{
+			if(index < num_vertices && remap[index] == unassigned)
+				remap[index] = next++;
+		}
+		for(unsigned int & v : remap)
+		{
+			if(v == unassigned)
+				v = next++;
+		}
+		return remap;
+	}
+
+	// Get the average cache miss ratio of a list of triangles, i.e. the average number of vertices transformed per triangle
+	// Ranges from 3 (no reuse) down to about 0.5 for a large regular grid
+	float MeshOptimizer::ComputeACMR(std::vector<unsigned int> const & indices, size_t num_vertices, size_t cache_size)
+	{
+		size_t num_triangles { indices.size() / 3 };
+		if(num_triangles == 0)
+			return 0.0f;
+
+		std::vector<size_t> timestamps(num_vertices, 0);
+		size_t time { cache_size + 1 };
+		size_t misses { 0 };
+		for(size_t i = 0; i < num_triangles * 3; ++i)
+		{
+			unsigned int index { indices[i] };
+			if(index >= num_vertices)
+			{
+				++misses;
+			}
+			else if(time - timestamps[index] > cache_size)
+			{
+				timestamps[index] = time++;
+				++misses;
+			}
+		}
+		return static_cast<float>(misses) / static_cast<float>(num_triangles);
+	}
+
+	// Get the score of a vertex given its position in the cache (-1 if not in cache) and its number of remaining triangles
+	float MeshOptimizer::VertexScore(int cache_position, uint32_t num_live_triangles)
+	{
+		// Vertices with no triangles left to draw can't make a triangle more attractive
+		if(num_live_triangles == 0)
+			return -1.0f;
+
+		// The vertices of the last triangle get a fixed score s.t. strips aren't favoured over fans, the rest decay with cache age
+		float score { 0.0f };
+		if(cache_position >= 0 && cache_position < 3)
+		{
+			score = 0.75f;
+		}
+		else if(cache_position >= 3)
+		{
+			float scale { 1.0f / static_cast<float>(VERTEX_CACHE_SIZE - 3) };
+			score = std::pow(1.0f - static_cast<float>(cache_position - 3) * scale, 1.5f);
+		}
+
+		// Vertices with few triangles left are boosted s.t. they are finished off rather than leaving lone triangles for later
+		score += 2.0f * std::pow(static_cast<float>(num_live_triangles), -0.5f);
+		return score;
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+namespace ose
+{
+	class Mesh;
+
+	// Reorders the triangles and vertices of an imported mesh s.t. the GPU does less work drawing it, without changing how it looks
+	// Triangles are ordered for the post-transform vertex cache (Forsyth), then clusters of them are ordered s.t. front-facing clusters
+	// tend to be drawn first (Sander et al.), then vertices are ordered by first use s.t. vertex fetch reads memory linearly
+	class MeshOptimizer
+	{
+	public:
+		// Average cache miss ratio (vertices transformed per triangle) of the mesh before and after it was optimized
+		struct Stats
+		{
+			float acmr_before_ { 0.0f };
+			float acmr_after_ { 0.0f };
+		};
+
+		// Size of the vertex cache the triangle order is optimized for
+		static constexpr size_t VERTEX_CACHE_SIZE { 32 };
+
+		// Size of the FIFO cache the ACMR is measured with, a conservative approximation of real hardware
+		static constexpr size_t ACMR_CACHE_SIZE { 16 };
+
+		// Clusters may be split where this would increase the ACMR of the triangles by at most this factor
+		static constexpr float OVERDRAW_ACMR_THRESHOLD { 1.05f };
+
+		// Optimize every section of a mesh, the mesh's vertices are reordered
+		static Stats Optimize(Mesh & mesh);
+
+		// Reorder triangles to maximise the number of vertices which are reused from the post-transform vertex cache
+		static std::vector<unsigned int> OptimizeVertexCache(std::vector<unsigned int> const & indices, size_t num_vertices);
+
+		// Reorder clusters of cache optimized triangles s.t. the clusters facing away from the mesh's centre are drawn first
+		// Clusters are only split where this increases the ACMR by less than threshold, s.t. the cache optimization is preserved
+		static std::vector<unsigned int> OptimizeOverdraw(std::vector<unsigned int> const & indices, std::vector<float> const & positions,
+			float threshold = OVERDRAW_ACMR_THRESHOLD);
+
+		// Get the vertex remap which orders vertices by their first use in indices, unused vertices are moved to the end
+		// Vertex v should move to remap[v]
+		static std::vector<unsigned int> OptimizeVertexFetch(std::vector<unsigned int> const & indices, size_t num_vertices);
+
+		// Get the average cache miss ratio of a list of triangles, i.e. the average number of vertices transformed per triangle
+		// Ranges from 3 (no reuse) down to about 0.5 for a large regular grid
+		static float ComputeACMR(std::vector<unsigned int> const & indices, size_t num_vertices, size_t cache_size = ACMR_CACHE_SIZE);
+
+	private:
+		// Get the score of a vertex given its position in the cache (-1 if not in cache) and its number of remaining triangles
+		static float VertexScore(int cache_position, uint32_t num_live_triangles);
+	};
+}
@@ -0,0 +1,230 @@
+#include "stdafx.h"
+#include "MeshSimplifier.h"
+#include <queue>
+
+namespace ose
+{
+	// Simplify the triangles of a mesh until at most target_index_count indices remain, or no edge can be collapsed
+	// positions is a list of xyz positions, every 3 indices make a triangle
+	// error is set to the largest distance (approximately) the simplified surface moved from the original surface
+	std::vector<unsigned int> MeshSimplifier::Simplify(std::vector<float> const & positions, std::vector<unsigned int> const & indices,
+		size_t target_index_count, float & error)
+	{
+		error = 0.0f;
+		size_t num_vertices { positions.size() / 3 };
+		size_t num_triangles { indices.size() / 3 };
+		std::vector<unsigned int> result(indices.begin(), indices.begin() + num_triangles * 3);
+		if(result.size() <= target_index_count)
+			return result;
+		for(unsigned int index : result)
+		{
+			if(index >= num_vertices)
+				return result;
+		}
+
+		std::vector<glm::dvec3> vertices(num_vertices);
+		for(size_t v = 0; v < num_vertices; ++v)
+			vertices[v] = { positions[v * 3 + 0], positions[v * 3 + 1], positions[v * 3 + 2] };
+
+		// Each vertex's quadric starts as the planes of the triangles using it
+		std::vector<Quadric> quadrics(num_vertices);
+		std::vector<std::vector<uint32_t>> vertex_triangles(num_vertices);
+		std::vector<uint64_t> directed_edges;
+		directed_edges.reserve(result.size());
+		for(uint32_t t = 0; t < num_triangles; ++t)
+		{
+			unsigned int const * tri { &result[t * 3] };
+			glm::dvec3 normal { glm::cross(vertices[tri[1]] - vertices[tri[0]], vertices[tri[2]] - vertices[tri[0]]) };
+			double length { glm::length(normal) };
+			Quadric plane { length > 0.0 ? Quadric::FromPlane(normal / length, vertices[tri[0]]) : Quadric{} };
+			for(uint32_t c = 0; c < 3; ++c)
+			{
+				quadrics[tri[c]].Add(plane);
+				vertex_triangles[tri[c]].push_back(t);
+				directed_edges.push_back((static_cast<uint64_t>(tri[c]) << 32) | tri[(c + 1) % 3]);
+			}
+		}
+		std::sort(directed_edges.begin(), directed_edges.end());
+
+		// An edge used by a single triangle is on a border, whose vertices are locked s.t. holes and seams don't open up
+		auto has_opposite { [&directed_edges](uint64_t edge) {
+			return std::binary_search(directed_edges.begin(), directed_edges.end(), (edge << 32) | (edge >> 32));
+		} };
+		std::vector<uint8_t> locked(num_vertices, 0);
+		for(uint64_t edge : directed_edges)
+		{
+			if(!has_opposite(edge))
+				locked[edge >> 32] = locked[edge & 0xFFFFFFFF] = 1;
+		}
+
+		// Candidate collapses are ordered by error, a candidate is stale once either vertex has changed since it was pushed
+		struct Collapse
+		{
+			double cost_;
+			unsigned int from_;
+			unsigned int to_;
+			uint32_t from_version_;
+			uint32_t to_version_;
+
+			bool operator>(Collapse const & other) const { return cost_ > other.cost_; }
+		};
+		std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> collapses;
+		std::vector<uint32_t> versions(num_vertices, 0);
+		std::vector<uint8_t> vertex_removed(num_vertices, 0);
+
+		// The edge is collapsed onto whichever end gives the smallest error, locked vertices can only be collapsed onto
+		auto push_edge { [&](unsigned int a, unsigned int b) {
+			if(locked[a] && locked[b])
+				return;
+			Quadric quadric { quadrics[a] };
+			quadric.Add(quadrics[b]);
+			double a_to_b { locked[a] ? std::numeric_limits<double>::max() : quadric.Evaluate(vertices[b]) };
+			double b_to_a { locked[b] ? std::numeric_limits<double>::max() : quadric.Evaluate(vertices[a]) };
+			if(a_to_b <= b_to_a)
+				collapses.push({ a_to_b, a, b, versions[a], versions[b] });
+			else
+				collapses.push({ b_to_a, b, a, versions[b], versions[a] });
+		} };
+		for(uint64_t edge : directed_edges)
+		{
+			unsigned int a { static_cast<unsigned int>(edge >> 32) };
+			unsigned int b { static_cast<unsigned int>(edge & 0xFFFFFFFF) };
+			if(a != b && (a < b || !has_opposite(edge)))
+				push_edge(a, b);
+		}
+
+		std::vector<uint8_t> triangle_removed(num_triangles, 0);
+		size_t num_indices { result.size() };
+		double max_cost { 0.0 };
+		std::vector<unsigned int> neighbours;
+		while(num_indices > target_index_count && !collapses.empty())
+		{
+			Collapse collapse { collapses.top() };
+			collapses.pop();
+			unsigned int from { collapse.from_ };
+			unsigned int to { collapse.to_ };
+			if(vertex_removed[from] || vertex_removed[to] || versions[from] != collapse.from_version_ || versions[to] != collapse.to_version_)
+				continue;
+			if(FlipsTriangle(vertices, result, triangle_removed, vertex_triangles[from], from, to))
+				continue;
+
+			// Triangles using the edge are removed, the rest of from's triangles are moved to to
+			for(uint32_t t : vertex_triangles[from])
+			{
+				if(triangle_removed[t])
+					continue;
+				unsigned int * tri { &result[t * 3] };
+				if(tri[0] == to || tri[1] == to || tri[2] == to)
+				{
+					triangle_removed[t] = 1;
+					num_indices -= 3;
+					continue;
+				}
+				for(uint32_t c = 0; c < 3; ++c)
+				{
+					if(tri[c] == from)
+						tri[c] = to;
+				}
+				vertex_triangles[to].push_back(t);
+			}
+			vertex_removed[from] = 1;
+			vertex_triangles[from].clear();
+			quadrics[to].Add(quadrics[from]);
+			++versions[to];
+			max_cost = std::max(max_cost, collapse.cost_);
+
+			// The cost of every edge around to has changed
+			auto & to_triangles { vertex_triangles[to] };
+			to_triangles.erase(std::remove_if(to_triangles.begin(), to_triangles.end(),
+				[&triangle_removed](uint32_t t) { return triangle_removed[t] != 0; }), to_triangles.end());
+			neighbours.clear();
+			for(uint32_t t : to_triangles)
+			{
+				for(uint32_t c = 0; c < 3; ++c)
+				{
+					if(result[t * 3 + c] != to)
+						neighbours.push_back(result[t * 3 + c]);
+				}
+			}
+			std::sort(neighbours.begin(), neighbours.end());
+			neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+			for(unsigned int neighbour : neighbours)
+				push_edge(to, neighbour);
+		}
+
+		// Compact the remaining triangles
+		size_t out { 0 };
+		for(uint32_t t = 0; t < num_triangles; ++t)
+		{
+			if(triangle_removed[t])
+				continue;
+			result[out++] = result[t * 3 + 0];
+			result[out++] = result[t * 3 + 1];
+			result[out++] = result[t * 3 + 2];
+		}
+		result.resize(out);
+		error = static_cast<float>(std::sqrt(max_cost));
+		return result;
+	}
+
+	// Returns true iff moving vertex from to the position of vertex to would flip or collapse a triangle around from
+	bool MeshSimplifier::FlipsTriangle(std::vector<glm::dvec3> const & vertices, std::vector<unsigned int> const & indices,
+		std::vector<uint8_t> const & triangle_removed, std::vector<uint32_t> const & triangles, unsigned int from, unsigned int to)
+	{
+		for(uint32_t t : triangles)
+		{
+			if(triangle_removed[t])
+				continue;
+			unsigned int const * tri { &indices[t * 3] };
+			// Triangles using the edge are removed by the collapse, so can't flip
+			if(tri[0] == to || tri[1] == to || tri[2] == to)
+				continue;
+
+			glm::dvec3 before[3] { vertices[tri[0]], vertices[tri[1]], vertices[tri[2]] };
+			glm::dvec3 after[3] { before[0], before[1], before[2] };
+			for(uint32_t c = 0; c < 3; ++c)
+			{
+				if(tri[c] == from)
+					after[c] = vertices[to];
+			}
+			glm::dvec3 normal_before { glm::cross(before[1] - before[0], before[2] - before[0]) };
+			glm::dvec3 normal_after { glm::cross(after[1] - after[0], after[2] - after[0]) };
+			if(glm::dot(normal_before, normal_after) <= 0.0 || glm::dot(normal_after, normal_after) <= 1e-24)
+				return true;
+		}
+		return false;
+	}
+
+	// Get the quadric of the plane with unit normal n, passing through point p
+	MeshSimplifier::Quadric MeshSimplifier::Quadric::FromPlane(glm::dvec3 const & n, glm::dvec3 const & p)
+	{
+		double d { -glm::dot(n, p) };
+		Quadric q;
+		q.a2_ = n.x * n.x;	q.ab_ = n.x * n.y;	q.ac_ = n.x * n.z;	q.ad_ = n.x * d;
+		q.b2_ = n.y * n.y;	q.bc_ = n.y * n.z;	q.bd_ = n.y * d;
+		q.c2_ = n.z * n.z;	q.cd_ = n.z * d;
+		q.d2_ = d * d;
+		return q;
+	}
+
+	// Add the planes of another quadric to this quadric
+	void MeshSimplifier::Quadric::Add(Quadric const & other)
+	{
+		a2_ += other.a2_;	ab_ += other.ab_;	ac_ += other.ac_;	ad_ += other.ad_;
+		b2_ += other.b2_;	bc_ += other.bc_;	bd_ += other.bd_;
+		c2_ += other.c2_;	cd_ += other.cd_;
+		d2_ += other.d2_;
+	}
+
+	// Get the sum of the squared distances from a point to the quadric's planes
+	double MeshSimplifier::Quadric::Evaluate(glm::dvec3 const & p) const
+	{
+		double x { p.x }, y { p.y }, z { p.z };
+		double result { a2_ * x * x + 2 * ab_ * x * y + 2 * ac_ * x * z + 2 * ad_ * x
+			+ b2_ * y * y + 2 * bc_ * y * z + 2 * bd_ * y
+			+ c2_ * z * z + 2 * cd_ * z
+			+ d2_ };
+		// Rounding can make the sum slightly negative
+		return std::max(result, 0.0);
+	}
+}
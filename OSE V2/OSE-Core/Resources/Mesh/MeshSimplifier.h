@@ -0,0 +1,40 @@
+#pragma once
+
+namespace ose
+{
+	// Reduces the number of triangles of a mesh by collapsing edges in the order of their quadric error (Garland & Heckbert)
+	// Edges are collapsed onto one of their vertices, s.t. the simplified triangles index the mesh's existing vertices
+	// Vertices on the border of the mesh (including UV and normal seams, where vertices are split) are never moved
+	class MeshSimplifier
+	{
+	public:
+		// Simplify the triangles of a mesh until at most target_index_count indices remain, or no edge can be collapsed
+		// positions is a list of xyz positions, every 3 indices make a triangle
+		// error is set to the largest distance (approximately) the simplified surface moved from the original surface
+		static std::vector<unsigned int> Simplify(std::vector<float> const & positions, std::vector<unsigned int> const & indices,
+			size_t target_index_count, float & error);
+
+	private:
+		// Symmetric 4x4 matrix whose quadratic form is the sum of the squared distances to a set of planes
+		struct Quadric
+		{
+			double a2_ { 0 }, ab_ { 0 }, ac_ { 0 }, ad_ { 0 };
+			double b2_ { 0 }, bc_ { 0 }, bd_ { 0 };
+			double c2_ { 0 }, cd_ { 0 };
+			double d2_ { 0 };
+
+			// Get the quadric of the plane with unit normal n, passing through point p
+			static Quadric FromPlane(glm::dvec3 const & n, glm::dvec3 const & p);
+
+			// Add the planes of another quadric to this quadric
+			void Add(Quadric const & other);
+
+			// Get the sum of the squared distances from a point to the quadric's planes
+			double Evaluate(glm::dvec3 const & p) const;
+		};
+
+		// Returns true iff moving vertex from to the position of vertex to would flip or collapse a triangle around from
+		static bool FlipsTriangle(std::vector<glm::dvec3> const & vertices, std::vector<unsigned int> const & indices,
+			std::vector<uint8_t> const & triangle_removed, std::vector<uint32_t> const & triangles, unsigned int from, unsigned int to);
+	};
+}
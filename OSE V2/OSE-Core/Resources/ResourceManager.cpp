@@ -6,14 +6,19 @@
 #include "Texture/Texture.h"
 #include "Texture/TextureLoader.h"
 #include "Texture/TextureMetaData.h"
+#include "Texture/TextureAtlas.h"
 #include "Tilemap/TilemapLoaderFactory.h"
 #include "Tilemap/Tilemap.h"
 #include "Tilemap/TilemapLoader.h"
 #include "Mesh/Mesh.h"
 #include "Mesh/MeshLoader.h"
 #include "Mesh/MeshLoaderFactory.h"
+#include "Mesh/MeshLodChain.h"
+#include "Mesh/MeshMetaData.h"
+#include "Mesh/MeshOptimizer.h"
 #include "Material/Material.h"
 #include "OSE-Core/File System/FileSystemUtil.h"
+#include <unordered_set>
 
 #include "OSE-Core/Shader/ShaderProg.h"
 #include "OSE-Core/Shader/Shaders/ShaderGraph2D.h"
@@ -138,12 +143,26 @@ namespace ose
 																	"mip_mapping_enabled 1\n"
 																	"min_LOD 0\n"
 																	"max_LOD 0\n"
-																	"LOD_bias 0");
+																	"LOD_bias 0\n"
+																	"compression 0");
 				}
 
 				// set the texture's meta data
 				tex->SetMetaData(meta_data);
 
+				// load the texture's block compressed container if it is up to date, skipping decoding the image
+				std::string container_abs_path { abs_path + CompressedImage::CONTAINER_EXTENSION };
+				if(meta_data.compression_ != ETextureCompression::NONE && fs::IsFileNewer(container_abs_path, abs_path))
+				{
+					CompressedImage image;
+					if(image.Read(container_abs_path) && image.format_ == meta_data.compression_)
+					{
+						tex->SetCompressedImage(std::move(image));
+						return;
+					}
+					LOG_ERROR("Failed to load texture container", container_abs_path, "- loading the uncompressed image instead");
+				}
+
 				// TODO - do the loading with multi-threading
 				int32_t w, h, channels;
 				IMGDATA d;
@@ -239,6 +258,125 @@ namespace ose
 		}
 	}
 
+	// offline step which writes a block compressed container next to each added texture whose meta data requests compression
+	// the next time the texture is added its container is loaded instead of decoding the image, until the image is modified
+	// textures which were loaded from an up to date container, or whose container has already been written, are skipped
+	void ResourceManager::CompressTextures()
+	{
+		auto compress = [](Texture const & tex) {
+			if(tex.GetCompression() == ETextureCompression::NONE || tex.GetCompressedImage() != nullptr || tex.GetImgData() == nullptr)
+				return;
+			std::string container_abs_path { tex.GetPath() + CompressedImage::CONTAINER_EXTENSION };
+			if(fs::IsFileNewer(container_abs_path, tex.GetPath()))
+				return;
+			CompressedImage image { CompressedImage::Encode(tex.GetImgData(), tex.GetWidth(), tex.GetHeight(), tex.GetNumChannels(),
+				tex.GetCompression(), tex.IsMipMappingEnabled()) };
+			if(image.Write(container_abs_path))
+				DEBUG_LOG("Compressed texture", tex.GetName(), "to", container_abs_path);
+			else
+				LOG_ERROR("Failed to write texture container", container_abs_path);
+		};
+
+		for(auto const & [name, tex] : textures_with_Gpu_memory_)
+			compress(*tex);
+		for(auto const & [name, tex] : textures_without_Gpu_memory_)
+			compress(*tex);
+	}
+
+	// pack textures into texture atlases s.t. render objects using them can be drawn without rebinding textures
+	// textures are grouped by their filtering settings, each group is packed into its own atlas
+	// textures which are already part of an atlas are ignored
+	// packed textures which no material uses free their own GPU texture, since they are only ever drawn from the atlas
+	// IMPORTANT - can only be called from the thread which contains the render context
+	void ResourceManager::CreateTextureAtlases(std::vector<Texture const *> const & textures)
+	{
+		// textures used by materials are sampled as regular textures, so keep their own GPU texture
+		std::unordered_set<Texture const *> material_textures;
+		for(auto const & [name, material] : materials_)
+			material_textures.insert(material->GetTextures().begin(), material->GetTextures().end());
+
+		// group the textures by filtering settings since an atlas can only be sampled one way
+		std::map<uint32_t, std::vector<Texture *>> groups;
+		for(Texture const * texture : textures)
+		{
+			if(texture == nullptr || texture->GetAtlas() != nullptr)
+				continue;
+
+			// only textures owned by the resource manager (with a GPU representation) are packed
+			auto const & tex_iter { textures_with_Gpu_memory_.find(texture->GetName()) };
+			if(tex_iter == textures_with_Gpu_memory_.end() || tex_iter->second.get() != texture)
+				continue;
+
+			uint32_t key { static_cast<uint32_t>(texture->GetMagFilterMode()) << 16
+				| static_cast<uint32_t>(texture->GetMinFilterMode()) << 8
+				| static_cast<uint32_t>(texture->IsMipMappingEnabled()) };
+			auto & group { groups[key] };
+			if(std::find(group.begin(), group.end(), tex_iter->second.get()) == group.end())
+				group.push_back(tex_iter->second.get());
+		}
+
+		for(auto & [key, group] : groups)
+		{
+			uptr<TextureAtlas> atlas { RenderingFactories[0]->NewTextureAtlas(TEXTURE_ATLAS_LAYER_SIZE, TEXTURE_ATLAS_LAYER_SIZE, TEXTURE_ATLAS_PADDING) };
+
+			// textures too large for a layer keep using their own GPU texture
+			std::vector<Texture *> packed;
+			for(Texture * texture : group)
+			{
+				if(atlas->AddTexture(texture))
+					packed.push_back(texture);
+			}
+
+			// even a single texture is packed, the atlas is the only copy of it in GPU memory
+			if(packed.empty())
+				continue;
+
+			try {
+				atlas->Pack();
+				atlas->CreateTextureAtlas();
+			} catch(std::exception const & e) {
+				LOG_ERROR(e.what());
+				continue;
+			}
+
+			for(Texture * texture : packed)
+			{
+				texture->SetAtlas(atlas.get(), *atlas->GetRegion(texture));
+				if(material_textures.find(texture) == material_textures.end())
+				{
+					texture->DestroyTexture();
+					atlas_only_textures_.push_back(texture->GetName());
+				}
+			}
+
+			texture_atlases_.push_back(std::move(atlas));
+		}
+	}
+
+	// free the GPU memory of every texture atlas and remove the textures from them
+	// textures which were only stored in an atlas no longer have a GPU representation, so are created again by CreateTextures
+	// IMPORTANT - can only be called from the thread which contains the render context
+	void ResourceManager::DestroyTextureAtlases()
+	{
+		for(auto const & [name, tex] : textures_with_Gpu_memory_)
+			tex->SetAtlas(nullptr, {});
+
+		for(auto const & name : atlas_only_textures_)
+		{
+			auto tex_iter { textures_with_Gpu_memory_.find(name) };
+			if(tex_iter != textures_with_Gpu_memory_.end())
+			{
+				textures_without_Gpu_memory_.insert({ name, std::move(tex_iter->second) });
+				textures_with_Gpu_memory_.erase(tex_iter);
+			}
+		}
+		atlas_only_textures_.clear();
+
+		for(auto & atlas : texture_atlases_)
+			atlas->DestroyTextureAtlas();
+		texture_atlases_.clear();
+	}
+
 	//loads a meta file for some texture, meta files map properties to values
 	void ResourceManager::LoadTextureMetaFile(std::string const & abs_path, TextureMetaData & meta_data)
 	{
@@ -264,6 +402,11 @@ namespace ose
 					meta_data.max_lod_ = value;
 				} else if(property == "LOD_bias") {
 					meta_data.lod_bias_ = value;
+				} else if(property == "compression") {
+					if(value == 0 || value == 1 || value == 3)
+						meta_data.compression_ = static_cast<ETextureCompression>(value);
+					else
+						LOG_ERROR("Texture compression must be 0 (none), 1 (BC1) or 3 (BC3) in meta file", abs_path);
 				}
 			}
 			catch(...)
@@ -276,6 +419,13 @@ namespace ose
 	// Get the tilemap from the resources manager
 	// Given the name of the tilemap, return the tilemap object
 	Tilemap const * ResourceManager::GetTilemap(std::string const & name)
+	{
+		return GetTilemapMutable(name);
+	}
+
+	// Get a tilemap which can be edited at runtime, e.g. by scripts calling Tilemap::SetTile
+	// Tile renderers using the tilemap update the edited tiles the next time they are drawn
+	Tilemap * ResourceManager::GetTilemapMutable(std::string const & name)
 	{
 		// search the tilemaps_ list
 		auto const & iter { tilemaps_.find(name) };
@@ -380,6 +530,44 @@ namespace ose
 
 				// TODO - Do the loading with multi-threading
 				mesh_loader_->LoadMesh(abs_path, mesh.get());
+
+				// load or generate the mesh's meta data
+				std::string meta_abs_path { abs_path + ".meta" };
+				MeshMetaData meta_data;	//object will have default values
+				if(fs::DoesFileExist(meta_abs_path))
+				{
+					try
+					{
+						LoadMeshMetaFile(meta_abs_path, meta_data);
+					}
+					catch(std::exception const &) {}	// the default meta data is used
+				}
+				else
+				{
+					fs::WriteTextFile(meta_abs_path,	"optimize 1\n"
+																	"compact_vertices 0");
+				}
+				mesh->SetMetaData(meta_data);
+
+				// Reorder the mesh for the GPU before generating its LOD chain, s.t. the LODs index the reordered vertices
+				if(meta_data.optimize_)
+				{
+					MeshOptimizer::Stats stats { MeshOptimizer::Optimize(*mesh) };
+					DEBUG_LOG("Optimized mesh", name_to_use, "ACMR", stats.acmr_before_, "->", stats.acmr_after_);
+				}
+
+				// Load the mesh's LOD chain if it is up to date, else simplify the mesh and cache the chain next to the mesh file
+				std::string lod_abs_path { abs_path + MeshLodChain::CONTAINER_EXTENSION };
+				MeshLodChain lod_chain;
+				if(!fs::IsFileNewer(lod_abs_path, abs_path) || !lod_chain.Read(lod_abs_path) || lod_chain.vertex_hash_ != MeshLodChain::HashVertices(*mesh))
+				{
+					lod_chain = MeshLodChain::Generate(*mesh);
+					if(lod_chain.Write(lod_abs_path))
+						DEBUG_LOG("Generated", lod_chain.lods_.size(), "levels of detail for mesh", name_to_use);
+					else
+						LOG_ERROR("Failed to write mesh LOD chain", lod_abs_path);
+				}
+				mesh->SetLods(std::move(lod_chain.lods_));
 			}
 			else
 			{
@@ -388,6 +576,32 @@ namespace ose
 		}
 	}
 
+	//loads a meta file for some mesh, meta files map properties to values
+	void ResourceManager::LoadMeshMetaFile(std::string const & abs_path, MeshMetaData & meta_data)
+	{
+		// Load the file (OSE stores meta files as property files)
+		auto props { LoadPropertyFile(abs_path) };
+
+		// Parse the properties
+		for(auto & [property, value_str] : props)
+		{
+			try
+			{
+				uint32_t value = std::stoi(value_str);
+
+				if(property == "optimize") {
+					meta_data.optimize_ = static_cast<bool>(value);
+				} else if(property == "compact_vertices") {
+					meta_data.compact_vertices_ = static_cast<bool>(value);
+				}
+			}
+			catch(...)
+			{
+				LOG_ERROR("Failed to convert mesh meta property", property, "of value", value_str, "to uint32 in meta file", abs_path);
+			}
+		}
+	}
+
 	// Remove the mesh from the meshes list and free the meshes resources
 	// IMPORTANT - Can be called from any thread (TODO)
 	void ResourceManager::RemoveMesh(std::string const & name)
@@ -461,6 +675,29 @@ namespace ose
 						// Add shader to material
 						material->SetShaderProg(shader_prog);
 					}
+					else if(key == "features")
+					{
+						// Comma separated list of the shader features the material uses, replaces the default features
+						uint32_t features { SHADER_FEATURE_NONE };
+						std::stringstream ss { value };
+						std::string feature;
+						while(std::getline(ss, feature, ','))
+						{
+							if(feature == "normal_map")
+								features |= SHADER_FEATURE_NORMAL_MAP;
+							else if(feature == "pbr_maps")
+								features |= SHADER_FEATURE_PBR_MAPS;
+							else if(feature == "point_lights")
+								features |= SHADER_FEATURE_POINT_LIGHTS;
+							else if(feature == "dir_lights")
+								features |= SHADER_FEATURE_DIR_LIGHTS;
+							else if(feature == "alpha_test")
+								features |= SHADER_FEATURE_ALPHA_TEST;
+							else if(!feature.empty())
+								LOG_ERROR("Unknown shader feature", feature, "in material", name_to_use);
+						}
+						material->SetShaderFeatures(features);
+					}
 				}
 			}
 			else
@@ -14,6 +14,7 @@ namespace ose
 
 	class MeshLoader;
 	class Mesh;
+	struct MeshMetaData;
 
 	class Material;
 
@@ -67,13 +68,34 @@ namespace ose
 		// IMPORTANT - can only be called from the thread which contains the render context
 		void CreateTextures();
 
+		// offline step which writes a block compressed container next to each added texture whose meta data requests compression
+		// the next time the texture is added its container is loaded instead of decoding the image, until the image is modified
+		// textures which were loaded from an up to date container, or whose container has already been written, are skipped
+		void CompressTextures();
+
 		// loads a meta file for some texture, meta files map properties to values
 		void LoadTextureMetaFile(std::string const & abs_path, TextureMetaData & meta_data);
 
+		// pack textures into texture atlases s.t. render objects using them can be drawn without rebinding textures
+		// textures are grouped by their filtering settings, each group is packed into its own atlas
+		// textures which are already part of an atlas are ignored
+		// packed textures which no material uses free their own GPU texture, since they are only ever drawn from the atlas
+		// IMPORTANT - can only be called from the thread which contains the render context
+		void CreateTextureAtlases(std::vector<Texture const *> const & textures);
+
+		// free the GPU memory of every texture atlas and remove the textures from them
+		// textures which were only stored in an atlas no longer have a GPU representation, so are created again by CreateTextures
+		// IMPORTANT - can only be called from the thread which contains the render context
+		void DestroyTextureAtlases();
+
 		// Get the tilemap from the resources manager
 		// Given the name of the tilemap, return the tilemap object
 		Tilemap const * GetTilemap(std::string const & name);
 
+		// Get a tilemap which can be edited at runtime, e.g. by scripts calling Tilemap::SetTile
+		// Tile renderers using the tilemap update the edited tiles the next time they are drawn
+		Tilemap * GetTilemapMutable(std::string const & name);
+
 		// Adds the tilemap at path to the list of active tilemaps, the tilemap must be in the project's resources directory
 		// Path is relative to ProjectPath/Resources
 		// If no name is given, the relative path will be used
@@ -98,6 +120,9 @@ namespace ose
 		// IMPORTANT - Can be called from any thread (TODO)
 		void RemoveMesh(std::string const & name);
 
+		// loads a meta file for some mesh, meta files map properties to values
+		void LoadMeshMetaFile(std::string const & abs_path, MeshMetaData & meta_data);
+
 		// Get the material from the resource manager
 		// Given the name of the material, return the material object
 		Material const * GetMaterial(std::string const & name);
@@ -157,6 +182,16 @@ namespace ose
 		// the TextureLoader object used for loading textures from image files
 		uptr<TextureLoader> texture_loader_;
 
+		// all texture atlases created in GPU memory
+		std::vector<uptr<TextureAtlas>> texture_atlases_;
+
+		// names of the packed textures whose own GPU texture was freed, they are only stored in an atlas
+		std::vector<std::string> atlas_only_textures_;
+
+		// the width and height of each layer of a texture atlas, and the padding between textures in the atlas
+		static constexpr int32_t TEXTURE_ATLAS_LAYER_SIZE { 2048 };
+		static constexpr int32_t TEXTURE_ATLAS_PADDING { 4 };
+
 		// Maps tilemap name to tilemap object
 		std::map<std::string, uptr<Tilemap>> tilemaps_;
 
@@ -0,0 +1,328 @@
+#include "stdafx.h"
+#include "BlockCompression.h"
+#include <cfloat>
+
+namespace ose
+{
+	namespace
+	{
+		// Quantise an 8-bit RGB colour to RGB565, rounding to the nearest representable value
+		uint16_t PackRGB565(float r, float g, float b)
+		{
+			uint32_t r5 { static_cast<uint32_t>(std::clamp(r, 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f) };
+			uint32_t g6 { static_cast<uint32_t>(std::clamp(g, 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f) };
+			uint32_t b5 { static_cast<uint32_t>(std::clamp(b, 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f) };
+			return static_cast<uint16_t>((r5 << 11) | (g6 << 5) | b5);
+		}
+
+		// Expand an RGB565 colour to 8 bits per channel by replicating the high bits into the low bits
+		void UnpackRGB565(uint16_t c, uint8_t * rgb)
+		{
+			uint32_t r5 { (c >> 11) & 31u };
+			uint32_t g6 { (c >> 5) & 63u };
+			uint32_t b5 { c & 31u };
+			rgb[0] = static_cast<uint8_t>((r5 << 3) | (r5 >> 2));
+			rgb[1] = static_cast<uint8_t>((g6 << 2) | (g6 >> 4));
+			rgb[2] = static_cast<uint8_t>((b5 << 3) | (b5 >> 2));
+		}
+
+		uint16_t ReadUint16(uint8_t const * p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+
+		void WriteUint16(uint8_t * p, uint16_t v) { p[0] = static_cast<uint8_t>(v); p[1] = static_cast<uint8_t>(v >> 8); }
+	}
+
+	// Get the number of bytes of each 4x4 block, 0 if the format is not block compressed
+	size_t BlockCompression::GetBlockSize(ETextureCompression format)
+	{
+		switch(format)
+		{
+		case ETextureCompression::BC1:
+			return 8;
+		case ETextureCompression::BC3:
+			return 16;
+		default:
+			return 0;
+		}
+	}
+
+	// Get the number of bytes of an image once compressed
+	size_t BlockCompression::GetCompressedSize(ETextureCompression format, int32_t width, int32_t height)
+	{
+		size_t blocks_x { static_cast<size_t>((width + 3) / 4) };
+		size_t blocks_y { static_cast<size_t>((height + 3) / 4) };
+		return blocks_x * blocks_y * GetBlockSize(format);
+	}
+
+	// Encode an RGB (channels = 3) or RGBA (channels = 4) image, blocks are appended to out
+	void BlockCompression::Encode(ETextureCompression format, unsigned char const * img_data, int32_t width, int32_t height, int32_t channels,
+		std::vector<uint8_t> & out)
+	{
+		size_t block_size { GetBlockSize(format) };
+		if(block_size == 0 || img_data == nullptr || width <= 0 || height <= 0 || channels < 3)
+			return;
+
+		size_t offset { out.size() };
+		out.resize(offset + GetCompressedSize(format, width, height));
+		uint8_t * block { out.data() + offset };
+
+		uint8_t texels[16][4];
+		for(int32_t by = 0; by < height; by += 4)
+		{
+			for(int32_t bx = 0; bx < width; bx += 4)
+			{
+				// Gather the block's texels, repeating the image's last row/column past its edge
+				for(int32_t t = 0; t < 16; ++t)
+				{
+					int32_t x { std::min(bx + (t & 3), width - 1) };
+					int32_t y { std::min(by + (t >> 2), height - 1) };
+					unsigned char const * texel { img_data + (static_cast<size_t>(y) * width + x) * channels };
+					texels[t][0] = texel[0];
+					texels[t][1] = texel[1];
+					texels[t][2] = texel[2];
+					texels[t][3] = channels == 4 ? texel[3] : 255;
+				}
+
+				if(format == ETextureCompression::BC3)
+				{
+					EncodeAlphaBlock(texels, block);
+					EncodeColorBlock(texels, block + 8);
+				}
+				else
+				{
+					EncodeColorBlock(texels, block);
+				}
+				block += block_size;
+			}
+		}
+	}
+
+	// Decode a block compressed image into RGBA, out is resized to width * height * 4 bytes
+	void BlockCompression::Decode(ETextureCompression format, uint8_t const * blocks, int32_t width, int32_t height, std::vector<unsigned char> & out)
+	{
+		size_t block_size { GetBlockSize(format) };
+		out.resize(static_cast<size_t>(std::max(width, 0)) * std::max(height, 0) * 4);
+		if(block_size == 0 || blocks == nullptr)
+			return;
+
+		uint8_t texels[16][4];
+		for(int32_t by = 0; by < height; by += 4)
+		{
+			for(int32_t bx = 0; bx < width; bx += 4)
+			{
+				if(format == ETextureCompression::BC3)
+				{
+					DecodeColorBlock(blocks + 8, true, texels);
+					DecodeAlphaBlock(blocks, texels);
+				}
+				else
+				{
+					DecodeColorBlock(blocks, false, texels);
+				}
+				blocks += block_size;
+
+				// Texels past the edge of the image are discarded
+				for(int32_t t = 0; t < 16; ++t)
+				{
+					int32_t x { bx + (t & 3) };
+					int32_t y { by + (t >> 2) };
+					if(x < width && y < height)
+						std::memcpy(&out[(static_cast<size_t>(y) * width + x) * 4], texels[t], 4);
+				}
+			}
+		}
+	}
+
+	// Encode the RGB of 16 RGBA texels as a BC1 colour block
+	void BlockCompression::EncodeColorBlock(uint8_t const (& texels)[16][4], uint8_t * block)
+	{
+		// Find the mean and covariance of the texel colours
+		glm::vec3 mean { 0.0f };
+		for(auto const & texel : texels)
+			mean += glm::vec3(texel[0], texel[1], texel[2]);
+		mean /= 16.0f;
+
+		glm::mat3 covariance { 0.0f };
+		for(auto const & texel : texels)
+		{
+			glm::vec3 d { glm::vec3(texel[0], texel[1], texel[2]) - mean };
+			covariance += glm::outerProduct(d, d);
+		}
+
+		// The endpoints lie on the principal axis of the colours, found by power iteration
+		// Iteration starts from the covariance column of the channel with the largest variance, which unlike a fixed
+		// start such as (1, 1, 1) cannot be orthogonal to the principal axis unless the colours are flat
+		int32_t largest { 0 };
+		for(int32_t c = 1; c < 3; ++c)
+		{
+			if(covariance[c][c] > covariance[largest][largest])
+				largest = c;
+		}
+		glm::vec3 axis { covariance[largest] };
+		if(glm::length(axis) < 1e-6f)
+			axis = glm::vec3(1.0f, 1.0f, 1.0f);
+		for(int32_t i = 0; i < 8; ++i)
+		{
+			glm::vec3 next { covariance * axis };
+			float length { glm::length(next) };
+			if(length < 1e-6f)
+				break;
+			axis = next / length;
+		}
+		axis = glm::normalize(axis);
+
+		// The extreme projections onto the axis become the endpoints
+		float min_t { FLT_MAX };
+		float max_t { -FLT_MAX };
+		for(auto const & texel : texels)
+		{
+			float t { glm::dot(glm::vec3(texel[0], texel[1], texel[2]) - mean, axis) };
+			min_t = std::min(min_t, t);
+			max_t = std::max(max_t, t);
+		}
+		glm::vec3 e0 { mean + axis * max_t };
+		glm::vec3 e1 { mean + axis * min_t };
+		uint16_t c0 { PackRGB565(e0.r, e0.g, e0.b) };
+		uint16_t c1 { PackRGB565(e1.r, e1.g, e1.b) };
+
+		// c0 > c1 selects four colour mode, equal endpoints (a flat block) only need index 0
+		if(c0 < c1)
+			std::swap(c0, c1);
+		WriteUint16(block, c0);
+		WriteUint16(block + 2, c1);
+
+		uint32_t indices { 0 };
+		if(c0 != c1)
+		{
+			uint8_t palette[4][4];
+			GetPalette(c0, c1, true, palette);
+			for(int32_t t = 0; t < 16; ++t)
+			{
+				// Choose the palette colour nearest to the texel
+				uint32_t best { 0 };
+				int32_t best_error { INT32_MAX };
+				for(uint32_t p = 0; p < 4; ++p)
+				{
+					int32_t dr { texels[t][0] - palette[p][0] };
+					int32_t dg { texels[t][1] - palette[p][1] };
+					int32_t db { texels[t][2] - palette[p][2] };
+					int32_t error { dr * dr + dg * dg + db * db };
+					if(error < best_error)
+					{
+						best_error = error;
+						best = p;
+					}
+				}
+				indices |= best << (2 * t);
+			}
+		}
+		block[4] = static_cast<uint8_t>(indices);
+		block[5] = static_cast<uint8_t>(indices >> 8);
+		block[6] = static_cast<uint8_t>(indices >> 16);
+		block[7] = static_cast<uint8_t>(indices >> 24);
+	}
+
+	// Encode the alpha of 16 RGBA texels as a BC3 alpha block
+	void BlockCompression::EncodeAlphaBlock(uint8_t const (& texels)[16][4], uint8_t * block)
+	{
+		uint8_t a0 { 0 };
+		uint8_t a1 { 255 };
+		for(auto const & texel : texels)
+		{
+			a0 = std::max(a0, texel[3]);
+			a1 = std::min(a1, texel[3]);
+		}
+		block[0] = a0;
+		block[1] = a1;
+
+		// a0 > a1 selects eight value mode, equal endpoints (a flat block) only need index 0
+		uint64_t indices { 0 };
+		if(a0 != a1)
+		{
+			// Index 0 is a0, index 1 is a1, indices 2-7 are interpolated from a0 towards a1
+			int32_t values[8] { a0, a1 };
+			for(int32_t i = 1; i < 7; ++i)
+				values[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+
+			for(int32_t t = 0; t < 16; ++t)
+			{
+				uint64_t best { 0 };
+				int32_t best_error { INT32_MAX };
+				for(uint64_t v = 0; v < 8; ++v)
+				{
+					int32_t error { std::abs(texels[t][3] - values[v]) };
+					if(error < best_error)
+					{
+						best_error = error;
+						best = v;
+					}
+				}
+				indices |= best << (3 * t);
+			}
+		}
+		for(int32_t i = 0; i < 6; ++i)
+			block[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+	}
+
+	// Decode a BC1 colour block into the RGB of 16 RGBA texels
+	void BlockCompression::DecodeColorBlock(uint8_t const * block, bool four_color_only, uint8_t (& texels)[16][4])
+	{
+		uint8_t palette[4][4];
+		GetPalette(ReadUint16(block), ReadUint16(block + 2), four_color_only, palette);
+		uint32_t indices { block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24) };
+		for(int32_t t = 0; t < 16; ++t)
+			std::memcpy(texels[t], palette[(indices >> (2 * t)) & 3u], 4);
+	}
+
+	// Decode a BC3 alpha block into the alpha of 16 RGBA texels
+	void BlockCompression::DecodeAlphaBlock(uint8_t const * block, uint8_t (& texels)[16][4])
+	{
+		int32_t a0 { block[0] };
+		int32_t a1 { block[1] };
+		int32_t values[8] { a0, a1 };
+		if(a0 > a1)
+		{
+			for(int32_t i = 1; i < 7; ++i)
+				values[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+		}
+		else
+		{
+			// Six interpolated values followed by fully transparent and fully opaque
+			for(int32_t i = 1; i < 5; ++i)
+				values[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+			values[6] = 0;
+			values[7] = 255;
+		}
+
+		uint64_t indices { 0 };
+		for(int32_t i = 0; i < 6; ++i)
+			indices |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+		for(int32_t t = 0; t < 16; ++t)
+			texels[t][3] = static_cast<uint8_t>(values[(indices >> (3 * t)) & 7u]);
+	}
+
+	// Get the four colours of a colour block's palette from its RGB565 endpoints
+	void BlockCompression::GetPalette(uint16_t c0, uint16_t c1, bool four_color_only, uint8_t (& palette)[4][4])
+	{
+		UnpackRGB565(c0, palette[0]);
+		UnpackRGB565(c1, palette[1]);
+		palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+		if(four_color_only || c0 > c1)
+		{
+			for(int32_t c = 0; c < 3; ++c)
+			{
+				palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c]) / 3);
+				palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c]) / 3);
+			}
+		}
+		else
+		{
+			// Three colour mode, the fourth colour is transparent black
+			for(int32_t c = 0; c < 3; ++c)
+			{
+				palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c]) / 2);
+				palette[3][c] = 0;
+			}
+			palette[3][3] = 0;
+		}
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "ETextureCompression.h"
+
+namespace ose
+{
+	// CPU encoder and decoder of the BC1 and BC3 block compressed formats
+	// Images are encoded in 4x4 texel blocks, images whose size is not a multiple of 4 repeat their edge texels
+	class BlockCompression
+	{
+	public:
+		// Get the number of bytes of each 4x4 block, 0 if the format is not block compressed
+		static size_t GetBlockSize(ETextureCompression format);
+
+		// Get the number of bytes of an image once compressed
+		static size_t GetCompressedSize(ETextureCompression format, int32_t width, int32_t height);
+
+		// Encode an RGB (channels = 3) or RGBA (channels = 4) image, blocks are appended to out
+		// BC1 ignores alpha, BC3 treats RGB images as opaque
+		static void Encode(ETextureCompression format, unsigned char const * img_data, int32_t width, int32_t height, int32_t channels,
+			std::vector<uint8_t> & out);
+
+		// Decode a block compressed image into RGBA, out is resized to width * height * 4 bytes
+		static void Decode(ETextureCompression format, uint8_t const * blocks, int32_t width, int32_t height, std::vector<unsigned char> & out);
+
+	private:
+		// Encode the RGB of 16 RGBA texels as a BC1 colour block
+		static void EncodeColorBlock(uint8_t const (& texels)[16][4], uint8_t * block);
+
+		// Encode the alpha of 16 RGBA texels as a BC3 alpha block
+		static void EncodeAlphaBlock(uint8_t const (& texels)[16][4], uint8_t * block);
+
+		// Decode a BC1 colour block into the RGB of 16 RGBA texels
+		// BC3 colour blocks are always decoded in four colour mode
+		static void DecodeColorBlock(uint8_t const * block, bool four_color_only, uint8_t (& texels)[16][4]);
+
+		// Decode a BC3 alpha block into the alpha of 16 RGBA texels
+		static void DecodeAlphaBlock(uint8_t const * block, uint8_t (& texels)[16][4]);
+
+		// Get the four colours of a colour block's palette from its RGB565 endpoints
+		static void GetPalette(uint16_t c0, uint16_t c1, bool four_color_only, uint8_t (& palette)[4][4]);
+	};
+}
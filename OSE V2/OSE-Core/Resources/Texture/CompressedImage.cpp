@@ -0,0 +1,98 @@
+#include "stdafx.h"
+#include "CompressedImage.h"
+#include "BlockCompression.h"
+#include "Texture.h"
+
+namespace ose
+{
+	// Encode an RGB or RGBA image, with every level of its mip chain if mip_mapped is true
+	CompressedImage CompressedImage::Encode(unsigned char const * img_data, int32_t width, int32_t height, int32_t channels,
+		ETextureCompression format, bool mip_mapped)
+	{
+		CompressedImage image;
+		image.format_ = format;
+		image.width_ = width;
+		image.height_ = height;
+		if(img_data == nullptr || width <= 0 || height <= 0)
+			return image;
+
+		image.levels_.emplace_back();
+		BlockCompression::Encode(format, img_data, width, height, channels, image.levels_.back());
+
+		// Each level is downsampled from the uncompressed level above s.t. compression errors don't accumulate
+		std::vector<unsigned char> level_data;
+		std::vector<unsigned char> next_level_data;
+		unsigned char const * src { img_data };
+		int32_t level_width { width };
+		int32_t level_height { height };
+		while(mip_mapped && (level_width > 1 || level_height > 1))
+		{
+			Texture::DownsampleImage(src, level_width, level_height, channels, next_level_data);
+			level_data.swap(next_level_data);
+			src = level_data.data();
+			level_width = std::max(1, level_width / 2);
+			level_height = std::max(1, level_height / 2);
+
+			image.levels_.emplace_back();
+			BlockCompression::Encode(format, src, level_width, level_height, channels, image.levels_.back());
+		}
+		return image;
+	}
+
+	// Write the image to a container file, returns false if the file could not be written
+	bool CompressedImage::Write(std::string const & path) const
+	{
+		std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if(!out)
+			return false;
+
+		ContainerHeader header { CONTAINER_MAGIC, CONTAINER_VERSION, static_cast<uint32_t>(format_), width_, height_, static_cast<uint32_t>(levels_.size()) };
+		out.write(reinterpret_cast<char const *>(&header), sizeof(header));
+		for(auto const & level : levels_)
+		{
+			uint32_t size { static_cast<uint32_t>(level.size()) };
+			out.write(reinterpret_cast<char const *>(&size), sizeof(size));
+		}
+		for(auto const & level : levels_)
+			out.write(reinterpret_cast<char const *>(level.data()), level.size());
+		return static_cast<bool>(out);
+	}
+
+	// Read the image from a container file, returns false if the file could not be read or is not a valid container
+	bool CompressedImage::Read(std::string const & path)
+	{
+		std::ifstream in(path, std::ios::in | std::ios::binary);
+		if(!in)
+			return false;
+
+		ContainerHeader header;
+		if(!in.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic_ != CONTAINER_MAGIC || header.version_ != CONTAINER_VERSION)
+			return false;
+
+		ETextureCompression format { static_cast<ETextureCompression>(header.format_) };
+		if(BlockCompression::GetBlockSize(format) == 0 || header.width_ <= 0 || header.height_ <= 0 || header.num_levels_ == 0 || header.num_levels_ > 32)
+			return false;
+
+		// Each level must be exactly the size of its blocks, s.t. a truncated or corrupt file is never uploaded
+		std::vector<uint32_t> sizes(header.num_levels_);
+		if(!in.read(reinterpret_cast<char *>(sizes.data()), sizes.size() * sizeof(uint32_t)))
+			return false;
+		std::vector<std::vector<uint8_t>> levels(header.num_levels_);
+		for(uint32_t level = 0; level < header.num_levels_; ++level)
+		{
+			int32_t level_width { std::max(1, header.width_ >> level) };
+			int32_t level_height { std::max(1, header.height_ >> level) };
+			if(sizes[level] != BlockCompression::GetCompressedSize(format, level_width, level_height))
+				return false;
+			levels[level].resize(sizes[level]);
+			if(!in.read(reinterpret_cast<char *>(levels[level].data()), sizes[level]))
+				return false;
+		}
+
+		format_ = format;
+		width_ = header.width_;
+		height_ = header.height_;
+		levels_ = std::move(levels);
+		return true;
+	}
+}
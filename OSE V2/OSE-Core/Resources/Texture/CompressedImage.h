@@ -0,0 +1,46 @@
+#pragma once
+#include "ETextureCompression.h"
+
+namespace ose
+{
+	// A block compressed image and its pre-built mip chain, loaded from a texture container (.otex) file
+	// Containers are written offline by ResourceManager::CompressTextures s.t. textures can be uploaded without decoding
+	// Layout (little-endian): ContainerHeader, a uint32 byte size for each level, then the data of each level, finest first
+	struct CompressedImage
+	{
+		// Identifies a texture container file and the layout of its header
+		static constexpr uint32_t CONTAINER_MAGIC { 0x5845544F };
+		static constexpr uint32_t CONTAINER_VERSION { 1 };
+
+		// Extension appended to the path of the source image to get the path of its container
+		static constexpr char const * CONTAINER_EXTENSION { ".otex" };
+
+		ETextureCompression format_ { ETextureCompression::NONE };
+		int32_t width_ { 0 };
+		int32_t height_ { 0 };
+
+		// Blocks of each level of the mip chain, level 0 is the full size image
+		std::vector<std::vector<uint8_t>> levels_;
+
+		// Encode an RGB or RGBA image, with every level of its mip chain if mip_mapped is true
+		static CompressedImage Encode(unsigned char const * img_data, int32_t width, int32_t height, int32_t channels,
+			ETextureCompression format, bool mip_mapped);
+
+		// Write the image to a container file, returns false if the file could not be written
+		bool Write(std::string const & path) const;
+
+		// Read the image from a container file, returns false if the file could not be read or is not a valid container
+		bool Read(std::string const & path);
+
+	private:
+		struct ContainerHeader
+		{
+			uint32_t magic_;
+			uint32_t version_;
+			uint32_t format_;
+			int32_t width_;
+			int32_t height_;
+			uint32_t num_levels_;
+		};
+	};
+}
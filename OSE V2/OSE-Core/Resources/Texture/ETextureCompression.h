@@ -0,0 +1,15 @@
+#pragma once
+
+namespace ose
+{
+	// Block compressed formats textures can be transcoded to, values are stored in texture meta files and containers
+	enum class ETextureCompression : uint32_t
+	{
+		// RGB(A)8, uncompressed
+		NONE = 0,
+		// 4x4 blocks of two RGB565 endpoints and 2-bit indices (8 bytes per block), opaque textures only
+		BC1 = 1,
+		// BC1 colour block preceded by an alpha block of two 8-bit endpoints and 3-bit indices (16 bytes per block)
+		BC3 = 3
+	};
+}
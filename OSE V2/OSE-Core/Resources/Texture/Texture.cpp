@@ -9,4 +9,40 @@ namespace ose
 	{
 		// this object did not allocate memory for img_data_, therefore, this object will not free it
 	}
+
+	// Set the block compressed image loaded from the texture's container, also sets the texture's size
+	void Texture::SetCompressedImage(CompressedImage && image)
+	{
+		width_ = image.width_;
+		height_ = image.height_;
+		channels_ = image.format_ == ETextureCompression::BC1 ? 3 : 4;
+		compressed_image_ = ose::make_unique<CompressedImage>(std::move(image));
+	}
+
+	// Halve an image by averaging 2x2 blocks of texels, used to build mip chains
+	// dst is resized to max(1, width / 2) * max(1, height / 2) texels
+	void Texture::DownsampleImage(unsigned char const * src, int32_t width, int32_t height, int32_t channels, std::vector<unsigned char> & dst)
+	{
+		int32_t dst_width { std::max(1, width / 2) };
+		int32_t dst_height { std::max(1, height / 2) };
+		dst.resize(static_cast<size_t>(dst_width) * dst_height * channels);
+
+		for(int32_t y = 0; y < dst_height; ++y)
+		{
+			// Once one dimension reaches 1 texel its single row/column is averaged with itself
+			int32_t y0 { std::min(2 * y, height - 1) };
+			int32_t y1 { std::min(2 * y + 1, height - 1) };
+			for(int32_t x = 0; x < dst_width; ++x)
+			{
+				int32_t x0 { std::min(2 * x, width - 1) };
+				int32_t x1 { std::min(2 * x + 1, width - 1) };
+				for(int32_t c = 0; c < channels; ++c)
+				{
+					uint32_t sum { static_cast<uint32_t>(src[(static_cast<size_t>(y0) * width + x0) * channels + c]) + src[(static_cast<size_t>(y0) * width + x1) * channels + c]
+						+ src[(static_cast<size_t>(y1) * width + x0) * channels + c] + src[(static_cast<size_t>(y1) * width + x1) * channels + c] };
+					dst[(static_cast<size_t>(y) * dst_width + x) * channels + c] = static_cast<unsigned char>((sum + 2) / 4);
+				}
+			}
+		}
+	}
 }
@@ -2,9 +2,13 @@
 
 #include "OSE-Core/Rendering/ETextureFilterMode.h"
 #include "TextureMetaData.h"
+#include "TextureAtlasRegion.h"
+#include "CompressedImage.h"
 
 namespace ose
 {
+	class TextureAtlas;
+
 	// for convenience
 	typedef unsigned char * IMGDATA;
 
@@ -61,6 +65,28 @@ namespace ose
 		//set all meta data in one go
 		void SetMetaData(TextureMetaData const & meta_data) { meta_data_ = meta_data; }
 
+		ETextureCompression GetCompression() const { return meta_data_.compression_; }
+
+		// Get the block compressed image loaded from the texture's container, nullptr if the texture was loaded uncompressed
+		// Compressed textures have no uncompressed image data, so are decoded when packed into texture atlases
+		CompressedImage const * GetCompressedImage() const { return compressed_image_.get(); }
+
+		// Set the block compressed image loaded from the texture's container, also sets the texture's size
+		void SetCompressedImage(CompressedImage && image);
+
+		// Halve an image by averaging 2x2 blocks of texels, used to build mip chains
+		// dst is resized to max(1, width / 2) * max(1, height / 2) texels
+		static void DownsampleImage(unsigned char const * src, int32_t width, int32_t height, int32_t channels, std::vector<unsigned char> & dst);
+
+		// Get the atlas the texture has been packed into, nullptr if the texture is not part of an atlas
+		TextureAtlas const * GetAtlas() const { return atlas_; }
+
+		// Get the region of the atlas the texture has been packed into
+		TextureAtlasRegion const & GetAtlasRegion() const { return atlas_region_; }
+
+		// Set the atlas the texture has been packed into
+		void SetAtlas(TextureAtlas const * atlas, TextureAtlasRegion const & region) { atlas_ = atlas; atlas_region_ = region; }
+
 	protected:
 		std::string name_;
 		std::string path_;
@@ -71,5 +97,12 @@ namespace ose
 
 		//meta data stored in a separate object for easier (and probably quicker) loading
 		TextureMetaData meta_data_;
+
+		// Block compressed image and mip chain, nullptr unless the texture was loaded from a container
+		uptr<CompressedImage> compressed_image_;
+
+		// The atlas the texture has been packed into (if any) and the region it occupies
+		TextureAtlas const * atlas_ { nullptr };
+		TextureAtlasRegion atlas_region_;
 	};
 }
@@ -0,0 +1,208 @@
+#include "stdafx.h"
+#include "TextureAtlas.h"
+#include "Texture.h"
+#include "BlockCompression.h"
+
+namespace ose
+{
+	TextureAtlas::TextureAtlas(int32_t layer_width, int32_t layer_height, int32_t padding)
+		: layer_width_(layer_width), layer_height_(layer_height), padding_(padding) {}
+
+	TextureAtlas::~TextureAtlas() {}
+
+	// Add a texture to be packed into the atlas, the texture's image data (or block compressed image) must still be loaded
+	// Returns false if the texture can never fit in a layer of the atlas
+	bool TextureAtlas::AddTexture(Texture const * texture)
+	{
+		if(texture == nullptr)
+			return false;
+		CompressedImage const * compressed { texture->GetCompressedImage() };
+		if(texture->GetImgData() == nullptr && (compressed == nullptr || compressed->levels_.empty()))
+			return false;
+		if(texture->GetWidth() + 2 * padding_ > layer_width_ || texture->GetHeight() + 2 * padding_ > layer_height_)
+			return false;
+		if(texture_indices_.find(texture) != texture_indices_.end())
+			return true;
+
+		// The atlas is filtered in the same way as the first texture added
+		if(textures_.empty())
+		{
+			meta_data_.mag_filter_mode_ = texture->GetMagFilterMode();
+			meta_data_.min_filter_mode_ = texture->GetMinFilterMode();
+			meta_data_.mip_mapping_enabled_ = texture->IsMipMappingEnabled();
+		}
+
+		texture_indices_.emplace(texture, textures_.size());
+		textures_.push_back(texture);
+		return true;
+	}
+
+	// Pack the added textures into as few layers as possible and build the atlas image data
+	// Must be called before the atlas is created in GPU memory
+	void TextureAtlas::Pack()
+	{
+		// Textures are packed into rows (shelves), the tallest textures are packed first s.t. shelves waste as little height as possible
+		struct Shelf
+		{
+			int32_t layer_;
+			int32_t y_;
+			int32_t height_;
+			int32_t x_;
+		};
+		std::vector<Shelf> shelves;
+		std::vector<int32_t> layer_heights;
+
+		// Padded sizes are rounded up to a multiple of the padding s.t. every texture starts on a mip block boundary
+		auto padded_size = [this](int32_t size) -> int32_t {
+			int32_t padded { size + 2 * padding_ };
+			if(padding_ > 0 && padded % padding_ != 0)
+				padded += padding_ - padded % padding_;
+			return std::min(padded, std::max(layer_width_, layer_height_));
+		};
+
+		std::vector<size_t> order(textures_.size());
+		for(size_t i = 0; i < order.size(); ++i)
+			order[i] = i;
+		std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+			if(textures_[a]->GetHeight() != textures_[b]->GetHeight())
+				return textures_[a]->GetHeight() > textures_[b]->GetHeight();
+			return textures_[a]->GetWidth() > textures_[b]->GetWidth();
+		});
+
+		// Layer and pixel position of the padded rect of each texture
+		std::vector<glm::ivec3> positions(textures_.size());
+		for(size_t i : order)
+		{
+			int32_t w { std::min(padded_size(textures_[i]->GetWidth()), layer_width_) };
+			int32_t h { std::min(padded_size(textures_[i]->GetHeight()), layer_height_) };
+
+			// Find the shelf with the least wasted height which has space for the texture
+			Shelf * best { nullptr };
+			for(auto & shelf : shelves)
+			{
+				if(shelf.height_ >= h && shelf.x_ + w <= layer_width_ && (!best || shelf.height_ < best->height_))
+					best = &shelf;
+			}
+
+			// If no shelf has space, open a new shelf in the first layer with enough remaining height
+			if(!best)
+			{
+				int32_t layer { -1 };
+				for(int32_t l = 0; l < static_cast<int32_t>(layer_heights.size()); ++l)
+				{
+					if(layer_heights[l] + h <= layer_height_)
+					{
+						layer = l;
+						break;
+					}
+				}
+				if(layer < 0)
+				{
+					layer = static_cast<int32_t>(layer_heights.size());
+					layer_heights.push_back(0);
+				}
+				shelves.push_back({ layer, layer_heights[layer], h, 0 });
+				layer_heights[layer] += h;
+				best = &shelves.back();
+			}
+
+			positions[i] = { best->layer_, best->x_, best->y_ };
+			best->x_ += w;
+		}
+
+		// Build the image data of every layer and the region of each texture
+		num_layers_ = static_cast<int32_t>(layer_heights.size());
+		img_data_.assign(static_cast<size_t>(layer_width_) * layer_height_ * 4 * num_layers_, 0);
+		regions_.resize(textures_.size());
+		for(size_t i = 0; i < textures_.size(); ++i)
+		{
+			int32_t x { positions[i].y + padding_ };
+			int32_t y { positions[i].z + padding_ };
+			CopyTexture(*textures_[i], positions[i].x, x, y);
+
+			regions_[i].layer_ = positions[i].x;
+			regions_[i].uv_rect_ = {
+				static_cast<float>(x) / layer_width_,
+				static_cast<float>(y) / layer_height_,
+				static_cast<float>(textures_[i]->GetWidth()) / layer_width_,
+				static_cast<float>(textures_[i]->GetHeight()) / layer_height_
+			};
+		}
+
+		DEBUG_LOG("Packed", textures_.size(), "textures into", num_layers_, "atlas layers");
+	}
+
+	// Get the region of the atlas occupied by a texture, nullptr if the texture is not in the atlas
+	TextureAtlasRegion const * TextureAtlas::GetRegion(Texture const * texture) const
+	{
+		auto iter { texture_indices_.find(texture) };
+		if(iter == texture_indices_.end() || iter->second >= regions_.size())
+			return nullptr;
+		return &regions_[iter->second];
+	}
+
+	// Get the highest mip level which does not blend neighbouring textures, i.e. log2(padding)
+	// Returns -1 if there is no limit (the atlas is unpadded so each layer must hold a single texture)
+	int32_t TextureAtlas::GetMaxSafeMipLevel() const
+	{
+		if(padding_ <= 0)
+			return -1;
+		int32_t level { 0 };
+		while((2 << level) <= padding_)
+			++level;
+		return level;
+	}
+
+	// Copy a texture's image data into the atlas at pixel (x, y) of a layer, extruding its border into the padding
+	// Block compressed textures have no uncompressed image data, so their full size level is decoded to RGBA first
+	void TextureAtlas::CopyTexture(Texture const & texture, int32_t layer, int32_t x, int32_t y)
+	{
+		int32_t w { texture.GetWidth() };
+		int32_t h { texture.GetHeight() };
+		int32_t channels { texture.GetNumChannels() };
+		unsigned char const * src { texture.GetImgData() };
+		std::vector<unsigned char> decoded;
+		if(src == nullptr)
+		{
+			CompressedImage const * compressed { texture.GetCompressedImage() };
+			BlockCompression::Decode(compressed->format_, compressed->levels_[0].data(), w, h, decoded);
+			src = decoded.data();
+			channels = 4;
+		}
+		unsigned char * dst_layer { img_data_.data() + static_cast<size_t>(layer) * layer_width_ * layer_height_ * 4 };
+
+		for(int32_t py = -padding_; py < h + padding_; ++py)
+		{
+			int32_t dy { y + py };
+			if(dy < 0 || dy >= layer_height_)
+				continue;
+			int32_t sy { std::clamp(py, 0, h - 1) };
+
+			for(int32_t px = -padding_; px < w + padding_; ++px)
+			{
+				int32_t dx { x + px };
+				if(dx < 0 || dx >= layer_width_)
+					continue;
+				int32_t sx { std::clamp(px, 0, w - 1) };
+
+				unsigned char const * s { src + (static_cast<size_t>(sy) * w + sx) * channels };
+				unsigned char * d { dst_layer + (static_cast<size_t>(dy) * layer_width_ + dx) * 4 };
+				switch(channels)
+				{
+				case 4:
+					d[0] = s[0]; d[1] = s[1]; d[2] = s[2]; d[3] = s[3];
+					break;
+				case 3:
+					d[0] = s[0]; d[1] = s[1]; d[2] = s[2]; d[3] = 255;
+					break;
+				case 2:
+					d[0] = d[1] = d[2] = s[0]; d[3] = s[1];
+					break;
+				default:
+					d[0] = d[1] = d[2] = s[0]; d[3] = 255;
+					break;
+				}
+			}
+		}
+	}
+}
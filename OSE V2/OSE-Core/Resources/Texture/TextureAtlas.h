@@ -0,0 +1,84 @@
+#pragma once
+
+#include "OSE-Core/Rendering/ETextureFilterMode.h"
+#include "TextureAtlasRegion.h"
+#include "TextureMetaData.h"
+
+namespace ose
+{
+	class Texture;
+
+	// A texture atlas packs many textures into the layers of a texture array s.t. they can be drawn without rebinding textures
+	// Packing is done on the CPU, the full class will contain render library specific data
+	class TextureAtlas
+	{
+	protected:
+		// TextureAtlas is an abstract class, the full class will contain render library specific data
+		// Each packed texture is surrounded by padding pixels on every side, filled by extruding the texture's border pixels
+		TextureAtlas(int32_t layer_width, int32_t layer_height, int32_t padding);
+	public:
+		virtual ~TextureAtlas();
+		// copying is not allowed
+		TextureAtlas(TextureAtlas &) = delete;
+		TextureAtlas & operator=(TextureAtlas &) = delete;
+		// moving is allowed
+		TextureAtlas(TextureAtlas &&) noexcept = default;
+		TextureAtlas & operator=(TextureAtlas &&) noexcept = default;
+
+		// Add a texture to be packed into the atlas, the texture's image data (or block compressed image) must still be loaded
+		// Returns false if the texture can never fit in a layer of the atlas
+		bool AddTexture(Texture const * texture);
+
+		// Pack the added textures into as few layers as possible and build the atlas image data
+		// Must be called before the atlas is created in GPU memory
+		void Pack();
+
+		// The atlas can be created in the GPU memory
+		virtual void CreateTextureAtlas() = 0;
+
+		// The atlas can be freed from the GPU memory
+		virtual void DestroyTextureAtlas() = 0;
+
+		// Get the region of the atlas occupied by a texture, nullptr if the texture is not in the atlas
+		TextureAtlasRegion const * GetRegion(Texture const * texture) const;
+
+		int32_t GetLayerWidth() const { return layer_width_; }
+		int32_t GetLayerHeight() const { return layer_height_; }
+		int32_t GetNumLayers() const { return num_layers_; }
+		int32_t GetPadding() const { return padding_; }
+
+		// Get the highest mip level which does not blend neighbouring textures, i.e. log2(padding)
+		// Returns -1 if there is no limit (the atlas is unpadded so each layer must hold a single texture)
+		int32_t GetMaxSafeMipLevel() const;
+
+		// Get the RGBA image data of every layer, stored one layer after another
+		std::vector<unsigned char> const & GetImgData() const { return img_data_; }
+
+		// The atlas uses the meta data of the first texture added
+		// Callers should only pack textures with matching filtering into the same atlas
+		TextureMetaData const & GetMetaData() const { return meta_data_; }
+
+	protected:
+		int32_t layer_width_;
+		int32_t layer_height_;
+		int32_t padding_;
+		int32_t num_layers_ { 0 };
+
+		// The textures to be packed and the region each is packed into (same indices)
+		std::vector<Texture const *> textures_;
+		std::vector<TextureAtlasRegion> regions_;
+
+		// Maps a texture to its index in textures_
+		std::unordered_map<Texture const *, size_t> texture_indices_;
+
+		// RGBA image data of every layer
+		std::vector<unsigned char> img_data_;
+
+		TextureMetaData meta_data_;
+
+	private:
+		// Copy a texture's image data into the atlas at pixel (x, y) of a layer, extruding its border into the padding
+		// Block compressed textures have no uncompressed image data, so their full size level is decoded to RGBA first
+		void CopyTexture(Texture const & texture, int32_t layer, int32_t x, int32_t y);
+	};
+}
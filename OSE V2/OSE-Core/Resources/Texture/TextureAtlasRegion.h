@@ -0,0 +1,15 @@
+#pragma once
+
+namespace ose
+{
+	// The region of a texture atlas occupied by a single texture
+	struct TextureAtlasRegion
+	{
+		// The layer of the texture array the texture is packed into
+		int32_t layer_ { 0 };
+
+		// UV offset (xy) and UV scale (zw) of the texture within the layer
+		// A texture co-ordinate uv of the original texture maps to uv_rect_.xy + uv * uv_rect_.zw
+		glm::vec4 uv_rect_ { 0.0f, 0.0f, 1.0f, 1.0f };
+	};
+}
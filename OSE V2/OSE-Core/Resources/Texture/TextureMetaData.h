@@ -1,4 +1,5 @@
 #pragma once
+#include "ETextureCompression.h"
 
 namespace ose
 {
@@ -14,5 +15,8 @@ namespace ose
 		uint32_t min_lod_ { 0 };
 		uint32_t max_lod_ { 0 };
 		uint32_t lod_bias_ { 0 };
+
+		//block compressed format the texture is transcoded to by ResourceManager::CompressTextures, NONE to keep it uncompressed
+		ETextureCompression compression_ { ETextureCompression::NONE };
 	};
 }
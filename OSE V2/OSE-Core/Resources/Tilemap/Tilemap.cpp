@@ -49,6 +49,7 @@ namespace ose
 				height_ = 0;
 				tile_grid_ = nullptr;
 			}
+			ResetEditLog();
 		}
 	}
 
@@ -58,5 +59,46 @@ namespace ose
 		height_ = 0;
 		delete[] tile_grid_;
 		tile_grid_ = nullptr;
+		ResetEditLog();
+	}
+
+	// Set the value of a tile at runtime
+	// Unlike operator(), the edit is recorded s.t. renderers can update only the affected region of the tilemap
+	void Tilemap::SetTile(int32_t col, int32_t row, int32_t value)
+	{
+		if(col < 0 || row < 0 || col >= width_ || row >= height_)
+		{
+			LOG_ERROR("Failed to set tile", col, row, "as it is outside of the tilemap");
+			return;
+		}
+		tile_grid_[col + static_cast<size_t>(row) * width_] = value;
+
+		// Discard the oldest half of the log once it is full
+		if(edit_log_.size() >= MAX_EDIT_LOG_SIZE)
+		{
+			size_t discard { edit_log_.size() / 2 };
+			edit_log_.erase(edit_log_.begin(), edit_log_.begin() + discard);
+			log_start_revision_ += static_cast<uint32_t>(discard);
+		}
+		edit_log_.push_back({ col, row });
+		++revision_;
+	}
+
+	// Append the edits made since a revision to a list of edits
+	// Returns false if the edit log no longer covers the revision, in which case the whole tilemap should be treated as changed
+	bool Tilemap::GetEditsSince(uint32_t revision, std::vector<TileEdit> & edits) const
+	{
+		if(revision < log_start_revision_ || revision > revision_)
+			return false;
+		edits.insert(edits.end(), edit_log_.begin() + (revision - log_start_revision_), edit_log_.end());
+		return true;
+	}
+
+	// Discard the edit log, called when the whole tile grid changes
+	void Tilemap::ResetEditLog()
+	{
+		edit_log_.clear();
+		++revision_;
+		log_start_revision_ = revision_;
 	}
 }
@@ -3,6 +3,13 @@
 
 namespace ose
 {
+	// A single tile edit recorded in a tilemap's edit log
+	struct TileEdit
+	{
+		int32_t col_;
+		int32_t row_;
+	};
+
 	class Tilemap
 	{
 	public:
@@ -27,6 +34,17 @@ namespace ose
 		int32_t operator[](size_t index) const { return tile_grid_[index]; }
 		int32_t operator()(size_t col, size_t row) const { return tile_grid_[col + row*width_]; }
 
+		// Set the value of a tile at runtime
+		// Unlike operator(), the edit is recorded s.t. renderers can update only the affected region of the tilemap
+		void SetTile(int32_t col, int32_t row, int32_t value);
+
+		// Get the revision of the tilemap, incremented by every edit
+		uint32_t GetRevision() const { return revision_; }
+
+		// Append the edits made since a revision to a list of edits
+		// Returns false if the edit log no longer covers the revision, in which case the whole tilemap should be treated as changed
+		bool GetEditsSince(uint32_t revision, std::vector<TileEdit> & edits) const;
+
 	protected:
 		std::string name_;
 		std::string path_;
@@ -35,5 +53,16 @@ namespace ose
 
 		int32_t width_;
 		int32_t height_;
+
+		// Maximum number of edits kept in the edit log, older edits are discarded once the log is full
+		static constexpr size_t MAX_EDIT_LOG_SIZE { 4096 };
+
+		// Log of edits, edit_log_[i] was made at revision log_start_revision_ + i + 1
+		std::vector<TileEdit> edit_log_;
+		uint32_t log_start_revision_ { 0 };
+		uint32_t revision_ { 0 };
+
+		// Discard the edit log, called when the whole tile grid changes
+		void ResetEditLog();
 	};
 }
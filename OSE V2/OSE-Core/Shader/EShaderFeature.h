@@ -0,0 +1,19 @@
+#pragma once
+
+namespace ose
+{
+	// Optional features of a shader, combined into a bit mask which selects the shader variant a material is drawn with
+	// Materials should only request the features they use s.t. the cheapest variant is used
+	enum EShaderFeature : uint32_t
+	{
+		SHADER_FEATURE_NONE = 0,
+		SHADER_FEATURE_NORMAL_MAP = 1,		// Perturb the surface normal by a normal map, otherwise the vertex normal is used
+		SHADER_FEATURE_PBR_MAPS = 2,		// Read metallic, roughness and ambient occlusion maps, otherwise constants are used
+		SHADER_FEATURE_POINT_LIGHTS = 4,	// Shade with the point lights of the fragment's cluster
+		SHADER_FEATURE_DIR_LIGHTS = 8,		// Shade with the direction lights
+		SHADER_FEATURE_ALPHA_TEST = 16,		// Discard fragments whose albedo alpha is below 0.5
+
+		// Features used by materials which do not request any, matches the shaders before variants were introduced
+		SHADER_FEATURE_DEFAULT = SHADER_FEATURE_NORMAL_MAP | SHADER_FEATURE_PBR_MAPS | SHADER_FEATURE_POINT_LIGHTS | SHADER_FEATURE_DIR_LIGHTS
+	};
+}
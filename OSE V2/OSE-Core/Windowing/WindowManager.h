@@ -50,6 +50,16 @@ namespace ose
 		virtual void Update() = 0;
 
 		virtual double GetTimeSeconds() const = 0;
+
+		// Create a hidden context which shares GPU objects with the window's context, s.t. worker threads can create GPU resources
+		// Must be called from the main thread, returns nullptr if the windowing toolkit does not support shared contexts
+		virtual void * NewSharedContext() { return nullptr; }
+
+		// Make a context current on the calling thread, nullptr releases the calling thread's context
+		virtual void MakeContextCurrent(void * context) {}
+
+		// Destroy a context created by NewSharedContext, must be called from the main thread once no thread is using the context
+		virtual void DestroySharedContext(void * context) {}
 	private:
 		virtual int	InitWindowingToolkit() const = 0;
 
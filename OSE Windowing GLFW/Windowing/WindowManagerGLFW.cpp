@@ -137,6 +137,36 @@ namespace ose::windowing
 
 
 
+	// Create a hidden context which shares GPU objects with the window's context, s.t. worker threads can create GPU resources
+	// Must be called from the main thread, returns nullptr if the windowing toolkit does not support shared contexts
+	void * WindowManagerGLFW::NewSharedContext()
+	{
+		if(!window_)
+			return nullptr;
+
+		// GLFW contexts belong to windows, so the shared context is given a tiny invisible window
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		GLFWwindow * context { glfwCreateWindow(1, 1, "", NULL, window_) };
+		glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+
+		if(!context)
+			LOG_ERROR("Failed to create shared GLFW context");
+		return context;
+	}
+
+	// Make a context current on the calling thread, nullptr releases the calling thread's context
+	void WindowManagerGLFW::MakeContextCurrent(void * context)
+	{
+		glfwMakeContextCurrent(static_cast<GLFWwindow *>(context));
+	}
+
+	// Destroy a context created by NewSharedContext, must be called from the main thread once no thread is using the context
+	void WindowManagerGLFW::DestroySharedContext(void * context)
+	{
+		if(context)
+			glfwDestroyWindow(static_cast<GLFWwindow *>(context));
+	}
+
 	void WindowManagerGLFW::Update()
 	{
 		//swap buffers to update the screen and then poll for new events
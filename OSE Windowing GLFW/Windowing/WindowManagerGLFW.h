@@ -40,6 +40,16 @@ namespace ose::windowing
 		void Update();
 
 		double GetTimeSeconds() const {return glfwGetTime();}
+
+		// Create a hidden context which shares GPU objects with the window's context, s.t. worker threads can create GPU resources
+		// Must be called from the main thread, returns nullptr if the windowing toolkit does not support shared contexts
+		void * NewSharedContext() override;
+
+		// Make a context current on the calling thread, nullptr releases the calling thread's context
+		void MakeContextCurrent(void * context) override;
+
+		// Destroy a context created by NewSharedContext, must be called from the main thread once no thread is using the context
+		void DestroySharedContext(void * context) override;
 	private:
 		int InitWindowingToolkit() const;
 